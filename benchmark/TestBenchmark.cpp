@@ -2,7 +2,9 @@
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cstdio>
 
 #include "kompute/Kompute.hpp"
 #include "kompute/logger/Logger.hpp"
@@ -68,14 +70,9 @@ TEST(TestBenchmark, TestMultipleSequenceOperationMostlyGPU)
     auto startTime = std::chrono::high_resolution_clock::now();
 
     for (uint32_t i = 0; i < numIter; i++) {
-        for (auto& sequence : sequences) {
-            // Opt: Run all queues async
-            // (Wait only for the last one)
-            sequence->evalAsync();
-        }
-        for (auto& sequence : sequences) {
-            sequence->evalAwait();
-        }
+        // Opt: Submit all sequences in a single queue submission
+        mgr.submit(sequences);
+        mgr.await();
     }
 
     auto endTime = std::chrono::high_resolution_clock::now();
@@ -92,3 +89,423 @@ TEST(TestBenchmark, TestMultipleSequenceOperationMostlyGPU)
     EXPECT_LT(totalTime, 50000000);
 }
 
+
+TEST(TestBenchmark, TestTensorCreationWithAndWithoutMemoryPool)
+{
+    // num<> parameters below can be tweaked for benchmark
+    uint32_t numIter = 10;
+    uint32_t numTensors = 1000;
+    uint32_t numElems = 256;
+
+    auto createTensors = [&](kp::Manager& mgr) {
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        for (uint32_t i = 0; i < numIter; i++) {
+            std::vector<std::shared_ptr<kp::TensorT<float>>> tensors;
+            for (uint32_t j = 0; j < numTensors; j++) {
+                tensors.push_back(mgr.tensor(std::vector<float>(numElems, j)));
+            }
+            // Opt: Release the tensors so the pool can hand the ranges out again
+            tensors.clear();
+            mgr.clear();
+        }
+
+        auto endTime = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime)
+          .count();
+    };
+
+    kp::Manager mgrNoPool;
+    auto totalTimeNoPool = createTensors(mgrNoPool);
+
+    kp::Manager mgrPool;
+    std::shared_ptr<kp::MemoryPool> pool = mgrPool.enableMemoryPool();
+    auto totalTimePool = createTensors(mgrPool);
+
+    kp::MemoryPool::Stats stats = pool->stats();
+
+    KP_LOG_INFO("Created {} tensors without pool in {}us, with pool in {}us "
+                "using {} device allocations",
+                numIter * numTensors,
+                totalTimeNoPool,
+                totalTimePool,
+                stats.deviceAllocateCalls);
+
+    EXPECT_EQ(stats.allocationCount, 0u);
+    EXPECT_EQ(stats.totalAllocations, (uint64_t)numIter * numTensors * 2);
+    EXPECT_LT(stats.deviceAllocateCalls, (uint64_t)numIter * numTensors * 2);
+}
+
+TEST(TestBenchmark, TestStagingPolicyBandwidth)
+{
+    // num<> parameters below can be tweaked for benchmark
+    uint32_t numIter = 20;
+    uint32_t numElems = 16 * 1024 * 1024;
+
+    double totalBytes = (double)numIter * numElems * sizeof(float);
+
+    for (kp::Memory::StagingPolicy policy :
+         { kp::Memory::StagingPolicy::eUpload,
+           kp::Memory::StagingPolicy::eReadback }) {
+        kp::Manager mgr;
+        mgr.setStagingPolicy(policy);
+
+        std::vector<float> data(numElems, 1);
+        std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor(data);
+
+        std::shared_ptr<kp::Sequence> sqUpload =
+          mgr.sequence()->record<kp::OpSyncDevice>({ tensor });
+        std::shared_ptr<kp::Sequence> sqReadback =
+          mgr.sequence()->record<kp::OpSyncLocal>({ tensor });
+
+        uint64_t uploadTime = 0;
+        uint64_t readbackTime = 0;
+        double sum = 0;
+
+        for (uint32_t i = 0; i < numIter; i++) {
+            auto startTime = std::chrono::high_resolution_clock::now();
+            tensor->setData(data);
+            sqUpload->eval();
+            auto midTime = std::chrono::high_resolution_clock::now();
+            sqReadback->eval();
+            // Opt: Read every element so the host reads hit the staging memory
+            const float* values = tensor->data();
+            for (uint32_t j = 0; j < numElems; j++) {
+                sum += values[j];
+            }
+            auto endTime = std::chrono::high_resolution_clock::now();
+
+            uploadTime += std::chrono::duration_cast<std::chrono::microseconds>(
+                            midTime - startTime)
+                            .count();
+            readbackTime +=
+              std::chrono::duration_cast<std::chrono::microseconds>(endTime -
+                                                                    midTime)
+                .count();
+        }
+
+        KP_LOG_INFO("Staging policy {} with memory flags {}: upload {} MB/s, "
+                    "readback {} MB/s",
+                    kp::Memory::toString(policy),
+                    vk::to_string(tensor->hostMemoryPropertyFlags()),
+                    totalBytes / std::max<uint64_t>(uploadTime, 1),
+                    totalBytes / std::max<uint64_t>(readbackTime, 1));
+
+        EXPECT_EQ(sum, totalBytes / sizeof(float));
+    }
+}
+
+TEST(TestBenchmark, TestStagingRingBandwidth)
+{
+    // num<> parameters below can be tweaked for benchmark
+    uint32_t numIter = 20;
+    uint32_t numTensors = 4;
+    uint32_t numElems = 16 * 1024 * 1024;
+
+    double totalBytes = (double)numIter * numTensors * numElems * sizeof(float);
+
+    for (bool useRing : { false, true }) {
+        kp::Manager mgr;
+        if (useRing) {
+            mgr.enableStagingRing();
+        }
+
+        std::vector<float> data(numElems, 1);
+        std::vector<std::shared_ptr<kp::Memory>> tensors;
+        for (uint32_t i = 0; i < numTensors; i++) {
+            tensors.push_back(mgr.tensor(data));
+        }
+
+        std::shared_ptr<kp::Sequence> sqUpload =
+          mgr.sequence()->record<kp::OpSyncDevice>(tensors);
+        std::shared_ptr<kp::Sequence> sqReadback =
+          mgr.sequence()->record<kp::OpSyncLocal>(tensors);
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        for (uint32_t i = 0; i < numIter; i++) {
+            sqUpload->eval();
+            sqReadback->eval();
+        }
+        auto endTime = std::chrono::high_resolution_clock::now();
+
+        uint64_t totalTime =
+          std::chrono::duration_cast<std::chrono::microseconds>(endTime -
+                                                                startTime)
+            .count();
+
+        // Opt: Staging bytes held is the host visible memory on top of the
+        // device buffers, which the ring bounds regardless of tensor sizes
+        uint64_t stagingBytes =
+          useRing ? mgr.getStagingRing()->size()
+                  : (uint64_t)numTensors * numElems * sizeof(float);
+
+        KP_LOG_INFO("Staging ring {}: round trip {} MB/s with {} MB of "
+                    "staging memory",
+                    useRing ? "enabled" : "disabled",
+                    2 * totalBytes / std::max<uint64_t>(totalTime, 1),
+                    stagingBytes / (1024 * 1024));
+
+        EXPECT_EQ(tensors[0]->vector<float>(), data);
+    }
+}
+
+TEST(TestBenchmark, TestParallelRecording)
+{
+    // num<> parameters below can be tweaked for benchmark
+    uint32_t numOps = 100000;
+    uint32_t numElems = 64;
+
+    std::string shader(R"(
+        #version 450
+
+        layout(local_size_x = 1) in;
+
+        layout(binding = 0) buffer tensorOut { float out_[]; };
+
+        layout(push_constant) uniform PushConstants { float value; } pc;
+
+        void main() {
+            out_[gl_GlobalInvocationID.x] += pc.value;
+        }
+    )");
+
+    std::vector<uint32_t> spirv = compileSource(shader);
+
+    for (uint32_t numThreads : { 1, 4, 16 }) {
+        kp::Manager mgr;
+
+        std::shared_ptr<kp::TensorT<float>> tensorOut =
+          mgr.tensor(std::vector<float>(numElems, 0));
+
+        std::shared_ptr<kp::Algorithm> algorithm = mgr.algorithm(
+          { tensorOut }, spirv, { numElems, 1, 1 }, {}, { 0.0f });
+
+        std::vector<std::shared_ptr<kp::OpBase>> ops;
+        for (uint32_t i = 0; i < numOps; i++) {
+            ops.push_back(std::make_shared<kp::OpAlgoDispatch>(
+              algorithm, std::vector<float>{ 1.0f }));
+        }
+
+        std::shared_ptr<kp::Sequence> sq =
+          mgr.sequence()->record<kp::OpSyncDevice>({ tensorOut });
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        // Opt: Record the dispatches into per-thread secondary buffers
+        sq->recordParallel(ops, numThreads);
+
+        auto endTime = std::chrono::high_resolution_clock::now();
+        auto recordTime =
+          std::chrono::duration_cast<std::chrono::microseconds>(endTime -
+                                                                startTime)
+            .count();
+
+        sq->record<kp::OpSyncLocal>({ tensorOut })->eval();
+
+        KP_LOG_INFO("Recorded {} dispatches with {} threads in {}us",
+                    numOps,
+                    numThreads,
+                    recordTime);
+
+        EXPECT_EQ(tensorOut->vector(), std::vector<float>(numElems, numOps));
+    }
+}
+
+TEST(TestBenchmark, TestWaitStrategyLatency)
+{
+    // num<> parameters below can be tweaked for benchmark
+    uint32_t numIterations = 2000;
+    uint32_t numElems = 64;
+
+    std::string shader(R"(
+        #version 450
+
+        layout(local_size_x = 1) in;
+
+        layout(binding = 0) buffer tensorOut { float out_[]; };
+
+        void main() {
+            out_[gl_GlobalInvocationID.x] += 1.0;
+        }
+    )");
+
+    std::vector<uint32_t> spirv = compileSource(shader);
+
+    for (kp::Sequence::WaitStrategy strategy :
+         { kp::Sequence::WaitStrategy::eBlock,
+           kp::Sequence::WaitStrategy::eSpin,
+           kp::Sequence::WaitStrategy::eHybrid }) {
+        kp::Manager mgr;
+
+        std::shared_ptr<kp::TensorT<float>> tensorOut =
+          mgr.tensor(std::vector<float>(numElems, 0));
+
+        std::shared_ptr<kp::Algorithm> algorithm =
+          mgr.algorithm({ tensorOut }, spirv, { numElems, 1, 1 });
+
+        mgr.sequence()->eval<kp::OpSyncDevice>({ tensorOut });
+
+        std::shared_ptr<kp::Sequence> sq =
+          mgr.sequence()->record<kp::OpAlgoDispatch>(algorithm);
+
+        // Opt: Poll the fence instead of sleeping until it signals
+        sq->setWaitStrategy(strategy);
+
+        std::vector<uint64_t> latencies;
+        for (uint32_t i = 0; i < numIterations; i++) {
+            auto startTime = std::chrono::high_resolution_clock::now();
+            sq->evalAsync()->evalAwait();
+            auto endTime = std::chrono::high_resolution_clock::now();
+            latencies.push_back(
+              std::chrono::duration_cast<std::chrono::nanoseconds>(endTime -
+                                                                   startTime)
+                .count());
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+
+        KP_LOG_INFO("Wait strategy {}: submit to completion p50 {}ns, "
+                    "p99 {}ns",
+                    static_cast<int>(strategy),
+                    latencies[latencies.size() / 2],
+                    latencies[latencies.size() * 99 / 100]);
+
+        sq->record<kp::OpSyncLocal>({ tensorOut })->eval();
+
+        EXPECT_EQ(tensorOut->vector(),
+                  std::vector<float>(numElems, numIterations + 1));
+    }
+}
+
+TEST(TestBenchmark, TestPipelineCacheStartup)
+{
+    // num<> parameters below can be tweaked for benchmark
+    uint32_t numAlgorithms = 64;
+    uint32_t numElems = 64;
+    std::string path = "kompute_benchmark_pipeline_cache.bin";
+
+    std::string shader(R"(
+        #version 450
+
+        layout(local_size_x = 1) in;
+
+        layout(constant_id = 0) const float scale = 1.0;
+
+        layout(binding = 0) buffer tensorOut { float out_[]; };
+
+        void main() {
+            float value = out_[gl_GlobalInvocationID.x];
+            for (uint i = 0; i < 16; i++) {
+                value = sin(value * scale) + cos(value + float(i));
+            }
+            out_[gl_GlobalInvocationID.x] = value;
+        }
+    )");
+
+    std::vector<uint32_t> spirv = compileSource(shader);
+
+    // Each specialization constant value compiles a different pipeline
+    auto startup = [&](bool warm) {
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        kp::Manager mgr;
+
+        // Opt: Skip the compilation of the pipelines saved by earlier runs
+        if (warm) {
+            EXPECT_TRUE(mgr.loadPipelineCache(path));
+        }
+
+        std::shared_ptr<kp::TensorT<float>> tensorOut =
+          mgr.tensor(std::vector<float>(numElems, 0));
+
+        std::vector<std::shared_ptr<kp::Algorithm>> algorithms;
+        for (uint32_t i = 0; i < numAlgorithms; i++) {
+            algorithms.push_back(mgr.algorithm(
+              { tensorOut }, spirv, { numElems, 1, 1 }, { float(i) }));
+        }
+
+        auto endTime = std::chrono::high_resolution_clock::now();
+
+        if (!warm) {
+            mgr.savePipelineCache(path);
+        }
+
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+                 endTime - startTime)
+          .count();
+    };
+
+    std::remove(path.c_str());
+    auto coldTime = startup(false);
+    auto warmTime = startup(true);
+    std::remove(path.c_str());
+
+    KP_LOG_INFO("Started up with {} algorithms in {}us with a cold pipeline "
+                "cache, {}us with a warm pipeline cache",
+                numAlgorithms,
+                coldTime,
+                warmTime);
+}
+
+TEST(TestBenchmark, TestAlgorithmCreationWithPipelineRegistry)
+{
+    // num<> parameters below can be tweaked for benchmark
+    uint32_t numAlgorithms = 100;
+    uint32_t numElems = 64;
+
+    std::string shader(R"(
+        #version 450
+
+        layout(local_size_x = 1) in;
+
+        layout(binding = 0) buffer tensorIn { float in_[]; };
+        layout(binding = 1) buffer tensorOut { float out_[]; };
+
+        void main() {
+            out_[gl_GlobalInvocationID.x] += in_[gl_GlobalInvocationID.x];
+        }
+    )");
+
+    std::vector<uint32_t> spirv = compileSource(shader);
+
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorIn =
+      mgr.tensor(std::vector<float>(numElems, 1));
+
+    std::vector<std::shared_ptr<kp::TensorT<float>>> tensorsOut;
+    for (uint32_t i = 0; i < numAlgorithms; i++) {
+        tensorsOut.push_back(mgr.tensor(std::vector<float>(numElems, 0)));
+    }
+
+    std::vector<std::shared_ptr<kp::Algorithm>> algorithms;
+    std::vector<uint64_t> creationTimes;
+    for (uint32_t i = 0; i < numAlgorithms; i++) {
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        // Opt: Algorithms with the same SPIR-V share their pipeline
+        algorithms.push_back(mgr.algorithm({ tensorIn, tensorsOut[i] }, spirv));
+
+        auto endTime = std::chrono::high_resolution_clock::now();
+        creationTimes.push_back(
+          std::chrono::duration_cast<std::chrono::microseconds>(endTime -
+                                                                startTime)
+            .count());
+    }
+
+    uint64_t sharedTime = 0;
+    for (uint32_t i = 1; i < numAlgorithms; i++) {
+        sharedTime += creationTimes[i];
+    }
+
+    kp::PipelineRegistry::Stats stats = mgr.getPipelineRegistry()->stats();
+
+    KP_LOG_INFO("Created the first algorithm in {}us and {} algorithms "
+                "sharing its pipeline in {}us on average",
+                creationTimes[0],
+                numAlgorithms - 1,
+                sharedTime / (numAlgorithms - 1));
+
+    EXPECT_EQ(stats.pipelinesCreated, 1u);
+    EXPECT_EQ(stats.pipelineHits, (uint64_t)numAlgorithms - 1);
+}
@@ -68,6 +68,12 @@ R"doc(Gets the current memory objects that are used in the algorithm.
 Returns:
     The list of memory objects used in the algorithm.)doc";
 
+static const char *__doc_kp_Algorithm_getName =
+R"doc(Gets the name of the algorithm.
+
+Returns:
+    The name of the algorithm, which is empty unless set)doc";
+
 static const char *__doc_kp_Algorithm_getPushConstants =
 R"doc(Gets the specialization constants of the current algorithm.
 
@@ -95,6 +101,17 @@ these have been created and returns true if all are valid.
 Returns:
     returns true if the algorithm is currently initialized.)doc";
 
+static const char *__doc_kp_Algorithm_isReadOnly =
+R"doc(Returns true if the shader only reads the memory object at the index
+provided, which is the case when its binding is declared readonly in
+the shader.
+
+Parameters:
+    index The index of the memory object, which is its binding
+
+Returns:
+    Boolean stating if the memory object is only read)doc";
+
 static const char *__doc_kp_Algorithm_mDescriptorPool = R"doc()doc";
 
 static const char *__doc_kp_Algorithm_mDescriptorSet = R"doc()doc";
@@ -182,6 +199,24 @@ same size as the ones provided during initialization.
 Parameter ``commandBuffer``:
     Command buffer to record the algorithm resources to)doc";
 
+static const char *__doc_kp_Algorithm_recordBindPush_2 =
+R"doc(Records command that binds the push constants provided to the command
+buffer, without changing the push constants of the algorithm. This
+allows recording dispatches with different push constants from several
+threads at the same time.
+
+Parameter ``commandBuffer``:
+    Command buffer to record the algorithm resources to
+
+Parameter ``data``:
+    The raw data of the push constants
+
+Parameter ``size``:
+    The number of data elements provided in the data
+
+Parameter ``memorySize``:
+    The memory size of each of the data elements in bytes)doc";
+
 static const char *__doc_kp_Algorithm_recordDispatch =
 R"doc(Records the dispatch function with the provided template parameters or
 alternatively using the size of the tensor by default.
@@ -189,6 +224,13 @@ alternatively using the size of the tensor by default.
 Parameter ``commandBuffer``:
     Command buffer to record the algorithm resources to)doc";
 
+static const char *__doc_kp_Algorithm_setName =
+R"doc(Sets the name of the algorithm, which labels its dispatches in the
+profiles of kp::Profiler.
+
+Parameter ``name``:
+    The name of the algorithm)doc";
+
 static const char *__doc_kp_Algorithm_setPushConstants =
 R"doc(Sets the push constants to the new value provided to use in the next
 bindPush()
@@ -617,6 +659,13 @@ Parameter ``pushConstants``:
 Returns:
     Shared pointer with initialised algorithm)doc";
 
+static const char *__doc_kp_Manager_await =
+R"doc(Waits for the queue submissions made with submit to finish processing
+and then runs the postEval of all operations of their sequences.
+
+Parameter ``waitFor``:
+    Number of milliseconds to wait before timing out.)doc";
+
 static const char *__doc_kp_Manager_clear =
 R"doc(Run a pseudo-garbage collection to release all the managed resources
 that have been already freed due to these reaching to zero ref count.)doc";
@@ -627,6 +676,18 @@ static const char *__doc_kp_Manager_createInstance = R"doc()doc";
 
 static const char *__doc_kp_Manager_destroy = R"doc(Destroy the GPU resources and all managed resources by manager.)doc";
 
+static const char *__doc_kp_Manager_fragment =
+R"doc(Create a managed sequence fragment that will be destroyed by this
+manager if it hasn't been destroyed by its reference count going to
+zero. The operations recorded into the fragment can be executed by the
+sequences of queues of the same family with kp::OpExecuteFragment.
+
+Parameter ``queueIndex``:
+    The queue whose family the fragment is recorded for
+
+Returns:
+    Shared pointer with initialised sequence fragment)doc";
+
 static const char *__doc_kp_Manager_getDeviceProperties =
 R"doc(Information about the current device.
 
@@ -634,6 +695,27 @@ Returns:
     vk::PhysicalDeviceProperties containing information about the
     device)doc";
 
+static const char *__doc_kp_Manager_getPipelineCache =
+R"doc(The pipeline cache shared by the algorithms created by the manager.
+
+Returns:
+    Shared pointer to the pipeline cache of the manager)doc";
+
+static const char *__doc_kp_Manager_getPipelineRegistry =
+R"doc(The registry through which the algorithms created by the manager share
+their shader modules and pipelines, so algorithms with the same SPIR-V,
+specialization constants, descriptor types and push constant range
+only compile their pipeline once.
+
+Returns:
+    Shared pointer to the pipeline registry of the manager)doc";
+
+static const char *__doc_kp_Manager_getStagingPolicy =
+R"doc(The staging policy used for new memory objects.
+
+Returns:
+    The staging policy of the manager)doc";
+
 static const char *__doc_kp_Manager_getVkInstance =
 R"doc(The current Vulkan instance.
 
@@ -682,6 +764,20 @@ R"doc(List the devices available in the current vulkan instance.
 Returns:
     vector of physical devices containing their respective properties)doc";
 
+static const char *__doc_kp_Manager_loadPipelineCache =
+R"doc(Merges the pipeline cache data saved to a file by savePipelineCache
+into the pipeline cache shared by the algorithms of the manager, so the
+pipelines they create skip the compilation of their shaders. Data
+saved by a different device or driver, identified by the vendor,
+device and pipeline cache UUID of its header, is ignored.
+
+Parameter ``path``:
+    The path of the file to load the pipeline cache from
+
+Returns:
+    True if the data was loaded, or false if the file doesn't exist or
+    its data doesn't match the device)doc";
+
 static const char *__doc_kp_Manager_mComputeQueueFamilyIndices = R"doc()doc";
 
 static const char *__doc_kp_Manager_mComputeQueues = R"doc()doc";
@@ -708,6 +804,27 @@ static const char *__doc_kp_Manager_mManagedSequences = R"doc()doc";
 
 static const char *__doc_kp_Manager_mPhysicalDevice = R"doc()doc";
 
+static const char *__doc_kp_Manager_profiler =
+R"doc(Create a profiler for the operations of the sequences of this manager,
+which converts their timestamps with the timestamp period of the
+device. Sequences are profiled when created with a timestamp per
+operation plus one.
+
+Parameter ``maxEvents``:
+    The number of most recent events kept by the profiler
+
+Returns:
+    Shared pointer with initialised profiler)doc";
+
+static const char *__doc_kp_Manager_savePipelineCache =
+R"doc(Saves the data of the pipeline cache shared by the algorithms of the
+manager to a file, which is written to a temporary file first and then
+renamed, so processes loading it concurrently never read a partial
+file.
+
+Parameter ``path``:
+    The path of the file to save the pipeline cache to)doc";
+
 static const char *__doc_kp_Manager_sequence =
 R"doc(Create a managed sequence that will be destroyed by this manager if it
 hasn't been destroyed by its reference count going to zero.
@@ -719,9 +836,32 @@ Parameter ``nrOfTimestamps``:
     The maximum number of timestamps to allocate. If zero (default),
     disables latching of timestamps.
 
+Parameter ``numBuffers``:
+    The number of command buffers the sequence submits in turn, which
+    is the maximum number of its submissions in flight.
+
 Returns:
     Shared pointer with initialised sequence)doc";
 
+static const char *__doc_kp_Manager_setStagingPolicy =
+R"doc(Sets the staging policy of the tensors and images created after this
+call. Memory objects that are mostly read back with OpSyncLocal should
+use kp::Memory::StagingPolicy::eReadback so their staging memory is
+host cached.
+
+Parameter ``stagingPolicy``:
+    The staging policy for new memory objects)doc";
+
+static const char *__doc_kp_Manager_submit =
+R"doc(Submits the recorded operations of several sequences, grouping the
+sequences that use the same queue into a single queue submission with
+one fence, which avoids the overhead of submitting each sequence
+separately. The submissions are awaited with await, or individually
+with the evalAwait functions of the sequences.
+
+Parameter ``sequences``:
+    The sequences to submit, in submission order)doc";
+
 static const char *__doc_kp_Manager_tensor = R"doc()doc";
 
 static const char *__doc_kp_Manager_tensor_2 = R"doc()doc";
@@ -782,6 +922,13 @@ static const char *__doc_kp_Memory_DataTypes_eUnsignedShort = R"doc()doc";
 
 static const char *__doc_kp_Memory_Memory = R"doc()doc";
 
+static const char *__doc_kp_Memory_Memory_2 =
+R"doc(Constructor of a one dimensional memory object, such as a tensor,
+whose number of elements may exceed the range of the image dimensions.
+
+Parameter ``size``:
+    The total number of elements of the memory object)doc";
+
 static const char *__doc_kp_Memory_MemoryTypes =
 R"doc(Type for memory created: Device allows memory to be transferred from
 staging memory. Staging are host memory visible. Storage are device
@@ -794,6 +941,20 @@ static const char *__doc_kp_Memory_MemoryTypes_eHost = R"doc(< Type is host memo
 
 static const char *__doc_kp_Memory_MemoryTypes_eStorage = R"doc(< Type is Device memory (only))doc";
 
+static const char *__doc_kp_Memory_MemoryTypes_eTransient = R"doc(< Type is Device memory (only) aliased by sequence)doc";
+
+static const char *__doc_kp_Memory_StagingPolicy =
+R"doc(Access pattern the host visible staging memory is optimised for.
+Upload staging uses write-combined memory, which is fast for the host
+to write but slow to read back. Readback staging prefers host cached
+memory, which is fast for the host to read after OpSyncLocal. If the
+preferred memory is not available on the device, the staging memory
+falls back to any host visible and host coherent memory.)doc";
+
+static const char *__doc_kp_Memory_StagingPolicy_eReadback = R"doc(< Host cached memory for device to host transfers)doc";
+
+static const char *__doc_kp_Memory_StagingPolicy_eUpload = R"doc(< Write-combined memory for host to device transfers)doc";
+
 static const char *__doc_kp_Memory_constructDescriptorSet =
 R"doc(Adds this object to a Vulkan descriptor set at \p binding.
 
@@ -986,6 +1147,31 @@ static const char *__doc_kp_Memory_setData_2 =
 R"doc(Sets / resets the data of the tensor/image which is directly done on
 the GPU host visible memory available by the tensor/image.)doc";
 
+static const char *__doc_kp_Memory_setData_3 =
+R"doc(Sets a range of the data of the tensor/image, which is directly done
+on the GPU host visible memory. Only the range written is flushed to the
+device by the next flushHostMemory.
+
+Parameter ``data``:
+    The data to copy into the memory object
+
+Parameter ``offset``:
+    The offset in bytes into the data of the memory object
+
+Parameter ``size``:
+    The size in bytes of the data to copy)doc";
+
+static const char *__doc_kp_Memory_setData_4 =
+R"doc(Sets a range of the elements of the tensor/image, which is directly
+done on the GPU host visible memory. Only the range written is flushed
+to the device by the next flushHostMemory.
+
+Parameter ``data``:
+    The elements to copy into the memory object
+
+Parameter ``offset``:
+    The index of the first element to set)doc";
+
 static const char *__doc_kp_Memory_size =
 R"doc(Returns the size/magnitude of the Tensor/Image, which will be the
 total number of elements across all dimensions
@@ -1053,6 +1239,39 @@ sends the shader processing to the gpu. This function also records the
 GPU memory copy of the output data for the staging buffer so it can be
 read by the host.
 
+Parameter ``commandBuffer``:
+    The command buffer to record the command into.)doc";
+
+static const char *__doc_kp_OpAlgoDispatchIndirect =
+R"doc(Operation that dispatches an algorithm with the workgroup counts read
+by the GPU from a tensor when the dispatch executes, instead of the
+workgroup of the algorithm. The tensor holds the X, Y and Z counts as
+three consecutive 32 bit unsigned integers, which can be written by
+earlier operations of the sequence, such as kp::OpWorkgroupCount.)doc";
+
+static const char *__doc_kp_OpAlgoDispatchIndirect_OpAlgoDispatchIndirect =
+R"doc(Constructor that stores the algorithm to dispatch, the tensor with the
+workgroup counts and the relevant push constants to override when
+recording.
+
+Parameter ``algorithm``:
+    The algorithm object to use for dispatch
+
+Parameter ``indirectTensor``:
+    The tensor with the workgroup counts
+
+Parameter ``offset``:
+    The offset in bytes of the workgroup counts in the tensor, which
+    has to be a multiple of 4
+
+Parameter ``pushConstants``:
+    The push constants to use for override)doc";
+
+static const char *__doc_kp_OpAlgoDispatchIndirect_record =
+R"doc(Records the bind commands of the algorithm followed by the indirect
+dispatch, which reads the workgroup counts from the primary buffer of
+the indirect tensor.
+
 Parameter ``commandBuffer``:
     The command buffer to record the command into.)doc";
 
@@ -1129,6 +1348,19 @@ other memory objects provided. Also optionally records a barrier.
 Parameter ``commandBuffer``:
     The command buffer to record the command into.)doc";
 
+static const char *__doc_kp_OpExecuteFragment =
+R"doc(Operation that executes the secondary command buffer of a
+kp::SequenceFragment, which inserts the operations recorded into the
+fragment without recording them again. The sequence the operation is
+recorded into has to submit to a queue of the family the fragment was
+created for.)doc";
+
+static const char *__doc_kp_OpExecuteFragment_OpExecuteFragment =
+R"doc(Constructor that stores the fragment to execute.
+
+Parameter ``fragment``:
+    The fragment to execute)doc";
+
 static const char *__doc_kp_OpMemoryBarrier =
 R"doc(Operation that provides a general abstraction that simplifies the use
 of algorithm and parameter components which can be used with shaders.
@@ -1206,6 +1438,56 @@ Parameter ``algorithm``:
     An algorithm that will be overridden with the OpMult shader data
     and the tensors provided which are expected to be 3)doc";
 
+static const char *__doc_kp_OpResize =
+R"doc(Operation that resizes tensors to a new number of elements, reusing
+their buffers while the size fits in their capacity and otherwise
+growing the capacity geometrically into new buffers with a copy of the
+existing contents. Algorithms bound to the tensors refresh their
+descriptors without rebuilding their pipelines. The tensors are resized
+when the operation is recorded, so the operations recorded after it in
+the sequence use the new size.)doc";
+
+static const char *__doc_kp_OpResize_OpResize =
+R"doc(Default constructor with parameters that provides the tensors to
+resize and their new number of elements. All the memory objects
+provided have to be tensors.
+
+Parameter ``memObjects``:
+    Tensors that will be resized by the operation.
+
+Parameter ``elementTotalCount``:
+    The new number of elements of the tensors.)doc";
+
+static const char *__doc_kp_OpResize_getMemObjects =
+R"doc(Returns the memory objects used by the operation.
+
+Returns:
+    The memory objects used by the operation)doc";
+
+static const char *__doc_kp_OpResize_mElementTotalCount = R"doc()doc";
+
+static const char *__doc_kp_OpResize_mMemObjects = R"doc()doc";
+
+static const char *__doc_kp_OpResize_postEval =
+R"doc(Frees the buffers the tensors were copied from once the copy has
+completed.
+
+Parameter ``commandBuffer``:
+    The command buffer to record the command into.)doc";
+
+static const char *__doc_kp_OpResize_preEval =
+R"doc(Does not perform any preEval commands.
+
+Parameter ``commandBuffer``:
+    The command buffer to record the command into.)doc";
+
+static const char *__doc_kp_OpResize_record =
+R"doc(Resizes the tensors, recording the copy of their contents for the ones
+that outgrow their capacity.
+
+Parameter ``commandBuffer``:
+    The command buffer to record the command into.)doc";
+
 static const char *__doc_kp_OpSyncDevice =
 R"doc(Operation that syncs mem object's device memory by mapping local data
 into the device memory. For MemoryTypes::eDevice it will use a record
@@ -1283,6 +1565,123 @@ to copy the data from its device to staging memory.
 Parameter ``commandBuffer``:
     The command buffer to record the command into.)doc";
 
+static const char *__doc_kp_OpSyncParameters =
+R"doc(Operation that copies the parameters of a kp::ParameterBlock into its
+tensor. The parameters set on the block are written into the slot of
+the command buffer during preEval, so a recorded sequence uses the
+parameters set before each of its evals without being recorded again.)doc";
+
+static const char *__doc_kp_OpSyncParameters_OpSyncParameters =
+R"doc(Constructor that stores the parameter block to copy.
+
+Parameter ``parameterBlock``:
+    The parameter block, which has to be created by the sequence the
+    operation is recorded into)doc";
+
+static const char *__doc_kp_OpWorkgroupCount =
+R"doc(Operation that turns an element count computed on the GPU into the
+workgroup counts of an indirect dispatch, with a built-in shader. It
+reads the count from the first element of a 32 bit unsigned integer
+tensor, and writes the number of workgroups of groupSize invocations
+needed to cover it, followed by 1 and 1, to the first three elements
+of another, which can then be used by kp::OpAlgoDispatchIndirect.)doc";
+
+static const char *__doc_kp_OpWorkgroupCount_OpWorkgroupCount =
+R"doc(Constructor that rebuilds the algorithm provided with the built-in
+shader and the tensors provided.
+
+Parameter ``memObjects``:
+    The tensor with the element count, followed by the tensor to write
+    the workgroup counts to
+
+Parameter ``algorithm``:
+    An algorithm that will be overridden with the OpWorkgroupCount
+    shader data and the tensors provided
+
+Parameter ``groupSize``:
+    The number of invocations per workgroup of the indirect dispatch,
+    usually the local size X of its shader)doc";
+
+static const char *__doc_kp_ParameterBlock =
+R"doc(Parameters of the shaders of a sequence that can change between evals
+without recording the sequence again, unlike push constants which are
+recorded into its command buffers.
+
+The parameters live in a tensor bound to the algorithms as any other
+buffer. The block holds a host visible ring with a slot per command
+buffer of the sequence that created it. kp::OpSyncParameters writes
+the current parameters into the slot of the command buffer being
+submitted, which is never in flight, and the command buffer copies its
+slot into the tensor when it executes. Setting new parameters is
+therefore a memcpy, and the submissions in flight keep the values they
+were submitted with.)doc";
+
+static const char *__doc_kp_ParameterBlock_getTensor =
+R"doc(Gets the tensor the parameters are copied into.
+
+Returns:
+    The tensor of the block)doc";
+
+static const char *__doc_kp_ParameterBlock_setData =
+R"doc(Sets the parameters used by the following submissions of the
+sequence, starting at the offset provided.
+
+Parameter ``data``:
+    The host data to copy the parameters from
+
+Parameter ``size``:
+    The size in bytes of the data
+
+Parameter ``offset``:
+    The offset in bytes into the parameters)doc";
+
+static const char *__doc_kp_ParameterBlock_size =
+R"doc(Size in bytes of the parameters, which is the size of the tensor when
+the block was created.
+
+Returns:
+    The size of the parameters)doc";
+
+static const char *__doc_kp_Profiler =
+R"doc(Profiler of the GPU time of the operations of sequences, built on the
+timestamps the sequences latch after each operation. Sequences have to
+be created with at least one timestamp per operation plus one.
+
+After each eval, collect reads the timestamps of the sequence without
+waiting for them, converts them to nanoseconds, and records an event
+per operation labelled with its name, such as the name of the
+algorithm of a dispatch. The profiler keeps the most recent events,
+from which it reports the duration statistics per label and exports a
+trace.)doc";
+
+static const char *__doc_kp_Profiler_clear = R"doc(Discards the events kept by the profiler.)doc";
+
+static const char *__doc_kp_Profiler_collect =
+R"doc(Records the events of the last submission of a sequence, unless its
+timestamps are not available yet or have already been collected. This
+doesn't wait for the submission, so it can be called again later.
+
+Parameter ``sequence``:
+    The sequence to collect the timestamps of
+
+Returns:
+    True if new events were recorded)doc";
+
+static const char *__doc_kp_Profiler_stats =
+R"doc(Returns the duration statistics of the events kept, per label, sorted
+by total duration from the longest.
+
+Returns:
+    The statistics per label)doc";
+
+static const char *__doc_kp_Profiler_traceJson =
+R"doc(Exports the events kept in the Chrome trace event format, which can be
+opened with Perfetto or chrome://tracing. Each sequence is shown as a
+separate thread.
+
+Returns:
+    The trace as a JSON string)doc";
+
 static const char *__doc_kp_Sequence = R"doc(Container of operations that can be sent to GPU as batch)doc";
 
 static const char *__doc_kp_Sequence_Sequence =
@@ -1302,12 +1701,36 @@ Parameter ``queueIndex``:
     Vulkan compute queue index in device
 
 Parameter ``totalTimestamps``:
-    Maximum number of timestamps to allocate)doc";
+    Maximum number of timestamps to allocate
+
+Parameter ``numBuffers``:
+    Number of command buffers and fences the recorded operations are
+    submitted with in turn, which allows resubmitting the sequence
+    while earlier submissions are still executing. Timestamps are only
+    supported with a single buffer.
+
+Parameter ``residency``:
+    Optional residency policy that restores the spilled tensors of the
+    sequence before it is submitted)doc";
+
+static const char *__doc_kp_Sequence_WaitStrategy =
+R"doc(Strategies used by evalAwait and evalAwaitTicket to wait for the
+submissions of the sequence.)doc";
+
+static const char *__doc_kp_Sequence_WaitStrategy_eBlock = R"doc(< Sleeps in the driver until the submission finishes)doc";
+
+static const char *__doc_kp_Sequence_WaitStrategy_eHybrid = R"doc(< Polls for an adaptive duration, and then sleeps)doc";
+
+static const char *__doc_kp_Sequence_WaitStrategy_eSpin = R"doc(< Polls the status of the submission until it finishes)doc";
 
 static const char *__doc_kp_Sequence_begin =
 R"doc(Begins recording commands for commands to be submitted into the
 command buffer.)doc";
 
+static const char *__doc_kp_Sequence_cancelSubmit =
+R"doc(Cancels the last submission prepared with prepareSubmit, which is
+required if its command buffer could not be submitted.)doc";
+
 static const char *__doc_kp_Sequence_clear =
 R"doc(Clear function clears all operations currently recorded and starts
 recording again.)doc";
@@ -1322,6 +1745,27 @@ static const char *__doc_kp_Sequence_destroy =
 R"doc(Destroys and frees the GPU resources which include the buffer and
 memory and sets the sequence as init=False.)doc";
 
+static const char *__doc_kp_Sequence_enablePipelineStatistics =
+R"doc(Creates the pipeline statistics query pool of the sequence, which
+counts the compute shader invocations of each kp::OpAlgoDispatch
+recorded after this call. This requires the pipelineStatisticsQuery
+feature, which kp::Manager enables when the device supports it, and is
+only supported with a single command buffer.
+
+Parameter ``totalQueries``:
+    Maximum number of operations queried, as the operations are queried
+    by their index in the sequence)doc";
+
+static const char *__doc_kp_Sequence_enableTimeline =
+R"doc(Creates the timeline semaphore of the sequence, which requires the
+VK_KHR_timeline_semaphore extension and the timelineSemaphore feature
+to be enabled on the device. Sequences created by a kp::Manager whose
+device has the extension enabled have a timeline semaphore already.
+
+Every submission of a sequence with a timeline semaphore signals it at
+a new value, which other sequences can wait for on the GPU, and
+evalAwait waits for that value instead of the fence.)doc";
+
 static const char *__doc_kp_Sequence_end =
 R"doc(Ends the recording and stops recording commands when the record
 command is sent.)doc";
@@ -1418,7 +1862,9 @@ Returns:
 
 static const char *__doc_kp_Sequence_evalAwait =
 R"doc(Eval Await waits for the fence to finish processing and then once it
-finishes, it runs the postEval of all operations.
+finishes, it runs the postEval of all operations. If the sequence has
+several submissions in flight it waits for all of them in the order
+they were submitted.
 
 Parameter ``waitFor``:
     Number of milliseconds to wait before timing out.
@@ -1426,10 +1872,94 @@ Parameter ``waitFor``:
 Returns:
     shared_ptr<Sequence> of the Sequence class itself)doc";
 
+static const char *__doc_kp_Sequence_evalAwaitTicket =
+R"doc(Eval Await Ticket waits for the fence of a single submission returned
+by getLastTicket() to finish processing, and then runs the postEval of
+all operations for that submission.
+
+Parameter ``ticket``:
+    The ticket of the submission to wait for
+
+Parameter ``waitFor``:
+    Number of milliseconds to wait before timing out.
+
+Returns:
+    shared_ptr<Sequence> of the Sequence class itself)doc";
+
+static const char *__doc_kp_Sequence_getBufferCount =
+R"doc(Returns the number of command buffers the sequence submits in turn,
+which is the maximum number of submissions in flight.
+
+Returns:
+    The number of command buffers of the sequence)doc";
+
+static const char *__doc_kp_Sequence_getCompletedTimelineValue =
+R"doc(Returns the current value of the timeline semaphore of the sequence,
+which is the value signalled by the last submission that finished.
+
+Returns:
+    The completed timeline value)doc";
+
+static const char *__doc_kp_Sequence_getComputeQueue =
+R"doc(The queue the sequence submits its command buffers to.
+
+Returns:
+    Shared pointer to the compute queue of the sequence)doc";
+
+static const char *__doc_kp_Sequence_getLastTicket =
+R"doc(Returns the ticket of the last submission made with evalAsync, which
+identifies the submission in evalAwaitTicket. Tickets start at 1 and
+increase with every submission.
+
+Returns:
+    The ticket of the last submission, or 0 if none was made)doc";
+
+static const char *__doc_kp_Sequence_getOperationNames =
+R"doc(Returns the names of the operations recorded into the sequence, in the
+order they are recorded.
+
+Returns:
+    The names of the operations)doc";
+
+static const char *__doc_kp_Sequence_getOverDispatchedOperations =
+R"doc(Returns the dispatches of the last eval() call whose compute shader
+invocations exceed the number of elements of the largest memory object
+bound to their algorithm by more than the factor provided. This is
+usually the case when the workgroup of the algorithm defaults to the
+size of the tensor for a shader with a local size larger than 1.
+
+Parameter ``factor``:
+    Ratio of invocations to bound elements above which a dispatch is
+    reported
+
+Returns:
+    The statistics of the over-dispatched operations)doc";
+
+static const char *__doc_kp_Sequence_getPipelineStatistics =
+R"doc(Return the compute shader invocations counted for each operation
+during the last eval() call, which are zero for the operations that
+are not queried dispatches.
+
+Returns:
+    The invocations per operation)doc";
+
+static const char *__doc_kp_Sequence_getTimelineValue =
+R"doc(Returns the timeline value signalled by the last submission of the
+sequence.
+
+Returns:
+    The last timeline value submitted, or 0 if none was)doc";
+
 static const char *__doc_kp_Sequence_getTimestamps =
 R"doc(Return the timestamps that were latched at the beginning and after
 each operation during the last eval() call.)doc";
 
+static const char *__doc_kp_Sequence_getWaitStrategy =
+R"doc(Returns how the sequence waits for its submissions.
+
+Returns:
+    The wait strategy of the sequence)doc";
+
 static const char *__doc_kp_Sequence_isInit =
 R"doc(Returns true if the sequence has been initialised, and it's based on
 the GPU resources being referenced.
@@ -1437,6 +1967,12 @@ the GPU resources being referenced.
 Returns:
     Boolean stating if is initialized)doc";
 
+static const char *__doc_kp_Sequence_isPipelineStatisticsEnabled =
+R"doc(Returns true if the sequence has a pipeline statistics query pool.
+
+Returns:
+    Boolean stating if pipeline statistics are enabled)doc";
+
 static const char *__doc_kp_Sequence_isRecording =
 R"doc(Returns true if the sequence is currently in recording activated.
 
@@ -1445,11 +1981,26 @@ Returns:
 
 static const char *__doc_kp_Sequence_isRunning =
 R"doc(Returns true if the sequence is currently running - mostly used for
-async workloads.
+async workloads. This is the case while any submission is in flight.
 
 Returns:
     Boolean stating if currently running.)doc";
 
+static const char *__doc_kp_Sequence_isRunning_2 =
+R"doc(Returns true if the submission with the ticket provided is in flight.
+
+Parameter ``ticket``:
+    The ticket of the submission
+
+Returns:
+    Boolean stating if the submission is currently running.)doc";
+
+static const char *__doc_kp_Sequence_isTimelineEnabled =
+R"doc(Returns true if the sequence has a timeline semaphore.
+
+Returns:
+    Boolean stating if timeline semaphores are enabled)doc";
+
 static const char *__doc_kp_Sequence_mCommandBuffer = R"doc()doc";
 
 static const char *__doc_kp_Sequence_mCommandPool = R"doc()doc";
@@ -1474,6 +2025,36 @@ static const char *__doc_kp_Sequence_mQueueIndex = R"doc()doc";
 
 static const char *__doc_kp_Sequence_mRecording = R"doc()doc";
 
+static const char *__doc_kp_Sequence_parameterBlock =
+R"doc(Creates a parameter block whose parameters are copied into the tensor
+provided, with a slot for each command buffer of the sequence. Once
+recorded into the sequence, the parameters set on the block are used
+by the following evals without recording the sequence again. The
+block is destroyed with the sequence.
+
+Parameter ``tensor``:
+    The tensor the parameters are copied into, which the algorithms
+    bind to read them
+
+Returns:
+    Shared pointer to the parameter block)doc";
+
+static const char *__doc_kp_Sequence_prepareSubmit =
+R"doc(Prepares the next submission of the sequence in the same way as
+evalAsync, but returns its command buffer instead of submitting it.
+This allows kp::Manager::submit to batch the submissions of several
+sequences into one queue submission that signals a shared fence. The
+submission is awaited with evalAwait or evalAwaitTicket as usual.
+
+Parameter ``fence``:
+    The fence signalled by the queue submission that will contain the
+    submit info
+
+Returns:
+    The submit info of the command buffer, including its timeline
+    semaphore waits and signal, which stays valid until the submission
+    has been awaited)doc";
+
 static const char *__doc_kp_Sequence_record =
 R"doc(Record function for operation to be added to the GPU queue in batch.
 This template requires classes to be derived from the OpBase class.
@@ -1519,13 +2100,166 @@ Parameter ``TArgs``:
 Returns:
     shared_ptr<Sequence> of the Sequence class itself)doc";
 
+static const char *__doc_kp_Sequence_record_4 =
+R"doc(Records the execution of a fragment, whose operations were recorded
+once into a secondary command buffer, as a kp::OpExecuteFragment
+operation. The fragment has to be recorded for the queue family of the
+sequence.
+
+Parameter ``fragment``:
+    The fragment to execute
+
+Returns:
+    shared_ptr<Sequence> of the Sequence class itself)doc";
+
+static const char *__doc_kp_Sequence_record_5 =
+R"doc(Records the copy of the parameters of a parameter block into its
+tensor as a kp::OpSyncParameters operation, which uses the parameters
+set on the block before each eval.
+
+Parameter ``parameterBlock``:
+    The parameter block created by this sequence
+
+Returns:
+    shared_ptr<Sequence> of the Sequence class itself)doc";
+
+static const char *__doc_kp_Sequence_recordParallel =
+R"doc(Records the operations provided from several host threads at once.
+The operations are split in contiguous ranges of similar size, and
+each thread records a range into its own kp::SequenceFragment, which
+has its own command pool and secondary command buffer. The fragments
+are then recorded into the sequence in the order of the ranges, so the
+result is the same regardless of how the threads are scheduled.
+
+The record function of the operations has to be safe to call from
+several threads for different operations. This is the case for the
+operations provided by Kompute except kp::OpResize, which can't be
+recorded in parallel. Dispatches without push constants use the push
+constants of their algorithm, which may have been set by a dispatch
+recorded in another range.
+
+Parameter ``ops``:
+    The operations to record, in order
+
+Parameter ``numThreads``:
+    The number of threads to record the operations with
+
+Returns:
+    shared_ptr<Sequence> of the Sequence class itself)doc";
+
 static const char *__doc_kp_Sequence_rerecord =
 R"doc(Clears command buffer and triggers re-record of all the current
 operations saved, which is useful if the underlying kp::Memorys or
 kp::Algorithms are modified and need to be re-recorded.)doc";
 
+static const char *__doc_kp_Sequence_setWaitStrategy =
+R"doc(Sets how the sequence waits for its submissions. Blocking waits let
+the thread sleep in the driver, which can add tens of microseconds of
+wake-up latency once the submission has finished. Spinning polls the
+status of the submission instead, which keeps a core busy during the
+whole wait. The hybrid strategy polls with an increasing backoff for
+up to the spin duration before sleeping, and shortens the polling
+while the submissions outlast it.
+
+Parameter ``strategy``:
+    The wait strategy of the sequence
+
+Parameter ``spinDuration``:
+    The maximum number of nanoseconds the hybrid strategy polls before
+    sleeping)doc";
+
+static const char *__doc_kp_Sequence_signal =
+R"doc(Declares the value the timeline semaphore of the sequence is signalled
+at by its next submission, which has to be greater than the values
+signalled before. Submissions without a declared value signal the
+value after the last one.
+
+Parameter ``value``:
+    The timeline value to signal
+
+Returns:
+    shared_ptr<Sequence> of the Sequence class itself)doc";
+
 static const char *__doc_kp_Sequence_timestampQueryPool = R"doc()doc";
 
+static const char *__doc_kp_Sequence_tryGetTimestamps =
+R"doc(Retrieves the timestamps latched by the last submission without
+waiting for them, using the availability of the queries. The
+timestamps are not retrieved while the submission is running.
+
+Parameter ``timestamps``:
+    Vector the timestamps are written to, at the beginning and after
+    each operation
+
+Returns:
+    True if all the timestamps were available)doc";
+
+static const char *__doc_kp_Sequence_waitFor =
+R"doc(Declares that the next submission of this sequence waits on the GPU
+until the timeline semaphore of another sequence reaches a value,
+without involving the host. Both sequences require a timeline
+semaphore, and the submission waited for may be made later, from any
+queue.
+
+Parameter ``sequence``:
+    The sequence to wait for
+
+Parameter ``value``:
+    The timeline value to wait for, which defaults to the value
+    signalled by the last submission of the sequence
+
+Parameter ``stages``:
+    The pipeline stages that wait for the value
+
+Returns:
+    shared_ptr<Sequence> of the Sequence class itself)doc";
+
+static const char *__doc_kp_SequenceFragment =
+R"doc(Block of operations recorded once into a secondary command buffer,
+which any number of sequences can then execute with
+kp::OpExecuteFragment instead of recording the operations themselves.
+
+The fragment records the barriers between its own operations, and
+declares the accesses of all its operations to the sequences that
+execute it, so they record the barriers it requires before and after
+it. Sequences that execute a fragment have to submit to a queue of the
+same family it was created for.)doc";
+
+static const char *__doc_kp_SequenceFragment_clear =
+R"doc(Clears the operations of the fragment.)doc";
+
+static const char *__doc_kp_SequenceFragment_destroy =
+R"doc(Destroys and frees the GPU resources of the fragment.)doc";
+
+static const char *__doc_kp_SequenceFragment_isInit =
+R"doc(Returns true if the fragment has been initialised, and it's based on
+the GPU resources being referenced.
+
+Returns:
+    Boolean stating if is initialized)doc";
+
+static const char *__doc_kp_SequenceFragment_isRecording =
+R"doc(Returns true if the fragment is currently recording.
+
+Returns:
+    Boolean stating if recording ongoing.)doc";
+
+static const char *__doc_kp_SequenceFragment_record =
+R"doc(Records an operation at the end of the fragment. Operations that use
+eTransient tensors without bound memory can't be recorded into a
+fragment, as their memory is planned by the sequence.
+
+Parameter ``op``:
+    Object derived from kp::BaseOp that will be recorded by the
+    fragment
+
+Returns:
+    shared_ptr<SequenceFragment> of the fragment itself)doc";
+
+static const char *__doc_kp_SequenceFragment_rerecord =
+R"doc(Re-records the operations of the fragment, which is required if the
+underlying kp::Memorys or kp::Algorithms are modified.)doc";
+
 static const char *__doc_kp_Tensor = R"doc()doc";
 
 static const char *__doc_kp_Tensor_2 =
@@ -1587,6 +2321,13 @@ static const char *__doc_kp_Tensor_allocateBindMemory = R"doc()doc";
 
 static const char *__doc_kp_Tensor_allocateMemoryCreateGPUResources = R"doc()doc";
 
+static const char *__doc_kp_Tensor_capacity =
+R"doc(Number of elements the buffers of the tensor can hold without being
+reallocated, which is at least the size of the tensor.
+
+Returns:
+    The capacity of the tensor in elements)doc";
+
 static const char *__doc_kp_Tensor_constructDescriptorBufferInfo = R"doc()doc";
 
 static const char *__doc_kp_Tensor_constructDescriptorSet =
@@ -1607,6 +2348,11 @@ static const char *__doc_kp_Tensor_destroy =
 R"doc(Destroys and frees the GPU resources which include the buffer and
 memory.)doc";
 
+static const char *__doc_kp_Tensor_finishResize =
+R"doc(Frees the buffers and memory replaced by recordResize once the
+recorded copy has executed, and invalidates the host memory the copy
+wrote to.)doc";
+
 static const char *__doc_kp_Tensor_getPrimaryBuffer = R"doc()doc";
 
 static const char *__doc_kp_Tensor_getPrimaryBufferUsageFlags = R"doc()doc";
@@ -1693,6 +2439,25 @@ Parameter ``scrStageMask``:
 Parameter ``dstStageMask``:
     Pipeline stage flags for destination stage mask)doc";
 
+static const char *__doc_kp_Tensor_recordResize =
+R"doc(Changes the number of elements of the tensor with std::vector-like
+capacity semantics. Sizes within the capacity keep the buffers and only
+change the range used by descriptors and copies, whereas larger sizes
+grow the capacity geometrically into new buffers and record a copy of
+the existing contents into the command buffer. The host data of grown
+tensors only holds the copied contents once the command buffer has
+executed, and finishResize has to be called afterwards to free the
+previous buffers. Either way the generation of the tensor increases, so
+algorithms refresh their descriptors and sequences re-record their
+commands. Views, eTransient tensors and tensors that have views or
+import host memory can't be resized.
+
+Parameter ``commandBuffer``:
+    Vulkan Command Buffer to record the copy into
+
+Parameter ``elementTotalCount``:
+    The new number of elements of the tensor)doc";
+
 static const char *__doc_kp_Tensor_recordStagingMemoryBarrier =
 R"doc(Records the memory barrier into the staging buffer and command buffer
 which ensures that relevant data transfers are carried out correctly.
@@ -1716,6 +2481,21 @@ static const char *__doc_kp_Tensor_reserve =
 R"doc(Function to reserve memory on the tensor. This does not copy any data,
 it just reserves memory, similarly to std::vector reserve() method.)doc";
 
+static const char *__doc_kp_Tensor_slice =
+R"doc(Creates a view over a range of the elements of the tensor, which can be
+used in algorithms and operations in place of a tensor. To be bound as a
+descriptor the offset of the view in bytes has to be a multiple of the
+minStorageBufferOffsetAlignment limit of the device.
+
+Parameter ``offset``:
+    The index of the first element of the view
+
+Parameter ``count``:
+    The number of elements of the view
+
+Returns:
+    Shared pointer with the view of the tensor)doc";
+
 #if defined(__GNUG__)
 #pragma GCC diagnostic pop
 #endif
@@ -108,6 +108,32 @@ PYBIND11_MODULE(kp, m)
       .value("storage",
              kp::Memory::MemoryTypes::eStorage,
              DOC(kp, Memory, MemoryTypes, eStorage))
+      .value("transient",
+             kp::Memory::MemoryTypes::eTransient,
+             DOC(kp, Memory, MemoryTypes, eTransient))
+      .export_values();
+
+    py::enum_<kp::Memory::StagingPolicy>(
+      m, "StagingPolicy", DOC(kp, Memory, StagingPolicy))
+      .value("upload",
+             kp::Memory::StagingPolicy::eUpload,
+             DOC(kp, Memory, StagingPolicy, eUpload))
+      .value("readback",
+             kp::Memory::StagingPolicy::eReadback,
+             DOC(kp, Memory, StagingPolicy, eReadback))
+      .export_values();
+
+    py::enum_<kp::Sequence::WaitStrategy>(
+      m, "WaitStrategy", DOC(kp, Sequence, WaitStrategy))
+      .value("block",
+             kp::Sequence::WaitStrategy::eBlock,
+             DOC(kp, Sequence, WaitStrategy, eBlock))
+      .value("spin",
+             kp::Sequence::WaitStrategy::eSpin,
+             DOC(kp, Sequence, WaitStrategy, eSpin))
+      .value("hybrid",
+             kp::Sequence::WaitStrategy::eHybrid,
+             DOC(kp, Sequence, WaitStrategy, eHybrid))
       .export_values();
 
     py::class_<kp::OpBase, std::shared_ptr<kp::OpBase>>(
@@ -132,6 +158,14 @@ PYBIND11_MODULE(kp, m)
       .def(py::init<const std::vector<std::shared_ptr<kp::Memory>>&>(),
            DOC(kp, OpCopy, OpCopy));
 
+    py::class_<kp::OpResize, kp::OpBase, std::shared_ptr<kp::OpResize>>(
+      m, "OpResize", DOC(kp, OpResize))
+      .def(py::init<const std::vector<std::shared_ptr<kp::Memory>>&,
+                    uint64_t>(),
+           DOC(kp, OpResize, OpResize),
+           py::arg("mem_objects"),
+           py::arg("element_total_count"));
+
     py::class_<kp::OpAlgoDispatch,
                kp::OpBase,
                std::shared_ptr<kp::OpAlgoDispatch>>(
@@ -146,18 +180,86 @@ PYBIND11_MODULE(kp, m)
            py::arg("algorithm"),
            py::arg("push_consts"));
 
+    py::class_<kp::OpAlgoDispatchIndirect,
+               kp::OpBase,
+               std::shared_ptr<kp::OpAlgoDispatchIndirect>>(
+      m, "OpAlgoDispatchIndirect", DOC(kp, OpAlgoDispatchIndirect))
+      .def(py::init<const std::shared_ptr<kp::Algorithm>&,
+                    const std::shared_ptr<kp::Tensor>&,
+                    uint64_t,
+                    const std::vector<float>&>(),
+           DOC(kp, OpAlgoDispatchIndirect, OpAlgoDispatchIndirect),
+           py::arg("algorithm"),
+           py::arg("indirect_tensor"),
+           py::arg("offset") = 0,
+           py::arg("push_consts") = std::vector<float>());
+
+    py::class_<kp::SequenceFragment, std::shared_ptr<kp::SequenceFragment>>(
+      m, "SequenceFragment", DOC(kp, SequenceFragment))
+      .def(
+        "record",
+        [](kp::SequenceFragment& self, std::shared_ptr<kp::OpBase> op) {
+            return self.record(op);
+        },
+        DOC(kp, SequenceFragment, record))
+      .def("clear",
+           &kp::SequenceFragment::clear,
+           DOC(kp, SequenceFragment, clear))
+      .def("rerecord",
+           &kp::SequenceFragment::rerecord,
+           DOC(kp, SequenceFragment, rerecord))
+      .def("is_recording",
+           &kp::SequenceFragment::isRecording,
+           DOC(kp, SequenceFragment, isRecording))
+      .def("is_init",
+           &kp::SequenceFragment::isInit,
+           DOC(kp, SequenceFragment, isInit))
+      .def("destroy",
+           &kp::SequenceFragment::destroy,
+           DOC(kp, SequenceFragment, destroy));
+
+    py::class_<kp::OpExecuteFragment,
+               kp::OpBase,
+               std::shared_ptr<kp::OpExecuteFragment>>(
+      m, "OpExecuteFragment", DOC(kp, OpExecuteFragment))
+      .def(py::init<std::shared_ptr<kp::SequenceFragment>>(),
+           DOC(kp, OpExecuteFragment, OpExecuteFragment),
+           py::arg("fragment"));
+
     py::class_<kp::OpMult, kp::OpBase, std::shared_ptr<kp::OpMult>>(
       m, "OpMult", DOC(kp, OpMult))
       .def(py::init<const std::vector<std::shared_ptr<kp::Memory>>&,
                     const std::shared_ptr<kp::Algorithm>&>(),
            DOC(kp, OpMult, OpMult));
 
+    py::class_<kp::OpWorkgroupCount,
+               kp::OpBase,
+               std::shared_ptr<kp::OpWorkgroupCount>>(
+      m, "OpWorkgroupCount", DOC(kp, OpWorkgroupCount))
+      .def(py::init<const std::vector<std::shared_ptr<kp::Memory>>&,
+                    const std::shared_ptr<kp::Algorithm>&,
+                    uint32_t>(),
+           DOC(kp, OpWorkgroupCount, OpWorkgroupCount),
+           py::arg("mem_objects"),
+           py::arg("algorithm"),
+           py::arg("group_size") = 1);
+
     py::class_<kp::Algorithm, std::shared_ptr<kp::Algorithm>>(
       m, "Algorithm", DOC(kp, Algorithm, Algorithm))
       .def("get_mem_objects",
            &kp::Algorithm::getMemObjects,
            DOC(kp, Algorithm, getMemObjects))
       .def("destroy", &kp::Algorithm::destroy, DOC(kp, Algorithm, destroy))
+      .def("is_read_only",
+           &kp::Algorithm::isReadOnly,
+           DOC(kp, Algorithm, isReadOnly))
+      .def("set_name",
+           &kp::Algorithm::setName,
+           DOC(kp, Algorithm, setName),
+           py::arg("name"))
+      .def("get_name",
+           &kp::Algorithm::getName,
+           DOC(kp, Algorithm, getName))
       .def("is_init", &kp::Algorithm::isInit, DOC(kp, Algorithm, isInit));
 
     py::class_<kp::Memory, std::shared_ptr<kp::Memory>>(
@@ -193,9 +295,15 @@ PYBIND11_MODULE(kp, m)
         DOC(kp, Memory, data))
       .def("size", &kp::Tensor::size, DOC(kp, Memory, size))
       .def("__len__", &kp::Tensor::size, DOC(kp, Memory, size))
+      .def("capacity", &kp::Tensor::capacity, DOC(kp, Tensor, capacity))
       .def("memory_type", &kp::Memory::memoryType, DOC(kp, Memory, memoryType))
       .def("data_type", static_cast<kp::Memory::DataTypes (kp::Memory::*)()>(&kp::Memory::dataType), DOC(kp, Memory, dataType))
       .def("is_init", &kp::Tensor::isInit, DOC(kp, Tensor, isInit))
+      .def("slice",
+           &kp::Tensor::slice,
+           DOC(kp, Tensor, slice),
+           py::arg("offset"),
+           py::arg("count"))
       .def("destroy", &kp::Tensor::destroy, DOC(kp, Tensor, destroy));
     py::class_<kp::Image, std::shared_ptr<kp::Image>, kp::Memory>(
       m, "Image", DOC(kp, Image))
@@ -238,6 +346,58 @@ PYBIND11_MODULE(kp, m)
       .def("is_init", &kp::Image::isInit, DOC(kp, Image, isInit))
       .def("destroy", &kp::Image::destroy, DOC(kp, Image, destroy));
 
+    py::class_<kp::Profiler, std::shared_ptr<kp::Profiler>>(
+      m, "Profiler", DOC(kp, Profiler))
+      .def("collect",
+           &kp::Profiler::collect,
+           DOC(kp, Profiler, collect),
+           py::arg("sequence"))
+      .def(
+        "stats",
+        [](kp::Profiler& self) {
+            py::list stats;
+            for (const kp::Profiler::OperationStats& opStats : self.stats()) {
+                py::dict entry;
+                entry["label"] = opStats.label;
+                entry["count"] = opStats.count;
+                entry["min_ns"] = opStats.minNs;
+                entry["mean_ns"] = opStats.meanNs;
+                entry["p99_ns"] = opStats.p99Ns;
+                entry["total_ns"] = opStats.totalNs;
+                stats.append(entry);
+            }
+            return stats;
+        },
+        DOC(kp, Profiler, stats))
+      .def("trace_json",
+           &kp::Profiler::traceJson,
+           DOC(kp, Profiler, traceJson))
+      .def("clear", &kp::Profiler::clear, DOC(kp, Profiler, clear));
+
+    py::class_<kp::ParameterBlock, std::shared_ptr<kp::ParameterBlock>>(
+      m, "ParameterBlock", DOC(kp, ParameterBlock))
+      .def(
+        "set_data",
+        [np](kp::ParameterBlock& self, const py::array& data) {
+            const py::array& flatdata = np.attr("ravel")(data);
+            const py::buffer_info info = flatdata.request();
+            self.setData(info.ptr, info.size * info.itemsize);
+        },
+        DOC(kp, ParameterBlock, setData),
+        py::arg("data"))
+      .def("get_tensor",
+           &kp::ParameterBlock::getTensor,
+           DOC(kp, ParameterBlock, getTensor))
+      .def("size", &kp::ParameterBlock::size, DOC(kp, ParameterBlock, size));
+
+    py::class_<kp::OpSyncParameters,
+               kp::OpBase,
+               std::shared_ptr<kp::OpSyncParameters>>(
+      m, "OpSyncParameters", DOC(kp, OpSyncParameters))
+      .def(py::init<std::shared_ptr<kp::ParameterBlock>>(),
+           DOC(kp, OpSyncParameters, OpSyncParameters),
+           py::arg("parameter_block"));
+
     py::class_<kp::Sequence, std::shared_ptr<kp::Sequence>>(m, "Sequence")
       .def(
         "record",
@@ -245,6 +405,23 @@ PYBIND11_MODULE(kp, m)
             return self.record(op);
         },
         DOC(kp, Sequence, record))
+      .def(
+        "record",
+        [](kp::Sequence& self, std::shared_ptr<kp::SequenceFragment> fragment) {
+            return self.record(fragment);
+        },
+        DOC(kp, Sequence, record_4))
+      .def(
+        "record",
+        [](kp::Sequence& self, std::shared_ptr<kp::ParameterBlock> block) {
+            return self.record(block);
+        },
+        DOC(kp, Sequence, record_5))
+      .def("record_parallel",
+           &kp::Sequence::recordParallel,
+           DOC(kp, Sequence, recordParallel),
+           py::arg("ops"),
+           py::arg("num_threads"))
       .def(
         "eval",
         [](kp::Sequence& self) { return self.eval(); },
@@ -273,16 +450,102 @@ PYBIND11_MODULE(kp, m)
         "eval_await",
         [](kp::Sequence& self, uint32_t wait) { return self.evalAwait(wait); },
         DOC(kp, Sequence, evalAwait))
+      .def("eval_await_ticket",
+           &kp::Sequence::evalAwaitTicket,
+           DOC(kp, Sequence, evalAwaitTicket),
+           py::arg("ticket"),
+           py::arg("wait_for") = UINT64_MAX)
+      .def("get_last_ticket",
+           &kp::Sequence::getLastTicket,
+           DOC(kp, Sequence, getLastTicket))
+      .def("get_operation_names",
+           &kp::Sequence::getOperationNames,
+           DOC(kp, Sequence, getOperationNames))
+      .def("get_buffer_count",
+           &kp::Sequence::getBufferCount,
+           DOC(kp, Sequence, getBufferCount))
+      .def("parameter_block",
+           &kp::Sequence::parameterBlock,
+           DOC(kp, Sequence, parameterBlock),
+           py::arg("tensor"))
+      .def("set_wait_strategy",
+           &kp::Sequence::setWaitStrategy,
+           DOC(kp, Sequence, setWaitStrategy),
+           py::arg("strategy"),
+           py::arg("spin_duration") = KP_DEFAULT_SPIN_DURATION)
+      .def("get_wait_strategy",
+           &kp::Sequence::getWaitStrategy,
+           DOC(kp, Sequence, getWaitStrategy))
+      .def("enable_timeline",
+           &kp::Sequence::enableTimeline,
+           DOC(kp, Sequence, enableTimeline))
+      .def("is_timeline_enabled",
+           &kp::Sequence::isTimelineEnabled,
+           DOC(kp, Sequence, isTimelineEnabled))
+      .def(
+        "wait_for",
+        [](kp::Sequence& self,
+           std::shared_ptr<kp::Sequence> sequence,
+           uint64_t value) { return self.waitFor(sequence, value); },
+        DOC(kp, Sequence, waitFor),
+        py::arg("sequence"),
+        py::arg("value") = 0)
+      .def("signal",
+           &kp::Sequence::signal,
+           DOC(kp, Sequence, signal),
+           py::arg("value"))
+      .def("get_timeline_value",
+           &kp::Sequence::getTimelineValue,
+           DOC(kp, Sequence, getTimelineValue))
+      .def("get_completed_timeline_value",
+           &kp::Sequence::getCompletedTimelineValue,
+           DOC(kp, Sequence, getCompletedTimelineValue))
       .def("is_recording",
            &kp::Sequence::isRecording,
            DOC(kp, Sequence, isRecording))
-      .def("is_running", &kp::Sequence::isRunning, DOC(kp, Sequence, isRunning))
+      .def(
+        "is_running",
+        [](kp::Sequence& self) { return self.isRunning(); },
+        DOC(kp, Sequence, isRunning))
+      .def(
+        "is_running",
+        [](kp::Sequence& self, uint64_t ticket) {
+            return self.isRunning(ticket);
+        },
+        DOC(kp, Sequence, isRunning_2),
+        py::arg("ticket"))
       .def("is_init", &kp::Sequence::isInit, DOC(kp, Sequence, isInit))
       .def("clear", &kp::Sequence::clear, DOC(kp, Sequence, clear))
       .def("rerecord", &kp::Sequence::rerecord, DOC(kp, Sequence, rerecord))
       .def("get_timestamps",
            &kp::Sequence::getTimestamps,
            DOC(kp, Sequence, getTimestamps))
+      .def("enable_pipeline_statistics",
+           &kp::Sequence::enablePipelineStatistics,
+           DOC(kp, Sequence, enablePipelineStatistics),
+           py::arg("total_queries"))
+      .def("is_pipeline_statistics_enabled",
+           &kp::Sequence::isPipelineStatisticsEnabled,
+           DOC(kp, Sequence, isPipelineStatisticsEnabled))
+      .def("get_pipeline_statistics",
+           &kp::Sequence::getPipelineStatistics,
+           DOC(kp, Sequence, getPipelineStatistics))
+      .def(
+        "get_over_dispatched_operations",
+        [](kp::Sequence& self, double factor) {
+            py::list operations;
+            for (const kp::Sequence::DispatchStatistics& statistics :
+                 self.getOverDispatchedOperations(factor)) {
+                py::dict entry;
+                entry["operation_index"] = statistics.operationIndex;
+                entry["invocations"] = statistics.invocations;
+                entry["bound_elements"] = statistics.boundElements;
+                operations.append(entry);
+            }
+            return operations;
+        },
+        DOC(kp, Sequence, getOverDispatchedOperations),
+        py::arg("factor") = KP_DEFAULT_OVER_DISPATCH_FACTOR)
       .def("destroy", &kp::Sequence::destroy, DOC(kp, Sequence, destroy));
 
     py::class_<kp::Manager, std::shared_ptr<kp::Manager>>(
@@ -301,7 +564,31 @@ PYBIND11_MODULE(kp, m)
            &kp::Manager::sequence,
            DOC(kp, Manager, sequence),
            py::arg("queue_index") = 0,
-           py::arg("total_timestamps") = 0)
+           py::arg("total_timestamps") = 0,
+           py::arg("num_buffers") = 1)
+      .def("fragment",
+           &kp::Manager::fragment,
+           DOC(kp, Manager, fragment),
+           py::arg("queue_index") = 0)
+      .def("profiler",
+           &kp::Manager::profiler,
+           DOC(kp, Manager, profiler),
+           py::arg("max_events") = KP_DEFAULT_PROFILER_MAX_EVENTS)
+      .def("submit",
+           &kp::Manager::submit,
+           DOC(kp, Manager, submit),
+           py::arg("sequences"))
+      .def("await_submitted",
+           &kp::Manager::await,
+           DOC(kp, Manager, await),
+           py::arg("wait_for") = UINT64_MAX)
+      .def("set_staging_policy",
+           &kp::Manager::setStagingPolicy,
+           DOC(kp, Manager, setStagingPolicy),
+           py::arg("staging_policy"))
+      .def("get_staging_policy",
+           &kp::Manager::getStagingPolicy,
+           DOC(kp, Manager, getStagingPolicy))
       .def(
         "tensor",
         [np](kp::Manager& self,
@@ -714,6 +1001,14 @@ PYBIND11_MODULE(kp, m)
         py::arg("workgroup") = kp::Workgroup(),
         py::arg("spec_consts") = std::vector<float>(),
         py::arg("push_consts") = std::vector<float>())
+      .def("load_pipeline_cache",
+           &kp::Manager::loadPipelineCache,
+           DOC(kp, Manager, loadPipelineCache),
+           py::arg("path"))
+      .def("save_pipeline_cache",
+           &kp::Manager::savePipelineCache,
+           DOC(kp, Manager, savePipelineCache),
+           py::arg("path"))
       .def(
         "list_devices",
         [](kp::Manager& self) {
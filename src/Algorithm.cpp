@@ -1,8 +1,12 @@
 // SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
 #include <fstream>
 
 #include "kompute/Algorithm.hpp"
 #include "kompute/Image.hpp"
+#include <fmt/core.h>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace kp {
 
@@ -38,6 +42,19 @@ Algorithm::destroy()
         return;
     }
 
+    // Shared shader modules and pipelines are destroyed by the registry once
+    // no algorithm uses them anymore
+    if (this->mRegistryPipeline) {
+        KP_LOG_DEBUG("Kompute Algorithm releasing shared pipeline");
+        this->mPipeline = nullptr;
+        this->mPipelineLayout = nullptr;
+        this->mRegistryPipeline = nullptr;
+    }
+    if (this->mPipelineRegistry && this->mShaderModule) {
+        KP_LOG_DEBUG("Kompute Algorithm releasing shared shader module");
+        this->mShaderModule = nullptr;
+    }
+
     if (this->mFreePipeline && this->mPipeline) {
         KP_LOG_DEBUG("Kompute Algorithm Destroying pipeline");
         if (!this->mPipeline) {
@@ -112,6 +129,8 @@ Algorithm::destroy()
         this->mDescriptorSetLayout = nullptr;
     }
 
+    this->destroyRetiredDescriptorPools();
+
     if (this->mFreeDescriptorPool && this->mDescriptorPool) {
         KP_LOG_DEBUG("Kompute Algorithm Destroying Descriptor Pool");
         if (!this->mDescriptorPool) {
@@ -141,34 +160,22 @@ Algorithm::createParameters()
         }
     }
 
-    std::vector<vk::DescriptorPoolSize> descriptorPoolSizes;
+    this->mDescriptorPoolSizes.clear();
 
     if (numTensors > 0) {
-        descriptorPoolSizes.push_back(vk::DescriptorPoolSize(
+        this->mDescriptorPoolSizes.push_back(vk::DescriptorPoolSize(
           vk::DescriptorType::eStorageBuffer,
           static_cast<uint32_t>(numTensors) // Descriptor count
           ));
     }
 
     if (numImages > 0) {
-        descriptorPoolSizes.push_back(vk::DescriptorPoolSize(
+        this->mDescriptorPoolSizes.push_back(vk::DescriptorPoolSize(
           vk::DescriptorType::eStorageImage,
           static_cast<uint32_t>(numImages) // Descriptor count
           ));
     };
 
-    vk::DescriptorPoolCreateInfo descriptorPoolInfo(
-      vk::DescriptorPoolCreateFlags(),
-      1, // Max sets
-      static_cast<uint32_t>(descriptorPoolSizes.size()),
-      descriptorPoolSizes.data());
-
-    KP_LOG_DEBUG("Kompute Algorithm creating descriptor pool");
-    this->mDescriptorPool = std::make_shared<vk::DescriptorPool>();
-    this->mDevice->createDescriptorPool(
-      &descriptorPoolInfo, nullptr, this->mDescriptorPool.get());
-    this->mFreeDescriptorPool = true;
-
     std::vector<vk::DescriptorSetLayoutBinding> descriptorSetBindings;
     for (size_t i = 0; i < this->mMemObjects.size(); i++) {
         descriptorSetBindings.push_back(
@@ -190,6 +197,29 @@ Algorithm::createParameters()
       &descriptorSetLayoutInfo, nullptr, this->mDescriptorSetLayout.get());
     this->mFreeDescriptorSetLayout = true;
 
+    this->createDescriptorSet();
+
+    this->mDescriptorSetsPending = true;
+    this->updateDescriptorSets();
+
+    KP_LOG_DEBUG("Kompute Algorithm successfully run init");
+}
+
+void
+Algorithm::createDescriptorSet()
+{
+    vk::DescriptorPoolCreateInfo descriptorPoolInfo(
+      vk::DescriptorPoolCreateFlags(),
+      1, // Max sets
+      static_cast<uint32_t>(this->mDescriptorPoolSizes.size()),
+      this->mDescriptorPoolSizes.data());
+
+    KP_LOG_DEBUG("Kompute Algorithm creating descriptor pool");
+    this->mDescriptorPool = std::make_shared<vk::DescriptorPool>();
+    this->mDevice->createDescriptorPool(
+      &descriptorPoolInfo, nullptr, this->mDescriptorPool.get());
+    this->mFreeDescriptorPool = true;
+
     vk::DescriptorSetAllocateInfo descriptorSetAllocateInfo(
       *this->mDescriptorPool,
       1, // Descriptor set layout count
@@ -200,9 +230,57 @@ Algorithm::createParameters()
     this->mDevice->allocateDescriptorSets(&descriptorSetAllocateInfo,
                                           this->mDescriptorSet.get());
     this->mFreeDescriptorSet = true;
+}
 
+void
+Algorithm::retireDescriptorSet()
+{
+    // The pools are only destroyed once no submission uses the memory
+    // objects, as any submission using the sets uses all of them
+    for (const std::shared_ptr<Memory>& mem : this->mMemObjects) {
+        if (mem->isUsedBySubmission()) {
+            if (this->mDescriptorSet) {
+                KP_LOG_DEBUG("Kompute Algorithm retiring descriptor set used "
+                             "by submissions in flight");
+                this->mRetiredDescriptorPools.push_back(this->mDescriptorPool);
+                this->createDescriptorSet();
+            }
+            return;
+        }
+    }
+    this->destroyRetiredDescriptorPools();
+}
+
+void
+Algorithm::destroyRetiredDescriptorPools()
+{
+    for (const std::shared_ptr<vk::DescriptorPool>& descriptorPool :
+         this->mRetiredDescriptorPools) {
+        this->mDevice->destroy(
+          *descriptorPool,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    }
+    this->mRetiredDescriptorPools.clear();
+}
+
+void
+Algorithm::updateDescriptorSets()
+{
     KP_LOG_DEBUG("Kompute Algorithm updating descriptor sets");
+
+    this->mDescriptorSetsPending = false;
+    this->mDescriptorGenerations.resize(this->mMemObjects.size());
+
     for (size_t i = 0; i < this->mMemObjects.size(); i++) {
+        // Transient memory objects are written once a sequence has bound them
+        if (!this->mMemObjects[i]->isMemoryBound()) {
+            KP_LOG_DEBUG("Kompute Algorithm deferring descriptor for binding "
+                         "{} without bound memory",
+                         i);
+            this->mDescriptorSetsPending = true;
+            continue;
+        }
+
         std::vector<vk::WriteDescriptorSet> computeWriteDescriptorSets;
 
         vk::WriteDescriptorSet descriptorSet =
@@ -213,9 +291,8 @@ Algorithm::createParameters()
 
         this->mDevice->updateDescriptorSets(computeWriteDescriptorSets,
                                             nullptr);
+        this->mDescriptorGenerations[i] = this->mMemObjects[i]->generation();
     }
-
-    KP_LOG_DEBUG("Kompute Algorithm successfully run init");
 }
 
 void
@@ -223,6 +300,13 @@ Algorithm::createShaderModule()
 {
     KP_LOG_DEBUG("Kompute Algorithm createShaderModule started");
 
+    if (this->mPipelineRegistry) {
+        this->mShaderModule =
+          this->mPipelineRegistry->shaderModule(this->mSpirv);
+        this->mFreeShaderModule = false;
+        return;
+    }
+
     vk::ShaderModuleCreateInfo shaderModuleInfo(vk::ShaderModuleCreateFlags(),
                                                 sizeof(uint32_t) *
                                                   this->mSpirv.size(),
@@ -244,26 +328,66 @@ Algorithm::createPipeline()
 {
     KP_LOG_DEBUG("Kompute Algorithm calling create Pipeline");
 
+    if (!this->mPipelineRegistry) {
+        PipelineRegistry::Pipeline pipeline = this->compilePipeline();
+        this->mPipelineLayout = pipeline.pipelineLayout;
+        this->mFreePipelineLayout = true;
+        this->mPipeline = pipeline.pipeline;
+        this->mFreePipeline = true;
+        return;
+    }
+
+    // Algorithms that only differ by the memory objects they bind share the
+    // pipeline, as their descriptor set layouts are identically defined
+    PipelineRegistry::PipelineKey key;
+    for (const std::shared_ptr<Memory>& mem : this->mMemObjects) {
+        key.descriptorTypes.push_back(mem->getDescriptorType());
+    }
+    if (this->mSpecializationConstantsData) {
+        const uint8_t* data =
+          static_cast<const uint8_t*>(this->mSpecializationConstantsData);
+        key.specializationConstants.assign(
+          data,
+          data + this->mSpecializationConstantsDataTypeMemorySize *
+                   this->mSpecializationConstantsSize);
+    }
+    key.specializationConstantSize =
+      this->mSpecializationConstantsDataTypeMemorySize;
+    key.pushConstantsSize = this->getPushConstantRangeSize();
+
+    this->mRegistryPipeline = this->mPipelineRegistry->pipeline(
+      this->mShaderModule, key, [this]() { return this->compilePipeline(); });
+    this->mPipelineLayout = this->mRegistryPipeline->pipelineLayout;
+    this->mFreePipelineLayout = false;
+    this->mPipeline = this->mRegistryPipeline->pipeline;
+    this->mFreePipeline = false;
+}
+
+PipelineRegistry::Pipeline
+Algorithm::compilePipeline()
+{
+    PipelineRegistry::Pipeline compiled;
+
     vk::PipelineLayoutCreateInfo pipelineLayoutInfo(
       vk::PipelineLayoutCreateFlags(),
       1, // Set layout count
       this->mDescriptorSetLayout.get());
 
+    // The range covers the reserved base workgroup push constant that
+    // follows the push constants of the algorithm when the shader reads it
     vk::PushConstantRange pushConstantRange;
-    if (this->mPushConstantsSize) {
-        pushConstantRange.setStageFlags(vk::ShaderStageFlagBits::eCompute);
-        pushConstantRange.setOffset(0);
-        pushConstantRange.setSize(this->mPushConstantsDataTypeMemorySize *
-                                  this->mPushConstantsSize);
+    pushConstantRange.setStageFlags(vk::ShaderStageFlagBits::eCompute);
+    pushConstantRange.setOffset(0);
+    pushConstantRange.setSize(this->getPushConstantRangeSize());
 
+    if (pushConstantRange.size) {
         pipelineLayoutInfo.setPushConstantRangeCount(1);
         pipelineLayoutInfo.setPPushConstantRanges(&pushConstantRange);
     }
 
-    this->mPipelineLayout = std::make_shared<vk::PipelineLayout>();
+    compiled.pipelineLayout = std::make_shared<vk::PipelineLayout>();
     this->mDevice->createPipelineLayout(
-      &pipelineLayoutInfo, nullptr, this->mPipelineLayout.get());
-    this->mFreePipelineLayout = true;
+      &pipelineLayoutInfo, nullptr, compiled.pipelineLayout.get());
 
     std::vector<vk::SpecializationMapEntry> specializationEntries;
 
@@ -295,16 +419,20 @@ Algorithm::createPipeline()
 
     vk::ComputePipelineCreateInfo pipelineInfo(vk::PipelineCreateFlags(),
                                                shaderStage,
-                                               *this->mPipelineLayout,
+                                               *compiled.pipelineLayout,
                                                vk::Pipeline(),
                                                0);
 
-    vk::PipelineCacheCreateInfo pipelineCacheInfo =
-      vk::PipelineCacheCreateInfo();
-    this->mPipelineCache = std::make_shared<vk::PipelineCache>();
-    this->mDevice->createPipelineCache(
-      &pipelineCacheInfo, nullptr, this->mPipelineCache.get());
-    this->mFreePipelineCache = true;
+    // Algorithms created by a manager share its pipeline cache, which is
+    // kept across rebuilds
+    if (!this->mPipelineCache) {
+        vk::PipelineCacheCreateInfo pipelineCacheInfo =
+          vk::PipelineCacheCreateInfo();
+        this->mPipelineCache = std::make_shared<vk::PipelineCache>();
+        this->mDevice->createPipelineCache(
+          &pipelineCacheInfo, nullptr, this->mPipelineCache.get());
+        this->mFreePipelineCache = true;
+    }
 
 #ifdef KOMPUTE_CREATE_PIPELINE_RESULT_VALUE
     vk::ResultValue<vk::Pipeline> pipelineResult =
@@ -316,14 +444,12 @@ Algorithm::createPipeline()
     }
 
     vk::Pipeline& pipeline = pipelineResult.value;
-    this->mPipeline = std::make_shared<vk::Pipeline>(pipeline);
-    this->mFreePipeline = true;
+    compiled.pipeline = std::make_shared<vk::Pipeline>(pipeline);
 #else
     vk::Pipeline pipeline =
       this->mDevice->createComputePipeline(*this->mPipelineCache, pipelineInfo)
         .value;
-    this->mPipeline = std::make_shared<vk::Pipeline>(pipeline);
-    this->mFreePipeline = true;
+    compiled.pipeline = std::make_shared<vk::Pipeline>(pipeline);
 #endif
 
     // TODO: Update to consistent
@@ -333,6 +459,8 @@ Algorithm::createPipeline()
     //         this->mPipeline.get());
 
     KP_LOG_DEBUG("Kompute Algorithm Create Pipeline Success");
+
+    return compiled;
 }
 
 void
@@ -340,6 +468,31 @@ Algorithm::recordBindCore(const vk::CommandBuffer& commandBuffer)
 {
     KP_LOG_DEBUG("Kompute Algorithm binding pipeline");
 
+    // Memory objects recreated since the descriptors were written, such as
+    // tensors restored by a residency policy, have a new buffer
+    std::unique_lock<std::mutex> lock(this->mRecordMutex);
+    for (size_t i = 0; i < this->mDescriptorGenerations.size(); i++) {
+        if (this->mMemObjects[i]->generation() !=
+            this->mDescriptorGenerations[i]) {
+            this->mDescriptorSetsPending = true;
+            break;
+        }
+    }
+
+    // Descriptor sets can't be updated while submissions in flight use them,
+    // so the new buffers are written into a fresh set in that case
+    if (this->mDescriptorSetsPending) {
+        this->retireDescriptorSet();
+        this->updateDescriptorSets();
+        if (this->mDescriptorSetsPending) {
+            throw std::runtime_error(
+              "Kompute Algorithm recorded with memory objects without bound "
+              "memory, transient memory objects must be recorded through a "
+              "sequence");
+        }
+    }
+    lock.unlock();
+
     commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute,
                                *this->mPipeline);
 
@@ -356,18 +509,51 @@ Algorithm::recordBindCore(const vk::CommandBuffer& commandBuffer)
 void
 Algorithm::recordBindPush(const vk::CommandBuffer& commandBuffer)
 {
-    if (this->mPushConstantsSize) {
+    std::lock_guard<std::mutex> lock(this->mRecordMutex);
+    this->recordBindPush(commandBuffer,
+                         this->mPushConstantsData,
+                         this->mPushConstantsSize,
+                         this->mPushConstantsDataTypeMemorySize);
+}
+
+void
+Algorithm::recordBindPush(const vk::CommandBuffer& commandBuffer,
+                          const void* data,
+                          uint32_t size,
+                          uint32_t memorySize)
+{
+    if (size * memorySize != this->mPushConstantsSize *
+                               this->mPushConstantsDataTypeMemorySize) {
+        throw std::runtime_error(fmt::format(
+          "Kompute Algorithm push constant total memory size provided is {} "
+          "but expected {} bytes",
+          size * memorySize,
+          this->mPushConstantsSize * this->mPushConstantsDataTypeMemorySize));
+    }
+
+    if (size) {
         KP_LOG_DEBUG("Kompute Algorithm binding push constants memory size: {}",
-                     this->mPushConstantsSize *
-                       this->mPushConstantsDataTypeMemorySize);
+                     size * memorySize);
 
         commandBuffer.pushConstants(*this->mPipelineLayout,
                                     vk::ShaderStageFlagBits::eCompute,
                                     0,
-                                    this->mPushConstantsSize *
-                                      this->mPushConstantsDataTypeMemorySize,
-                                    this->mPushConstantsData);
+                                    size * memorySize,
+                                    data);
     }
+
+    if (!this->mReadsBaseWorkgroup) {
+        return;
+    }
+
+    // Split dispatches leave the base of their last part in the command
+    // buffer, so every dispatch starts from the first workgroup
+    uint32_t baseWorkgroup = 0;
+    commandBuffer.pushConstants(*this->mPipelineLayout,
+                                vk::ShaderStageFlagBits::eCompute,
+                                this->getBaseWorkgroupOffset(),
+                                sizeof(uint32_t),
+                                &baseWorkgroup);
 }
 
 void
@@ -375,12 +561,58 @@ Algorithm::recordDispatch(const vk::CommandBuffer& commandBuffer)
 {
     KP_LOG_DEBUG("Kompute Algorithm recording dispatch");
 
-    commandBuffer.dispatch(
-      this->mWorkgroup[0], this->mWorkgroup[1], this->mWorkgroup[2]);
+    const Workgroup& workgroup = this->mWorkgroup;
+    const Workgroup& maxCount = this->mMaxWorkgroupCount;
+
+    if (workgroup[1] > maxCount[1] || workgroup[2] > maxCount[2]) {
+        throw std::runtime_error(fmt::format(
+          "Kompute Algorithm workgroup ({}, {}, {}) exceeds the maximum "
+          "workgroup count ({}, {}, {}) in Y or Z, which can't be split",
+          workgroup[0],
+          workgroup[1],
+          workgroup[2],
+          maxCount[0],
+          maxCount[1],
+          maxCount[2]));
+    }
+
+    if (workgroup[0] <= maxCount[0]) {
+        commandBuffer.dispatch(workgroup[0], workgroup[1], workgroup[2]);
+        return;
+    }
+
+    if (!this->mReadsBaseWorkgroup) {
+        throw std::runtime_error(fmt::format(
+          "Kompute Algorithm workgroup ({}, {}, {}) exceeds the maximum "
+          "workgroup count {} in X, which can only be split for shaders that "
+          "declare the base workgroup push constant",
+          workgroup[0],
+          workgroup[1],
+          workgroup[2],
+          maxCount[0]));
+    }
+
+    KP_LOG_DEBUG("Kompute Algorithm splitting {} workgroups in X into "
+                 "dispatches of at most {}",
+                 workgroup[0],
+                 maxCount[0]);
+
+    uint32_t offset = this->getBaseWorkgroupOffset();
+    for (uint64_t base = 0; base < workgroup[0]; base += maxCount[0]) {
+        uint32_t baseWorkgroup = static_cast<uint32_t>(base);
+        uint32_t count = static_cast<uint32_t>(
+          std::min<uint64_t>(maxCount[0], workgroup[0] - base));
+        commandBuffer.pushConstants(*this->mPipelineLayout,
+                                    vk::ShaderStageFlagBits::eCompute,
+                                    offset,
+                                    sizeof(uint32_t),
+                                    &baseWorkgroup);
+        commandBuffer.dispatch(count, workgroup[1], workgroup[2]);
+    }
 }
 
 void
-Algorithm::setWorkgroup(const Workgroup& workgroup, uint32_t minSize)
+Algorithm::setWorkgroup(const Workgroup& workgroup, uint64_t minSize)
 {
 
     KP_LOG_INFO("Kompute OpAlgoCreate setting dispatch size");
@@ -394,7 +626,13 @@ Algorithm::setWorkgroup(const Workgroup& workgroup, uint32_t minSize)
                              workgroup[1] > 0 ? workgroup[1] : 1,
                              workgroup[2] > 0 ? workgroup[2] : 1 };
     } else {
-        this->mWorkgroup = { minSize, 1, 1 };
+        if (minSize > UINT32_MAX) {
+            throw std::runtime_error(
+              fmt::format("Kompute Algorithm default workgroup of {} exceeds "
+                          "the 32 bit dispatch size, provide a workgroup",
+                          minSize));
+        }
+        this->mWorkgroup = { static_cast<uint32_t>(minSize), 1, 1 };
     }
 
     KP_LOG_INFO("Kompute OpAlgoCreate set dispatch size X: {}, Y: {}, Z: {}",
@@ -409,10 +647,223 @@ Algorithm::getWorkgroup()
     return this->mWorkgroup;
 }
 
+void
+Algorithm::setMaxWorkgroupCount(const Workgroup& maxWorkgroupCount)
+{
+    if (!maxWorkgroupCount[0] || !maxWorkgroupCount[1] ||
+        !maxWorkgroupCount[2]) {
+        throw std::runtime_error(
+          "Kompute Algorithm maximum workgroup count must not be 0");
+    }
+
+    this->mMaxWorkgroupCount = maxWorkgroupCount;
+}
+
+const Workgroup&
+Algorithm::getMaxWorkgroupCount()
+{
+    return this->mMaxWorkgroupCount;
+}
+
+uint32_t
+Algorithm::getBaseWorkgroupOffset() const
+{
+    // Push constant offsets have to be multiples of 4
+    uint32_t size =
+      this->mPushConstantsSize * this->mPushConstantsDataTypeMemorySize;
+    return (size + 3) & ~3u;
+}
+
+bool
+Algorithm::readsBaseWorkgroup() const
+{
+    return this->mReadsBaseWorkgroup;
+}
+
+uint32_t
+Algorithm::getPushConstantRangeSize() const
+{
+    if (this->mReadsBaseWorkgroup) {
+        return this->getBaseWorkgroupOffset() + sizeof(uint32_t);
+    }
+    return this->getBaseWorkgroupOffset();
+}
+
+void
+Algorithm::setName(const std::string& name)
+{
+    this->mName = name;
+}
+
+const std::string&
+Algorithm::getName() const
+{
+    return this->mName;
+}
+
 const std::vector<std::shared_ptr<Memory>>&
 Algorithm::getMemObjects()
 {
     return this->mMemObjects;
 }
 
+bool
+Algorithm::isReadOnly(uint32_t index) const
+{
+    return index < this->mReadOnlyBindings.size() &&
+           this->mReadOnlyBindings[index];
+}
+
+void
+Algorithm::findReadOnlyBindings()
+{
+    this->mReadOnlyBindings.assign(this->mMemObjects.size(), false);
+
+    // Readonly buffers are decorated as NonWritable either on the variable
+    // or on all the members of the block it points to
+    constexpr uint32_t opTypeStruct = 30;
+    constexpr uint32_t opTypePointer = 32;
+    constexpr uint32_t opVariable = 59;
+    constexpr uint32_t opDecorate = 71;
+    constexpr uint32_t opMemberDecorate = 72;
+    constexpr uint32_t decorationNonWritable = 24;
+    constexpr uint32_t decorationBinding = 33;
+
+    std::unordered_map<uint32_t, uint32_t> bindings;
+    std::unordered_set<uint32_t> nonWritableIds;
+    std::unordered_map<uint32_t, uint32_t> nonWritableMembers;
+    std::unordered_map<uint32_t, uint32_t> structMemberCounts;
+    std::unordered_map<uint32_t, uint32_t> pointerTypes;
+    std::unordered_map<uint32_t, uint32_t> variableTypes;
+
+    const std::vector<uint32_t>& spirv = this->mSpirv;
+    size_t i = 5; // Words of the SPIR-V header
+    while (i < spirv.size()) {
+        uint32_t opcode = spirv[i] & 0xFFFF;
+        uint32_t wordCount = spirv[i] >> 16;
+        if (wordCount == 0 || i + wordCount > spirv.size()) {
+            KP_LOG_WARN("Kompute Algorithm found malformed SPIR-V when "
+                        "finding readonly bindings");
+            return;
+        }
+
+        const uint32_t* words = spirv.data() + i;
+        switch (opcode) {
+            case opDecorate:
+                if (words[2] == decorationBinding && wordCount > 3) {
+                    bindings[words[1]] = words[3];
+                } else if (words[2] == decorationNonWritable) {
+                    nonWritableIds.insert(words[1]);
+                }
+                break;
+            case opMemberDecorate:
+                if (words[3] == decorationNonWritable) {
+                    nonWritableMembers[words[1]]++;
+                }
+                break;
+            case opTypeStruct:
+                structMemberCounts[words[1]] = wordCount - 2;
+                break;
+            case opTypePointer:
+                pointerTypes[words[1]] = words[3];
+                break;
+            case opVariable:
+                variableTypes[words[2]] = words[1];
+                break;
+            default:
+                break;
+        }
+        i += wordCount;
+    }
+
+    for (const std::pair<const uint32_t, uint32_t>& binding : bindings) {
+        if (binding.second >= this->mReadOnlyBindings.size()) {
+            continue;
+        }
+        uint32_t id = binding.first;
+        bool readOnly = nonWritableIds.count(id) > 0;
+        if (!readOnly && variableTypes.count(id) &&
+            pointerTypes.count(variableTypes[id])) {
+            uint32_t type = pointerTypes[variableTypes[id]];
+            readOnly = structMemberCounts.count(type) &&
+                       structMemberCounts[type] > 0 &&
+                       nonWritableMembers[type] >= structMemberCounts[type];
+        }
+        this->mReadOnlyBindings[binding.second] = readOnly;
+    }
+}
+
+void
+Algorithm::findBaseWorkgroupPushConstant()
+{
+    this->mReadsBaseWorkgroup = false;
+
+    // The shader reads the base workgroup when its push constant block has a
+    // member at or after the offset reserved for it
+    constexpr uint32_t opTypePointer = 32;
+    constexpr uint32_t opVariable = 59;
+    constexpr uint32_t opMemberDecorate = 72;
+    constexpr uint32_t decorationOffset = 35;
+    constexpr uint32_t storageClassPushConstant = 9;
+
+    std::unordered_map<uint32_t, uint32_t> maxMemberOffsets;
+    std::unordered_map<uint32_t, uint32_t> pointerTypes;
+    std::vector<uint32_t> pushConstantPointers;
+
+    const std::vector<uint32_t>& spirv = this->mSpirv;
+    size_t i = 5; // Words of the SPIR-V header
+    while (i < spirv.size()) {
+        uint32_t opcode = spirv[i] & 0xFFFF;
+        uint32_t wordCount = spirv[i] >> 16;
+        if (wordCount == 0 || i + wordCount > spirv.size()) {
+            KP_LOG_WARN("Kompute Algorithm found malformed SPIR-V when "
+                        "finding the base workgroup push constant");
+            break;
+        }
+
+        const uint32_t* words = spirv.data() + i;
+        switch (opcode) {
+            case opMemberDecorate:
+                if (wordCount > 4 && words[3] == decorationOffset) {
+                    uint32_t& offset = maxMemberOffsets[words[1]];
+                    offset = std::max(offset, words[4]);
+                }
+                break;
+            case opTypePointer:
+                pointerTypes[words[1]] = words[3];
+                break;
+            case opVariable:
+                if (words[3] == storageClassPushConstant) {
+                    pushConstantPointers.push_back(words[1]);
+                }
+                break;
+            default:
+                break;
+        }
+        i += wordCount;
+    }
+
+    uint32_t baseOffset = this->getBaseWorkgroupOffset();
+    for (uint32_t pointer : pushConstantPointers) {
+        auto type = pointerTypes.find(pointer);
+        if (type == pointerTypes.end()) {
+            continue;
+        }
+        auto offset = maxMemberOffsets.find(type->second);
+        if (offset != maxMemberOffsets.end() && offset->second >= baseOffset) {
+            this->mReadsBaseWorkgroup = true;
+        }
+    }
+
+    uint32_t rangeSize = this->getPushConstantRangeSize();
+    if (rangeSize > this->mMaxPushConstantsSize) {
+        throw std::runtime_error(fmt::format(
+          "Kompute Algorithm push constants require {} bytes{}, which exceeds "
+          "the maxPushConstantsSize limit of {} bytes of the device",
+          rangeSize,
+          this->mReadsBaseWorkgroup ? " including the base workgroup" : "",
+          this->mMaxPushConstantsSize));
+    }
+}
+
 }
@@ -0,0 +1,194 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <exception>
+#include <fmt/core.h>
+
+#include "kompute/CompletionThread.hpp"
+#include "kompute/Sequence.hpp"
+
+namespace kp {
+
+CompletionThread::CompletionThread(std::shared_ptr<vk::Device> device,
+                                   uint64_t pollInterval)
+{
+    KP_LOG_DEBUG("Kompute CompletionThread constructor with poll interval {}",
+                 pollInterval);
+
+    if (!device) {
+        throw std::runtime_error("Kompute CompletionThread device is null");
+    }
+
+    this->mDevice = device;
+    this->mPollInterval = pollInterval;
+}
+
+CompletionThread::~CompletionThread()
+{
+    KP_LOG_DEBUG("Kompute CompletionThread destructor started");
+
+    if (this->mDevice) {
+        this->destroy();
+    }
+}
+
+std::future<void>
+CompletionThread::watch(std::shared_ptr<Sequence> sequence,
+                        uint64_t ticket,
+                        Callback callback)
+{
+    KP_LOG_DEBUG("Kompute CompletionThread watching ticket {}", ticket);
+
+    if (!sequence->isRunning(ticket)) {
+        throw std::runtime_error(fmt::format(
+          "Kompute CompletionThread ticket {} is not in flight", ticket));
+    }
+
+    std::shared_ptr<Entry> entry = std::make_shared<Entry>();
+    entry->sequence = sequence;
+    entry->ticket = ticket;
+    entry->fence = sequence->getSubmissionFence(ticket);
+    entry->callback = std::move(callback);
+    std::future<void> future = entry->promise.get_future();
+
+    {
+        std::lock_guard<std::mutex> lock(this->mMutex);
+        if (!this->mDevice || this->mStop) {
+            throw std::runtime_error(
+              "Kompute CompletionThread watch called after destroy");
+        }
+        this->mEntries.push_back(entry);
+        if (!this->mThread.joinable()) {
+            this->mThread = std::thread(&CompletionThread::run, this);
+        }
+    }
+    this->mCondition.notify_one();
+
+    return future;
+}
+
+size_t
+CompletionThread::pendingCount()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    return this->mEntries.size();
+}
+
+bool
+CompletionThread::isInit() const
+{
+    return this->mDevice != nullptr;
+}
+
+void
+CompletionThread::destroy()
+{
+    KP_LOG_DEBUG("Kompute CompletionThread destroy called");
+
+    if (!this->mDevice) {
+        KP_LOG_WARN("Kompute CompletionThread destroy called "
+                    "with null Device pointer");
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->mMutex);
+        this->mStop = true;
+    }
+    this->mCondition.notify_one();
+
+    if (this->mThread.joinable()) {
+        this->mThread.join();
+    }
+
+    this->mDevice = nullptr;
+}
+
+void
+CompletionThread::run()
+{
+    std::vector<std::shared_ptr<Entry>> entries;
+    std::vector<vk::Fence> fences;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(this->mMutex);
+            this->mCondition.wait(lock, [this] {
+                return this->mStop || !this->mEntries.empty();
+            });
+            // Pending submissions are still completed once stopped
+            if (this->mEntries.empty()) {
+                return;
+            }
+            entries = this->mEntries;
+        }
+
+        fences.clear();
+        for (const std::shared_ptr<Entry>& entry : entries) {
+            fences.push_back(entry->fence);
+        }
+
+        std::vector<std::shared_ptr<Entry>> completed;
+        std::exception_ptr error = nullptr;
+        try {
+            // Wakes up as soon as any of the submissions finishes, or after
+            // the poll interval to wait on the submissions watched since
+            vk::Result result =
+              this->mDevice->waitForFences(static_cast<uint32_t>(fences.size()),
+                                           fences.data(),
+                                           VK_FALSE,
+                                           this->mPollInterval);
+            if (result == vk::Result::eTimeout) {
+                continue;
+            }
+            for (const std::shared_ptr<Entry>& entry : entries) {
+                if (this->mDevice->getFenceStatus(entry->fence) ==
+                    vk::Result::eSuccess) {
+                    completed.push_back(entry);
+                }
+            }
+        } catch (...) {
+            // Errors such as a lost device fail all the pending submissions
+            error = std::current_exception();
+            completed = entries;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(this->mMutex);
+            for (const std::shared_ptr<Entry>& entry : completed) {
+                this->mEntries.erase(std::find(
+                  this->mEntries.begin(), this->mEntries.end(), entry));
+            }
+        }
+
+        // Submissions are completed outside of the lock, so callbacks can
+        // watch new submissions
+        for (const std::shared_ptr<Entry>& entry : completed) {
+            if (error) {
+                entry->promise.set_exception(error);
+            } else {
+                CompletionThread::complete(*entry);
+            }
+            entry->sequence = nullptr;
+        }
+    }
+}
+
+void
+CompletionThread::complete(Entry& entry)
+{
+    KP_LOG_DEBUG("Kompute CompletionThread completing ticket {}",
+                 entry.ticket);
+
+    try {
+        entry.sequence->evalAwaitTicket(entry.ticket);
+        if (entry.callback) {
+            entry.callback();
+        }
+        entry.promise.set_value();
+    } catch (...) {
+        entry.promise.set_exception(std::current_exception());
+    }
+}
+
+}
@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "kompute/HazardTracker.hpp"
+
+namespace kp {
+
+HazardTracker::HazardTracker(bool assumeWritten)
+  : mAssumeWritten(assumeWritten)
+{
+}
+
+HazardTracker::Barrier
+HazardTracker::plan(const std::shared_ptr<OpBase>& op)
+{
+    Barrier barrier;
+
+    // Tensors used before the recording may have been written by any
+    // previous command, unless the caller made those writes visible or a
+    // full barrier has been recorded since
+    AccessState firstState;
+    if (this->mAssumeWritten && !this->mAllVisible) {
+        firstState.writeAccess = vk::AccessFlagBits::eMemoryWrite;
+        firstState.writeStages = vk::PipelineStageFlagBits::eAllCommands;
+    }
+
+    std::vector<OpBase::MemoryAccess> accesses = op->getMemoryAccesses();
+
+    // Operations that don't declare their accesses may read or write any
+    // memory, so they are ordered against every command recorded before
+    // them, and the operation that follows against all of their commands
+    bool undeclared = accesses.empty();
+    bool recordedBefore = this->mAssumeWritten || !this->mAccessStates.empty();
+    if (this->mFullBarrierPending || (undeclared && recordedBefore)) {
+        barrier.srcStageMask = vk::PipelineStageFlagBits::eAllCommands;
+        barrier.dstStageMask = vk::PipelineStageFlagBits::eAllCommands;
+        barrier.memoryBarrier.srcAccessMask = vk::AccessFlagBits::eMemoryWrite;
+        barrier.memoryBarrier.dstAccessMask =
+          vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite;
+        this->mAccessStates.clear();
+        this->mAllVisible = true;
+        firstState = AccessState();
+        this->mStats.fullBarriers++;
+    }
+    this->mFullBarrierPending = undeclared;
+
+    for (const OpBase::MemoryAccess& access : accesses) {
+        if (access.memory->type() != Memory::Type::eTensor) {
+            continue;
+        }
+        VkBuffer buffer = *std::static_pointer_cast<Tensor>(access.memory)
+                             ->getPrimaryBuffer();
+
+        auto it = this->mAccessStates.find(buffer);
+        const AccessState& state =
+          it != this->mAccessStates.end() ? it->second : firstState;
+
+        // Reads after a write need the write to be visible to their stages,
+        // while writes also have to wait for the previous reads to finish
+        bool required = false;
+        if (state.writeStages &&
+            (access.write ||
+             (state.visibleStages & access.stageMask) != access.stageMask)) {
+            barrier.srcStageMask |= state.writeStages;
+            barrier.memoryBarrier.srcAccessMask |= state.writeAccess;
+            barrier.memoryBarrier.dstAccessMask |= access.accessMask;
+            required = true;
+        }
+        if (access.write && state.readStages) {
+            barrier.srcStageMask |= state.readStages;
+            required = true;
+        }
+
+        if (required) {
+            barrier.dstStageMask |= access.stageMask;
+            this->mStats.requiredBarriers++;
+        } else {
+            this->mStats.elidedBarriers++;
+        }
+        this->mStats.trackedAccesses++;
+    }
+
+    if (barrier.srcStageMask) {
+        this->mStats.pipelineBarriers++;
+    }
+
+    // The state is updated once all the accesses have been checked, as an
+    // operation may access the same tensor more than once
+    for (const OpBase::MemoryAccess& access : accesses) {
+        if (access.memory->type() != Memory::Type::eTensor) {
+            continue;
+        }
+        VkBuffer buffer = *std::static_pointer_cast<Tensor>(access.memory)
+                             ->getPrimaryBuffer();
+
+        AccessState& state =
+          this->mAccessStates.emplace(buffer, firstState).first->second;
+        if (access.write) {
+            state = AccessState();
+            state.writeAccess = access.accessMask;
+            state.writeStages = access.stageMask;
+        } else {
+            state.visibleStages |= access.stageMask;
+            state.readStages |= access.stageMask;
+        }
+    }
+
+    return barrier;
+}
+
+void
+HazardTracker::record(const vk::CommandBuffer& commandBuffer,
+                      const Barrier& barrier)
+{
+    if (!barrier.srcStageMask) {
+        return;
+    }
+
+    commandBuffer.pipelineBarrier(barrier.srcStageMask,
+                                  barrier.dstStageMask,
+                                  vk::DependencyFlags(),
+                                  barrier.memoryBarrier,
+                                  nullptr,
+                                  nullptr);
+}
+
+void
+HazardTracker::clear()
+{
+    this->mAccessStates.clear();
+    this->mFullBarrierPending = false;
+    this->mAllVisible = false;
+}
+
+HazardTracker::Stats
+HazardTracker::stats() const
+{
+    return this->mStats;
+}
+
+}
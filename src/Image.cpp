@@ -45,7 +45,7 @@ Image::init(void* data,
     this->mNumChannels = numChannels;
     this->mDescriptorType = vk::DescriptorType::eStorageImage;
     this->mTiling = tiling;
-    this->mSize = this->getX() * this->getY() * this->mNumChannels;
+    this->mSize = (uint64_t)this->getX() * this->getY() * this->mNumChannels;
 
     this->reserve();
     this->updateRawData(data);
@@ -140,7 +140,8 @@ Image::recordCopyFrom(const vk::CommandBuffer& commandBuffer,
 
     vk::Extent3D size = { this->getX(), this->getY(), 1 };
 
-    vk::BufferImageCopy copyRegion(0, 0, 0, layer, offset, size);
+    vk::BufferImageCopy copyRegion(
+      copyFromTensor->memoryOffset(), 0, 0, layer, offset, size);
 
     KP_LOG_DEBUG(
       "Kompute Image recordCopyFrom size {},{}.", size.width, size.height);
@@ -508,10 +509,12 @@ Image::allocateMemoryCreateGPUResources()
     this->createImage(
       this->mPrimaryImage, this->getPrimaryImageUsageFlags(), this->mTiling);
     this->mFreePrimaryImage = true;
-    this->mPrimaryMemory = std::make_shared<vk::DeviceMemory>();
-    this->allocateBindMemory(this->mPrimaryImage,
-                             this->mPrimaryMemory,
-                             this->getPrimaryMemoryPropertyFlags());
+    this->mPrimaryMemoryPropertyFlags =
+      this->allocateBindMemory(this->mPrimaryImage,
+                               this->mPrimaryMemory,
+                               this->mPrimaryAllocation,
+                               this->getPrimaryMemoryPropertyFlags(),
+                               this->mTiling == vk::ImageTiling::eLinear);
     this->mFreePrimaryMemory = true;
 
     if (this->mMemoryType == MemoryTypes::eDevice) {
@@ -522,10 +525,12 @@ Image::allocateMemoryCreateGPUResources()
                           this->getStagingImageUsageFlags(),
                           vk::ImageTiling::eLinear);
         this->mFreeStagingImage = true;
-        this->mStagingMemory = std::make_shared<vk::DeviceMemory>();
-        this->allocateBindMemory(this->mStagingImage,
-                                 this->mStagingMemory,
-                                 this->getStagingMemoryPropertyFlags());
+        this->mStagingMemoryPropertyFlags =
+          this->allocateBindMemory(this->mStagingImage,
+                                   this->mStagingMemory,
+                                   this->mStagingAllocation,
+                                   this->getStagingMemoryPropertyFlags(),
+                                   true);
         this->mFreeStagingMemory = true;
     }
 
@@ -565,49 +570,62 @@ Image::createImage(std::shared_ptr<vk::Image> image,
     this->mDevice->createImage(&imageInfo, nullptr, image.get());
 }
 
-void
-Image::allocateBindMemory(std::shared_ptr<vk::Image> image,
-                          std::shared_ptr<vk::DeviceMemory> memory,
-                          vk::MemoryPropertyFlags memoryPropertyFlags)
+vk::MemoryPropertyFlags
+Image::allocateBindMemory(
+  std::shared_ptr<vk::Image> image,
+  std::shared_ptr<vk::DeviceMemory>& memory,
+  MemoryPool::Allocation& allocation,
+  const std::vector<vk::MemoryPropertyFlags>& memoryPropertyFlags,
+  bool linear)
 {
 
     KP_LOG_DEBUG("Kompute Image allocating and binding memory");
 
-    vk::PhysicalDeviceMemoryProperties memoryProperties =
-      this->mPhysicalDevice->getMemoryProperties();
-
     vk::MemoryRequirements memoryRequirements =
       this->mDevice->getImageMemoryRequirements(*image);
 
-    uint32_t memoryTypeIndex = -1;
-    bool memoryTypeIndexFound = false;
-    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
-        if (memoryRequirements.memoryTypeBits & (1 << i)) {
-            if (((memoryProperties.memoryTypes[i]).propertyFlags &
-                 memoryPropertyFlags) == memoryPropertyFlags) {
-                memoryTypeIndex = i;
-                memoryTypeIndexFound = true;
-                break;
-            }
-        }
-    }
-    if (!memoryTypeIndexFound) {
-        throw std::runtime_error(
-          "Memory type index for image creation not found");
+    uint32_t memoryTypeIndex = this->findMemoryTypeIndex(
+      memoryRequirements.memoryTypeBits, memoryPropertyFlags);
+    vk::MemoryPropertyFlags memoryTypeFlags =
+      this->mPhysicalDevice->getMemoryProperties()
+        .memoryTypes[memoryTypeIndex]
+        .propertyFlags;
+
+    if (this->mMemoryPool) {
+        KP_LOG_DEBUG("Kompute Image allocating pooled memory index: {}, size "
+                     "{}, flags: {}",
+                     memoryTypeIndex,
+                     memoryRequirements.size,
+                     vk::to_string(memoryTypeFlags));
+
+        allocation = this->mMemoryPool->allocate(
+          memoryRequirements, memoryTypeIndex, linear);
+        memory = allocation.memory;
+
+        this->mDevice->bindImageMemory(*image, *memory, allocation.offset);
+        return memoryTypeFlags;
     }
 
     KP_LOG_DEBUG(
       "Kompute Image allocating memory index: {}, size {}, flags: {}",
       memoryTypeIndex,
       memoryRequirements.size,
-      vk::to_string(memoryPropertyFlags));
+      vk::to_string(memoryTypeFlags));
+
+    // Unpooled allocations only record their size and type for accounting
+    allocation = MemoryPool::Allocation();
+    allocation.size = memoryRequirements.size;
+    allocation.memoryTypeIndex = memoryTypeIndex;
 
     vk::MemoryAllocateInfo memoryAllocateInfo(memoryRequirements.size,
                                               memoryTypeIndex);
 
+    memory = std::make_shared<vk::DeviceMemory>();
     this->mDevice->allocateMemory(&memoryAllocateInfo, nullptr, memory.get());
 
     this->mDevice->bindImageMemory(*image, *memory, 0);
+
+    return memoryTypeFlags;
 }
 
 void
@@ -4,6 +4,10 @@
 #include "kompute/logger/Logger.hpp"
 #include <fmt/core.h>
 #include <fmt/ranges.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <iterator>
 #include <set>
 #include <sstream>
@@ -52,6 +56,8 @@ Manager::Manager(uint32_t physicalDeviceIndex,
     this->createInstance();
     this->createDevice(
       familyQueueIndices, physicalDeviceIndex, desiredExtensions);
+    this->createPipelineCache();
+    this->mPipelineRegistry = std::make_shared<PipelineRegistry>(this->mDevice);
 }
 
 Manager::Manager(std::shared_ptr<vk::Instance> instance,
@@ -68,6 +74,9 @@ Manager::Manager(std::shared_ptr<vk::Instance> instance,
 #if !KOMPUTE_OPT_LOG_LEVEL_DISABLED
     logger::setupLogger();
 #endif
+
+    this->createPipelineCache();
+    this->mPipelineRegistry = std::make_shared<PipelineRegistry>(this->mDevice);
 }
 
 Manager::~Manager()
@@ -88,6 +97,14 @@ Manager::destroy()
         return;
     }
 
+    // The pending submissions are completed before their sequences are
+    // destroyed
+    if (this->mCompletionThread) {
+        KP_LOG_DEBUG("Kompute Manager destroying completion thread");
+        this->mCompletionThread->destroy();
+        this->mCompletionThread = nullptr;
+    }
+
     if (this->mManageResources && this->mManagedSequences.size()) {
         KP_LOG_DEBUG("Kompute Manager explicitly running destructor for "
                      "managed sequences");
@@ -99,6 +116,19 @@ Manager::destroy()
         this->mManagedSequences.clear();
     }
 
+    if (this->mManageResources && this->mManagedFragments.size()) {
+        KP_LOG_DEBUG("Kompute Manager explicitly running destructor for "
+                     "managed sequence fragments");
+        for (const std::weak_ptr<SequenceFragment>& weakFragment :
+             this->mManagedFragments) {
+            if (std::shared_ptr<SequenceFragment> fragment =
+                  weakFragment.lock()) {
+                fragment->destroy();
+            }
+        }
+        this->mManagedFragments.clear();
+    }
+
     if (this->mManageResources && this->mManagedAlgorithms.size()) {
         KP_LOG_DEBUG("Kompute Manager explicitly freeing algorithms");
         for (const std::weak_ptr<Algorithm>& weakAlgorithm :
@@ -110,6 +140,20 @@ Manager::destroy()
         this->mManagedAlgorithms.clear();
     }
 
+    if (this->mPipelineRegistry) {
+        KP_LOG_DEBUG("Kompute Manager destroying pipeline registry");
+        this->mPipelineRegistry->destroy();
+        this->mPipelineRegistry = nullptr;
+    }
+
+    if (this->mPipelineCache) {
+        KP_LOG_DEBUG("Kompute Manager destroying pipeline cache");
+        this->mDevice->destroy(
+          *this->mPipelineCache,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        this->mPipelineCache = nullptr;
+    }
+
     if (this->mManageResources && this->mManagedMemObjects.size()) {
         KP_LOG_DEBUG("Kompute Manager explicitly freeing memory objects");
         for (const std::weak_ptr<Memory>& weakMemory :
@@ -121,6 +165,34 @@ Manager::destroy()
         this->mManagedMemObjects.clear();
     }
 
+    if (this->mSubmitBatches.size()) {
+        KP_LOG_DEBUG("Kompute Manager destroying submission fences");
+        for (const SubmitBatch& batch : this->mSubmitBatches) {
+            this->mDevice->destroy(
+              *batch.fence,
+              (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        }
+        this->mSubmitBatches.clear();
+    }
+
+    if (this->mResidency) {
+        KP_LOG_DEBUG("Kompute Manager destroying residency policy");
+        this->mResidency->destroy();
+        this->mResidency = nullptr;
+    }
+
+    if (this->mStagingRing) {
+        KP_LOG_DEBUG("Kompute Manager destroying staging ring");
+        this->mStagingRing->destroy();
+        this->mStagingRing = nullptr;
+    }
+
+    if (this->mMemoryPool) {
+        KP_LOG_DEBUG("Kompute Manager destroying memory pool");
+        this->mMemoryPool->destroy();
+        this->mMemoryPool = nullptr;
+    }
+
     if (this->mFreeDevice) {
         KP_LOG_INFO("Destroying device");
         this->mDevice->destroy(
@@ -306,6 +378,12 @@ Manager::clear()
                          end(this->mManagedSequences),
                          [](std::weak_ptr<Sequence> t) { return t.expired(); }),
           end(this->mManagedSequences));
+        this->mManagedFragments.erase(
+          std::remove_if(
+            begin(this->mManagedFragments),
+            end(this->mManagedFragments),
+            [](std::weak_ptr<SequenceFragment> t) { return t.expired(); }),
+          end(this->mManagedFragments));
     }
 }
 
@@ -429,6 +507,14 @@ Manager::createDevice(const std::vector<uint32_t>& familyQueueIndices,
         KP_LOG_ERROR("Kompute Manager not all extensions were added: {}",
                      fmt::join(validExtensions, ", "));
     }
+    this->mEnabledExtensions.assign(validExtensions.begin(),
+                                    validExtensions.end());
+
+    // Sequences can count the invocations of their dispatches when the
+    // device supports pipeline statistics queries
+    vk::PhysicalDeviceFeatures enabledFeatures;
+    enabledFeatures.pipelineStatisticsQuery =
+      physicalDevice.getFeatures().pipelineStatisticsQuery;
 
     vk::DeviceCreateInfo deviceCreateInfo(vk::DeviceCreateFlags(),
                                           deviceQueueCreateInfos.size(),
@@ -436,7 +522,16 @@ Manager::createDevice(const std::vector<uint32_t>& familyQueueIndices,
                                           {},
                                           {},
                                           validExtensions.size(),
-                                          validExtensions.data());
+                                          validExtensions.data(),
+                                          &enabledFeatures);
+
+    // Sequences synchronise with each other through timeline semaphores when
+    // the extension is enabled
+    vk::PhysicalDeviceTimelineSemaphoreFeaturesKHR timelineSemaphoreFeatures(
+      true);
+    if (this->isExtensionEnabled(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME)) {
+        deviceCreateInfo.setPNext(&timelineSemaphoreFeatures);
+    }
 
     this->mDevice = std::make_shared<vk::Device>();
     physicalDevice.createDevice(
@@ -453,13 +548,35 @@ Manager::createDevice(const std::vector<uint32_t>& familyQueueIndices,
         familyQueueIndexCount[familyQueueIndex]++;
 
         this->mComputeQueues.push_back(currQueue);
+        this->mComputeQueueMutexes.push_back(std::make_shared<std::mutex>());
     }
 
     KP_LOG_DEBUG("Kompute Manager compute queue obtained");
 }
 
+void
+Manager::createPipelineCache()
+{
+    KP_LOG_DEBUG("Kompute Manager creating pipeline cache");
+
+    vk::PipelineCacheCreateInfo pipelineCacheInfo;
+    this->mPipelineCache = std::make_shared<vk::PipelineCache>();
+    this->mDevice->createPipelineCache(
+      &pipelineCacheInfo, nullptr, this->mPipelineCache.get());
+}
+
+bool
+Manager::isExtensionEnabled(const std::string& extensionName) const
+{
+    return std::find(this->mEnabledExtensions.begin(),
+                     this->mEnabledExtensions.end(),
+                     extensionName) != this->mEnabledExtensions.end();
+}
+
 std::shared_ptr<Sequence>
-Manager::sequence(uint32_t queueIndex, uint32_t totalTimestamps)
+Manager::sequence(uint32_t queueIndex,
+                  uint32_t totalTimestamps,
+                  uint32_t numBuffers)
 {
     KP_LOG_DEBUG("Kompute Manager sequence() with queueIndex: {}", queueIndex);
 
@@ -468,7 +585,15 @@ Manager::sequence(uint32_t queueIndex, uint32_t totalTimestamps)
       this->mDevice,
       this->mComputeQueues[queueIndex],
       this->mComputeQueueFamilyIndices[queueIndex],
-      totalTimestamps) };
+      totalTimestamps,
+      numBuffers,
+      this->mResidency,
+      this->mCompletionThread,
+      this->mComputeQueueMutexes[queueIndex]) };
+
+    if (this->isExtensionEnabled(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME)) {
+        sq->enableTimeline();
+    }
 
     if (this->mManageResources) {
         this->mManagedSequences.push_back(sq);
@@ -477,6 +602,529 @@ Manager::sequence(uint32_t queueIndex, uint32_t totalTimestamps)
     return sq;
 }
 
+std::shared_ptr<SequenceFragment>
+Manager::fragment(uint32_t queueIndex)
+{
+    KP_LOG_DEBUG("Kompute Manager fragment() with queueIndex: {}", queueIndex);
+
+    std::shared_ptr<SequenceFragment> fragment{ new kp::SequenceFragment(
+      this->mDevice,
+      this->mComputeQueueFamilyIndices[queueIndex],
+      this->mResidency) };
+
+    if (this->mManageResources) {
+        this->mManagedFragments.push_back(fragment);
+    }
+
+    return fragment;
+}
+
+std::shared_ptr<Profiler>
+Manager::profiler(size_t maxEvents)
+{
+    KP_LOG_DEBUG("Kompute Manager profiler() with max events: {}",
+                 maxEvents);
+
+    return std::make_shared<Profiler>(
+      this->mPhysicalDevice->getProperties().limits.timestampPeriod,
+      maxEvents);
+}
+
+void
+Manager::submit(const std::vector<std::shared_ptr<Sequence>>& sequences)
+{
+    KP_LOG_DEBUG("Kompute Manager submit() with {} sequences",
+                 sequences.size());
+
+    // Sequences using the same queue are submitted together, keeping the
+    // order in which they were provided
+    std::vector<std::vector<std::shared_ptr<Sequence>>> groups;
+    for (const std::shared_ptr<Sequence>& sq : sequences) {
+        auto it = std::find_if(
+          groups.begin(),
+          groups.end(),
+          [&sq](const std::vector<std::shared_ptr<Sequence>>& group) {
+              return *group[0]->getComputeQueue() == *sq->getComputeQueue();
+          });
+        if (it == groups.end()) {
+            groups.push_back({ sq });
+        } else {
+            it->push_back(sq);
+        }
+    }
+
+    for (const std::vector<std::shared_ptr<Sequence>>& group : groups) {
+        SubmitBatch batch;
+        batch.fence = std::make_shared<vk::Fence>(
+          this->mDevice->createFence(vk::FenceCreateInfo()));
+
+        std::vector<vk::SubmitInfo> submitInfos;
+        try {
+            for (const std::shared_ptr<Sequence>& sq : group) {
+                submitInfos.push_back(sq->prepareSubmit(batch.fence));
+                batch.tickets.push_back({ sq, sq->getLastTicket() });
+            }
+
+            KP_LOG_DEBUG("Kompute Manager submitting {} command buffers in "
+                         "one queue submission",
+                         submitInfos.size());
+
+            std::shared_ptr<vk::Queue> queue = group[0]->getComputeQueue();
+            auto queueIt = std::find(
+              this->mComputeQueues.begin(), this->mComputeQueues.end(), queue);
+            std::unique_lock<std::mutex> queueLock;
+            if (queueIt != this->mComputeQueues.end()) {
+                queueLock = std::unique_lock<std::mutex>(
+                  *this->mComputeQueueMutexes[queueIt -
+                                              this->mComputeQueues.begin()]);
+            }
+            queue->submit(submitInfos, *batch.fence);
+        } catch (...) {
+            // Sequences prepared before the failure are cancelled in reverse
+            // order, as a sequence may appear more than once in the batch
+            for (auto it = batch.tickets.rbegin(); it != batch.tickets.rend();
+                 it++) {
+                if (std::shared_ptr<Sequence> sq = it->first.lock()) {
+                    sq->cancelSubmit();
+                }
+            }
+            this->mDevice->destroy(
+              *batch.fence,
+              (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+            throw;
+        }
+
+        this->mSubmitBatches.push_back(batch);
+    }
+}
+
+void
+Manager::await(uint64_t waitFor)
+{
+    KP_LOG_DEBUG("Kompute Manager await() with {} submissions",
+                 this->mSubmitBatches.size());
+
+    size_t finished = 0;
+    for (SubmitBatch& batch : this->mSubmitBatches) {
+        vk::Result result =
+          this->mDevice->waitForFences(1, batch.fence.get(), VK_TRUE, waitFor);
+
+        if (result == vk::Result::eTimeout) {
+            KP_LOG_WARN("Kompute Manager await reached timeout of {}",
+                        waitFor);
+            break;
+        }
+
+        // Sequences that were awaited directly have already run postEval
+        for (const std::pair<std::weak_ptr<Sequence>, uint64_t>& ticket :
+             batch.tickets) {
+            std::shared_ptr<Sequence> sq = ticket.first.lock();
+            if (sq && sq->isRunning(ticket.second)) {
+                sq->evalAwaitTicket(ticket.second);
+            }
+        }
+
+        this->mDevice->destroy(
+          *batch.fence, (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        finished++;
+    }
+
+    this->mSubmitBatches.erase(this->mSubmitBatches.begin(),
+                               this->mSubmitBatches.begin() + finished);
+}
+
+// Checks the VkPipelineCacheHeaderVersionOne header at the start of the data,
+// as some drivers don't reject data saved by another device or driver
+static bool
+isPipelineCacheCompatible(const std::vector<char>& data,
+                          const vk::PhysicalDeviceProperties& properties)
+{
+    const size_t uuidOffset = 4 * sizeof(uint32_t);
+    if (data.size() < uuidOffset + VK_UUID_SIZE) {
+        return false;
+    }
+
+    uint32_t header[4];
+    memcpy(header, data.data(), sizeof(header));
+    if (header[0] < uuidOffset + VK_UUID_SIZE || header[0] > data.size() ||
+        header[1] != VK_PIPELINE_CACHE_HEADER_VERSION_ONE ||
+        header[2] != properties.vendorID || header[3] != properties.deviceID) {
+        return false;
+    }
+
+    return memcmp(data.data() + uuidOffset,
+                  properties.pipelineCacheUUID.data(),
+                  VK_UUID_SIZE) == 0;
+}
+
+bool
+Manager::loadPipelineCache(const std::string& path)
+{
+    KP_LOG_DEBUG("Kompute Manager loading pipeline cache from {}", path);
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        KP_LOG_INFO("Kompute Manager pipeline cache {} not found", path);
+        return false;
+    }
+    std::vector<char> data((std::istreambuf_iterator<char>(file)),
+                           std::istreambuf_iterator<char>());
+
+    if (!isPipelineCacheCompatible(data, this->getDeviceProperties())) {
+        KP_LOG_WARN("Kompute Manager pipeline cache {} was saved by another "
+                    "device or driver and is ignored",
+                    path);
+        return false;
+    }
+
+    // Data can only be provided when creating a cache, so it is merged from
+    // a temporary cache into the one the algorithms already use
+    vk::PipelineCacheCreateInfo pipelineCacheInfo(
+      vk::PipelineCacheCreateFlags(), data.size(), data.data());
+    vk::PipelineCache loadedCache;
+    this->mDevice->createPipelineCache(
+      &pipelineCacheInfo, nullptr, &loadedCache);
+    try {
+        this->mDevice->mergePipelineCaches(*this->mPipelineCache, loadedCache);
+    } catch (...) {
+        this->mDevice->destroy(
+          loadedCache, (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        throw;
+    }
+    this->mDevice->destroy(
+      loadedCache, (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+
+    KP_LOG_INFO("Kompute Manager loaded {} bytes of pipeline cache",
+                data.size());
+    return true;
+}
+
+void
+Manager::savePipelineCache(const std::string& path)
+{
+    KP_LOG_DEBUG("Kompute Manager saving pipeline cache to {}", path);
+
+    std::vector<uint8_t> data =
+      this->mDevice->getPipelineCacheData(*this->mPipelineCache);
+
+    std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(data.data()), data.size());
+        if (!file) {
+            throw std::runtime_error(fmt::format(
+              "Kompute Manager failed to write pipeline cache to {}",
+              temporaryPath));
+        }
+    }
+
+    // Renaming doesn't replace existing files on every platform
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        std::remove(path.c_str());
+        if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+            std::remove(temporaryPath.c_str());
+            throw std::runtime_error(fmt::format(
+              "Kompute Manager failed to save pipeline cache to {}", path));
+        }
+    }
+
+    KP_LOG_INFO("Kompute Manager saved {} bytes of pipeline cache to {}",
+                data.size(),
+                path);
+}
+
+std::shared_ptr<vk::PipelineCache>
+Manager::getPipelineCache() const
+{
+    return this->mPipelineCache;
+}
+
+std::shared_ptr<PipelineRegistry>
+Manager::getPipelineRegistry() const
+{
+    return this->mPipelineRegistry;
+}
+
+std::shared_ptr<MemoryPool>
+Manager::enableMemoryPool(vk::DeviceSize blockSize)
+{
+    KP_LOG_DEBUG("Kompute Manager enableMemoryPool with block size {}",
+                 blockSize);
+
+    if (this->mMemoryPool) {
+        KP_LOG_WARN("Kompute Manager memory pool already enabled with block "
+                    "size {}",
+                    this->mMemoryPool->blockSize());
+        return this->mMemoryPool;
+    }
+
+    this->mMemoryPool = std::make_shared<MemoryPool>(
+      this->mPhysicalDevice, this->mDevice, blockSize);
+
+    return this->mMemoryPool;
+}
+
+std::shared_ptr<MemoryPool>
+Manager::getMemoryPool() const
+{
+    return this->mMemoryPool;
+}
+
+void
+Manager::setStagingPolicy(Memory::StagingPolicy stagingPolicy)
+{
+    KP_LOG_DEBUG("Kompute Manager setting staging policy to {}",
+                 Memory::toString(stagingPolicy));
+
+    this->mStagingPolicy = stagingPolicy;
+}
+
+Memory::StagingPolicy
+Manager::getStagingPolicy() const
+{
+    return this->mStagingPolicy;
+}
+
+std::shared_ptr<StagingRing>
+Manager::enableStagingRing(vk::DeviceSize size, uint32_t numChunks)
+{
+    KP_LOG_DEBUG("Kompute Manager enableStagingRing with size {}", size);
+
+    if (this->mStagingRing) {
+        KP_LOG_WARN("Kompute Manager staging ring already enabled with size "
+                    "{}",
+                    this->mStagingRing->size());
+        return this->mStagingRing;
+    }
+
+    this->mStagingRing =
+      std::make_shared<StagingRing>(this->mPhysicalDevice,
+                                    this->mDevice,
+                                    this->mComputeQueues[0],
+                                    this->mComputeQueueFamilyIndices[0],
+                                    size,
+                                    numChunks,
+                                    this->mComputeQueueMutexes[0]);
+
+    return this->mStagingRing;
+}
+
+std::shared_ptr<StagingRing>
+Manager::getStagingRing() const
+{
+    return this->mStagingRing;
+}
+
+std::shared_ptr<Residency>
+Manager::enableResidency(vk::DeviceSize budget)
+{
+    KP_LOG_DEBUG("Kompute Manager enableResidency with budget {}", budget);
+
+    if (this->mResidency) {
+        KP_LOG_WARN("Kompute Manager residency already enabled with budget "
+                    "{}",
+                    this->mResidency->budget());
+        return this->mResidency;
+    }
+
+    this->mResidency =
+      std::make_shared<Residency>(this->mPhysicalDevice,
+                                  this->mDevice,
+                                  this->mComputeQueues[0],
+                                  this->mComputeQueueFamilyIndices[0],
+                                  budget,
+                                  this->mComputeQueueMutexes[0]);
+
+    return this->mResidency;
+}
+
+std::shared_ptr<Residency>
+Manager::getResidency() const
+{
+    return this->mResidency;
+}
+
+std::shared_ptr<CompletionThread>
+Manager::enableCompletionThread(uint64_t pollInterval)
+{
+    KP_LOG_DEBUG("Kompute Manager enableCompletionThread with poll interval "
+                 "{}",
+                 pollInterval);
+
+    if (this->mCompletionThread) {
+        KP_LOG_WARN("Kompute Manager completion thread already enabled");
+        return this->mCompletionThread;
+    }
+
+    this->mCompletionThread =
+      std::make_shared<CompletionThread>(this->mDevice, pollInterval);
+
+    return this->mCompletionThread;
+}
+
+std::shared_ptr<CompletionThread>
+Manager::getCompletionThread() const
+{
+    return this->mCompletionThread;
+}
+
+Manager::MemoryStats
+Manager::memoryStats()
+{
+    KP_LOG_DEBUG("Kompute Manager memoryStats started");
+
+    MemoryStats stats;
+
+    vk::PhysicalDeviceMemoryProperties memoryProperties =
+      this->mPhysicalDevice->getMemoryProperties();
+
+    stats.heaps.resize(memoryProperties.memoryHeapCount);
+    for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++) {
+        stats.heaps[i].size = memoryProperties.memoryHeaps[i].size;
+        stats.heaps[i].deviceLocal =
+          (bool)(memoryProperties.memoryHeaps[i].flags &
+                 vk::MemoryHeapFlagBits::eDeviceLocal);
+    }
+
+    for (const std::weak_ptr<Memory>& weakMemory : this->mManagedMemObjects) {
+        std::shared_ptr<Memory> memory = weakMemory.lock();
+        if (!memory || !memory->isInit()) {
+            continue;
+        }
+
+        MemoryTypeStats& typeStats = stats.memoryTypes[memory->memoryType()];
+        typeStats.count++;
+        typeStats.usedBytes += memory->memorySize();
+
+        for (const MemoryPool::Allocation& allocation :
+             memory->ownedAllocations()) {
+            uint32_t heapIndex =
+              memoryProperties.memoryTypes[allocation.memoryTypeIndex]
+                .heapIndex;
+            typeStats.allocatedBytes += allocation.size;
+            stats.heaps[heapIndex].allocatedBytes += allocation.size;
+        }
+    }
+
+    std::vector<vk::ExtensionProperties> extensions =
+      this->mPhysicalDevice->enumerateDeviceExtensionProperties();
+    for (const vk::ExtensionProperties& extension : extensions) {
+        if (std::string(extension.extensionName) ==
+            VK_EXT_MEMORY_BUDGET_EXTENSION_NAME) {
+            stats.budgetAvailable = true;
+            break;
+        }
+    }
+
+    if (stats.budgetAvailable) {
+        vk::StructureChain<vk::PhysicalDeviceMemoryProperties2,
+                           vk::PhysicalDeviceMemoryBudgetPropertiesEXT>
+          properties = this->mPhysicalDevice->getMemoryProperties2<
+            vk::PhysicalDeviceMemoryProperties2,
+            vk::PhysicalDeviceMemoryBudgetPropertiesEXT>();
+        const vk::PhysicalDeviceMemoryBudgetPropertiesEXT& budget =
+          properties.get<vk::PhysicalDeviceMemoryBudgetPropertiesEXT>();
+
+        for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++) {
+            stats.heaps[i].budget = budget.heapBudget[i];
+            stats.heaps[i].usage = budget.heapUsage[i];
+        }
+    } else {
+        // Without the extension only the allocations of the memory objects of
+        // the manager are known, which excludes other processes
+        for (MemoryHeapStats& heap : stats.heaps) {
+            heap.budget = heap.size;
+            heap.usage = heap.allocatedBytes;
+        }
+    }
+
+    return stats;
+}
+
+std::shared_ptr<Tensor>
+Manager::tensorFromHostPointer(void* data,
+                               size_t bytes,
+                               const Memory::DataTypes& dataType)
+{
+    uint32_t elementMemorySize = Memory::dataTypeMemorySize(dataType);
+    if (!data || bytes == 0 || bytes % elementMemorySize != 0) {
+        throw std::runtime_error(
+          fmt::format("Kompute Manager host pointer of {} bytes is not a "
+                      "whole number of elements of {} bytes",
+                      bytes,
+                      elementMemorySize));
+    }
+    uint64_t elementTotalCount = bytes / elementMemorySize;
+
+    // Devices provided externally may have enabled the extension without
+    // the manager knowing, in which case the device can resolve its function
+    bool extensionEnabled =
+      this->isExtensionEnabled(VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME) ||
+      (!this->mFreeDevice &&
+       this->mDevice->getProcAddr("vkGetMemoryHostPointerPropertiesEXT"));
+
+    std::string fallbackReason;
+    if (!extensionEnabled) {
+        fallbackReason =
+          fmt::format("the {} device extension is not enabled",
+                      VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME);
+    } else {
+        vk::StructureChain<vk::PhysicalDeviceProperties2,
+                           vk::PhysicalDeviceExternalMemoryHostPropertiesEXT>
+          properties = this->mPhysicalDevice->getProperties2<
+            vk::PhysicalDeviceProperties2,
+            vk::PhysicalDeviceExternalMemoryHostPropertiesEXT>();
+        vk::DeviceSize alignment =
+          properties.get<vk::PhysicalDeviceExternalMemoryHostPropertiesEXT>()
+            .minImportedHostPointerAlignment;
+        if (reinterpret_cast<uintptr_t>(data) % alignment != 0 ||
+            bytes % alignment != 0) {
+            fallbackReason =
+              fmt::format("the pointer and size of {} bytes are not aligned "
+                          "to the minImportedHostPointerAlignment of {} bytes",
+                          bytes,
+                          alignment);
+        }
+    }
+
+    std::shared_ptr<Tensor> tensor;
+    if (fallbackReason.empty()) {
+        KP_LOG_DEBUG("Kompute Manager importing {} bytes of host memory",
+                     bytes);
+
+        // The driver can still refuse the pointer, for instance when it
+        // isn't host allocated memory or the import runs out of memory
+        try {
+            tensor = std::shared_ptr<Tensor>{ new kp::Tensor(
+              this->mPhysicalDevice,
+              this->mDevice,
+              Tensor::HostPointer{ data, bytes },
+              elementTotalCount,
+              elementMemorySize,
+              dataType) };
+        } catch (const std::runtime_error& e) {
+            fallbackReason = e.what();
+        }
+    }
+
+    if (!fallbackReason.empty()) {
+        KP_LOG_WARN("Kompute Manager copying host pointer data into a new "
+                    "tensor as it cannot be imported: {}",
+                    fallbackReason);
+        return this->tensor(data,
+                            elementTotalCount,
+                            elementMemorySize,
+                            dataType,
+                            Memory::MemoryTypes::eHost);
+    }
+
+    if (this->mManageResources) {
+        this->mManagedMemObjects.push_back(tensor);
+    }
+
+    return tensor;
+}
+
 vk::PhysicalDeviceProperties
 Manager::getDeviceProperties() const
 {
@@ -3,6 +3,7 @@
 #include "kompute/Memory.hpp"
 #include "kompute/Image.hpp"
 #include "kompute/Tensor.hpp"
+#include <algorithm>
 #include <fmt/core.h>
 
 namespace kp {
@@ -12,7 +13,9 @@ Memory::Memory(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
                const DataTypes& dataType,
                const MemoryTypes& memoryType,
                uint32_t x,
-               uint32_t y)
+               uint32_t y,
+               std::shared_ptr<MemoryPool> memoryPool,
+               const StagingPolicy& stagingPolicy)
 {
     if (x == 0 || y == 0) {
         throw std::runtime_error(
@@ -21,13 +24,34 @@ Memory::Memory(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
 
     this->mPhysicalDevice = physicalDevice;
     this->mDevice = device;
+    this->mMemoryPool = memoryPool;
     this->mDataType = dataType;
     this->mMemoryType = memoryType;
+    this->mStagingPolicy = stagingPolicy;
     this->mDataTypeMemorySize = Memory::dataTypeMemorySize(dataType);
     this->mX = x;
     this->mY = y;
 }
 
+Memory::Memory(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+               std::shared_ptr<vk::Device> device,
+               const DataTypes& dataType,
+               const MemoryTypes& memoryType,
+               uint64_t size,
+               std::shared_ptr<MemoryPool> memoryPool,
+               const StagingPolicy& stagingPolicy)
+  : Memory(physicalDevice,
+           device,
+           dataType,
+           memoryType,
+           // The x dimension saturates for sizes beyond 32 bits
+           static_cast<uint32_t>(std::min<uint64_t>(size, UINT32_MAX)),
+           1,
+           memoryPool,
+           stagingPolicy)
+{
+}
+
 std::string
 Memory::toString(Memory::MemoryTypes dt)
 {
@@ -38,6 +62,8 @@ Memory::toString(Memory::MemoryTypes dt)
             return "eHost";
         case MemoryTypes::eStorage:
             return "eStorage";
+        case MemoryTypes::eTransient:
+            return "eTransient";
         default:
             return "unknown";
     }
@@ -70,13 +96,26 @@ Memory::toString(Memory::DataTypes dt)
     }
 }
 
+std::string
+Memory::toString(Memory::StagingPolicy sp)
+{
+    switch (sp) {
+        case StagingPolicy::eUpload:
+            return "eUpload";
+        case StagingPolicy::eReadback:
+            return "eReadback";
+        default:
+            return "unknown";
+    }
+}
+
 Memory::MemoryTypes
 Memory::memoryType()
 {
     return this->mMemoryType;
 }
 
-uint32_t
+uint64_t
 Memory::size()
 {
     return this->mSize;
@@ -121,10 +160,263 @@ Memory::dataType()
     return this->mDataType;
 }
 
-uint32_t
+Memory::StagingPolicy
+Memory::stagingPolicy()
+{
+    return this->mStagingPolicy;
+}
+
+bool
+Memory::isMemoryBound()
+{
+    return this->mPrimaryMemory != nullptr;
+}
+
+uint64_t
+Memory::generation()
+{
+    return this->mGeneration;
+}
+
+void
+Memory::acquireSubmission(const vk::Queue& queue)
+{
+    std::lock_guard<std::mutex> lock(this->mSubmissionQueuesMutex);
+    this->mSubmissionQueues.push_back(queue);
+}
+
+void
+Memory::releaseSubmission(const vk::Queue& queue)
+{
+    std::lock_guard<std::mutex> lock(this->mSubmissionQueuesMutex);
+    auto it = std::find(
+      this->mSubmissionQueues.begin(), this->mSubmissionQueues.end(), queue);
+    if (it != this->mSubmissionQueues.end()) {
+        this->mSubmissionQueues.erase(it);
+    }
+}
+
+bool
+Memory::isUsedByOtherQueue(const vk::Queue& queue)
+{
+    std::lock_guard<std::mutex> lock(this->mSubmissionQueuesMutex);
+    return std::any_of(this->mSubmissionQueues.begin(),
+                       this->mSubmissionQueues.end(),
+                       [&queue](const vk::Queue& q) { return q != queue; });
+}
+
+bool
+Memory::isUsedBySubmission()
+{
+    std::lock_guard<std::mutex> lock(this->mSubmissionQueuesMutex);
+    return !this->mSubmissionQueues.empty();
+}
+
+std::vector<MemoryPool::Allocation>
+Memory::ownedAllocations()
+{
+    std::vector<MemoryPool::Allocation> allocations;
+    if (this->mFreePrimaryMemory && this->mPrimaryMemory) {
+        allocations.push_back(this->mPrimaryAllocation);
+    }
+    if (this->mFreeStagingMemory && this->mStagingMemory) {
+        allocations.push_back(this->mStagingAllocation);
+    }
+    return allocations;
+}
+
+vk::MemoryPropertyFlags
+Memory::hostMemoryPropertyFlags()
+{
+    switch (this->mMemoryType) {
+        case MemoryTypes::eHost:
+        case MemoryTypes::eDeviceAndHost:
+            return this->mPrimaryMemoryPropertyFlags;
+        case MemoryTypes::eDevice:
+            return this->mStagingMemoryPropertyFlags;
+        default:
+            return vk::MemoryPropertyFlags();
+    }
+}
+
+void
+Memory::flushHostMemory()
+{
+    std::vector<HostRange> dirtyRanges;
+    dirtyRanges.swap(this->mDirtyHostRanges);
+
+    vk::MemoryPropertyFlags flags = this->hostMemoryPropertyFlags();
+    if (!this->mRawData ||
+        !(flags & vk::MemoryPropertyFlagBits::eHostVisible) ||
+        (flags & vk::MemoryPropertyFlagBits::eHostCoherent)) {
+        return;
+    }
+
+    if (!this->mTrackHostWrites) {
+        dirtyRanges = { { 0, this->memorySize() } };
+    }
+
+    std::vector<vk::MappedMemoryRange> mappedRanges;
+    for (const HostRange& range : dirtyRanges) {
+        vk::MappedMemoryRange mappedRange;
+        if (this->hostMemoryRange(
+              mappedRange, range.begin, range.end - range.begin)) {
+            mappedRanges.push_back(mappedRange);
+        }
+    }
+
+    if (mappedRanges.size()) {
+        KP_LOG_DEBUG("Kompute Memory flushing {} non-coherent host ranges",
+                     mappedRanges.size());
+        this->mDevice->flushMappedMemoryRanges(mappedRanges.size(),
+                                               mappedRanges.data());
+    }
+}
+
+void
+Memory::invalidateHostMemory()
+{
+    this->invalidateHostMemory(0, this->memorySize());
+}
+
+void
+Memory::invalidateHostMemory(uint64_t offset, uint64_t size)
+{
+    vk::MemoryPropertyFlags flags = this->hostMemoryPropertyFlags();
+    if (!(flags & vk::MemoryPropertyFlagBits::eHostVisible) ||
+        (flags & vk::MemoryPropertyFlagBits::eHostCoherent)) {
+        return;
+    }
+
+    if (!this->mRawData) {
+        this->mapRawData();
+    }
+
+    this->flushHostWritesOutside(offset, size);
+
+    vk::MappedMemoryRange mappedRange;
+    if (this->hostMemoryRange(mappedRange, offset, size)) {
+        KP_LOG_DEBUG("Kompute Memory invalidating non-coherent host memory");
+        this->mDevice->invalidateMappedMemoryRanges(1, &mappedRange);
+    }
+}
+
+void
+Memory::flushHostWritesOutside(uint64_t offset, uint64_t size)
+{
+    std::vector<HostRange> dirtyRanges;
+    dirtyRanges.swap(this->mDirtyHostRanges);
+
+    // Host writes made through the raw data pointer are not tracked, so only
+    // the ranges written with setData can be preserved
+    uint64_t end = offset + size;
+    std::vector<vk::MappedMemoryRange> mappedRanges;
+    for (const HostRange& range : dirtyRanges) {
+        HostRange outside[2] = { { range.begin, std::min(range.end, offset) },
+                                 { std::max(range.begin, end), range.end } };
+        for (const HostRange& part : outside) {
+            vk::MappedMemoryRange mappedRange;
+            if (part.begin < part.end &&
+                this->hostMemoryRange(
+                  mappedRange, part.begin, part.end - part.begin)) {
+                mappedRanges.push_back(mappedRange);
+            }
+        }
+    }
+
+    if (mappedRanges.size()) {
+        KP_LOG_DEBUG("Kompute Memory flushing {} non-coherent host ranges "
+                     "before invalidating",
+                     mappedRanges.size());
+        this->mDevice->flushMappedMemoryRanges(mappedRanges.size(),
+                                               mappedRanges.data());
+    }
+}
+
+bool
+Memory::hostMemoryRange(vk::MappedMemoryRange& mappedRange,
+                        vk::DeviceSize offset,
+                        vk::DeviceSize size)
+{
+    std::shared_ptr<vk::DeviceMemory> hostVisibleMemory = nullptr;
+    MemoryPool::Allocation* hostVisibleAllocation = nullptr;
+
+    if (this->mMemoryType == MemoryTypes::eHost ||
+        this->mMemoryType == MemoryTypes::eDeviceAndHost) {
+        hostVisibleMemory = this->mPrimaryMemory;
+        hostVisibleAllocation = &this->mPrimaryAllocation;
+    } else if (this->mMemoryType == MemoryTypes::eDevice) {
+        hostVisibleMemory = this->mStagingMemory;
+        hostVisibleAllocation = &this->mStagingAllocation;
+    }
+
+    if (!hostVisibleMemory) {
+        return false;
+    }
+
+    vk::DeviceSize atomSize =
+      this->mPhysicalDevice->getProperties().limits.nonCoherentAtomSize;
+    vk::DeviceSize begin = this->memoryOffset() + offset;
+    vk::DeviceSize end = begin + size;
+    begin -= begin % atomSize;
+    end = (end + atomSize - 1) / atomSize * atomSize;
+
+    // Pooled ranges start on a non-coherent atom boundary and span a whole
+    // number of atoms, whereas unpooled memory is mapped from offset zero
+    // and the range is extended to the end of the mapping when rounding it
+    // up would go past the data
+    mappedRange.memory = *hostVisibleMemory;
+    if (hostVisibleAllocation->memory) {
+        mappedRange.offset = hostVisibleAllocation->offset + begin;
+        mappedRange.size = std::min(end, hostVisibleAllocation->size) - begin;
+    } else if (end > this->memoryOffset() + this->memorySize()) {
+        mappedRange.offset = begin;
+        mappedRange.size = VK_WHOLE_SIZE;
+    } else {
+        mappedRange.offset = begin;
+        mappedRange.size = end - begin;
+    }
+    return true;
+}
+
+void
+Memory::markHostRangeDirty(uint64_t offset, uint64_t size)
+{
+    if (!this->mTrackHostWrites || !size) {
+        return;
+    }
+
+    // Keep the ranges sorted and merge the ones that touch
+    this->mDirtyHostRanges.push_back({ offset, offset + size });
+    std::sort(this->mDirtyHostRanges.begin(),
+              this->mDirtyHostRanges.end(),
+              [](const HostRange& a, const HostRange& b) {
+                  return a.begin < b.begin;
+              });
+
+    std::vector<HostRange> mergedRanges;
+    for (const HostRange& range : this->mDirtyHostRanges) {
+        if (mergedRanges.size() && range.begin <= mergedRanges.back().end) {
+            mergedRanges.back().end =
+              std::max(mergedRanges.back().end, range.end);
+        } else {
+            mergedRanges.push_back(range);
+        }
+    }
+    this->mDirtyHostRanges.swap(mergedRanges);
+}
+
+void
+Memory::stopTrackingHostWrites()
+{
+    this->mTrackHostWrites = false;
+    this->mDirtyHostRanges.clear();
+}
+
+uint64_t
 Memory::memorySize()
 {
-    return this->mSize * this->mDataTypeMemorySize;
+    return this->mSize * static_cast<uint64_t>(this->mDataTypeMemorySize);
 }
 
 void*
@@ -133,9 +425,29 @@ Memory::rawData()
     if (!this->mRawData) {
         this->mapRawData();
     }
+
+    // Writes through the pointer can't be tracked
+    this->stopTrackingHostWrites();
+
+    return this->mRawData;
+}
+
+const void*
+Memory::constRawData()
+{
+    if (!this->mRawData) {
+        this->mapRawData();
+    }
+
     return this->mRawData;
 }
 
+bool
+Memory::isTrackingHostWrites()
+{
+    return this->mTrackHostWrites;
+}
+
 void
 Memory::setData(const void* data, size_t size)
 {
@@ -148,6 +460,26 @@ Memory::setData(const void* data, size_t size)
         this->mapRawData();
     }
     memcpy(this->mRawData, data, this->memorySize());
+    this->markHostRangeDirty(0, this->memorySize());
+}
+
+void
+Memory::setData(const void* data, uint64_t offset, uint64_t size)
+{
+    if (offset + size > this->memorySize()) {
+        throw std::runtime_error(
+          fmt::format("Kompute Memory cannot set {} bytes at offset {} of "
+                      "memory of {} bytes",
+                      size,
+                      offset,
+                      this->memorySize()));
+    }
+
+    if (!this->mRawData) {
+        this->mapRawData();
+    }
+    memcpy((uint8_t*)this->mRawData + offset, data, size);
+    this->markHostRangeDirty(offset, size);
 }
 
 void
@@ -156,24 +488,45 @@ Memory::mapRawData()
     KP_LOG_DEBUG("Kompute Memory mapping data from host buffer");
 
     std::shared_ptr<vk::DeviceMemory> hostVisibleMemory = nullptr;
+    MemoryPool::Allocation* hostVisibleAllocation = nullptr;
 
     if (this->mMemoryType == MemoryTypes::eHost ||
         this->mMemoryType == MemoryTypes::eDeviceAndHost) {
         hostVisibleMemory = this->mPrimaryMemory;
+        hostVisibleAllocation = &this->mPrimaryAllocation;
     } else if (this->mMemoryType == MemoryTypes::eDevice) {
         hostVisibleMemory = this->mStagingMemory;
+        hostVisibleAllocation = &this->mStagingAllocation;
     } else {
         KP_LOG_WARN("Kompute Memory mapping data not supported on {} memory",
                     Memory::toString(this->memoryType()));
         return;
     }
 
-    vk::DeviceSize size = this->memorySize();
+    // Memory objects without staging memory transfer through a staging ring,
+    // so their host data only lives in host memory allocated on first access
+    if (!hostVisibleMemory) {
+        KP_LOG_DEBUG("Kompute Memory allocating host data of size {}",
+                     this->memorySize());
+        this->mHostData.resize(this->memorySize());
+        this->mRawData = this->mHostData.data();
+        this->mUnmapMemory = false;
+        return;
+    }
+
+    // Pooled memory is mapped once by the pool for the lifetime of the block
+    if (hostVisibleAllocation->memory) {
+        this->mRawData = hostVisibleAllocation->mappedData;
+        this->mUnmapMemory = false;
+        return;
+    }
 
-    // Given we request coherent host memory we don't need to invalidate /
-    // flush
+    // Coherent host memory doesn't need to be invalidated / flushed, the
+    // non-coherent fallback is handled by flushHostMemory and
+    // invalidateHostMemory. The whole allocation is mapped so tensors
+    // resized within their capacity keep a valid mapping
     this->mRawData = this->mDevice->mapMemory(
-      *hostVisibleMemory, 0, size, vk::MemoryMapFlags());
+      *hostVisibleMemory, 0, VK_WHOLE_SIZE, vk::MemoryMapFlags());
 
     this->mUnmapMemory = true;
 }
@@ -199,9 +552,8 @@ Memory::unmapRawData()
         return;
     }
 
-    vk::DeviceSize size = this->memorySize();
-    vk::MappedMemoryRange mappedRange(*hostVisibleMemory, 0, size);
-    this->mDevice->flushMappedMemoryRanges(1, &mappedRange);
+    // Host writes are flushed by flushHostMemory before the device reads
+    // them, so there is nothing left to flush once the memory is unmapped
     this->mDevice->unmapMemory(*hostVisibleMemory);
 
     this->mUnmapMemory = false;
@@ -211,48 +563,111 @@ void
 Memory::updateRawData(void* data)
 {
     if (this->memoryType() != Memory::MemoryTypes::eStorage &&
+        this->memoryType() != Memory::MemoryTypes::eTransient &&
         data != nullptr) {
         this->mapRawData();
         memcpy(this->mRawData, data, this->memorySize());
+        this->markHostRangeDirty(0, this->memorySize());
     }
 }
 
-vk::MemoryPropertyFlags
+std::vector<vk::MemoryPropertyFlags>
 Memory::getPrimaryMemoryPropertyFlags()
 {
     switch (this->mMemoryType) {
         case MemoryTypes::eDevice:
-            return vk::MemoryPropertyFlagBits::eDeviceLocal;
+            return { vk::MemoryPropertyFlagBits::eDeviceLocal };
             break;
         case MemoryTypes::eHost:
-            return vk::MemoryPropertyFlagBits::eHostVisible |
-                   vk::MemoryPropertyFlagBits::eHostCoherent;
+            // Non-coherent memory is flushed and invalidated by the syncs
+            return { vk::MemoryPropertyFlagBits::eHostVisible |
+                       vk::MemoryPropertyFlagBits::eHostCoherent,
+                     vk::MemoryPropertyFlagBits::eHostVisible };
             break;
         case MemoryTypes::eDeviceAndHost:
-            return vk::MemoryPropertyFlagBits::eDeviceLocal |
-                   vk::MemoryPropertyFlagBits::eHostVisible |
-                   vk::MemoryPropertyFlagBits::eHostCoherent;
+            // Fall back to host memory on devices without host visible device
+            // local memory
+            return { vk::MemoryPropertyFlagBits::eDeviceLocal |
+                       vk::MemoryPropertyFlagBits::eHostVisible |
+                       vk::MemoryPropertyFlagBits::eHostCoherent,
+                     vk::MemoryPropertyFlagBits::eHostVisible |
+                       vk::MemoryPropertyFlagBits::eHostCoherent,
+                     vk::MemoryPropertyFlagBits::eHostVisible };
         case MemoryTypes::eStorage:
-            return vk::MemoryPropertyFlagBits::eDeviceLocal;
+        case MemoryTypes::eTransient:
+            return { vk::MemoryPropertyFlagBits::eDeviceLocal };
             break;
         default:
             throw std::runtime_error("Kompute Memory invalid memory type");
     }
 }
 
-vk::MemoryPropertyFlags
+std::vector<vk::MemoryPropertyFlags>
 Memory::getStagingMemoryPropertyFlags()
 {
     switch (this->mMemoryType) {
         case MemoryTypes::eDevice:
-            return vk::MemoryPropertyFlagBits::eHostVisible |
-                   vk::MemoryPropertyFlagBits::eHostCoherent;
+            if (this->mStagingPolicy == StagingPolicy::eReadback) {
+                return { vk::MemoryPropertyFlagBits::eHostVisible |
+                           vk::MemoryPropertyFlagBits::eHostCoherent |
+                           vk::MemoryPropertyFlagBits::eHostCached,
+                         vk::MemoryPropertyFlagBits::eHostVisible |
+                           vk::MemoryPropertyFlagBits::eHostCached,
+                         vk::MemoryPropertyFlagBits::eHostVisible |
+                           vk::MemoryPropertyFlagBits::eHostCoherent };
+            }
+            return { vk::MemoryPropertyFlagBits::eHostVisible |
+                       vk::MemoryPropertyFlagBits::eHostCoherent,
+                     vk::MemoryPropertyFlagBits::eHostVisible };
             break;
         default:
             throw std::runtime_error("Kompute Memory invalid memory type");
     }
 }
 
+uint32_t
+Memory::findMemoryTypeIndex(
+  uint32_t memoryTypeBits,
+  const std::vector<vk::MemoryPropertyFlags>& memoryPropertyFlags)
+{
+    vk::PhysicalDeviceMemoryProperties memoryProperties =
+      this->mPhysicalDevice->getMemoryProperties();
+
+    for (const vk::MemoryPropertyFlags& flags : memoryPropertyFlags) {
+        // Prefer memory types that are not host cached unless requested, as
+        // uncached host memory is write-combined and faster to upload from
+        for (bool allowUnrequestedCached : { false, true }) {
+            for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+                if (!(memoryTypeBits & (1 << i))) {
+                    continue;
+                }
+                vk::MemoryPropertyFlags typeFlags =
+                  memoryProperties.memoryTypes[i].propertyFlags;
+                if ((typeFlags & flags) != flags) {
+                    continue;
+                }
+                if (!allowUnrequestedCached &&
+                    !(flags & vk::MemoryPropertyFlagBits::eHostCached) &&
+                    (typeFlags & vk::MemoryPropertyFlagBits::eHostCached)) {
+                    continue;
+                }
+
+                if (flags != memoryPropertyFlags.front()) {
+                    KP_LOG_DEBUG("Kompute Memory memory type with flags {} not "
+                                 "found, falling back to {}",
+                                 vk::to_string(memoryPropertyFlags.front()),
+                                 vk::to_string(flags));
+                }
+                return i;
+            }
+        }
+    }
+
+    throw std::runtime_error(
+      "Kompute Memory memory type index with flags " +
+      vk::to_string(memoryPropertyFlags.front()) + " not found");
+}
+
 void
 Memory::recordCopyFrom(const vk::CommandBuffer& commandBuffer,
                        std::shared_ptr<Memory> copyFromMemory)
@@ -282,17 +697,36 @@ Memory::recordCopyFrom(const vk::CommandBuffer& commandBuffer,
     }
 }
 
+void
+Memory::freeMemory(std::shared_ptr<vk::DeviceMemory>& memory,
+                   MemoryPool::Allocation& allocation)
+{
+    if (allocation.memory) {
+        // Pooled ranges are handed back to the pool instead of being freed
+        this->mMemoryPool->free(allocation);
+    } else {
+        this->mDevice->freeMemory(
+          *memory, (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    }
+    allocation = MemoryPool::Allocation();
+    memory = nullptr;
+}
+
 void
 Memory::destroy(void)
 {
     // Setting raw data to null regardless whether device is available to
     // invalidate Memory
     this->mRawData = nullptr;
+    this->mHostData.clear();
+    this->mHostData.shrink_to_fit();
+    this->mDirtyHostRanges.clear();
     this->mSize = 0;
     this->mDataTypeMemorySize = 0;
 
     // Unmap the current memory data
-    if (this->memoryType() != Memory::MemoryTypes::eStorage) {
+    if (this->memoryType() != Memory::MemoryTypes::eStorage &&
+        this->memoryType() != Memory::MemoryTypes::eTransient) {
         this->unmapRawData();
     }
 
@@ -302,10 +736,7 @@ Memory::destroy(void)
                         "got null memory");
         } else {
             KP_LOG_DEBUG("Kompose Memory freeing primary memory");
-            this->mDevice->freeMemory(
-              *this->mPrimaryMemory,
-              (vk::Optional<const vk::AllocationCallbacks>)nullptr);
-            this->mPrimaryMemory = nullptr;
+            this->freeMemory(this->mPrimaryMemory, this->mPrimaryAllocation);
             this->mFreePrimaryMemory = false;
         }
     }
@@ -316,10 +747,7 @@ Memory::destroy(void)
                         "got null memory");
         } else {
             KP_LOG_DEBUG("Kompose Memory freeing staging memory");
-            this->mDevice->freeMemory(
-              *this->mStagingMemory,
-              (vk::Optional<const vk::AllocationCallbacks>)nullptr);
-            this->mStagingMemory = nullptr;
+            this->freeMemory(this->mStagingMemory, this->mStagingAllocation);
             this->mFreeStagingMemory = false;
         }
     }
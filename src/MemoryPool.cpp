@@ -0,0 +1,381 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "kompute/MemoryPool.hpp"
+#include <algorithm>
+
+namespace kp {
+
+struct MemoryPool::Block
+{
+    std::shared_ptr<vk::DeviceMemory> memory;
+    vk::DeviceSize size = 0;
+    vk::DeviceSize used = 0;
+    void* mappedData = nullptr;
+    uint32_t liveCount = 0;
+    bool dedicated = false;
+};
+
+constexpr vk::DeviceSize MemoryPool::MIN_CLASS_SIZE;
+
+MemoryPool::MemoryPool(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                       std::shared_ptr<vk::Device> device,
+                       vk::DeviceSize blockSize)
+{
+    KP_LOG_DEBUG("Kompute MemoryPool constructor with block size {}",
+                 blockSize);
+
+    if (blockSize < MIN_CLASS_SIZE * 8) {
+        throw std::runtime_error(
+          "Kompute MemoryPool block size must be at least 8 times the "
+          "minimum size class");
+    }
+
+    this->mPhysicalDevice = physicalDevice;
+    this->mDevice = device;
+    this->mBlockSize = blockSize;
+    this->mMemoryProperties = this->mPhysicalDevice->getMemoryProperties();
+    this->mNonCoherentAtomSize =
+      this->mPhysicalDevice->getProperties().limits.nonCoherentAtomSize;
+}
+
+MemoryPool::~MemoryPool()
+{
+    KP_LOG_DEBUG("Kompute MemoryPool destructor started");
+
+    if (this->mDevice) {
+        this->destroy();
+    }
+}
+
+MemoryPool::Allocation
+MemoryPool::allocate(const vk::MemoryRequirements& memoryRequirements,
+                     uint32_t memoryTypeIndex,
+                     bool linear)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        throw std::runtime_error("Kompute MemoryPool device is null");
+    }
+
+    vk::DeviceSize alignment = std::max<vk::DeviceSize>(
+      memoryRequirements.alignment, 1);
+    // Keep host visible ranges on atom boundaries so they can be flushed and
+    // invalidated independently of their neighbours
+    if (this->isHostVisible(memoryTypeIndex)) {
+        alignment = std::max(alignment, this->mNonCoherentAtomSize);
+    }
+
+    Allocation allocation;
+    allocation.memoryTypeIndex = memoryTypeIndex;
+    allocation.linear = linear;
+    allocation.sizeClass = this->sizeClass(memoryRequirements.size);
+
+    Bucket& bucket = this->mBuckets[{ memoryTypeIndex, linear }];
+    this->mStats.totalAllocations++;
+
+    if (allocation.sizeClass < 0 || alignment > this->mBlockSize / 8) {
+        KP_LOG_DEBUG("Kompute MemoryPool dedicated allocation of size {}",
+                     memoryRequirements.size);
+
+        std::unique_ptr<Block> block(new Block());
+        block->size = memoryRequirements.size;
+        block->used = memoryRequirements.size;
+        block->liveCount = 1;
+        block->dedicated = true;
+        block->memory = this->allocateDeviceMemory(
+          block->size, memoryTypeIndex, &block->mappedData);
+
+        allocation.sizeClass = -1;
+        allocation.memory = block->memory;
+        allocation.offset = 0;
+        allocation.size = block->size;
+        allocation.mappedData = block->mappedData;
+        allocation.block = block.get();
+
+        this->mStats.dedicatedCount++;
+        this->mStats.dedicatedBytes += block->size;
+        bucket.blocks.push_back(std::move(block));
+        return allocation;
+    }
+
+    vk::DeviceSize size = this->classSize(allocation.sizeClass);
+    allocation.size = size;
+
+    if (bucket.freeChunks.size() <= (size_t)allocation.sizeClass) {
+        bucket.freeChunks.resize(allocation.sizeClass + 1);
+    }
+    std::vector<Chunk>& freeChunks = bucket.freeChunks[allocation.sizeClass];
+
+    // Reuse a previously released range of the same size class
+    for (size_t i = freeChunks.size(); i > 0; i--) {
+        Chunk chunk = freeChunks[i - 1];
+        if (chunk.offset % alignment == 0) {
+            freeChunks[i - 1] = freeChunks.back();
+            freeChunks.pop_back();
+
+            chunk.block->liveCount++;
+            allocation.block = chunk.block;
+            allocation.memory = chunk.block->memory;
+            allocation.offset = chunk.offset;
+
+            this->mStats.reusedAllocations++;
+            break;
+        }
+    }
+
+    // Otherwise carve a new range from a block with enough space left
+    if (!allocation.block) {
+        Block* target = nullptr;
+        vk::DeviceSize offset = 0;
+        for (const std::unique_ptr<Block>& block : bucket.blocks) {
+            if (block->dedicated) {
+                continue;
+            }
+            offset = (block->used + alignment - 1) / alignment * alignment;
+            if (offset + size <= block->size) {
+                target = block.get();
+                break;
+            }
+        }
+
+        if (!target) {
+            KP_LOG_DEBUG("Kompute MemoryPool creating block for memory type "
+                         "index {}",
+                         memoryTypeIndex);
+
+            std::unique_ptr<Block> block(new Block());
+            block->size = this->mBlockSize;
+            block->memory = this->allocateDeviceMemory(
+              block->size, memoryTypeIndex, &block->mappedData);
+            target = block.get();
+            offset = 0;
+
+            this->mStats.blockCount++;
+            this->mStats.blockBytes += block->size;
+            bucket.blocks.push_back(std::move(block));
+        }
+
+        target->used = offset + size;
+        target->liveCount++;
+        allocation.block = target;
+        allocation.memory = target->memory;
+        allocation.offset = offset;
+    }
+
+    if (allocation.block->mappedData) {
+        allocation.mappedData =
+          (uint8_t*)allocation.block->mappedData + allocation.offset;
+    }
+
+    this->mStats.allocationCount++;
+    this->mStats.allocatedBytes += size;
+
+    return allocation;
+}
+
+void
+MemoryPool::free(const Allocation& allocation)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        KP_LOG_WARN("Kompute MemoryPool free called after pool was destroyed");
+        return;
+    }
+
+    if (!allocation.block) {
+        KP_LOG_WARN("Kompute MemoryPool free called with empty allocation");
+        return;
+    }
+
+    auto bucketIt =
+      this->mBuckets.find({ allocation.memoryTypeIndex, allocation.linear });
+    if (bucketIt == this->mBuckets.end()) {
+        KP_LOG_WARN("Kompute MemoryPool free called with unknown allocation");
+        return;
+    }
+    Bucket& bucket = bucketIt->second;
+
+    this->mStats.totalFrees++;
+
+    if (allocation.sizeClass < 0) {
+        for (auto it = bucket.blocks.begin(); it != bucket.blocks.end(); ++it) {
+            if (it->get() == allocation.block) {
+                this->freeDeviceMemory((*it)->memory, (*it)->mappedData);
+                this->mStats.dedicatedCount--;
+                this->mStats.dedicatedBytes -= (*it)->size;
+                bucket.blocks.erase(it);
+                return;
+            }
+        }
+        KP_LOG_WARN("Kompute MemoryPool dedicated allocation not found");
+        return;
+    }
+
+    allocation.block->liveCount--;
+    bucket.freeChunks[allocation.sizeClass].push_back(
+      { allocation.block, allocation.offset });
+
+    this->mStats.allocationCount--;
+    this->mStats.allocatedBytes -= allocation.size;
+}
+
+void
+MemoryPool::trim()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        return;
+    }
+
+    for (auto& bucketPair : this->mBuckets) {
+        Bucket& bucket = bucketPair.second;
+
+        for (size_t i = bucket.blocks.size(); i > 0; i--) {
+            Block* block = bucket.blocks[i - 1].get();
+            if (block->liveCount > 0 || block->dedicated) {
+                continue;
+            }
+
+            KP_LOG_DEBUG("Kompute MemoryPool releasing unused block");
+
+            for (std::vector<Chunk>& freeChunks : bucket.freeChunks) {
+                freeChunks.erase(std::remove_if(freeChunks.begin(),
+                                                freeChunks.end(),
+                                                [block](const Chunk& c) {
+                                                    return c.block == block;
+                                                }),
+                                 freeChunks.end());
+            }
+
+            this->freeDeviceMemory(block->memory, block->mappedData);
+            this->mStats.blockCount--;
+            this->mStats.blockBytes -= block->size;
+            bucket.blocks.erase(bucket.blocks.begin() + (i - 1));
+        }
+    }
+}
+
+MemoryPool::Stats
+MemoryPool::stats()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    return this->mStats;
+}
+
+vk::DeviceSize
+MemoryPool::blockSize() const
+{
+    return this->mBlockSize;
+}
+
+bool
+MemoryPool::isInit() const
+{
+    return this->mDevice != nullptr;
+}
+
+void
+MemoryPool::destroy()
+{
+    KP_LOG_DEBUG("Kompute MemoryPool destroy started");
+
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        KP_LOG_WARN("Kompute MemoryPool destroy called with null Device");
+        return;
+    }
+
+    if (this->mStats.allocationCount || this->mStats.dedicatedCount) {
+        KP_LOG_WARN("Kompute MemoryPool destroyed with {} live allocations",
+                    this->mStats.allocationCount +
+                      this->mStats.dedicatedCount);
+    }
+
+    for (auto& bucketPair : this->mBuckets) {
+        for (const std::unique_ptr<Block>& block : bucketPair.second.blocks) {
+            this->freeDeviceMemory(block->memory, block->mappedData);
+        }
+    }
+    this->mBuckets.clear();
+    this->mStats = Stats();
+
+    this->mDevice = nullptr;
+    this->mPhysicalDevice = nullptr;
+}
+
+int32_t
+MemoryPool::sizeClass(vk::DeviceSize size) const
+{
+    int32_t sizeClass = 0;
+    vk::DeviceSize classSize = MIN_CLASS_SIZE;
+    while (classSize < size) {
+        classSize <<= 1;
+        sizeClass++;
+    }
+    if (classSize > this->mBlockSize / 8) {
+        return -1;
+    }
+    return sizeClass;
+}
+
+vk::DeviceSize
+MemoryPool::classSize(int32_t sizeClass) const
+{
+    return MIN_CLASS_SIZE << sizeClass;
+}
+
+bool
+MemoryPool::isHostVisible(uint32_t memoryTypeIndex) const
+{
+    return (bool)(this->mMemoryProperties.memoryTypes[memoryTypeIndex]
+                    .propertyFlags &
+                  vk::MemoryPropertyFlagBits::eHostVisible);
+}
+
+std::shared_ptr<vk::DeviceMemory>
+MemoryPool::allocateDeviceMemory(vk::DeviceSize size,
+                                 uint32_t memoryTypeIndex,
+                                 void** mappedData)
+{
+    KP_LOG_DEBUG("Kompute MemoryPool allocating memory index: {}, size {}",
+                 memoryTypeIndex,
+                 size);
+
+    vk::MemoryAllocateInfo memoryAllocateInfo(size, memoryTypeIndex);
+    std::shared_ptr<vk::DeviceMemory> memory =
+      std::make_shared<vk::DeviceMemory>();
+
+    vk::Result result =
+      this->mDevice->allocateMemory(&memoryAllocateInfo, nullptr, memory.get());
+    if (result != vk::Result::eSuccess) {
+        throw std::runtime_error("Kompute MemoryPool failed to allocate "
+                                 "device memory: " +
+                                 vk::to_string(result));
+    }
+    this->mStats.deviceAllocateCalls++;
+
+    *mappedData = nullptr;
+    if (this->isHostVisible(memoryTypeIndex)) {
+        *mappedData = this->mDevice->mapMemory(
+          *memory, 0, VK_WHOLE_SIZE, vk::MemoryMapFlags());
+    }
+
+    return memory;
+}
+
+void
+MemoryPool::freeDeviceMemory(std::shared_ptr<vk::DeviceMemory> memory,
+                             void* mappedData)
+{
+    if (mappedData) {
+        this->mDevice->unmapMemory(*memory);
+    }
+    this->mDevice->freeMemory(
+      *memory, (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+}
+
+}
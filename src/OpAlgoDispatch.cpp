@@ -19,12 +19,18 @@ OpAlgoDispatch::record(const vk::CommandBuffer& commandBuffer)
 {
     KP_LOG_DEBUG("Kompute OpAlgoDispatch record called");
 
-    // Barrier to ensure the data is finished writing to buffer memory
+    this->recordBind(commandBuffer);
+    this->mAlgorithm->recordDispatch(commandBuffer);
+}
+
+void
+OpAlgoDispatch::recordBind(const vk::CommandBuffer& commandBuffer)
+{
+    // Barriers for tensors are recorded by the sequence from the declared
+    // accesses, while images need their layout set to eGeneral before using
+    // them for imageLoad/imageStore in a shader.
     for (const std::shared_ptr<Memory>& mem :
          this->mAlgorithm->getMemObjects()) {
-
-        // For images the image layout needs to be set to eGeneral before using
-        // it for imageLoad/imageStore in a shader.
         if (mem->type() == Memory::Type::eImage) {
             std::shared_ptr<Image> image = std::static_pointer_cast<Image>(mem);
 
@@ -35,26 +41,27 @@ OpAlgoDispatch::record(const vk::CommandBuffer& commandBuffer)
               vk::PipelineStageFlagBits::eTransfer,
               vk::PipelineStageFlagBits::eComputeShader,
               vk::ImageLayout::eGeneral);
-        } else {
-            mem->recordPrimaryMemoryBarrier(
-              commandBuffer,
-              vk::AccessFlagBits::eTransferWrite,
-              vk::AccessFlagBits::eShaderRead,
-              vk::PipelineStageFlagBits::eTransfer,
-              vk::PipelineStageFlagBits::eComputeShader);
         }
     }
 
+    this->mAlgorithm->recordBindCore(commandBuffer);
+
+    // The push constants of the operation are recorded directly, as other
+    // threads may be recording dispatches of the algorithm, and are also
+    // kept as the constants of the algorithm for the following dispatches
     if (this->mPushConstantsSize) {
         this->mAlgorithm->setPushConstants(
           this->mPushConstantsData,
           this->mPushConstantsSize,
           this->mPushConstantsDataTypeMemorySize);
+        this->mAlgorithm->recordBindPush(
+          commandBuffer,
+          this->mPushConstantsData,
+          this->mPushConstantsSize,
+          this->mPushConstantsDataTypeMemorySize);
+    } else {
+        this->mAlgorithm->recordBindPush(commandBuffer);
     }
-
-    this->mAlgorithm->recordBindCore(commandBuffer);
-    this->mAlgorithm->recordBindPush(commandBuffer);
-    this->mAlgorithm->recordDispatch(commandBuffer);
 }
 
 void
@@ -69,4 +76,44 @@ OpAlgoDispatch::postEval(const vk::CommandBuffer& /*commandBuffer*/)
     KP_LOG_DEBUG("Kompute OpAlgoDispatch postSubmit called");
 }
 
+std::vector<std::shared_ptr<Memory>>
+OpAlgoDispatch::getMemObjects()
+{
+    return this->mAlgorithm->getMemObjects();
+}
+
+std::vector<OpBase::MemoryAccess>
+OpAlgoDispatch::getMemoryAccesses()
+{
+    // Tensors bound to readonly buffers are only read by the shader, which
+    // doesn't require barriers against other reads
+    std::vector<MemoryAccess> accesses;
+    const std::vector<std::shared_ptr<Memory>>& memObjects =
+      this->mAlgorithm->getMemObjects();
+    for (uint32_t i = 0; i < memObjects.size(); i++) {
+        if (memObjects[i]->type() != Memory::Type::eTensor) {
+            continue;
+        }
+        bool readOnly = this->mAlgorithm->isReadOnly(i);
+        accesses.push_back(
+          { memObjects[i],
+            readOnly ? vk::AccessFlags(vk::AccessFlagBits::eShaderRead)
+                     : vk::AccessFlagBits::eShaderRead |
+                         vk::AccessFlagBits::eShaderWrite,
+            vk::PipelineStageFlagBits::eComputeShader,
+            !readOnly });
+    }
+    return accesses;
+}
+
+std::string
+OpAlgoDispatch::name() const
+{
+    std::string algorithmName = this->mAlgorithm->getName();
+    if (algorithmName.empty()) {
+        return "OpAlgoDispatch";
+    }
+    return "OpAlgoDispatch(" + algorithmName + ")";
+}
+
 }
@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "kompute/operations/OpAlgoDispatchIndirect.hpp"
+
+namespace kp {
+
+OpAlgoDispatchIndirect::~OpAlgoDispatchIndirect()
+{
+    KP_LOG_DEBUG("Kompute OpAlgoDispatchIndirect destructor started");
+}
+
+void
+OpAlgoDispatchIndirect::record(const vk::CommandBuffer& commandBuffer)
+{
+    KP_LOG_DEBUG("Kompute OpAlgoDispatchIndirect record called");
+
+    // The offset is relative to the tensor, which may be a view into the
+    // buffer of another tensor
+    this->recordBind(commandBuffer);
+    commandBuffer.dispatchIndirect(*this->mIndirectTensor->getPrimaryBuffer(),
+                                   this->mIndirectTensor->memoryOffset() +
+                                     this->mOffset);
+}
+
+std::vector<std::shared_ptr<Memory>>
+OpAlgoDispatchIndirect::getMemObjects()
+{
+    std::vector<std::shared_ptr<Memory>> memObjects =
+      OpAlgoDispatch::getMemObjects();
+    memObjects.push_back(this->mIndirectTensor);
+    return memObjects;
+}
+
+std::vector<OpBase::MemoryAccess>
+OpAlgoDispatchIndirect::getMemoryAccesses()
+{
+    // The workgroup counts are read by the dispatch itself rather than by the
+    // shader, in the draw indirect stage which also covers dispatches
+    std::vector<MemoryAccess> accesses = OpAlgoDispatch::getMemoryAccesses();
+    accesses.push_back({ this->mIndirectTensor,
+                         vk::AccessFlagBits::eIndirectCommandRead,
+                         vk::PipelineStageFlagBits::eDrawIndirect,
+                         false });
+    return accesses;
+}
+
+std::string
+OpAlgoDispatchIndirect::name() const
+{
+    std::string algorithmName = this->mAlgorithm->getName();
+    if (algorithmName.empty()) {
+        return "OpAlgoDispatchIndirect";
+    }
+    return "OpAlgoDispatchIndirect(" + algorithmName + ")";
+}
+
+}
@@ -48,7 +48,9 @@ OpCopy::postEval(const vk::CommandBuffer& /*commandBuffer*/)
 
     // Do not copy on CPU side if source is storage memory
     if (this->mMemObjects[0]->memoryType() ==
-        kp::Memory::MemoryTypes::eStorage) {
+          kp::Memory::MemoryTypes::eStorage ||
+        this->mMemObjects[0]->memoryType() ==
+          kp::Memory::MemoryTypes::eTransient) {
         KP_LOG_DEBUG("Kompute OpCopy not copying tensor source given "
                      "it's of eStorage type");
         return;
@@ -57,14 +59,52 @@ OpCopy::postEval(const vk::CommandBuffer& /*commandBuffer*/)
     // Copy the data from the first memory object into all the memory objects
     for (size_t i = 1; i < this->mMemObjects.size(); i++) {
         if (this->mMemObjects[i]->memoryType() ==
-            kp::Memory::MemoryTypes::eStorage) {
+              kp::Memory::MemoryTypes::eStorage ||
+            this->mMemObjects[i]->memoryType() ==
+              kp::Memory::MemoryTypes::eTransient) {
             KP_LOG_DEBUG("Kompute OpCopy not copying to tensor dest "
                          "given it's of eStorage type");
             continue;
         }
-        this->mMemObjects[i]->setData(this->mMemObjects[0]->rawData(),
+        // The source is only read, so its partial writes are still tracked
+        this->mMemObjects[i]->setData(this->mMemObjects[0]->constRawData(),
                                       this->mMemObjects[0]->memorySize());
     }
 }
 
+std::vector<std::shared_ptr<Memory>>
+OpCopy::getMemObjects()
+{
+    return this->mMemObjects;
+}
+
+std::vector<OpBase::MemoryAccess>
+OpCopy::getMemoryAccesses()
+{
+    std::vector<MemoryAccess> accesses;
+    for (size_t i = 0; i < this->mMemObjects.size(); i++) {
+        if (this->mMemObjects[i]->type() != Memory::Type::eTensor) {
+            continue;
+        }
+        if (i == 0) {
+            accesses.push_back({ this->mMemObjects[i],
+                                 vk::AccessFlagBits::eTransferRead,
+                                 vk::PipelineStageFlagBits::eTransfer,
+                                 false });
+        } else {
+            accesses.push_back({ this->mMemObjects[i],
+                                 vk::AccessFlagBits::eTransferWrite,
+                                 vk::PipelineStageFlagBits::eTransfer,
+                                 true });
+        }
+    }
+    return accesses;
+}
+
+std::string
+OpCopy::name() const
+{
+    return "OpCopy";
+}
+
 }
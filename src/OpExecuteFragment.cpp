@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "kompute/operations/OpExecuteFragment.hpp"
+
+namespace kp {
+
+OpExecuteFragment::OpExecuteFragment(
+  std::shared_ptr<SequenceFragment> fragment)
+{
+    KP_LOG_DEBUG("Kompute OpExecuteFragment constructor");
+
+    if (!fragment) {
+        throw std::runtime_error(
+          "Kompute OpExecuteFragment called with null fragment");
+    }
+
+    this->mFragment = fragment;
+}
+
+OpExecuteFragment::~OpExecuteFragment()
+{
+    KP_LOG_DEBUG("Kompute OpExecuteFragment destructor started");
+}
+
+void
+OpExecuteFragment::record(const vk::CommandBuffer& commandBuffer)
+{
+    KP_LOG_DEBUG("Kompute OpExecuteFragment record called");
+
+    this->mFragmentBuffer = this->mFragment->getCommandBuffer();
+
+    commandBuffer.executeCommands(1, this->mFragmentBuffer.get());
+}
+
+void
+OpExecuteFragment::preEval(const vk::CommandBuffer& commandBuffer)
+{
+    KP_LOG_DEBUG("Kompute OpExecuteFragment preEval called");
+
+    this->mFragment->preEval(commandBuffer);
+}
+
+void
+OpExecuteFragment::postEval(const vk::CommandBuffer& commandBuffer)
+{
+    KP_LOG_DEBUG("Kompute OpExecuteFragment postEval called");
+
+    this->mFragment->postEval(commandBuffer);
+}
+
+std::vector<std::shared_ptr<Memory>>
+OpExecuteFragment::getMemObjects()
+{
+    return this->mFragment->getMemObjects();
+}
+
+std::vector<OpBase::MemoryAccess>
+OpExecuteFragment::getMemoryAccesses()
+{
+    return this->mFragment->getMemoryAccesses();
+}
+
+std::string
+OpExecuteFragment::name() const
+{
+    return "OpExecuteFragment";
+}
+
+}
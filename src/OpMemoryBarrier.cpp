@@ -63,4 +63,16 @@ OpMemoryBarrier::postEval(const vk::CommandBuffer& /*commandBuffer*/)
     KP_LOG_DEBUG("Kompute OpMemoryBarrier postSubmit called");
 }
 
+std::vector<std::shared_ptr<Memory>>
+OpMemoryBarrier::getMemObjects()
+{
+    return this->mMemObjects;
+}
+
+std::string
+OpMemoryBarrier::name() const
+{
+    return "OpMemoryBarrier";
+}
+
 }
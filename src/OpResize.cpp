@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "kompute/Tensor.hpp"
+
+#include "kompute/operations/OpResize.hpp"
+
+namespace kp {
+
+OpResize::OpResize(const std::vector<std::shared_ptr<Memory>>& memObjects,
+                   uint64_t elementTotalCount)
+{
+    KP_LOG_DEBUG("Kompute OpResize constructor with params");
+
+    if (memObjects.size() < 1) {
+        throw std::runtime_error(
+          "Kompute OpResize called with less than 1 memory object");
+    }
+
+    for (const std::shared_ptr<Memory>& memory : memObjects) {
+        if (memory->type() != Memory::Type::eTensor) {
+            throw std::runtime_error(
+              "Kompute OpResize can only resize tensors");
+        }
+    }
+
+    this->mMemObjects = memObjects;
+    this->mElementTotalCount = elementTotalCount;
+    this->mResizes.resize(memObjects.size());
+}
+
+OpResize::~OpResize()
+{
+    KP_LOG_DEBUG("Kompute OpResize destructor started");
+}
+
+void
+OpResize::record(const vk::CommandBuffer& commandBuffer)
+{
+    KP_LOG_DEBUG("Kompute OpResize record called");
+
+    for (size_t i = 0; i < this->mMemObjects.size(); i++) {
+        std::shared_ptr<Tensor> tensor =
+          std::static_pointer_cast<Tensor>(this->mMemObjects[i]);
+
+        // Command buffers recorded again before the resize has executed,
+        // such as the other ones of a multi-buffered sequence, repeat its
+        // copy instead of resizing the tensor again
+        if (this->mResizes[i] &&
+            tensor->repeatResize(commandBuffer, this->mResizes[i])) {
+            continue;
+        }
+        this->mResizes[i] =
+          tensor->recordResize(commandBuffer, this->mElementTotalCount);
+    }
+}
+
+void
+OpResize::preEval(const vk::CommandBuffer& /*commandBuffer*/)
+{
+    KP_LOG_DEBUG("Kompute OpResize preEval called");
+}
+
+void
+OpResize::postEval(const vk::CommandBuffer& /*commandBuffer*/)
+{
+    KP_LOG_DEBUG("Kompute OpResize postEval called");
+
+    // Submissions still in flight may copy from the previous buffers, in
+    // which case they are freed by a later evaluation once none is left, or
+    // when the tensor is destroyed
+    for (size_t i = 0; i < this->mMemObjects.size(); i++) {
+        if (!this->mMemObjects[i]->isUsedBySubmission()) {
+            std::static_pointer_cast<Tensor>(this->mMemObjects[i])
+              ->finishResize();
+        }
+    }
+}
+
+std::vector<std::shared_ptr<Memory>>
+OpResize::getMemObjects()
+{
+    return this->mMemObjects;
+}
+
+std::string
+OpResize::name() const
+{
+    return "OpResize";
+}
+
+}
@@ -32,7 +32,19 @@ OpSyncDevice::record(const vk::CommandBuffer& commandBuffer)
     for (size_t i = 0; i < this->mMemObjects.size(); i++) {
         if (this->mMemObjects[i]->memoryType() ==
             Tensor::MemoryTypes::eDevice) {
-            this->mMemObjects[i]->recordCopyFromStagingToDevice(commandBuffer);
+            if (this->usesStagingRing(this->mMemObjects[i])) {
+                // The data is transferred through the staging ring before the
+                // submission, so only its writes have to be made visible
+                this->mMemObjects[i]->recordPrimaryMemoryBarrier(
+                  commandBuffer,
+                  vk::AccessFlagBits::eTransferWrite,
+                  vk::AccessFlagBits::eShaderRead,
+                  vk::PipelineStageFlagBits::eTransfer,
+                  vk::PipelineStageFlagBits::eComputeShader);
+            } else {
+                this->mMemObjects[i]->recordCopyFromStagingToDevice(
+                  commandBuffer);
+            }
         }
     }
 }
@@ -41,6 +53,23 @@ void
 OpSyncDevice::preEval(const vk::CommandBuffer& /*commandBuffer*/)
 {
     KP_LOG_DEBUG("Kompute OpSyncDevice preEval called");
+
+    // Make host writes to non-coherent staging memory visible to the copy
+    for (size_t i = 0; i < this->mMemObjects.size(); i++) {
+        if (this->usesStagingRing(this->mMemObjects[i])) {
+            std::static_pointer_cast<Tensor>(this->mMemObjects[i])
+              ->uploadThroughStagingRing();
+        } else {
+            this->mMemObjects[i]->flushHostMemory();
+        }
+    }
+}
+
+bool
+OpSyncDevice::usesStagingRing(const std::shared_ptr<Memory>& memory)
+{
+    return memory->type() == Memory::Type::eTensor &&
+           std::static_pointer_cast<Tensor>(memory)->usesStagingRing();
 }
 
 void
@@ -49,4 +78,33 @@ OpSyncDevice::postEval(const vk::CommandBuffer& /*commandBuffer*/)
     KP_LOG_DEBUG("Kompute OpSyncDevice postEval called");
 }
 
+std::vector<std::shared_ptr<Memory>>
+OpSyncDevice::getMemObjects()
+{
+    return this->mMemObjects;
+}
+
+std::vector<OpBase::MemoryAccess>
+OpSyncDevice::getMemoryAccesses()
+{
+    std::vector<MemoryAccess> accesses;
+    for (const std::shared_ptr<Memory>& mem : this->mMemObjects) {
+        if (mem->type() == Memory::Type::eTensor &&
+            mem->memoryType() == Memory::MemoryTypes::eDevice &&
+            !this->usesStagingRing(mem)) {
+            accesses.push_back({ mem,
+                                 vk::AccessFlagBits::eTransferWrite,
+                                 vk::PipelineStageFlagBits::eTransfer,
+                                 true });
+        }
+    }
+    return accesses;
+}
+
+std::string
+OpSyncDevice::name() const
+{
+    return "OpSyncDevice";
+}
+
 }
@@ -32,12 +32,22 @@ OpSyncLocal::record(const vk::CommandBuffer& commandBuffer)
         if (this->mMemObjects[i]->memoryType() ==
             Memory::MemoryTypes::eDevice) {
 
-            this->mMemObjects[i]->recordPrimaryMemoryBarrier(
-              commandBuffer,
-              vk::AccessFlagBits::eShaderWrite,
-              vk::AccessFlagBits::eTransferRead,
-              vk::PipelineStageFlagBits::eComputeShader,
-              vk::PipelineStageFlagBits::eTransfer);
+            // The previous writes to tensors are made visible to the
+            // transfer by the barrier planned for the declared accesses
+            if (this->mMemObjects[i]->type() != Memory::Type::eTensor) {
+                this->mMemObjects[i]->recordPrimaryMemoryBarrier(
+                  commandBuffer,
+                  vk::AccessFlagBits::eShaderWrite,
+                  vk::AccessFlagBits::eTransferRead,
+                  vk::PipelineStageFlagBits::eComputeShader,
+                  vk::PipelineStageFlagBits::eTransfer);
+            }
+
+            // The data is transferred through the staging ring once the
+            // submission has completed
+            if (this->usesStagingRing(this->mMemObjects[i])) {
+                continue;
+            }
 
             this->mMemObjects[i]->recordCopyFromDeviceToStaging(commandBuffer);
 
@@ -63,6 +73,61 @@ OpSyncLocal::postEval(const vk::CommandBuffer& /*commandBuffer*/)
     KP_LOG_DEBUG("Kompute OpSyncLocal postEval called");
 
     KP_LOG_DEBUG("Kompute OpSyncLocal mapping data into tensor local");
+
+    // Host cached staging memory may not be coherent, in which case the
+    // device writes have to be invalidated before the host reads them
+    for (size_t i = 0; i < this->mMemObjects.size(); i++) {
+        if (this->usesStagingRing(this->mMemObjects[i])) {
+            std::static_pointer_cast<Tensor>(this->mMemObjects[i])
+              ->downloadThroughStagingRing();
+        } else {
+            this->mMemObjects[i]->invalidateHostMemory();
+        }
+    }
+}
+
+bool
+OpSyncLocal::usesStagingRing(const std::shared_ptr<Memory>& memory)
+{
+    return memory->type() == Memory::Type::eTensor &&
+           std::static_pointer_cast<Tensor>(memory)->usesStagingRing();
+}
+
+std::vector<std::shared_ptr<Memory>>
+OpSyncLocal::getMemObjects()
+{
+    return this->mMemObjects;
+}
+
+std::vector<OpBase::MemoryAccess>
+OpSyncLocal::getMemoryAccesses()
+{
+    // Device tensors are read by a transfer, either into their staging
+    // buffer or from the staging ring, and host tensors by the host
+    std::vector<MemoryAccess> accesses;
+    for (const std::shared_ptr<Memory>& mem : this->mMemObjects) {
+        if (mem->type() != Memory::Type::eTensor) {
+            continue;
+        }
+        if (mem->memoryType() == Memory::MemoryTypes::eDevice) {
+            accesses.push_back({ mem,
+                                 vk::AccessFlagBits::eTransferRead,
+                                 vk::PipelineStageFlagBits::eTransfer,
+                                 false });
+        } else if (mem->memoryType() == Memory::MemoryTypes::eHost) {
+            accesses.push_back({ mem,
+                                 vk::AccessFlagBits::eHostRead,
+                                 vk::PipelineStageFlagBits::eHost,
+                                 false });
+        }
+    }
+    return accesses;
+}
+
+std::string
+OpSyncLocal::name() const
+{
+    return "OpSyncLocal";
 }
 
 }
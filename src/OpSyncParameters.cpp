@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "kompute/operations/OpSyncParameters.hpp"
+
+namespace kp {
+
+OpSyncParameters::OpSyncParameters(
+  std::shared_ptr<ParameterBlock> parameterBlock)
+{
+    KP_LOG_DEBUG("Kompute OpSyncParameters constructor with params");
+
+    if (!parameterBlock) {
+        throw std::runtime_error(
+          "Kompute OpSyncParameters parameter block is null");
+    }
+
+    this->mParameterBlock = parameterBlock;
+}
+
+OpSyncParameters::~OpSyncParameters()
+{
+    KP_LOG_DEBUG("Kompute OpSyncParameters destructor started");
+}
+
+void
+OpSyncParameters::record(const vk::CommandBuffer& commandBuffer)
+{
+    KP_LOG_DEBUG("Kompute OpSyncParameters record called");
+
+    this->mParameterBlock->recordCopy(commandBuffer);
+}
+
+void
+OpSyncParameters::preEval(const vk::CommandBuffer& commandBuffer)
+{
+    KP_LOG_DEBUG("Kompute OpSyncParameters preEval called");
+
+    this->mParameterBlock->writeSlot(commandBuffer);
+}
+
+void
+OpSyncParameters::postEval(const vk::CommandBuffer& /*commandBuffer*/)
+{
+    KP_LOG_DEBUG("Kompute OpSyncParameters postEval called");
+}
+
+std::vector<std::shared_ptr<Memory>>
+OpSyncParameters::getMemObjects()
+{
+    return { this->mParameterBlock->getTensor() };
+}
+
+std::vector<OpBase::MemoryAccess>
+OpSyncParameters::getMemoryAccesses()
+{
+    return { { this->mParameterBlock->getTensor(),
+               vk::AccessFlagBits::eTransferWrite,
+               vk::PipelineStageFlagBits::eTransfer,
+               true } };
+}
+
+std::string
+OpSyncParameters::name() const
+{
+    return "OpSyncParameters";
+}
+
+}
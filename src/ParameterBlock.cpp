@@ -0,0 +1,224 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "kompute/ParameterBlock.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fmt/core.h>
+
+namespace kp {
+
+ParameterBlock::ParameterBlock(
+  std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+  std::shared_ptr<vk::Device> device,
+  std::shared_ptr<Tensor> tensor,
+  const std::vector<vk::CommandBuffer>& commandBuffers)
+{
+    KP_LOG_DEBUG("Kompute ParameterBlock constructor with {} slots",
+                 commandBuffers.size());
+
+    if (!tensor) {
+        throw std::runtime_error("Kompute ParameterBlock tensor is null");
+    }
+    if (commandBuffers.empty()) {
+        throw std::runtime_error(
+          "Kompute ParameterBlock requires at least one command buffer");
+    }
+
+    this->mPhysicalDevice = physicalDevice;
+    this->mDevice = device;
+    this->mTensor = tensor;
+    this->mCommandBuffers = commandBuffers;
+    this->mSize = tensor->memorySize();
+
+    if (this->mSize == 0) {
+        throw std::runtime_error("Kompute ParameterBlock tensor is empty");
+    }
+
+    // Tensors without host data, such as eStorage ones, start from zeros
+    this->mData.resize(this->mSize, 0);
+    if (tensor->memoryType() != Memory::MemoryTypes::eStorage &&
+        tensor->memoryType() != Memory::MemoryTypes::eTransient) {
+        const void* data = tensor->rawData();
+        if (data) {
+            memcpy(this->mData.data(), data, this->mSize);
+        }
+    }
+
+    this->createBuffer();
+}
+
+ParameterBlock::~ParameterBlock()
+{
+    KP_LOG_DEBUG("Kompute ParameterBlock destructor started");
+
+    if (this->mDevice) {
+        this->destroy();
+    }
+}
+
+void
+ParameterBlock::setData(const void* data, uint64_t size, uint64_t offset)
+{
+    if (offset + size > this->mSize) {
+        throw std::runtime_error(fmt::format(
+          "Kompute ParameterBlock can't set {} bytes at offset {} of {} bytes "
+          "of parameters",
+          size,
+          offset,
+          this->mSize));
+    }
+
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    memcpy(this->mData.data() + offset, data, size);
+}
+
+void
+ParameterBlock::recordCopy(const vk::CommandBuffer& commandBuffer)
+{
+    KP_LOG_DEBUG("Kompute ParameterBlock recording copy of {} bytes",
+                 this->mSize);
+
+    if (this->mTensor->memorySize() < this->mSize) {
+        throw std::runtime_error(fmt::format(
+          "Kompute ParameterBlock tensor of {} bytes is smaller than the {} "
+          "bytes of parameters",
+          this->mTensor->memorySize(),
+          this->mSize));
+    }
+
+    vk::BufferCopy copyRegion(
+      this->getSlot(commandBuffer) * this->mSize, 0, this->mSize);
+    commandBuffer.copyBuffer(
+      *this->mBuffer, *this->mTensor->getPrimaryBuffer(), 1, &copyRegion);
+}
+
+void
+ParameterBlock::writeSlot(const vk::CommandBuffer& commandBuffer)
+{
+    // The slot isn't read by the device until the command buffer is
+    // submitted, and the memory is coherent so the write doesn't need a flush
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    memcpy(this->mMappedData + this->getSlot(commandBuffer) * this->mSize,
+           this->mData.data(),
+           this->mSize);
+}
+
+std::shared_ptr<Tensor>
+ParameterBlock::getTensor() const
+{
+    return this->mTensor;
+}
+
+uint64_t
+ParameterBlock::size() const
+{
+    return this->mSize;
+}
+
+bool
+ParameterBlock::isInit() const
+{
+    return this->mDevice && this->mBuffer && this->mMemory;
+}
+
+void
+ParameterBlock::destroy()
+{
+    KP_LOG_DEBUG("Kompute ParameterBlock destroy started");
+
+    if (!this->mDevice) {
+        KP_LOG_WARN("Kompute ParameterBlock destroy called with null Device");
+        return;
+    }
+
+    if (this->mBuffer) {
+        this->mDevice->destroy(
+          *this->mBuffer, (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        this->mBuffer = nullptr;
+    }
+
+    if (this->mMemory) {
+        this->mDevice->unmapMemory(*this->mMemory);
+        this->mMappedData = nullptr;
+        this->mDevice->freeMemory(
+          *this->mMemory, (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        this->mMemory = nullptr;
+    }
+
+    this->mCommandBuffers.clear();
+    this->mDevice = nullptr;
+    this->mPhysicalDevice = nullptr;
+}
+
+void
+ParameterBlock::createBuffer()
+{
+    vk::DeviceSize bufferSize = this->mSize * this->mCommandBuffers.size();
+
+    KP_LOG_DEBUG("Kompute ParameterBlock creating buffer of size {}",
+                 bufferSize);
+
+    vk::BufferCreateInfo bufferInfo(vk::BufferCreateFlags(),
+                                    bufferSize,
+                                    vk::BufferUsageFlagBits::eTransferSrc,
+                                    vk::SharingMode::eExclusive);
+    this->mBuffer = std::make_shared<vk::Buffer>();
+    this->mDevice->createBuffer(&bufferInfo, nullptr, this->mBuffer.get());
+
+    vk::MemoryRequirements memoryRequirements =
+      this->mDevice->getBufferMemoryRequirements(*this->mBuffer);
+    vk::PhysicalDeviceMemoryProperties memoryProperties =
+      this->mPhysicalDevice->getMemoryProperties();
+
+    // The slots are only written sequentially by the host, which coherent
+    // write-combined memory handles well
+    const vk::MemoryPropertyFlags flags =
+      vk::MemoryPropertyFlagBits::eHostVisible |
+      vk::MemoryPropertyFlagBits::eHostCoherent;
+
+    uint32_t memoryTypeIndex = memoryProperties.memoryTypeCount;
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+        if ((memoryRequirements.memoryTypeBits & (1 << i)) &&
+            (memoryProperties.memoryTypes[i].propertyFlags & flags) == flags) {
+            memoryTypeIndex = i;
+            break;
+        }
+    }
+    if (memoryTypeIndex == memoryProperties.memoryTypeCount) {
+        throw std::runtime_error(
+          "Kompute ParameterBlock host visible memory type not found");
+    }
+
+    vk::MemoryAllocateInfo memoryAllocateInfo(memoryRequirements.size,
+                                              memoryTypeIndex);
+    this->mMemory = std::make_shared<vk::DeviceMemory>();
+    this->mDevice->allocateMemory(
+      &memoryAllocateInfo, nullptr, this->mMemory.get());
+    this->mDevice->bindBufferMemory(*this->mBuffer, *this->mMemory, 0);
+
+    this->mMappedData = (uint8_t*)this->mDevice->mapMemory(
+      *this->mMemory, 0, VK_WHOLE_SIZE, vk::MemoryMapFlags());
+
+    // Every slot starts with the initial parameters, as the block may be
+    // recorded after some command buffers were submitted
+    for (size_t i = 0; i < this->mCommandBuffers.size(); i++) {
+        memcpy(
+          this->mMappedData + i * this->mSize, this->mData.data(), this->mSize);
+    }
+}
+
+uint32_t
+ParameterBlock::getSlot(const vk::CommandBuffer& commandBuffer) const
+{
+    auto it = std::find(this->mCommandBuffers.begin(),
+                        this->mCommandBuffers.end(),
+                        commandBuffer);
+    if (it == this->mCommandBuffers.end()) {
+        throw std::runtime_error(
+          "Kompute ParameterBlock can only be used in the command buffers of "
+          "the sequence that created it");
+    }
+    return static_cast<uint32_t>(it - this->mCommandBuffers.begin());
+}
+
+}
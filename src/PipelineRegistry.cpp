@@ -0,0 +1,290 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "kompute/PipelineRegistry.hpp"
+
+namespace kp {
+
+// 64 bit FNV-1a, which is good enough to spread SPIR-V words and keys across
+// the buckets, as entries with the same hash are still compared
+static const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+static const uint64_t FNV_PRIME = 1099511628211ull;
+
+static uint64_t
+hashBytes(uint64_t hash, const void* data, size_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+bool
+PipelineRegistry::PipelineKey::operator==(const PipelineKey& other) const
+{
+    return this->descriptorTypes == other.descriptorTypes &&
+           this->specializationConstants == other.specializationConstants &&
+           this->specializationConstantSize ==
+             other.specializationConstantSize &&
+           this->pushConstantsSize == other.pushConstantsSize;
+}
+
+bool
+PipelineRegistry::Key::operator==(const Key& other) const
+{
+    return this->shaderModule == other.shaderModule &&
+           this->pipeline == other.pipeline;
+}
+
+size_t
+PipelineRegistry::SpirvHash::operator()(
+  const std::vector<uint32_t>& spirv) const
+{
+    return static_cast<size_t>(hashBytes(
+      FNV_OFFSET_BASIS, spirv.data(), spirv.size() * sizeof(uint32_t)));
+}
+
+size_t
+PipelineRegistry::KeyHash::operator()(const Key& key) const
+{
+    VkShaderModule shaderModule = key.shaderModule;
+    uint64_t hash =
+      hashBytes(FNV_OFFSET_BASIS, &shaderModule, sizeof(shaderModule));
+    hash = hashBytes(hash,
+                     key.pipeline.descriptorTypes.data(),
+                     key.pipeline.descriptorTypes.size() *
+                       sizeof(vk::DescriptorType));
+    hash = hashBytes(hash,
+                     key.pipeline.specializationConstants.data(),
+                     key.pipeline.specializationConstants.size());
+    hash = hashBytes(hash,
+                     &key.pipeline.specializationConstantSize,
+                     sizeof(key.pipeline.specializationConstantSize));
+    hash = hashBytes(hash,
+                     &key.pipeline.pushConstantsSize,
+                     sizeof(key.pipeline.pushConstantsSize));
+    return static_cast<size_t>(hash);
+}
+
+PipelineRegistry::PipelineRegistry(std::shared_ptr<vk::Device> device)
+{
+    KP_LOG_DEBUG("Kompute PipelineRegistry constructor");
+
+    if (!device) {
+        throw std::runtime_error("Kompute PipelineRegistry device is null");
+    }
+
+    this->mDevice = device;
+}
+
+PipelineRegistry::~PipelineRegistry()
+{
+    KP_LOG_DEBUG("Kompute PipelineRegistry destructor started");
+
+    if (this->mDevice) {
+        this->destroy();
+    }
+}
+
+std::shared_ptr<vk::ShaderModule>
+PipelineRegistry::shaderModule(const std::vector<uint32_t>& spirv)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        throw std::runtime_error(
+          "Kompute PipelineRegistry shaderModule called after destroy");
+    }
+
+    auto it = this->mShaderModules.find(spirv);
+    if (it != this->mShaderModules.end()) {
+        if (std::shared_ptr<vk::ShaderModule> shaderModule =
+              it->second.lock()) {
+            this->mStats.shaderModuleHits++;
+            return shaderModule;
+        }
+    }
+
+    KP_LOG_DEBUG("Kompute PipelineRegistry creating shader module of {} words",
+                 spirv.size());
+
+    vk::ShaderModuleCreateInfo shaderModuleInfo(vk::ShaderModuleCreateFlags(),
+                                                sizeof(uint32_t) *
+                                                  spirv.size(),
+                                                spirv.data());
+    vk::ShaderModule created;
+    this->mDevice->createShaderModule(&shaderModuleInfo, nullptr, &created);
+
+    // The last algorithm releasing the shader module destroys it, unless the
+    // registry has already been destroyed
+    std::weak_ptr<PipelineRegistry> registry = this->shared_from_this();
+    std::shared_ptr<vk::ShaderModule> shaderModule(
+      new vk::ShaderModule(created),
+      [registry, spirv](vk::ShaderModule* shaderModule) {
+          if (std::shared_ptr<PipelineRegistry> owner = registry.lock()) {
+              owner->releaseShaderModule(spirv, *shaderModule);
+          }
+          delete shaderModule;
+      });
+
+    this->mShaderModules[spirv] = shaderModule;
+    this->mStats.shaderModulesCreated++;
+
+    return shaderModule;
+}
+
+std::shared_ptr<PipelineRegistry::Pipeline>
+PipelineRegistry::pipeline(std::shared_ptr<vk::ShaderModule> shaderModule,
+                           const PipelineKey& key,
+                           const std::function<Pipeline()>& create)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        throw std::runtime_error(
+          "Kompute PipelineRegistry pipeline called after destroy");
+    }
+
+    Key registryKey{ *shaderModule, key };
+
+    auto it = this->mPipelines.find(registryKey);
+    if (it != this->mPipelines.end()) {
+        if (std::shared_ptr<Pipeline> pipeline = it->second.lock()) {
+            this->mStats.pipelineHits++;
+            return pipeline;
+        }
+    }
+
+    KP_LOG_DEBUG("Kompute PipelineRegistry creating pipeline");
+
+    // The pipeline keeps its shader module, so the handle in its key is not
+    // reused by another shader module while the pipeline is registered
+    Pipeline created = create();
+    created.shaderModule = shaderModule;
+
+    std::weak_ptr<PipelineRegistry> registry = this->shared_from_this();
+    std::shared_ptr<Pipeline> pipeline(
+      new Pipeline(created), [registry, registryKey](Pipeline* pipeline) {
+          if (std::shared_ptr<PipelineRegistry> owner = registry.lock()) {
+              owner->releasePipeline(registryKey, *pipeline);
+          }
+          // Releases the shader module outside of the lock of the registry
+          delete pipeline;
+      });
+
+    this->mPipelines[registryKey] = pipeline;
+    this->mStats.pipelinesCreated++;
+
+    return pipeline;
+}
+
+PipelineRegistry::Stats
+PipelineRegistry::stats()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    Stats stats = this->mStats;
+    stats.shaderModuleCount = this->mShaderModules.size();
+    stats.pipelineCount = this->mPipelines.size();
+    return stats;
+}
+
+bool
+PipelineRegistry::isInit() const
+{
+    return this->mDevice != nullptr;
+}
+
+void
+PipelineRegistry::destroy()
+{
+    KP_LOG_DEBUG("Kompute PipelineRegistry destroy called");
+
+    // The entries still in use are only released once the lock is released,
+    // as releasing them locks the registry
+    std::vector<std::shared_ptr<vk::ShaderModule>> shaderModules;
+    std::vector<std::shared_ptr<Pipeline>> pipelines;
+
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        KP_LOG_WARN("Kompute PipelineRegistry destroy called "
+                    "with null Device pointer");
+        return;
+    }
+
+    for (const auto& entry : this->mPipelines) {
+        if (std::shared_ptr<Pipeline> pipeline = entry.second.lock()) {
+            KP_LOG_WARN("Kompute PipelineRegistry destroying pipeline that "
+                        "is still in use");
+            this->mDevice->destroy(
+              *pipeline->pipeline,
+              (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+            this->mDevice->destroy(
+              *pipeline->pipelineLayout,
+              (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+            pipelines.push_back(pipeline);
+        }
+    }
+
+    for (const auto& entry : this->mShaderModules) {
+        if (std::shared_ptr<vk::ShaderModule> shaderModule =
+              entry.second.lock()) {
+            this->mDevice->destroy(
+              *shaderModule,
+              (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+            shaderModules.push_back(shaderModule);
+        }
+    }
+
+    this->mPipelines.clear();
+    this->mShaderModules.clear();
+    this->mDevice = nullptr;
+}
+
+void
+PipelineRegistry::releaseShaderModule(const std::vector<uint32_t>& spirv,
+                                      vk::ShaderModule shaderModule)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        return;
+    }
+
+    KP_LOG_DEBUG("Kompute PipelineRegistry destroying shader module");
+    this->mDevice->destroy(
+      shaderModule, (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+
+    // The entry may already have been replaced by a new shader module with
+    // the same SPIR-V
+    auto it = this->mShaderModules.find(spirv);
+    if (it != this->mShaderModules.end() && it->second.expired()) {
+        this->mShaderModules.erase(it);
+    }
+}
+
+void
+PipelineRegistry::releasePipeline(const Key& key, const Pipeline& pipeline)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        return;
+    }
+
+    KP_LOG_DEBUG("Kompute PipelineRegistry destroying pipeline");
+    this->mDevice->destroy(
+      *pipeline.pipeline,
+      (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    this->mDevice->destroy(
+      *pipeline.pipelineLayout,
+      (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+
+    auto it = this->mPipelines.find(key);
+    if (it != this->mPipelines.end() && it->second.expired()) {
+        this->mPipelines.erase(it);
+    }
+}
+
+}
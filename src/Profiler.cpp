@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <fmt/core.h>
+
+#include "kompute/Profiler.hpp"
+
+namespace kp {
+
+static std::string
+escapeJson(const std::string& value)
+{
+    std::string escaped;
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            escaped += fmt::format("\\u{:04x}", static_cast<int>(c));
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+Profiler::Profiler(float timestampPeriod, size_t maxEvents)
+{
+    KP_LOG_DEBUG("Kompute Profiler constructor with timestamp period {}",
+                 timestampPeriod);
+
+    this->mTimestampPeriod = timestampPeriod;
+    this->mMaxEvents = maxEvents;
+}
+
+bool
+Profiler::collect(std::shared_ptr<Sequence> sequence)
+{
+    uint64_t ticket = sequence->getLastTicket();
+    if (ticket == 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    auto it = this->mTracks.find(sequence);
+    if (it != this->mTracks.end() && it->second.collectedTicket == ticket) {
+        return false;
+    }
+
+    std::vector<uint64_t> timestamps;
+    if (!sequence->tryGetTimestamps(timestamps)) {
+        return false;
+    }
+
+    if (it == this->mTracks.end()) {
+        // Sequences destroyed since don't need their track anymore
+        for (auto track = this->mTracks.begin();
+             track != this->mTracks.end();) {
+            track = track->first.expired() ? this->mTracks.erase(track)
+                                           : std::next(track);
+        }
+        it = this->mTracks.emplace(sequence, Track{ this->mNextTrack++, 0 })
+               .first;
+    }
+    it->second.collectedTicket = ticket;
+
+    std::vector<std::string> names = sequence->getOperationNames();
+    for (size_t i = 0; i + 1 < timestamps.size() && i < names.size(); i++) {
+        Event event;
+        event.label = names[i];
+        event.track = it->second.id;
+        event.index = static_cast<uint32_t>(i);
+        event.startNs = timestamps[i] * double(this->mTimestampPeriod);
+        event.durationNs =
+          (timestamps[i + 1] - timestamps[i]) * double(this->mTimestampPeriod);
+        this->mEvents.push_back(event);
+    }
+
+    while (this->mEvents.size() > this->mMaxEvents) {
+        this->mEvents.pop_front();
+    }
+
+    return true;
+}
+
+std::vector<Profiler::OperationStats>
+Profiler::stats()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    std::map<std::string, std::vector<double>> durations;
+    for (const Event& event : this->mEvents) {
+        durations[event.label].push_back(event.durationNs);
+    }
+
+    std::vector<OperationStats> stats;
+    for (auto& entry : durations) {
+        std::vector<double>& values = entry.second;
+        std::sort(values.begin(), values.end());
+
+        OperationStats opStats;
+        opStats.label = entry.first;
+        opStats.count = values.size();
+        opStats.minNs = values.front();
+        for (double value : values) {
+            opStats.totalNs += value;
+        }
+        opStats.meanNs = opStats.totalNs / values.size();
+        opStats.p99Ns = values[(values.size() - 1) * 99 / 100];
+        stats.push_back(opStats);
+    }
+
+    std::sort(stats.begin(),
+              stats.end(),
+              [](const OperationStats& a, const OperationStats& b) {
+                  return a.totalNs > b.totalNs;
+              });
+    return stats;
+}
+
+std::vector<Profiler::Event>
+Profiler::events()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    return { this->mEvents.begin(), this->mEvents.end() };
+}
+
+std::string
+Profiler::traceJson()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    // Complete events take their timestamps and durations in microseconds
+    std::string json = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    for (size_t i = 0; i < this->mEvents.size(); i++) {
+        const Event& event = this->mEvents[i];
+        json += fmt::format("{}{{\"name\":\"{}\",\"cat\":\"kompute\","
+                            "\"ph\":\"X\",\"pid\":0,\"tid\":{},"
+                            "\"ts\":{:.3f},\"dur\":{:.3f},"
+                            "\"args\":{{\"index\":{}}}}}",
+                            i ? "," : "",
+                            escapeJson(event.label),
+                            event.track,
+                            event.startNs / 1000.0,
+                            event.durationNs / 1000.0,
+                            event.index);
+    }
+    json += "]}";
+    return json;
+}
+
+void
+Profiler::clear()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    this->mEvents.clear();
+}
+
+}
@@ -0,0 +1,423 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "kompute/Residency.hpp"
+#include <algorithm>
+
+namespace kp {
+
+Residency::Residency(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                     std::shared_ptr<vk::Device> device,
+                     std::shared_ptr<vk::Queue> queue,
+                     uint32_t queueFamilyIndex,
+                     vk::DeviceSize budget,
+                     std::shared_ptr<std::mutex> queueMutex)
+{
+    KP_LOG_DEBUG("Kompute Residency constructor with budget {}", budget);
+
+    this->mPhysicalDevice = physicalDevice;
+    this->mDevice = device;
+    this->mQueue = queue;
+    this->mQueueMutex = queueMutex;
+    this->mBudget = budget;
+
+    vk::CommandPoolCreateInfo commandPoolInfo(
+      vk::CommandPoolCreateFlagBits::eResetCommandBuffer |
+        vk::CommandPoolCreateFlagBits::eTransient,
+      queueFamilyIndex);
+    this->mCommandPool = std::make_shared<vk::CommandPool>();
+    this->mDevice->createCommandPool(
+      &commandPoolInfo, nullptr, this->mCommandPool.get());
+
+    vk::CommandBufferAllocateInfo commandBufferAllocateInfo(
+      *this->mCommandPool, vk::CommandBufferLevel::ePrimary, 1);
+    this->mDevice->allocateCommandBuffers(&commandBufferAllocateInfo,
+                                          &this->mCommandBuffer);
+
+    this->mFence = this->mDevice->createFence(vk::FenceCreateInfo());
+}
+
+Residency::~Residency()
+{
+    KP_LOG_DEBUG("Kompute Residency destructor started");
+
+    if (this->mDevice) {
+        this->destroy();
+    }
+}
+
+void
+Residency::track(std::shared_ptr<Tensor> tensor)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!tensor || !tensor->isEvictable()) {
+        return;
+    }
+
+    // Entries left by a destroyed tensor at the same address are reset
+    Entry& entry = this->mEntries[tensor.get()];
+    this->freeSpillBuffer(entry);
+    entry = Entry();
+    entry.tensor = tensor;
+    entry.lastUse = ++this->mTick;
+}
+
+void
+Residency::restore(const std::vector<std::shared_ptr<Memory>>& memObjects)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        throw std::runtime_error("Kompute Residency device is null");
+    }
+
+    uint64_t tick = ++this->mTick;
+    for (const std::shared_ptr<Memory>& memory : memObjects) {
+        Entry* entry = this->findEntry(memory);
+        if (entry) {
+            this->restoreEntry(*entry,
+                               std::static_pointer_cast<Tensor>(memory));
+            entry->lastUse = tick;
+        }
+    }
+}
+
+void
+Residency::acquire(const std::vector<std::shared_ptr<Memory>>& memObjects)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        throw std::runtime_error("Kompute Residency device is null");
+    }
+
+    uint64_t tick = ++this->mTick;
+    for (const std::shared_ptr<Memory>& memory : memObjects) {
+        Entry* entry = this->findEntry(memory);
+        if (entry) {
+            this->restoreEntry(*entry,
+                               std::static_pointer_cast<Tensor>(memory));
+            entry->lastUse = tick;
+            entry->pins++;
+        }
+    }
+
+    this->enforceBudget();
+}
+
+void
+Residency::release(const std::vector<std::shared_ptr<Memory>>& memObjects)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    for (const std::shared_ptr<Memory>& memory : memObjects) {
+        Entry* entry = this->findEntry(memory);
+        if (entry && entry->pins > 0) {
+            entry->pins--;
+        }
+    }
+}
+
+vk::DeviceSize
+Residency::budget() const
+{
+    return this->mBudget;
+}
+
+Residency::Stats
+Residency::stats()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    Stats stats;
+    for (const std::pair<Tensor* const, Entry>& pair : this->mEntries) {
+        std::shared_ptr<Tensor> tensor = pair.second.tensor.lock();
+        if (!tensor || !tensor->isInit()) {
+            continue;
+        }
+
+        stats.trackedCount++;
+        if (tensor->isResident()) {
+            stats.residentCount++;
+            stats.residentBytes += tensor->memorySize();
+        } else {
+            stats.spilledBytes += tensor->memorySize();
+        }
+    }
+    stats.totalEvictions = this->mTotalEvictions;
+    stats.totalRestores = this->mTotalRestores;
+
+    return stats;
+}
+
+bool
+Residency::isInit() const
+{
+    return this->mDevice && this->mCommandPool;
+}
+
+void
+Residency::destroy()
+{
+    KP_LOG_DEBUG("Kompute Residency destroy started");
+
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        KP_LOG_WARN("Kompute Residency destroy called with null Device");
+        return;
+    }
+
+    for (std::pair<Tensor* const, Entry>& pair : this->mEntries) {
+        this->freeSpillBuffer(pair.second);
+    }
+    this->mEntries.clear();
+
+    this->mDevice->destroy(
+      this->mFence, (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+
+    if (this->mCommandPool) {
+        this->mDevice->freeCommandBuffers(
+          *this->mCommandPool, 1, &this->mCommandBuffer);
+        this->mDevice->destroy(
+          *this->mCommandPool,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        this->mCommandPool = nullptr;
+    }
+
+    this->mDevice = nullptr;
+    this->mPhysicalDevice = nullptr;
+    this->mQueue = nullptr;
+    this->mQueueMutex = nullptr;
+}
+
+Residency::Entry*
+Residency::findEntry(const std::shared_ptr<Memory>& memory)
+{
+    if (!memory || memory->type() != Memory::Type::eTensor) {
+        return nullptr;
+    }
+
+    std::unordered_map<Tensor*, Entry>::iterator it =
+      this->mEntries.find(static_cast<Tensor*>(memory.get()));
+    if (it == this->mEntries.end()) {
+        return nullptr;
+    }
+
+    return &it->second;
+}
+
+void
+Residency::restoreEntry(Entry& entry, const std::shared_ptr<Tensor>& tensor)
+{
+    if (tensor->isResident()) {
+        return;
+    }
+
+    KP_LOG_DEBUG("Kompute Residency restoring tensor of {} bytes",
+                 tensor->memorySize());
+
+    tensor->restorePrimaryMemory();
+    this->copyBuffer(
+      *entry.spillBuffer, *tensor->getPrimaryBuffer(), tensor->memorySize());
+    this->freeSpillBuffer(entry);
+
+    this->mTotalRestores++;
+}
+
+void
+Residency::evictEntry(Entry& entry, const std::shared_ptr<Tensor>& tensor)
+{
+    KP_LOG_DEBUG("Kompute Residency spilling tensor of {} bytes",
+                 tensor->memorySize());
+
+    this->createSpillBuffer(entry, tensor->memorySize());
+    this->copyBuffer(
+      *tensor->getPrimaryBuffer(), *entry.spillBuffer, tensor->memorySize());
+    tensor->evictPrimaryMemory();
+
+    this->mTotalEvictions++;
+}
+
+void
+Residency::enforceBudget()
+{
+    // Entries of destroyed tensors are dropped, along with the host memory
+    // they may still hold
+    vk::DeviceSize residentBytes = 0;
+    std::vector<std::pair<uint64_t, Tensor*>> candidates;
+    for (std::unordered_map<Tensor*, Entry>::iterator it =
+           this->mEntries.begin();
+         it != this->mEntries.end();) {
+        std::shared_ptr<Tensor> tensor = it->second.tensor.lock();
+        if (!tensor || !tensor->isInit()) {
+            this->freeSpillBuffer(it->second);
+            it = this->mEntries.erase(it);
+            continue;
+        }
+
+        if (tensor->isResident()) {
+            residentBytes += tensor->memorySize();
+            if (it->second.pins == 0 && tensor->isEvictable()) {
+                candidates.push_back({ it->second.lastUse, it->first });
+            }
+        }
+        it++;
+    }
+
+    if (residentBytes <= this->mBudget) {
+        return;
+    }
+
+    std::sort(candidates.begin(), candidates.end());
+
+    for (const std::pair<uint64_t, Tensor*>& candidate : candidates) {
+        if (residentBytes <= this->mBudget) {
+            break;
+        }
+
+        Entry& entry = this->mEntries[candidate.second];
+        std::shared_ptr<Tensor> tensor = entry.tensor.lock();
+        this->evictEntry(entry, tensor);
+        residentBytes -= tensor->memorySize();
+    }
+
+    if (residentBytes > this->mBudget) {
+        KP_LOG_WARN("Kompute Residency {} resident bytes exceed the budget of "
+                    "{} bytes as the remaining tensors are in use",
+                    residentBytes,
+                    this->mBudget);
+    }
+}
+
+void
+Residency::createSpillBuffer(Entry& entry, vk::DeviceSize size)
+{
+    vk::BufferCreateInfo bufferInfo(vk::BufferCreateFlags(),
+                                    size,
+                                    vk::BufferUsageFlagBits::eTransferSrc |
+                                      vk::BufferUsageFlagBits::eTransferDst,
+                                    vk::SharingMode::eExclusive);
+    entry.spillBuffer = std::make_shared<vk::Buffer>();
+    this->mDevice->createBuffer(&bufferInfo, nullptr, entry.spillBuffer.get());
+
+    vk::MemoryRequirements memoryRequirements =
+      this->mDevice->getBufferMemoryRequirements(*entry.spillBuffer);
+    vk::PhysicalDeviceMemoryProperties memoryProperties =
+      this->mPhysicalDevice->getMemoryProperties();
+
+    // Spilled tensors are only accessed by the device, so any host visible
+    // memory type outside of the device local heaps works
+    const vk::MemoryPropertyFlags candidates[] = {
+        vk::MemoryPropertyFlagBits::eHostVisible |
+          vk::MemoryPropertyFlagBits::eHostCoherent |
+          vk::MemoryPropertyFlagBits::eHostCached,
+        vk::MemoryPropertyFlagBits::eHostVisible |
+          vk::MemoryPropertyFlagBits::eHostCoherent
+    };
+
+    uint32_t memoryTypeIndex = memoryProperties.memoryTypeCount;
+    for (const vk::MemoryPropertyFlags& flags : candidates) {
+        for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+            if ((memoryRequirements.memoryTypeBits & (1 << i)) &&
+                (memoryProperties.memoryTypes[i].propertyFlags & flags) ==
+                  flags) {
+                memoryTypeIndex = i;
+                break;
+            }
+        }
+        if (memoryTypeIndex < memoryProperties.memoryTypeCount) {
+            break;
+        }
+    }
+    if (memoryTypeIndex == memoryProperties.memoryTypeCount) {
+        this->freeSpillBuffer(entry);
+        throw std::runtime_error(
+          "Kompute Residency host visible memory type not found");
+    }
+
+    vk::MemoryAllocateInfo memoryAllocateInfo(memoryRequirements.size,
+                                              memoryTypeIndex);
+    entry.spillMemory = std::make_shared<vk::DeviceMemory>();
+    try {
+        this->mDevice->allocateMemory(
+          &memoryAllocateInfo, nullptr, entry.spillMemory.get());
+    } catch (...) {
+        entry.spillMemory = nullptr;
+        this->freeSpillBuffer(entry);
+        throw;
+    }
+    this->mDevice->bindBufferMemory(*entry.spillBuffer, *entry.spillMemory, 0);
+}
+
+void
+Residency::freeSpillBuffer(Entry& entry)
+{
+    if (entry.spillBuffer) {
+        this->mDevice->destroy(
+          *entry.spillBuffer,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        entry.spillBuffer = nullptr;
+    }
+
+    if (entry.spillMemory) {
+        this->mDevice->freeMemory(
+          *entry.spillMemory,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        entry.spillMemory = nullptr;
+    }
+}
+
+void
+Residency::copyBuffer(const vk::Buffer& srcBuffer,
+                      const vk::Buffer& dstBuffer,
+                      vk::DeviceSize size)
+{
+    // The tensors were last used by earlier submissions and are next used by
+    // later ones, so the copy is ordered against both with memory barriers
+    vk::MemoryBarrier beforeBarrier(vk::AccessFlagBits::eMemoryWrite,
+                                    vk::AccessFlagBits::eTransferRead);
+    vk::MemoryBarrier afterBarrier(vk::AccessFlagBits::eTransferWrite,
+                                   vk::AccessFlagBits::eMemoryRead |
+                                     vk::AccessFlagBits::eMemoryWrite);
+
+    this->mCommandBuffer.begin(vk::CommandBufferBeginInfo(
+      vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+    this->mCommandBuffer.pipelineBarrier(
+      vk::PipelineStageFlagBits::eAllCommands,
+      vk::PipelineStageFlagBits::eTransfer,
+      vk::DependencyFlags(),
+      beforeBarrier,
+      nullptr,
+      nullptr);
+    this->mCommandBuffer.copyBuffer(
+      srcBuffer, dstBuffer, vk::BufferCopy(0, 0, size));
+    this->mCommandBuffer.pipelineBarrier(
+      vk::PipelineStageFlagBits::eTransfer,
+      vk::PipelineStageFlagBits::eAllCommands,
+      vk::DependencyFlags(),
+      afterBarrier,
+      nullptr,
+      nullptr);
+    this->mCommandBuffer.end();
+
+    vk::SubmitInfo submitInfo(0, nullptr, nullptr, 1, &this->mCommandBuffer);
+    {
+        std::unique_lock<std::mutex> queueLock;
+        if (this->mQueueMutex) {
+            queueLock = std::unique_lock<std::mutex>(*this->mQueueMutex);
+        }
+        this->mQueue->submit(1, &submitInfo, this->mFence);
+    }
+
+    vk::Result result =
+      this->mDevice->waitForFences(1, &this->mFence, VK_TRUE, UINT64_MAX);
+    this->mDevice->resetFences({ this->mFence });
+    if (result != vk::Result::eSuccess) {
+        throw std::runtime_error("Kompute Residency failed to wait for "
+                                 "transfer: " +
+                                 vk::to_string(result));
+    }
+}
+
+}
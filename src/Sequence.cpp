@@ -1,6 +1,16 @@
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <fmt/core.h>
+#include <thread>
+#include <unordered_map>
+
 #include "kompute/Sequence.hpp"
+#include "kompute/operations/OpResize.hpp"
+#include "kompute/operations/OpSyncDevice.hpp"
+#include "kompute/operations/OpSyncLocal.hpp"
 
 namespace kp {
 
@@ -8,18 +18,36 @@ Sequence::Sequence(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
                    std::shared_ptr<vk::Device> device,
                    std::shared_ptr<vk::Queue> computeQueue,
                    uint32_t queueIndex,
-                   uint32_t totalTimestamps)
+                   uint32_t totalTimestamps,
+                   uint32_t numBuffers,
+                   std::shared_ptr<Residency> residency,
+                   std::shared_ptr<CompletionThread> completionThread,
+                   std::shared_ptr<std::mutex> queueMutex)
 {
     KP_LOG_DEBUG("Kompute Sequence Constructor with existing device & queue");
 
+    if (numBuffers == 0) {
+        throw std::runtime_error(
+          "Kompute Sequence requires at least one command buffer");
+    }
+    if (totalTimestamps > 0 && numBuffers > 1) {
+        throw std::runtime_error("Kompute Sequence timestamps are only "
+                                 "supported with a single command buffer");
+    }
+
     this->mPhysicalDevice = physicalDevice;
     this->mDevice = device;
     this->mComputeQueue = computeQueue;
     this->mQueueIndex = queueIndex;
-    this->mFence = this->mDevice->createFence(vk::FenceCreateInfo());
+    this->mResidency = residency;
+    this->mCompletionThread = completionThread;
+    this->mQueueMutex = queueMutex;
 
     this->createCommandPool();
-    this->createCommandBuffer();
+    this->createCommandBuffer(numBuffers);
+    for (Submission& submission : this->mSubmissions) {
+        submission.fence = this->mDevice->createFence(vk::FenceCreateInfo());
+    }
     if (totalTimestamps > 0)
         this->createTimestampQueryPool(totalTimestamps +
                                        1); //+1 for the first one
@@ -52,13 +80,26 @@ Sequence::begin()
     KP_LOG_INFO("Kompute Sequence command now started recording");
     this->mCommandBuffer->begin(vk::CommandBufferBeginInfo());
     this->mRecording = true;
+    this->mFirstRecordedOperation = this->mOperations.size();
+    this->mAliasBarriers.clear();
+    this->mHazardBarriers.clear();
+    this->mHazardTracker.clear();
+
+    // latch the first timestamp before any commands are submitted, after
+    // resetting the availability of the timestamps of the previous eval
+    if (this->mStatisticsQueryPool) {
+        this->mCommandBuffer->resetQueryPool(
+          *this->mStatisticsQueryPool, 0, this->mStatisticsCount);
+    }
 
-    // latch the first timestamp before any commands are submitted
-    if (this->timestampQueryPool)
+    if (this->timestampQueryPool) {
+        this->mCommandBuffer->resetQueryPool(
+          *this->timestampQueryPool, 0, this->mTimestampCount);
         this->mCommandBuffer->writeTimestamp(
           vk::PipelineStageFlagBits::eAllCommands,
           *this->timestampQueryPool,
           0);
+    }
 }
 
 void
@@ -75,9 +116,20 @@ Sequence::end()
         KP_LOG_WARN("Kompute Sequence end called when not recording");
         return;
     } else {
+        if (this->mDeferRecording) {
+            this->recordDeferredOperations();
+        }
+
         KP_LOG_INFO("Kompute Sequence command recording END");
         this->mCommandBuffer->end();
         this->mRecording = false;
+
+        if (this->mSubmissions.size() > 1) {
+            this->replayOperations();
+        }
+
+        // Commands refer to the buffers the memory objects had when recorded
+        this->mRecordedGenerations = this->getMemGenerations();
     }
 }
 
@@ -86,9 +138,14 @@ Sequence::clear()
 {
     KP_LOG_DEBUG("Kompute Sequence calling clear");
     this->mOperations.clear();
+    this->mFirstStatisticsOperation = 0;
     if (this->isRecording()) {
         this->end();
     }
+
+    // Operations recorded next may use the transient tensors in a different
+    // order, which requires a new plan
+    this->releaseTransientMemory();
 }
 
 std::shared_ptr<Sequence>
@@ -108,34 +165,191 @@ Sequence::eval(std::shared_ptr<OpBase> op)
 
 std::shared_ptr<Sequence>
 Sequence::evalAsync()
+{
+    Submission& submission = this->prepareSubmission(nullptr);
+
+    KP_LOG_DEBUG("Kompute sequence submitting command buffer into compute "
+                 "queue with ticket {}",
+                 submission.ticket);
+
+    try {
+        this->mDevice->resetFences({ submission.fence });
+
+        std::unique_lock<std::mutex> queueLock;
+        if (this->mQueueMutex) {
+            queueLock = std::unique_lock<std::mutex>(*this->mQueueMutex);
+        }
+        this->mComputeQueue->submit(
+          1, &submission.submitInfo, submission.fence);
+    } catch (...) {
+        // The submission never reached the queue, so it is rolled back like
+        // the prepared submissions of a batch that failed
+        this->cancelSubmit();
+        throw;
+    }
+
+    return shared_from_this();
+}
+
+std::future<void>
+Sequence::evalAsyncFuture(CompletionThread::Callback callback)
+{
+    if (!this->mCompletionThread) {
+        throw std::runtime_error(
+          "Kompute Sequence evalAsyncFuture requires a completion thread, "
+          "which is enabled with Manager::enableCompletionThread");
+    }
+
+    this->evalAsync();
+
+    return this->mCompletionThread->watch(
+      shared_from_this(), this->mLastTicket, std::move(callback));
+}
+
+vk::SubmitInfo
+Sequence::prepareSubmit(std::shared_ptr<vk::Fence> fence)
+{
+    if (!fence) {
+        throw std::runtime_error(
+          "Kompute Sequence prepareSubmit requires a fence");
+    }
+
+    return this->prepareSubmission(fence).submitInfo;
+}
+
+void
+Sequence::cancelSubmit()
+{
+    if (!this->isRunning(this->mLastTicket)) {
+        KP_LOG_WARN("Kompute Sequence cancelSubmit called without prepared "
+                    "submission");
+        return;
+    }
+
+    Submission& submission =
+      this->mSubmissions[(this->mLastTicket - 1) % this->mSubmissions.size()];
+
+    submission.pending = false;
+    submission.sharedFence = nullptr;
+    this->releaseMemObjects(submission);
+
+    // The timeline waits apply to the next submission instead
+    this->mTimelineWaits.insert(this->mTimelineWaits.begin(),
+                                submission.timelineWaits.begin(),
+                                submission.timelineWaits.end());
+    submission.timelineWaits.clear();
+    this->mTimelineValue = submission.previousTimelineValue;
+
+    this->mLastTicket--;
+}
+
+Sequence::Submission&
+Sequence::prepareSubmission(std::shared_ptr<vk::Fence> sharedFence)
 {
     if (this->isRecording()) {
         this->end();
     }
 
-    if (this->mIsRunning) {
+    // Command buffers are submitted in turn, so the next one is only
+    // available once the submission that used it last has been awaited
+    uint64_t ticket = this->mLastTicket + 1;
+    Submission& submission =
+      this->mSubmissions[(ticket - 1) % this->mSubmissions.size()];
+
+    if (submission.pending) {
         throw std::runtime_error(
           "Kompute Sequence evalAsync called when an eval async was "
           "called without successful wait");
     }
 
-    this->mIsRunning = true;
+    // Spilled tensors are restored into new buffers, and the memory objects
+    // may have been recreated since recording, which requires re-recording
+    std::vector<std::shared_ptr<Memory>> acquiredMemObjects =
+      this->getMemObjects();
+    if (this->mResidency) {
+        this->mResidency->acquire(acquiredMemObjects);
+    }
+
+    // Nothing is committed until the operations are ready to be submitted,
+    // so a failure leaves the sequence as it was before the call
+    try {
+        if (this->getMemGenerations() != this->mRecordedGenerations) {
+            KP_LOG_DEBUG("Kompute Sequence re-recording as memory objects "
+                         "were recreated");
+            // All the command buffers are re-recorded, including the ones of
+            // the submissions still in flight
+            if (this->isRunning()) {
+                this->evalAwait();
+            }
+            this->rerecord();
+            this->end();
+        }
 
-    for (size_t i = 0; i < this->mOperations.size(); i++) {
-        this->mOperations[i]->preEval(*this->mCommandBuffer);
+        for (size_t i = 0; i < this->mOperations.size(); i++) {
+            this->mOperations[i]->preEval(*submission.commandBuffer);
+        }
+    } catch (...) {
+        if (this->mResidency) {
+            this->mResidency->release(acquiredMemObjects);
+        }
+        throw;
     }
 
-    vk::SubmitInfo submitInfo(
-      0, nullptr, nullptr, 1, this->mCommandBuffer.get());
+    this->mLastTicket = ticket;
+    submission.ticket = ticket;
+    submission.pending = true;
+    submission.sharedFence = sharedFence;
+    submission.acquiredMemObjects = acquiredMemObjects;
 
-    KP_LOG_DEBUG(
-      "Kompute sequence submitting command buffer into compute queue");
+    // Transfers that bypass the queue, such as the ones of the staging ring,
+    // check the queues of the submissions using the memory objects
+    for (const std::shared_ptr<Memory>& mem : acquiredMemObjects) {
+        mem->acquireSubmission(*this->mComputeQueue);
+    }
 
-    this->mDevice->resetFences({ this->mFence });
+    submission.submitInfo = vk::SubmitInfo(
+      0, nullptr, nullptr, 1, submission.commandBuffer.get());
+
+    // The waited sequences are kept alive until the submission finishes, as
+    // their semaphores can't be destroyed while it waits for them
+    submission.timelineWaits.swap(this->mTimelineWaits);
+    this->mTimelineWaits.clear();
+    submission.previousTimelineValue = this->mTimelineValue;
+
+    if (this->mTimelineSemaphore) {
+        submission.waitSemaphores.clear();
+        submission.waitValues.clear();
+        submission.waitStages.clear();
+        for (const TimelineWait& wait : submission.timelineWaits) {
+            submission.waitSemaphores.push_back(
+              wait.sequence->mTimelineSemaphore);
+            submission.waitValues.push_back(wait.value);
+            submission.waitStages.push_back(wait.stages);
+        }
 
-    this->mComputeQueue->submit(1, &submitInfo, this->mFence);
+        this->mTimelineValue = std::max(this->mTimelineValue + 1,
+                                        this->mSignalValue);
+        this->mSignalValue = 0;
+        submission.timelineValue = this->mTimelineValue;
+
+        submission.timelineSubmitInfo = vk::TimelineSemaphoreSubmitInfoKHR(
+          submission.waitValues.size(),
+          submission.waitValues.data(),
+          1,
+          &submission.timelineValue);
+
+        submission.submitInfo.setWaitSemaphoreCount(
+          submission.waitSemaphores.size());
+        submission.submitInfo.setPWaitSemaphores(
+          submission.waitSemaphores.data());
+        submission.submitInfo.setPWaitDstStageMask(
+          submission.waitStages.data());
+        submission.submitInfo.setSignalSemaphoreCount(1);
+        submission.submitInfo.setPSignalSemaphores(&this->mTimelineSemaphore);
+        submission.submitInfo.setPNext(&submission.timelineSubmitInfo);
+    }
 
-    return shared_from_this();
+    return submission;
 }
 
 std::shared_ptr<Sequence>
@@ -150,33 +364,368 @@ Sequence::evalAsync(std::shared_ptr<OpBase> op)
 std::shared_ptr<Sequence>
 Sequence::evalAwait(uint64_t waitFor)
 {
-    if (!this->mIsRunning) {
+    if (!this->isRunning()) {
         KP_LOG_WARN("Kompute Sequence evalAwait called without existing eval");
         return shared_from_this();
     }
 
-    vk::Result result =
-      this->mDevice->waitForFences(1, &this->mFence, VK_TRUE, waitFor);
+    // Submissions in flight have the most recent tickets, which are awaited
+    // in the order they were submitted
+    uint64_t numBuffers = this->mSubmissions.size();
+    uint64_t firstTicket =
+      this->mLastTicket > numBuffers ? this->mLastTicket - numBuffers + 1 : 1;
+    for (uint64_t ticket = firstTicket; ticket <= this->mLastTicket; ticket++) {
+        if (!this->isRunning(ticket)) {
+            continue;
+        }
+        if (!this->awaitSubmission(
+              this->mSubmissions[(ticket - 1) % numBuffers], waitFor)) {
+            break;
+        }
+    }
+
+    return shared_from_this();
+}
+
+std::shared_ptr<Sequence>
+Sequence::evalAwaitTicket(uint64_t ticket, uint64_t waitFor)
+{
+    if (!this->isRunning(ticket)) {
+        KP_LOG_WARN("Kompute Sequence evalAwaitTicket called for ticket {} "
+                    "which is not in flight",
+                    ticket);
+        return shared_from_this();
+    }
+
+    this->awaitSubmission(
+      this->mSubmissions[(ticket - 1) % this->mSubmissions.size()], waitFor);
 
-    this->mIsRunning = false;
+    return shared_from_this();
+}
+
+bool
+Sequence::awaitSubmission(Submission& submission, uint64_t waitFor)
+{
+    vk::Result result = vk::Result::eTimeout;
+    uint64_t blockFor = waitFor;
+
+    if (this->mWaitStrategy == WaitStrategy::eSpin) {
+        result = this->spinSubmission(submission, waitFor, false);
+    } else if (this->mWaitStrategy == WaitStrategy::eHybrid) {
+        uint64_t spinFor = std::min(this->mSpinBudget, waitFor);
+        result = this->spinSubmission(submission, spinFor, true);
+        blockFor = waitFor - spinFor;
+
+        // The polling is shortened while the submissions outlast it, and
+        // lengthened again once they finish within it
+        if (result == vk::Result::eSuccess) {
+            this->mSpinBudget =
+              std::min(this->mSpinBudget * 2, this->mSpinDuration);
+        } else {
+            this->mSpinBudget =
+              std::max(this->mSpinBudget / 2, this->mSpinDuration / 16);
+        }
+    }
+
+    if (result != vk::Result::eSuccess &&
+        this->mWaitStrategy != WaitStrategy::eSpin) {
+        if (this->mTimelineSemaphore) {
+            VkSemaphore semaphore = this->mTimelineSemaphore;
+            VkSemaphoreWaitInfoKHR waitInfo = {};
+            waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR;
+            waitInfo.semaphoreCount = 1;
+            waitInfo.pSemaphores = &semaphore;
+            waitInfo.pValues = &submission.timelineValue;
+            result = static_cast<vk::Result>(
+              this->mWaitSemaphores(*this->mDevice, &waitInfo, blockFor));
+        } else {
+            // Batched submissions signal the fence shared by the whole batch
+            const vk::Fence& fence = submission.sharedFence
+                                       ? *submission.sharedFence
+                                       : submission.fence;
+            result =
+              this->mDevice->waitForFences(1, &fence, VK_TRUE, blockFor);
+        }
+    }
+
+    submission.pending = false;
+    submission.sharedFence = nullptr;
+    submission.timelineWaits.clear();
 
     if (result == vk::Result::eTimeout) {
         KP_LOG_WARN("Kompute Sequence evalAwait reached timeout of {}",
                     waitFor);
-        return shared_from_this();
+        // The memory objects stay pinned as the submission may still use
+        // them, but the sequence no longer tracks it
+        for (const std::shared_ptr<Memory>& mem :
+             submission.acquiredMemObjects) {
+            mem->releaseSubmission(*this->mComputeQueue);
+        }
+        return false;
     }
 
+    this->releaseMemObjects(submission);
+
     for (size_t i = 0; i < this->mOperations.size(); i++) {
-        this->mOperations[i]->postEval(*this->mCommandBuffer);
+        this->mOperations[i]->postEval(*submission.commandBuffer);
     }
 
+    return true;
+}
+
+void
+Sequence::releaseMemObjects(Submission& submission)
+{
+    if (this->mResidency) {
+        this->mResidency->release(submission.acquiredMemObjects);
+    }
+    for (const std::shared_ptr<Memory>& mem : submission.acquiredMemObjects) {
+        mem->releaseSubmission(*this->mComputeQueue);
+    }
+    submission.acquiredMemObjects.clear();
+}
+
+vk::Result
+Sequence::spinSubmission(const Submission& submission,
+                         uint64_t duration,
+                         bool backoff) const
+{
+    auto startTime = std::chrono::steady_clock::now();
+    uint32_t yields = 0;
+
+    while (!this->isSubmissionComplete(submission)) {
+        uint64_t elapsed =
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - startTime)
+            .count();
+        if (elapsed >= duration) {
+            return vk::Result::eTimeout;
+        }
+
+        // Backing off leaves the core to other threads as the wait grows
+        for (uint32_t i = 0; i < yields; i++) {
+            std::this_thread::yield();
+        }
+        if (backoff) {
+            yields = std::min(std::max(yields * 2, 1u), 64u);
+        }
+    }
+
+    return vk::Result::eSuccess;
+}
+
+bool
+Sequence::isSubmissionComplete(const Submission& submission) const
+{
+    if (this->mTimelineSemaphore) {
+        uint64_t value = 0;
+        this->mGetSemaphoreCounterValue(
+          *this->mDevice, this->mTimelineSemaphore, &value);
+        return value >= submission.timelineValue;
+    }
+
+    const vk::Fence& fence =
+      submission.sharedFence ? *submission.sharedFence : submission.fence;
+    return this->mDevice->getFenceStatus(fence) == vk::Result::eSuccess;
+}
+
+uint64_t
+Sequence::getLastTicket() const
+{
+    return this->mLastTicket;
+}
+
+void
+Sequence::setWaitStrategy(WaitStrategy strategy, uint64_t spinDuration)
+{
+    KP_LOG_DEBUG("Kompute Sequence setWaitStrategy {} with spin duration {}",
+                 static_cast<int>(strategy),
+                 spinDuration);
+
+    this->mWaitStrategy = strategy;
+    this->mSpinDuration = spinDuration;
+    this->mSpinBudget = spinDuration;
+}
+
+Sequence::WaitStrategy
+Sequence::getWaitStrategy() const
+{
+    return this->mWaitStrategy;
+}
+
+vk::Fence
+Sequence::getSubmissionFence(uint64_t ticket) const
+{
+    if (!this->isRunning(ticket)) {
+        throw std::runtime_error(fmt::format(
+          "Kompute Sequence ticket {} is not in flight", ticket));
+    }
+
+    const Submission& submission =
+      this->mSubmissions[(ticket - 1) % this->mSubmissions.size()];
+    return submission.sharedFence ? *submission.sharedFence
+                                  : submission.fence;
+}
+
+uint32_t
+Sequence::getBufferCount() const
+{
+    return this->mSubmissions.size();
+}
+
+std::shared_ptr<ParameterBlock>
+Sequence::parameterBlock(std::shared_ptr<Tensor> tensor)
+{
+    KP_LOG_DEBUG("Kompute Sequence creating parameter block");
+
+    if (!this->mDevice) {
+        throw std::runtime_error("Kompute Sequence device is null");
+    }
+
+    std::vector<vk::CommandBuffer> commandBuffers;
+    for (const Submission& submission : this->mSubmissions) {
+        commandBuffers.push_back(*submission.commandBuffer);
+    }
+
+    std::shared_ptr<ParameterBlock> block = std::make_shared<ParameterBlock>(
+      this->mPhysicalDevice, this->mDevice, tensor, commandBuffers);
+
+    // Blocks that were released since don't need to be kept
+    this->mParameterBlocks.erase(
+      std::remove_if(this->mParameterBlocks.begin(),
+                     this->mParameterBlocks.end(),
+                     [](const std::weak_ptr<ParameterBlock>& weakBlock) {
+                         return weakBlock.expired();
+                     }),
+      this->mParameterBlocks.end());
+    this->mParameterBlocks.push_back(block);
+
+    return block;
+}
+
+std::shared_ptr<vk::Queue>
+Sequence::getComputeQueue() const
+{
+    return this->mComputeQueue;
+}
+
+void
+Sequence::enableTimeline()
+{
+    KP_LOG_DEBUG("Kompute Sequence enabling timeline semaphore");
+
+    if (this->mTimelineSemaphore) {
+        KP_LOG_WARN("Kompute Sequence timeline semaphore already enabled");
+        return;
+    }
+
+    // The extension commands aren't exported by the loader
+    this->mWaitSemaphores = reinterpret_cast<PFN_vkWaitSemaphoresKHR>(
+      this->mDevice->getProcAddr("vkWaitSemaphoresKHR"));
+    this->mGetSemaphoreCounterValue =
+      reinterpret_cast<PFN_vkGetSemaphoreCounterValueKHR>(
+        this->mDevice->getProcAddr("vkGetSemaphoreCounterValueKHR"));
+    if (!this->mWaitSemaphores || !this->mGetSemaphoreCounterValue) {
+        throw std::runtime_error("Kompute Sequence timeline semaphores "
+                                 "require VK_KHR_timeline_semaphore");
+    }
+
+    vk::SemaphoreTypeCreateInfoKHR semaphoreTypeInfo(
+      vk::SemaphoreTypeKHR::eTimeline, this->mTimelineValue);
+    vk::SemaphoreCreateInfo semaphoreInfo;
+    semaphoreInfo.setPNext(&semaphoreTypeInfo);
+
+    this->mTimelineSemaphore = this->mDevice->createSemaphore(semaphoreInfo);
+}
+
+bool
+Sequence::isTimelineEnabled() const
+{
+    return static_cast<bool>(this->mTimelineSemaphore);
+}
+
+std::shared_ptr<Sequence>
+Sequence::waitFor(std::shared_ptr<Sequence> sequence,
+                  uint64_t value,
+                  vk::PipelineStageFlags stages)
+{
+    if (!this->mTimelineSemaphore || !sequence->mTimelineSemaphore) {
+        throw std::runtime_error("Kompute Sequence waitFor requires both "
+                                 "sequences to have a timeline semaphore");
+    }
+    if (value == 0) {
+        value = sequence->getTimelineValue();
+    }
+
+    KP_LOG_DEBUG("Kompute Sequence next submission waits for timeline "
+                 "value {}",
+                 value);
+
+    this->mTimelineWaits.push_back({ sequence, value, stages });
+
+    return shared_from_this();
+}
+
+std::shared_ptr<Sequence>
+Sequence::signal(uint64_t value)
+{
+    if (!this->mTimelineSemaphore) {
+        throw std::runtime_error(
+          "Kompute Sequence signal requires a timeline semaphore");
+    }
+    if (value <= this->mTimelineValue) {
+        throw std::runtime_error(fmt::format(
+          "Kompute Sequence signal value {} has to be greater than {}",
+          value,
+          this->mTimelineValue));
+    }
+
+    this->mSignalValue = value;
+
     return shared_from_this();
 }
 
+uint64_t
+Sequence::getTimelineValue() const
+{
+    return this->mTimelineValue;
+}
+
+uint64_t
+Sequence::getCompletedTimelineValue() const
+{
+    if (!this->mTimelineSemaphore) {
+        return 0;
+    }
+
+    uint64_t value = 0;
+    this->mGetSemaphoreCounterValue(
+      *this->mDevice, this->mTimelineSemaphore, &value);
+    return value;
+}
+
 bool
 Sequence::isRunning() const
 {
-    return this->mIsRunning;
+    for (const Submission& submission : this->mSubmissions) {
+        if (submission.pending) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool
+Sequence::isRunning(uint64_t ticket) const
+{
+    if (ticket == 0 || ticket > this->mLastTicket ||
+        this->mSubmissions.empty()) {
+        return false;
+    }
+
+    const Submission& submission =
+      this->mSubmissions[(ticket - 1) % this->mSubmissions.size()];
+    return submission.pending && submission.ticket == ticket;
 }
 
 bool
@@ -195,9 +744,16 @@ Sequence::isInit() const
 void
 Sequence::rerecord()
 {
-    this->end();
+    if (this->isRecording()) {
+        this->end();
+    }
     std::vector<std::shared_ptr<OpBase>> ops = this->mOperations;
     this->mOperations.clear();
+
+    // The transient tensors are planned again, which also records the
+    // barriers between the tensors that share memory
+    this->releaseTransientMemory();
+
     for (const std::shared_ptr<kp::OpBase>& op : ops) {
         this->record(op);
     }
@@ -214,9 +770,34 @@ Sequence::destroy()
         return;
     }
 
-    if (this->mFence) {
+    if (this->mTimelineSemaphore) {
         this->mDevice->destroy(
-          this->mFence, (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+          this->mTimelineSemaphore,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        this->mTimelineSemaphore = nullptr;
+    }
+    this->mTimelineWaits.clear();
+
+    for (const std::weak_ptr<ParameterBlock>& weakBlock :
+         this->mParameterBlocks) {
+        if (std::shared_ptr<ParameterBlock> block = weakBlock.lock()) {
+            block->destroy();
+        }
+    }
+    this->mParameterBlocks.clear();
+
+    for (Submission& submission : this->mSubmissions) {
+        submission.timelineWaits.clear();
+        if (submission.pending) {
+            submission.pending = false;
+            this->releaseMemObjects(submission);
+        }
+        if (submission.fence) {
+            this->mDevice->destroy(
+              submission.fence,
+              (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+            submission.fence = nullptr;
+        }
     }
 
     if (this->mFreeCommandBuffer) {
@@ -226,9 +807,15 @@ Sequence::destroy()
                         "CommandPool pointer");
             return;
         }
-        this->mDevice->freeCommandBuffers(
-          *this->mCommandPool, 1, this->mCommandBuffer.get());
+        std::vector<vk::CommandBuffer> commandBuffers;
+        for (const Submission& submission : this->mSubmissions) {
+            commandBuffers.push_back(*submission.commandBuffer);
+        }
+        this->mDevice->freeCommandBuffers(*this->mCommandPool,
+                                          commandBuffers.size(),
+                                          commandBuffers.data());
 
+        this->mSubmissions.clear();
         this->mCommandBuffer = nullptr;
         this->mFreeCommandBuffer = false;
 
@@ -257,6 +844,8 @@ Sequence::destroy()
         this->mOperations.clear();
     }
 
+    this->releaseTransientMemory();
+
     if (this->timestampQueryPool) {
         KP_LOG_INFO("Destroying QueryPool");
         this->mDevice->destroy(
@@ -267,6 +856,15 @@ Sequence::destroy()
         KP_LOG_DEBUG("Kompute Sequence Destroyed QueryPool");
     }
 
+    if (this->mStatisticsQueryPool) {
+        KP_LOG_INFO("Destroying pipeline statistics QueryPool");
+        this->mDevice->destroy(
+          *this->mStatisticsQueryPool,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+
+        this->mStatisticsQueryPool = nullptr;
+    }
+
     if (this->mDevice) {
         this->mDevice = nullptr;
     }
@@ -285,18 +883,158 @@ Sequence::record(std::shared_ptr<OpBase> op)
 
     this->begin();
 
+    // The plan of the sequence that bound a transient tensor only accounts
+    // for the operations of that sequence
+    if (this->usesForeignTransientMemory(op)) {
+        throw std::runtime_error(
+          "Kompute Sequence can't record operations using eTransient memory "
+          "objects planned by another sequence, which has to be cleared or "
+          "destroyed first");
+    }
+
+    if (this->mResidency) {
+        this->mResidency->restore(op->getMemObjects());
+    }
+
+    this->checkStagingRingSyncs(op);
+
+    // Operations using transient memory are recorded once it's planned
+    if (!this->mDeferRecording && usesUnboundTransientMemory(op)) {
+        KP_LOG_DEBUG("Kompute Sequence deferring record until transient "
+                     "memory is planned");
+        this->mDeferRecording = true;
+        this->mFirstDeferredOperation = this->mOperations.size();
+    }
+
+    if (this->mDeferRecording) {
+        this->mOperations.push_back(op);
+        return shared_from_this();
+    }
+
     KP_LOG_DEBUG(
       "Kompute Sequence running record on OpBase derived class instance");
 
-    op->record(*this->mCommandBuffer);
-
     this->mOperations.push_back(op);
 
-    if (this->timestampQueryPool)
-        this->mCommandBuffer->writeTimestamp(
-          vk::PipelineStageFlagBits::eAllCommands,
-          *this->timestampQueryPool,
-          this->mOperations.size());
+    this->mHazardBarriers.resize(this->mOperations.size());
+
+    try {
+        this->mHazardBarriers.back() = this->mHazardTracker.plan(op);
+        this->recordOperation(*this->mCommandBuffer,
+                              this->mOperations.size() - 1);
+    } catch (...) {
+        this->mOperations.pop_back();
+        this->mHazardBarriers.pop_back();
+        throw;
+    }
+
+    return shared_from_this();
+}
+
+std::shared_ptr<Sequence>
+Sequence::record(std::shared_ptr<SequenceFragment> fragment)
+{
+    if (fragment && fragment->getQueueIndex() != this->mQueueIndex) {
+        throw std::runtime_error(fmt::format(
+          "Kompute Sequence can't execute a fragment recorded for queue "
+          "family {} on queue family {}",
+          fragment->getQueueIndex(),
+          this->mQueueIndex));
+    }
+
+    return this->record(std::make_shared<OpExecuteFragment>(fragment));
+}
+
+std::shared_ptr<Sequence>
+Sequence::record(std::shared_ptr<ParameterBlock> parameterBlock)
+{
+    return this->record(std::make_shared<OpSyncParameters>(parameterBlock));
+}
+
+std::shared_ptr<Sequence>
+Sequence::recordParallel(const std::vector<std::shared_ptr<OpBase>>& ops,
+                         uint32_t numThreads)
+{
+    KP_LOG_DEBUG("Kompute Sequence recording {} operations with {} threads",
+                 ops.size(),
+                 numThreads);
+
+    if (numThreads == 0) {
+        throw std::runtime_error(
+          "Kompute Sequence recordParallel requires at least one thread");
+    }
+    if (ops.empty()) {
+        return shared_from_this();
+    }
+    numThreads = static_cast<uint32_t>(
+      std::min<size_t>(numThreads, ops.size()));
+
+    // Memory objects are restored before recording, so the threads only
+    // read them
+    std::vector<std::shared_ptr<Memory>> memObjects;
+    for (const std::shared_ptr<OpBase>& op : ops) {
+        if (std::dynamic_pointer_cast<OpResize>(op)) {
+            throw std::runtime_error(
+              "Kompute Sequence can't record OpResize operations in parallel");
+        }
+        std::vector<std::shared_ptr<Memory>> opMemObjects =
+          op->getMemObjects();
+        memObjects.insert(
+          memObjects.end(), opMemObjects.begin(), opMemObjects.end());
+    }
+    if (this->mResidency) {
+        this->mResidency->restore(memObjects);
+    }
+
+    std::vector<std::shared_ptr<SequenceFragment>> fragments(numThreads);
+    for (std::shared_ptr<SequenceFragment>& fragment : fragments) {
+        fragment = std::make_shared<SequenceFragment>(
+          this->mDevice, this->mQueueIndex, this->mResidency);
+    }
+
+    // The first ranges take one more operation when they don't divide evenly
+    std::vector<std::exception_ptr> errors(numThreads);
+    auto recordRange = [&](uint32_t t) {
+        size_t rangeSize = ops.size() / numThreads;
+        size_t remainder = ops.size() % numThreads;
+        size_t first = t * rangeSize + std::min<size_t>(t, remainder);
+        size_t last = first + rangeSize + (t < remainder ? 1 : 0);
+        try {
+            for (size_t i = first; i < last; i++) {
+                fragments[t]->record(ops[i]);
+            }
+            fragments[t]->end();
+        } catch (...) {
+            errors[t] = std::current_exception();
+        }
+    };
+
+    // The calling thread records the first range
+    std::vector<std::thread> threads;
+    try {
+        for (uint32_t t = 1; t < numThreads; t++) {
+            threads.emplace_back(recordRange, t);
+        }
+    } catch (...) {
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        throw;
+    }
+    recordRange(0);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    for (const std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    for (const std::shared_ptr<SequenceFragment>& fragment : fragments) {
+        this->record(fragment);
+    }
 
     return shared_from_this();
 }
@@ -321,9 +1059,9 @@ Sequence::createCommandPool()
 }
 
 void
-Sequence::createCommandBuffer()
+Sequence::createCommandBuffer(uint32_t numBuffers)
 {
-    KP_LOG_DEBUG("Kompute Sequence creating command buffer");
+    KP_LOG_DEBUG("Kompute Sequence creating {} command buffers", numBuffers);
     if (!this->mDevice) {
         throw std::runtime_error("Kompute Sequence device is null");
     }
@@ -334,11 +1072,21 @@ Sequence::createCommandBuffer()
     this->mFreeCommandBuffer = true;
 
     vk::CommandBufferAllocateInfo commandBufferAllocateInfo(
-      *this->mCommandPool, vk::CommandBufferLevel::ePrimary, 1);
+      *this->mCommandPool, vk::CommandBufferLevel::ePrimary, numBuffers);
 
-    this->mCommandBuffer = std::make_shared<vk::CommandBuffer>();
+    std::vector<vk::CommandBuffer> commandBuffers(numBuffers);
     this->mDevice->allocateCommandBuffers(&commandBufferAllocateInfo,
-                                          this->mCommandBuffer.get());
+                                          commandBuffers.data());
+
+    this->mSubmissions.resize(numBuffers);
+    for (uint32_t i = 0; i < numBuffers; i++) {
+        this->mSubmissions[i].commandBuffer =
+          std::make_shared<vk::CommandBuffer>(commandBuffers[i]);
+    }
+
+    // Operations are recorded into the first command buffer, and replayed
+    // into the others when the recording ends
+    this->mCommandBuffer = this->mSubmissions[0].commandBuffer;
     KP_LOG_DEBUG("Kompute Sequence Command Buffer Created");
 }
 
@@ -363,6 +1111,7 @@ Sequence::createTimestampQueryPool(uint32_t totalTimestamps)
         queryPoolInfo.setQueryType(vk::QueryType::eTimestamp);
         this->timestampQueryPool = std::make_shared<vk::QueryPool>(
           this->mDevice->createQueryPool(queryPoolInfo));
+        this->mTimestampCount = totalTimestamps;
 
         KP_LOG_DEBUG("Query pool for timestamps created");
     } else {
@@ -390,4 +1139,626 @@ Sequence::getTimestamps()
     return timestamps;
 }
 
+bool
+Sequence::tryGetTimestamps(std::vector<std::uint64_t>& timestamps)
+{
+    if (!this->timestampQueryPool)
+        throw std::runtime_error("Timestamp latching not enabled");
+
+    // The queries of a submission still running may not have been reset yet,
+    // in which case they would report the timestamps of the previous eval
+    for (const Submission& submission : this->mSubmissions) {
+        if (submission.pending && !this->isSubmissionComplete(submission)) {
+            return false;
+        }
+    }
+
+    // Each timestamp is followed by its availability
+    const auto n = std::min<size_t>(this->mOperations.size() + 1,
+                                    this->mTimestampCount);
+    std::vector<std::uint64_t> results(n * 2, 0);
+    vk::Result result = this->mDevice->getQueryPoolResults(
+      *this->timestampQueryPool,
+      0,
+      n,
+      results.size() * sizeof(std::uint64_t),
+      results.data(),
+      2 * sizeof(std::uint64_t),
+      vk::QueryResultFlagBits::e64 |
+        vk::QueryResultFlagBits::eWithAvailability);
+    if (result != vk::Result::eSuccess && result != vk::Result::eNotReady) {
+        return false;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        if (!results[2 * i + 1]) {
+            return false;
+        }
+    }
+
+    timestamps.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        timestamps[i] = results[2 * i];
+    }
+    return true;
+}
+
+void
+Sequence::enablePipelineStatistics(uint32_t totalQueries)
+{
+    KP_LOG_DEBUG("Kompute Sequence enabling pipeline statistics for {} "
+                 "operations",
+                 totalQueries);
+
+    if (!this->isInit()) {
+        throw std::runtime_error("Kompute Sequence enablePipelineStatistics "
+                                 "called on uninitialized Sequence");
+    }
+    if (this->mStatisticsQueryPool) {
+        KP_LOG_WARN("Kompute Sequence pipeline statistics already enabled");
+        return;
+    }
+    if (this->mSubmissions.size() > 1) {
+        throw std::runtime_error("Kompute Sequence pipeline statistics are "
+                                 "only supported with a single command "
+                                 "buffer");
+    }
+    if (!this->mPhysicalDevice->getFeatures().pipelineStatisticsQuery) {
+        throw std::runtime_error(
+          "Device does not support pipeline statistics queries");
+    }
+
+    vk::QueryPoolCreateInfo queryPoolInfo;
+    queryPoolInfo.setQueryCount(totalQueries);
+    queryPoolInfo.setQueryType(vk::QueryType::ePipelineStatistics);
+    queryPoolInfo.setPipelineStatistics(
+      vk::QueryPipelineStatisticFlagBits::eComputeShaderInvocations);
+    this->mStatisticsQueryPool = std::make_shared<vk::QueryPool>(
+      this->mDevice->createQueryPool(queryPoolInfo));
+    this->mStatisticsCount = totalQueries;
+    this->mFirstStatisticsOperation = this->mOperations.size();
+
+    // Queries have to be reset before they are used by the recording ongoing
+    if (this->isRecording()) {
+        this->mCommandBuffer->resetQueryPool(
+          *this->mStatisticsQueryPool, 0, this->mStatisticsCount);
+    }
+
+    KP_LOG_DEBUG("Query pool for pipeline statistics created");
+}
+
+bool
+Sequence::isPipelineStatisticsEnabled() const
+{
+    return this->mStatisticsQueryPool != nullptr;
+}
+
+std::vector<std::uint64_t>
+Sequence::getPipelineStatistics()
+{
+    if (!this->mStatisticsQueryPool)
+        throw std::runtime_error("Pipeline statistics not enabled");
+
+    // Operations that were not queried have no results to wait for
+    std::vector<std::uint64_t> invocations(this->mOperations.size(), 0);
+    for (size_t i = 0; i < this->mOperations.size(); i++) {
+        if (!this->isStatisticsQueried(i)) {
+            continue;
+        }
+        this->mDevice->getQueryPoolResults(
+          *this->mStatisticsQueryPool,
+          i,
+          1,
+          sizeof(std::uint64_t),
+          &invocations[i],
+          sizeof(std::uint64_t),
+          vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWait);
+    }
+
+    return invocations;
+}
+
+std::vector<Sequence::DispatchStatistics>
+Sequence::getOverDispatchedOperations(double factor)
+{
+    std::vector<std::uint64_t> invocations = this->getPipelineStatistics();
+
+    std::vector<DispatchStatistics> overDispatched;
+    for (size_t i = 0; i < this->mOperations.size(); i++) {
+        if (!this->isStatisticsQueried(i)) {
+            continue;
+        }
+
+        DispatchStatistics statistics;
+        statistics.operationIndex = i;
+        statistics.invocations = invocations[i];
+        for (const std::shared_ptr<Memory>& mem :
+             this->mOperations[i]->getMemObjects()) {
+            statistics.boundElements =
+              std::max<uint64_t>(statistics.boundElements, mem->size());
+        }
+
+        if (statistics.invocations > factor * statistics.boundElements) {
+            overDispatched.push_back(statistics);
+        }
+    }
+
+    return overDispatched;
+}
+
+std::vector<std::string>
+Sequence::getOperationNames() const
+{
+    std::vector<std::string> names;
+    for (const std::shared_ptr<OpBase>& op : this->mOperations) {
+        names.push_back(op->name());
+    }
+    return names;
+}
+
+Sequence::TransientMemoryStats
+Sequence::getTransientMemoryStats() const
+{
+    return this->mTransientMemoryStats;
+}
+
+Sequence::BarrierStats
+Sequence::getBarrierStats() const
+{
+    return this->mHazardTracker.stats();
+}
+
+std::vector<std::shared_ptr<Memory>>
+Sequence::getMemObjects()
+{
+    std::vector<std::shared_ptr<Memory>> memObjects;
+    for (const std::shared_ptr<OpBase>& op : this->mOperations) {
+        for (const std::shared_ptr<Memory>& mem : op->getMemObjects()) {
+            if (std::find(memObjects.begin(), memObjects.end(), mem) ==
+                memObjects.end()) {
+                memObjects.push_back(mem);
+            }
+        }
+    }
+    return memObjects;
+}
+
+std::vector<uint64_t>
+Sequence::getMemGenerations()
+{
+    std::vector<uint64_t> generations;
+    for (const std::shared_ptr<OpBase>& op : this->mOperations) {
+        for (const std::shared_ptr<Memory>& mem : op->getMemObjects()) {
+            generations.push_back(mem->generation());
+        }
+    }
+    return generations;
+}
+
+bool
+Sequence::usesUnboundTransientMemory(const std::shared_ptr<OpBase>& op)
+{
+    for (const std::shared_ptr<Memory>& mem : op->getMemObjects()) {
+        if (mem->memoryType() == Memory::MemoryTypes::eTransient &&
+            !mem->isMemoryBound()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Whether two memory objects are tensors that share the same buffer, such as
+// a tensor and its views
+static bool
+sharesBuffer(const std::shared_ptr<Memory>& a, const std::shared_ptr<Memory>& b)
+{
+    if (a->type() != Memory::Type::eTensor ||
+        b->type() != Memory::Type::eTensor) {
+        return false;
+    }
+    std::shared_ptr<vk::Buffer> buffer =
+      std::static_pointer_cast<Tensor>(a)->getPrimaryBuffer();
+    return buffer &&
+           buffer == std::static_pointer_cast<Tensor>(b)->getPrimaryBuffer();
+}
+
+static bool
+usesStagingRing(const std::shared_ptr<Memory>& mem)
+{
+    return mem->type() == Memory::Type::eTensor &&
+           std::static_pointer_cast<Tensor>(mem)->usesStagingRing();
+}
+
+void
+Sequence::checkStagingRingSyncs(const std::shared_ptr<OpBase>& op)
+{
+    // The staging ring uploads the data of OpSyncDevice before the submission
+    // and downloads the data of OpSyncLocal after it, which only matches the
+    // order of the operations if no earlier operation accesses an uploaded
+    // tensor and no later operation writes a downloaded tensor
+    if (std::dynamic_pointer_cast<OpSyncDevice>(op)) {
+        for (const std::shared_ptr<Memory>& mem : op->getMemObjects()) {
+            if (!usesStagingRing(mem)) {
+                continue;
+            }
+            for (const std::shared_ptr<OpBase>& earlier : this->mOperations) {
+                for (const std::shared_ptr<Memory>& other :
+                     earlier->getMemObjects()) {
+                    if (sharesBuffer(mem, other)) {
+                        throw std::runtime_error(
+                          "Kompute Sequence can't record OpSyncDevice of a "
+                          "tensor using the staging ring after operations "
+                          "that access it, as it is uploaded before the "
+                          "submission");
+                    }
+                }
+            }
+        }
+    }
+
+    if (std::dynamic_pointer_cast<OpSyncLocal>(op)) {
+        return;
+    }
+
+    // Operations that don't declare their accesses may write any of their
+    // memory objects
+    std::vector<std::shared_ptr<Memory>> written;
+    std::vector<OpBase::MemoryAccess> accesses = op->getMemoryAccesses();
+    if (accesses.empty()) {
+        written = op->getMemObjects();
+    }
+    for (const OpBase::MemoryAccess& access : accesses) {
+        if (access.write) {
+            written.push_back(access.memory);
+        }
+    }
+
+    for (const std::shared_ptr<OpBase>& earlier : this->mOperations) {
+        if (!std::dynamic_pointer_cast<OpSyncLocal>(earlier)) {
+            continue;
+        }
+        for (const std::shared_ptr<Memory>& mem : earlier->getMemObjects()) {
+            if (!usesStagingRing(mem)) {
+                continue;
+            }
+            for (const std::shared_ptr<Memory>& other : written) {
+                if (sharesBuffer(mem, other)) {
+                    throw std::runtime_error(
+                      "Kompute Sequence can't record operations that write "
+                      "a tensor using the staging ring after its "
+                      "OpSyncLocal, as it is downloaded after the "
+                      "submission");
+                }
+            }
+        }
+    }
+}
+
+bool
+Sequence::usesForeignTransientMemory(const std::shared_ptr<OpBase>& op)
+{
+    for (const std::shared_ptr<Memory>& mem : op->getMemObjects()) {
+        if (mem->memoryType() != Memory::MemoryTypes::eTransient ||
+            !mem->isMemoryBound()) {
+            continue;
+        }
+        auto it = std::find_if(this->mTransientTensors.begin(),
+                               this->mTransientTensors.end(),
+                               [&mem](const std::weak_ptr<Tensor>& tensor) {
+                                   return tensor.lock() == mem;
+                               });
+        if (it == this->mTransientTensors.end()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+Sequence::recordDeferredOperations()
+{
+    KP_LOG_DEBUG("Kompute Sequence recording deferred operations");
+
+    this->mDeferRecording = false;
+
+    this->mAliasBarriers = this->planTransientMemory();
+    this->mHazardBarriers.resize(this->mOperations.size());
+
+    for (size_t i = this->mFirstDeferredOperation;
+         i < this->mOperations.size();
+         i++) {
+        this->mHazardBarriers[i] =
+          this->mHazardTracker.plan(this->mOperations[i]);
+        this->recordOperation(*this->mCommandBuffer, i);
+    }
+}
+
+void
+Sequence::recordAliasBarrier(const vk::CommandBuffer& commandBuffer)
+{
+    // Writes to memory that is reused by a transient tensor have to finish
+    // before the operations using the tensor access it
+    vk::MemoryBarrier memoryBarrier(
+      vk::AccessFlagBits::eShaderWrite | vk::AccessFlagBits::eTransferWrite,
+      vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite |
+        vk::AccessFlagBits::eTransferRead |
+        vk::AccessFlagBits::eTransferWrite);
+
+    commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader |
+                                    vk::PipelineStageFlagBits::eTransfer,
+                                  vk::PipelineStageFlagBits::eComputeShader |
+                                    vk::PipelineStageFlagBits::eTransfer,
+                                  vk::DependencyFlags(),
+                                  memoryBarrier,
+                                  nullptr,
+                                  nullptr);
+}
+
+void
+Sequence::replayOperations()
+{
+    KP_LOG_DEBUG("Kompute Sequence replaying operations into {} command "
+                 "buffers",
+                 this->mSubmissions.size() - 1);
+
+    for (size_t b = 1; b < this->mSubmissions.size(); b++) {
+        const vk::CommandBuffer& commandBuffer =
+          *this->mSubmissions[b].commandBuffer;
+
+        commandBuffer.begin(vk::CommandBufferBeginInfo());
+        for (size_t i = this->mFirstRecordedOperation;
+             i < this->mOperations.size();
+             i++) {
+            this->recordOperation(commandBuffer, i);
+        }
+        commandBuffer.end();
+    }
+}
+
+void
+Sequence::recordOperation(const vk::CommandBuffer& commandBuffer,
+                          size_t index)
+{
+    if (index < this->mAliasBarriers.size() && this->mAliasBarriers[index]) {
+        this->recordAliasBarrier(commandBuffer);
+    }
+
+    if (index < this->mHazardBarriers.size()) {
+        HazardTracker::record(commandBuffer, this->mHazardBarriers[index]);
+    }
+
+    bool queried = this->isStatisticsQueried(index);
+    if (queried) {
+        commandBuffer.beginQuery(
+          *this->mStatisticsQueryPool, index, vk::QueryControlFlags());
+    }
+
+    this->mOperations[index]->record(commandBuffer);
+
+    if (queried) {
+        commandBuffer.endQuery(*this->mStatisticsQueryPool, index);
+    }
+
+    if (this->timestampQueryPool)
+        commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eAllCommands,
+                                     *this->timestampQueryPool,
+                                     index + 1);
+}
+
+bool
+Sequence::isStatisticsQueried(size_t index) const
+{
+    // Queries can't stay active across the secondary command buffers of
+    // fragments, so only dispatches recorded in the sequence are queried
+    return this->mStatisticsQueryPool &&
+           index >= this->mFirstStatisticsOperation &&
+           index < this->mStatisticsCount &&
+           std::dynamic_pointer_cast<OpAlgoDispatch>(this->mOperations[index]);
+}
+
+void
+Sequence::releaseTransientMemory()
+{
+    // The statistics describe the memory planned for the current recording
+    this->mTransientMemoryStats = TransientMemoryStats();
+
+    if (this->mTransientMemories.empty()) {
+        return;
+    }
+
+    // The memory can't be freed while submissions still use it
+    if (this->isRunning()) {
+        this->evalAwait();
+    }
+
+    KP_LOG_INFO("Kompute Sequence freeing transient memory");
+
+    for (const std::weak_ptr<Tensor>& weakTensor : this->mTransientTensors) {
+        std::shared_ptr<Tensor> tensor = weakTensor.lock();
+        if (tensor && tensor->isInit()) {
+            tensor->unbindTransientMemory();
+        }
+    }
+    this->mTransientTensors.clear();
+
+    for (const std::shared_ptr<vk::DeviceMemory>& memory :
+         this->mTransientMemories) {
+        this->mDevice->freeMemory(
+          *memory, (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    }
+    this->mTransientMemories.clear();
+}
+
+std::vector<bool>
+Sequence::planTransientMemory()
+{
+    struct TransientRange
+    {
+        std::shared_ptr<Tensor> tensor;
+        vk::MemoryRequirements memoryRequirements;
+        size_t firstOperation;
+        size_t lastOperation;
+        vk::DeviceSize offset;
+    };
+
+    std::vector<bool> aliasBarriers(this->mOperations.size(), false);
+
+    // The live range of a transient tensor goes from the first to the last
+    // operation that uses it
+    std::vector<TransientRange> ranges;
+    std::unordered_map<Memory*, size_t> rangeIndices;
+    uint32_t memoryTypeBits = UINT32_MAX;
+
+    for (size_t i = this->mFirstDeferredOperation;
+         i < this->mOperations.size();
+         i++) {
+        for (const std::shared_ptr<Memory>& mem :
+             this->mOperations[i]->getMemObjects()) {
+            if (mem->memoryType() != Memory::MemoryTypes::eTransient ||
+                mem->isMemoryBound()) {
+                continue;
+            }
+
+            auto it = rangeIndices.find(mem.get());
+            if (it != rangeIndices.end()) {
+                ranges[it->second].lastOperation = i;
+                continue;
+            }
+
+            std::shared_ptr<Tensor> tensor =
+              std::static_pointer_cast<Tensor>(mem);
+            vk::MemoryRequirements memoryRequirements =
+              this->mDevice->getBufferMemoryRequirements(
+                *tensor->getPrimaryBuffer());
+            memoryTypeBits &= memoryRequirements.memoryTypeBits;
+
+            rangeIndices[mem.get()] = ranges.size();
+            ranges.push_back({ tensor, memoryRequirements, i, i, 0 });
+        }
+    }
+
+    if (ranges.empty()) {
+        return aliasBarriers;
+    }
+
+    // Place the largest tensors first at the lowest offset that doesn't
+    // overlap with the placed tensors that are alive at the same time
+    std::vector<size_t> order;
+    for (size_t i = 0; i < ranges.size(); i++) {
+        order.push_back(i);
+    }
+    std::sort(order.begin(), order.end(), [&ranges](size_t a, size_t b) {
+        if (ranges[a].memoryRequirements.size !=
+            ranges[b].memoryRequirements.size) {
+            return ranges[a].memoryRequirements.size >
+                   ranges[b].memoryRequirements.size;
+        }
+        return ranges[a].firstOperation < ranges[b].firstOperation;
+    });
+
+    std::vector<size_t> placed;
+    vk::DeviceSize requestedSize = 0;
+    vk::DeviceSize allocationSize = 0;
+
+    for (size_t index : order) {
+        TransientRange& range = ranges[index];
+
+        std::vector<size_t> alive;
+        for (size_t other : placed) {
+            if (ranges[other].firstOperation <= range.lastOperation &&
+                range.firstOperation <= ranges[other].lastOperation) {
+                alive.push_back(other);
+            }
+        }
+        std::sort(alive.begin(), alive.end(), [&ranges](size_t a, size_t b) {
+            return ranges[a].offset < ranges[b].offset;
+        });
+
+        vk::DeviceSize size = range.memoryRequirements.size;
+        vk::DeviceSize alignment =
+          std::max<vk::DeviceSize>(range.memoryRequirements.alignment, 1);
+        vk::DeviceSize offset = 0;
+        for (size_t other : alive) {
+            vk::DeviceSize aligned =
+              (offset + alignment - 1) / alignment * alignment;
+            if (aligned + size <= ranges[other].offset) {
+                break;
+            }
+            offset = std::max(offset,
+                              ranges[other].offset +
+                                ranges[other].memoryRequirements.size);
+        }
+        range.offset = (offset + alignment - 1) / alignment * alignment;
+
+        placed.push_back(index);
+        requestedSize += size;
+        allocationSize = std::max(allocationSize, range.offset + size);
+    }
+
+    // Tensors that reuse the memory of a tensor whose live range has ended
+    // need a barrier before their first operation
+    for (const TransientRange& range : ranges) {
+        for (const TransientRange& other : ranges) {
+            if (other.lastOperation < range.firstOperation &&
+                other.offset < range.offset + range.memoryRequirements.size &&
+                range.offset < other.offset + other.memoryRequirements.size) {
+                aliasBarriers[range.firstOperation] = true;
+            }
+        }
+    }
+
+    vk::PhysicalDeviceMemoryProperties memoryProperties =
+      this->mPhysicalDevice->getMemoryProperties();
+    uint32_t memoryTypeIndex = UINT32_MAX;
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+        if ((memoryTypeBits & (1 << i)) &&
+            (memoryProperties.memoryTypes[i].propertyFlags &
+             vk::MemoryPropertyFlagBits::eDeviceLocal)) {
+            memoryTypeIndex = i;
+            break;
+        }
+    }
+    if (memoryTypeIndex == UINT32_MAX) {
+        throw std::runtime_error(
+          "Kompute Sequence device local memory type for transient tensors "
+          "not found");
+    }
+
+    KP_LOG_DEBUG("Kompute Sequence allocating transient memory index: {}, "
+                 "size {}",
+                 memoryTypeIndex,
+                 allocationSize);
+
+    vk::MemoryAllocateInfo memoryAllocateInfo(allocationSize, memoryTypeIndex);
+    std::shared_ptr<vk::DeviceMemory> memory =
+      std::make_shared<vk::DeviceMemory>();
+    this->mDevice->allocateMemory(&memoryAllocateInfo, nullptr, memory.get());
+    this->mTransientMemories.push_back(memory);
+
+    for (const TransientRange& range : ranges) {
+        range.tensor->bindTransientMemory(
+          memory,
+          range.offset,
+          memoryProperties.memoryTypes[memoryTypeIndex].propertyFlags);
+        this->mTransientTensors.push_back(range.tensor);
+    }
+
+    vk::DeviceSize savedSize =
+      requestedSize > allocationSize ? requestedSize - allocationSize : 0;
+
+    this->mTransientMemoryStats.tensorCount += ranges.size();
+    this->mTransientMemoryStats.requestedBytes += requestedSize;
+    this->mTransientMemoryStats.allocatedBytes += allocationSize;
+    this->mTransientMemoryStats.savedBytes += savedSize;
+
+    KP_LOG_INFO("Kompute Sequence bound {} transient tensors to {} bytes, "
+                "saving {} of {} bytes",
+                ranges.size(),
+                allocationSize,
+                savedSize,
+                requestedSize);
+
+    return aliasBarriers;
+}
+
 }
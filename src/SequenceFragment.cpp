@@ -0,0 +1,317 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+
+#include "kompute/SequenceFragment.hpp"
+
+namespace kp {
+
+SequenceFragment::SequenceFragment(std::shared_ptr<vk::Device> device,
+                                   uint32_t queueIndex,
+                                   std::shared_ptr<Residency> residency)
+{
+    KP_LOG_DEBUG("Kompute SequenceFragment constructor");
+
+    if (!device) {
+        throw std::runtime_error("Kompute SequenceFragment device is null");
+    }
+
+    this->mDevice = device;
+    this->mQueueIndex = queueIndex;
+    this->mResidency = residency;
+
+    vk::CommandPoolCreateInfo commandPoolInfo(
+      vk::CommandPoolCreateFlagBits::eResetCommandBuffer, this->mQueueIndex);
+    this->mCommandPool = std::make_shared<vk::CommandPool>();
+    this->mDevice->createCommandPool(
+      &commandPoolInfo, nullptr, this->mCommandPool.get());
+
+    this->mCommandBuffer = this->allocateCommandBuffer();
+}
+
+SequenceFragment::~SequenceFragment()
+{
+    KP_LOG_DEBUG("Kompute SequenceFragment destructor started");
+
+    if (this->mDevice) {
+        this->destroy();
+    }
+}
+
+std::shared_ptr<SequenceFragment>
+SequenceFragment::record(std::shared_ptr<OpBase> op)
+{
+    KP_LOG_DEBUG("Kompute SequenceFragment record function started");
+
+    for (const std::shared_ptr<Memory>& mem : op->getMemObjects()) {
+        if (mem->memoryType() == Memory::MemoryTypes::eTransient &&
+            !mem->isMemoryBound()) {
+            throw std::runtime_error(
+              "Kompute SequenceFragment can't record operations using "
+              "eTransient memory objects without bound memory");
+        }
+    }
+
+    this->begin();
+
+    if (this->mResidency) {
+        this->mResidency->restore(op->getMemObjects());
+    }
+
+    this->recordOperation(op);
+    this->mOperations.push_back(op);
+
+    return shared_from_this();
+}
+
+std::shared_ptr<vk::CommandBuffer>
+SequenceFragment::getCommandBuffer()
+{
+    if (this->isRecording()) {
+        this->end();
+    } else if (!this->mRecorded ||
+               this->getMemGenerations() != this->mRecordedGenerations) {
+        KP_LOG_DEBUG("Kompute SequenceFragment re-recording as memory "
+                     "objects were recreated");
+        this->rerecord();
+    }
+
+    this->mCommandBufferShared = true;
+    return this->mCommandBuffer;
+}
+
+std::vector<std::shared_ptr<Memory>>
+SequenceFragment::getMemObjects()
+{
+    std::vector<std::shared_ptr<Memory>> memObjects;
+    for (const std::shared_ptr<OpBase>& op : this->mOperations) {
+        for (const std::shared_ptr<Memory>& mem : op->getMemObjects()) {
+            if (std::find(memObjects.begin(), memObjects.end(), mem) ==
+                memObjects.end()) {
+                memObjects.push_back(mem);
+            }
+        }
+    }
+    return memObjects;
+}
+
+std::vector<OpBase::MemoryAccess>
+SequenceFragment::getMemoryAccesses()
+{
+    // Tensors written anywhere in the fragment are seen as written by all
+    // the stages that access them, which orders the commands after the
+    // fragment against any of its accesses. A fragment with an operation
+    // that doesn't declare its accesses doesn't declare any either
+    std::vector<OpBase::MemoryAccess> accesses;
+    for (const std::shared_ptr<OpBase>& op : this->mOperations) {
+        std::vector<OpBase::MemoryAccess> opAccesses = op->getMemoryAccesses();
+        if (opAccesses.empty()) {
+            return {};
+        }
+        for (const OpBase::MemoryAccess& access : opAccesses) {
+            auto it = std::find_if(accesses.begin(),
+                                   accesses.end(),
+                                   [&access](const OpBase::MemoryAccess& a) {
+                                       return a.memory == access.memory;
+                                   });
+            if (it == accesses.end()) {
+                accesses.push_back(access);
+            } else {
+                it->accessMask |= access.accessMask;
+                it->stageMask |= access.stageMask;
+                it->write = it->write || access.write;
+            }
+        }
+    }
+    return accesses;
+}
+
+void
+SequenceFragment::preEval(const vk::CommandBuffer& commandBuffer)
+{
+    for (const std::shared_ptr<OpBase>& op : this->mOperations) {
+        op->preEval(commandBuffer);
+    }
+}
+
+void
+SequenceFragment::postEval(const vk::CommandBuffer& commandBuffer)
+{
+    for (const std::shared_ptr<OpBase>& op : this->mOperations) {
+        op->postEval(commandBuffer);
+    }
+}
+
+HazardTracker::Stats
+SequenceFragment::getBarrierStats() const
+{
+    return this->mHazardTracker.stats();
+}
+
+void
+SequenceFragment::begin()
+{
+    KP_LOG_DEBUG("Kompute SequenceFragment called BEGIN");
+
+    if (this->isRecording()) {
+        KP_LOG_DEBUG("Kompute SequenceFragment begin called when already "
+                     "recording");
+        return;
+    }
+    if (!this->isInit()) {
+        throw std::runtime_error(
+          "Kompute SequenceFragment begin called when not initialized");
+    }
+
+    // Sequences that executed the previous recording may still be running,
+    // so it is recorded into a new command buffer, and the previous one is
+    // freed once the operations executing it release it
+    if (this->mCommandBufferShared) {
+        this->mCommandBuffer = this->allocateCommandBuffer();
+        this->mCommandBufferShared = false;
+    }
+
+    // The fragment can be executed by several pending command buffers at
+    // the same time, such as the buffers of a multi-buffered sequence
+    vk::CommandBufferInheritanceInfo inheritanceInfo;
+    this->mCommandBuffer->begin(vk::CommandBufferBeginInfo(
+      vk::CommandBufferUsageFlagBits::eSimultaneousUse, &inheritanceInfo));
+    this->mRecording = true;
+    this->mHazardTracker.clear();
+
+    if (this->mResidency) {
+        this->mResidency->restore(this->getMemObjects());
+    }
+    for (const std::shared_ptr<OpBase>& op : this->mOperations) {
+        this->recordOperation(op);
+    }
+}
+
+void
+SequenceFragment::end()
+{
+    KP_LOG_DEBUG("Kompute SequenceFragment calling END");
+
+    if (!this->isRecording()) {
+        KP_LOG_WARN("Kompute SequenceFragment end called when not recording");
+        return;
+    }
+
+    this->mCommandBuffer->end();
+    this->mRecording = false;
+    this->mRecorded = true;
+
+    // Commands refer to the buffers the memory objects had when recorded
+    this->mRecordedGenerations = this->getMemGenerations();
+}
+
+void
+SequenceFragment::clear()
+{
+    KP_LOG_DEBUG("Kompute SequenceFragment calling clear");
+    this->mOperations.clear();
+    if (this->isRecording()) {
+        this->end();
+    }
+    this->mRecorded = false;
+}
+
+void
+SequenceFragment::rerecord()
+{
+    if (this->isRecording()) {
+        this->end();
+    }
+    this->begin();
+    this->end();
+}
+
+bool
+SequenceFragment::isRecording() const
+{
+    return this->mRecording;
+}
+
+uint32_t
+SequenceFragment::getQueueIndex() const
+{
+    return this->mQueueIndex;
+}
+
+bool
+SequenceFragment::isInit() const
+{
+    return this->mDevice && this->mCommandPool && this->mCommandBuffer;
+}
+
+void
+SequenceFragment::destroy()
+{
+    KP_LOG_DEBUG("Kompute SequenceFragment destroy called");
+
+    if (!this->mDevice) {
+        KP_LOG_WARN("Kompute SequenceFragment destroy called "
+                    "with null Device pointer");
+        return;
+    }
+
+    // Destroying the pool frees the command buffers still held by operations
+    this->mCommandBuffer = nullptr;
+    this->mCommandBufferShared = false;
+
+    if (this->mCommandPool) {
+        this->mDevice->destroy(
+          *this->mCommandPool,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        this->mCommandPool = nullptr;
+    }
+
+    this->mOperations.clear();
+    this->mRecording = false;
+    this->mRecorded = false;
+    this->mDevice = nullptr;
+}
+
+std::shared_ptr<vk::CommandBuffer>
+SequenceFragment::allocateCommandBuffer()
+{
+    vk::CommandBufferAllocateInfo commandBufferAllocateInfo(
+      *this->mCommandPool, vk::CommandBufferLevel::eSecondary, 1);
+    vk::CommandBuffer allocated;
+    this->mDevice->allocateCommandBuffers(&commandBufferAllocateInfo,
+                                          &allocated);
+
+    // The command buffer is freed by whoever releases it last, unless the
+    // pool has been destroyed with the fragment
+    std::shared_ptr<vk::Device> device = this->mDevice;
+    std::weak_ptr<vk::CommandPool> commandPool = this->mCommandPool;
+    return std::shared_ptr<vk::CommandBuffer>(
+      new vk::CommandBuffer(allocated),
+      [device, commandPool](vk::CommandBuffer* commandBuffer) {
+          if (std::shared_ptr<vk::CommandPool> pool = commandPool.lock()) {
+              device->freeCommandBuffers(*pool, 1, commandBuffer);
+          }
+          delete commandBuffer;
+      });
+}
+
+void
+SequenceFragment::recordOperation(const std::shared_ptr<OpBase>& op)
+{
+    HazardTracker::record(*this->mCommandBuffer, this->mHazardTracker.plan(op));
+    op->record(*this->mCommandBuffer);
+}
+
+std::vector<uint64_t>
+SequenceFragment::getMemGenerations()
+{
+    std::vector<uint64_t> generations;
+    for (const std::shared_ptr<OpBase>& op : this->mOperations) {
+        for (const std::shared_ptr<Memory>& mem : op->getMemObjects()) {
+            generations.push_back(mem->generation());
+        }
+    }
+    return generations;
+}
+
+}
@@ -0,0 +1,378 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "kompute/StagingRing.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace kp {
+
+// Chunks start on this alignment, which is a multiple of the
+// optimalBufferCopyOffsetAlignment and nonCoherentAtomSize of most devices
+static const vk::DeviceSize CHUNK_ALIGNMENT = 256;
+
+StagingRing::StagingRing(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                         std::shared_ptr<vk::Device> device,
+                         std::shared_ptr<vk::Queue> queue,
+                         uint32_t queueFamilyIndex,
+                         vk::DeviceSize size,
+                         uint32_t numChunks,
+                         std::shared_ptr<std::mutex> queueMutex)
+{
+    KP_LOG_DEBUG("Kompute StagingRing constructor with size {} and {} chunks",
+                 size,
+                 numChunks);
+
+    if (numChunks == 0) {
+        throw std::runtime_error(
+          "Kompute StagingRing requires at least one chunk");
+    }
+
+    this->mPhysicalDevice = physicalDevice;
+    this->mDevice = device;
+    this->mQueue = queue;
+    this->mQueueMutex = queueMutex;
+    this->mChunkSize = size / numChunks / CHUNK_ALIGNMENT * CHUNK_ALIGNMENT;
+    this->mSize = this->mChunkSize * numChunks;
+
+    if (this->mChunkSize == 0) {
+        throw std::runtime_error(
+          "Kompute StagingRing size is too small for the number of chunks");
+    }
+
+    this->createBuffer(queueFamilyIndex);
+
+    this->mCommandBuffers.resize(numChunks);
+    vk::CommandBufferAllocateInfo commandBufferAllocateInfo(
+      *this->mCommandPool, vk::CommandBufferLevel::ePrimary, numChunks);
+    this->mDevice->allocateCommandBuffers(&commandBufferAllocateInfo,
+                                          this->mCommandBuffers.data());
+
+    for (uint32_t i = 0; i < numChunks; i++) {
+        this->mFences.push_back(
+          this->mDevice->createFence(vk::FenceCreateInfo()));
+    }
+    this->mSubmitted.resize(numChunks, false);
+    this->mPendingReads.resize(numChunks);
+}
+
+StagingRing::~StagingRing()
+{
+    KP_LOG_DEBUG("Kompute StagingRing destructor started");
+
+    if (this->mDevice) {
+        this->destroy();
+    }
+}
+
+void
+StagingRing::upload(const vk::Buffer& dstBuffer,
+                    vk::DeviceSize dstOffset,
+                    const void* data,
+                    vk::DeviceSize size)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        throw std::runtime_error("Kompute StagingRing device is null");
+    }
+
+    KP_LOG_DEBUG("Kompute StagingRing uploading {} bytes", size);
+
+    const uint8_t* src = (const uint8_t*)data;
+    uint32_t numChunks = (uint32_t)this->mFences.size();
+    uint32_t chunk = 0;
+
+    for (vk::DeviceSize offset = 0; offset < size; offset += this->mChunkSize) {
+        vk::DeviceSize copySize = std::min(this->mChunkSize, size - offset);
+        vk::DeviceSize ringOffset = chunk * this->mChunkSize;
+
+        // Wait for the previous transfer through this chunk before
+        // overwriting it, the other chunks keep the device busy meanwhile
+        this->finishChunk(chunk);
+        memcpy(this->mMappedData + ringOffset, src + offset, copySize);
+
+        vk::BufferCopy copyRegion(ringOffset, dstOffset + offset, copySize);
+        this->submitChunk(chunk, *this->mBuffer, dstBuffer, copyRegion, false);
+
+        chunk = (chunk + 1) % numChunks;
+    }
+
+    for (uint32_t i = 0; i < numChunks; i++) {
+        this->finishChunk(i);
+    }
+}
+
+void
+StagingRing::download(const vk::Buffer& srcBuffer,
+                      vk::DeviceSize srcOffset,
+                      void* data,
+                      vk::DeviceSize size)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        throw std::runtime_error("Kompute StagingRing device is null");
+    }
+
+    KP_LOG_DEBUG("Kompute StagingRing downloading {} bytes", size);
+
+    uint8_t* dst = (uint8_t*)data;
+    uint32_t numChunks = (uint32_t)this->mFences.size();
+    uint32_t chunk = 0;
+
+    for (vk::DeviceSize offset = 0; offset < size; offset += this->mChunkSize) {
+        vk::DeviceSize copySize = std::min(this->mChunkSize, size - offset);
+        vk::DeviceSize ringOffset = chunk * this->mChunkSize;
+
+        // Drains the data previously copied into this chunk before reusing it
+        this->finishChunk(chunk);
+
+        vk::BufferCopy copyRegion(srcOffset + offset, ringOffset, copySize);
+        this->submitChunk(chunk, srcBuffer, *this->mBuffer, copyRegion, true);
+        this->mPendingReads[chunk].data = dst + offset;
+        this->mPendingReads[chunk].size = copySize;
+
+        chunk = (chunk + 1) % numChunks;
+    }
+
+    // Drain the remaining chunks in submission order
+    for (uint32_t i = 0; i < numChunks; i++) {
+        this->finishChunk((chunk + i) % numChunks);
+    }
+}
+
+vk::DeviceSize
+StagingRing::size() const
+{
+    return this->mSize;
+}
+
+vk::DeviceSize
+StagingRing::chunkSize() const
+{
+    return this->mChunkSize;
+}
+
+std::shared_ptr<vk::Queue>
+StagingRing::queue() const
+{
+    return this->mQueue;
+}
+
+bool
+StagingRing::isInit() const
+{
+    return this->mDevice && this->mBuffer && this->mMemory;
+}
+
+void
+StagingRing::destroy()
+{
+    KP_LOG_DEBUG("Kompute StagingRing destroy started");
+
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        KP_LOG_WARN("Kompute StagingRing destroy called with null Device");
+        return;
+    }
+
+    for (uint32_t i = 0; i < this->mFences.size(); i++) {
+        if (this->mSubmitted[i]) {
+            (void)this->mDevice->waitForFences(
+              1, &this->mFences[i], VK_TRUE, UINT64_MAX);
+        }
+        this->mDevice->destroy(
+          this->mFences[i],
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    }
+    this->mFences.clear();
+    this->mSubmitted.clear();
+    this->mPendingReads.clear();
+
+    if (this->mCommandPool) {
+        this->mDevice->freeCommandBuffers(
+          *this->mCommandPool,
+          (uint32_t)this->mCommandBuffers.size(),
+          this->mCommandBuffers.data());
+        this->mCommandBuffers.clear();
+        this->mDevice->destroy(
+          *this->mCommandPool,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        this->mCommandPool = nullptr;
+    }
+
+    if (this->mBuffer) {
+        this->mDevice->destroy(
+          *this->mBuffer, (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        this->mBuffer = nullptr;
+    }
+
+    if (this->mMemory) {
+        this->mDevice->unmapMemory(*this->mMemory);
+        this->mMappedData = nullptr;
+        this->mDevice->freeMemory(
+          *this->mMemory, (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        this->mMemory = nullptr;
+    }
+
+    this->mDevice = nullptr;
+    this->mPhysicalDevice = nullptr;
+    this->mQueue = nullptr;
+    this->mQueueMutex = nullptr;
+}
+
+void
+StagingRing::createBuffer(uint32_t queueFamilyIndex)
+{
+    KP_LOG_DEBUG("Kompute StagingRing creating buffer of size {}",
+                 this->mSize);
+
+    vk::BufferCreateInfo bufferInfo(vk::BufferCreateFlags(),
+                                    this->mSize,
+                                    vk::BufferUsageFlagBits::eTransferSrc |
+                                      vk::BufferUsageFlagBits::eTransferDst,
+                                    vk::SharingMode::eExclusive);
+    this->mBuffer = std::make_shared<vk::Buffer>();
+    this->mDevice->createBuffer(&bufferInfo, nullptr, this->mBuffer.get());
+
+    vk::MemoryRequirements memoryRequirements =
+      this->mDevice->getBufferMemoryRequirements(*this->mBuffer);
+    vk::PhysicalDeviceMemoryProperties memoryProperties =
+      this->mPhysicalDevice->getMemoryProperties();
+
+    // The ring is used in both directions, so host cached memory is preferred
+    // as it is fast to read back and still fast to write to sequentially
+    const vk::MemoryPropertyFlags candidates[] = {
+        vk::MemoryPropertyFlagBits::eHostVisible |
+          vk::MemoryPropertyFlagBits::eHostCoherent |
+          vk::MemoryPropertyFlagBits::eHostCached,
+        vk::MemoryPropertyFlagBits::eHostVisible |
+          vk::MemoryPropertyFlagBits::eHostCoherent
+    };
+
+    uint32_t memoryTypeIndex = memoryProperties.memoryTypeCount;
+    for (const vk::MemoryPropertyFlags& flags : candidates) {
+        for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+            if ((memoryRequirements.memoryTypeBits & (1 << i)) &&
+                (memoryProperties.memoryTypes[i].propertyFlags & flags) ==
+                  flags) {
+                memoryTypeIndex = i;
+                break;
+            }
+        }
+        if (memoryTypeIndex < memoryProperties.memoryTypeCount) {
+            break;
+        }
+    }
+    if (memoryTypeIndex == memoryProperties.memoryTypeCount) {
+        throw std::runtime_error(
+          "Kompute StagingRing host visible memory type not found");
+    }
+
+    vk::MemoryAllocateInfo memoryAllocateInfo(memoryRequirements.size,
+                                              memoryTypeIndex);
+    this->mMemory = std::make_shared<vk::DeviceMemory>();
+    this->mDevice->allocateMemory(
+      &memoryAllocateInfo, nullptr, this->mMemory.get());
+    this->mDevice->bindBufferMemory(*this->mBuffer, *this->mMemory, 0);
+
+    this->mMappedData = (uint8_t*)this->mDevice->mapMemory(
+      *this->mMemory, 0, VK_WHOLE_SIZE, vk::MemoryMapFlags());
+
+    vk::CommandPoolCreateInfo commandPoolInfo(
+      vk::CommandPoolCreateFlagBits::eResetCommandBuffer |
+        vk::CommandPoolCreateFlagBits::eTransient,
+      queueFamilyIndex);
+    this->mCommandPool = std::make_shared<vk::CommandPool>();
+    this->mDevice->createCommandPool(
+      &commandPoolInfo, nullptr, this->mCommandPool.get());
+}
+
+void
+StagingRing::submitChunk(uint32_t chunk,
+                         const vk::Buffer& srcBuffer,
+                         const vk::Buffer& dstBuffer,
+                         const vk::BufferCopy& copyRegion,
+                         bool hostRead)
+{
+    vk::CommandBuffer& commandBuffer = this->mCommandBuffers[chunk];
+
+    commandBuffer.begin(vk::CommandBufferBeginInfo(
+      vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+
+    // Earlier submissions of the queue may still read or write the device
+    // buffer, such as the other submissions in flight of a multi-buffered
+    // sequence, so the copy is ordered after all of them
+    vk::MemoryBarrier beforeBarrier(vk::AccessFlagBits::eMemoryWrite,
+                                    vk::AccessFlagBits::eTransferRead |
+                                      vk::AccessFlagBits::eTransferWrite);
+    commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands,
+                                  vk::PipelineStageFlagBits::eTransfer,
+                                  vk::DependencyFlags(),
+                                  beforeBarrier,
+                                  nullptr,
+                                  nullptr);
+
+    commandBuffer.copyBuffer(srcBuffer, dstBuffer, copyRegion);
+
+    if (hostRead) {
+        vk::BufferMemoryBarrier bufferMemoryBarrier;
+        bufferMemoryBarrier.buffer = dstBuffer;
+        bufferMemoryBarrier.offset = copyRegion.dstOffset;
+        bufferMemoryBarrier.size = copyRegion.size;
+        bufferMemoryBarrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+        bufferMemoryBarrier.dstAccessMask = vk::AccessFlagBits::eHostRead;
+        bufferMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        bufferMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+
+        commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+                                      vk::PipelineStageFlagBits::eHost,
+                                      vk::DependencyFlags(),
+                                      nullptr,
+                                      bufferMemoryBarrier,
+                                      nullptr);
+    }
+
+    commandBuffer.end();
+
+    vk::SubmitInfo submitInfo(0, nullptr, nullptr, 1, &commandBuffer);
+    {
+        // Transfers may run on the completion thread while other threads
+        // submit to the same queue
+        std::unique_lock<std::mutex> queueLock;
+        if (this->mQueueMutex) {
+            queueLock = std::unique_lock<std::mutex>(*this->mQueueMutex);
+        }
+        this->mQueue->submit(1, &submitInfo, this->mFences[chunk]);
+    }
+    this->mSubmitted[chunk] = true;
+}
+
+void
+StagingRing::finishChunk(uint32_t chunk)
+{
+    if (!this->mSubmitted[chunk]) {
+        return;
+    }
+
+    vk::Result result = this->mDevice->waitForFences(
+      1, &this->mFences[chunk], VK_TRUE, UINT64_MAX);
+    if (result != vk::Result::eSuccess) {
+        throw std::runtime_error("Kompute StagingRing failed to wait for "
+                                 "transfer: " +
+                                 vk::to_string(result));
+    }
+    this->mDevice->resetFences({ this->mFences[chunk] });
+    this->mSubmitted[chunk] = false;
+
+    PendingRead& pendingRead = this->mPendingReads[chunk];
+    if (pendingRead.size) {
+        memcpy(pendingRead.data,
+               this->mMappedData + chunk * this->mChunkSize,
+               pendingRead.size);
+        pendingRead = PendingRead();
+    }
+}
+
+}
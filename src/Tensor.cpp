@@ -2,19 +2,32 @@
 
 #include "kompute/Tensor.hpp"
 #include "kompute/Image.hpp"
+#include <algorithm>
+#include <fmt/core.h>
 
 namespace kp {
 
 Tensor::Tensor(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
                std::shared_ptr<vk::Device> device,
                void* data,
-               uint32_t elementTotalCount,
+               uint64_t elementTotalCount,
                uint32_t elementMemorySize,
                const DataTypes& dataType,
-               const MemoryTypes& memoryType)
-  : Memory(physicalDevice, device, dataType, memoryType, elementTotalCount, 1)
+               const MemoryTypes& memoryType,
+               std::shared_ptr<MemoryPool> memoryPool,
+               const StagingPolicy& stagingPolicy,
+               std::shared_ptr<StagingRing> stagingRing)
+  : Memory(physicalDevice,
+           device,
+           dataType,
+           memoryType,
+           elementTotalCount,
+           memoryPool,
+           stagingPolicy)
 {
     this->mSize = elementTotalCount;
+    this->mCapacity = elementTotalCount;
+    this->mStagingRing = stagingRing;
 
     // This is required if dataType is eCustom
     this->mDataTypeMemorySize = elementMemorySize;
@@ -31,13 +44,24 @@ Tensor::Tensor(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
 
 Tensor::Tensor(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
                std::shared_ptr<vk::Device> device,
-               uint32_t elementTotalCount,
+               uint64_t elementTotalCount,
                uint32_t elementMemorySize,
                const DataTypes& dataType,
-               const MemoryTypes& memoryType)
-  : Memory(physicalDevice, device, dataType, memoryType, elementTotalCount, 1)
+               const MemoryTypes& memoryType,
+               std::shared_ptr<MemoryPool> memoryPool,
+               const StagingPolicy& stagingPolicy,
+               std::shared_ptr<StagingRing> stagingRing)
+  : Memory(physicalDevice,
+           device,
+           dataType,
+           memoryType,
+           elementTotalCount,
+           memoryPool,
+           stagingPolicy)
 {
     this->mSize = elementTotalCount;
+    this->mCapacity = elementTotalCount;
+    this->mStagingRing = stagingRing;
 
     // This is required if dataType is eCustom
     this->mDataTypeMemorySize = elementMemorySize;
@@ -51,6 +75,95 @@ Tensor::Tensor(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
     this->reserve();
 }
 
+Tensor::Tensor(std::shared_ptr<Tensor> tensor, uint64_t offset, uint64_t count)
+  : Memory(tensor->mPhysicalDevice,
+           tensor->mDevice,
+           tensor->mDataType,
+           tensor->mMemoryType,
+           count,
+           nullptr,
+           tensor->mStagingPolicy)
+{
+    KP_LOG_DEBUG("Kompute Tensor creating view with offset {} and size {}",
+                 offset,
+                 count);
+
+    if (!tensor->isInit() || !tensor->isMemoryBound()) {
+        throw std::runtime_error(
+          "Kompute Tensor view requires a tensor with bound memory");
+    }
+    if (offset + count > tensor->size()) {
+        throw std::runtime_error(
+          fmt::format("Kompute Tensor view of elements [{}, {}) is out of "
+                      "range of tensor of size {}",
+                      offset,
+                      offset + count,
+                      tensor->size()));
+    }
+
+    // Views of views refer to the tensor that owns the buffers
+    this->mViewedTensor =
+      tensor->mViewedTensor ? tensor->mViewedTensor : tensor;
+    this->mViewedTensor->mViewCount++;
+    this->mOffset = tensor->mOffset + offset;
+    this->mSize = count;
+    this->mCapacity = count;
+    this->mDataTypeMemorySize = tensor->mDataTypeMemorySize;
+    this->mDescriptorType = tensor->mDescriptorType;
+    this->mStagingRing = tensor->mStagingRing;
+
+    // The buffers and memory are shared but never freed by the view
+    this->mPrimaryBuffer = tensor->mPrimaryBuffer;
+    this->mStagingBuffer = tensor->mStagingBuffer;
+    this->mPrimaryMemory = tensor->mPrimaryMemory;
+    this->mPrimaryAllocation = tensor->mPrimaryAllocation;
+    this->mPrimaryMemoryPropertyFlags = tensor->mPrimaryMemoryPropertyFlags;
+    this->mStagingMemory = tensor->mStagingMemory;
+    this->mStagingAllocation = tensor->mStagingAllocation;
+    this->mStagingMemoryPropertyFlags = tensor->mStagingMemoryPropertyFlags;
+
+    if (this->mMemoryType != MemoryTypes::eStorage &&
+        this->mMemoryType != MemoryTypes::eTransient) {
+        if (!this->mViewedTensor->mRawData) {
+            this->mViewedTensor->mapRawData();
+        }
+        this->mRawData = (uint8_t*)this->mViewedTensor->mRawData +
+                         this->memoryOffset();
+        this->mUnmapMemory = false;
+    }
+
+    // Host writes of views are tracked by the viewed tensor, so views flush
+    // their whole range
+    this->mTrackHostWrites = false;
+}
+
+Tensor::Tensor(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+               std::shared_ptr<vk::Device> device,
+               const HostPointer& hostPointer,
+               uint64_t elementTotalCount,
+               uint32_t elementMemorySize,
+               const DataTypes& dataType)
+  : Memory(physicalDevice,
+           device,
+           dataType,
+           MemoryTypes::eHost,
+           elementTotalCount)
+{
+    this->mSize = elementTotalCount;
+    this->mCapacity = elementTotalCount;
+
+    // This is required if dataType is eCustom
+    this->mDataTypeMemorySize = elementMemorySize;
+
+    KP_LOG_DEBUG("Kompute Tensor constructor importing host pointer with "
+                 "data length: {}",
+                 elementTotalCount);
+
+    this->mDescriptorType = vk::DescriptorType::eStorageBuffer;
+
+    this->importHostMemory(hostPointer);
+}
+
 Tensor::~Tensor()
 {
     KP_LOG_DEBUG("Kompute Tensor destructor started. Type: {}",
@@ -81,7 +194,11 @@ Tensor::reserve()
 bool
 Tensor::isInit()
 {
-    return this->mDevice && this->mPrimaryBuffer && this->mPrimaryMemory;
+    return this->mDevice &&
+           ((this->mPrimaryBuffer &&
+             (this->mPrimaryMemory ||
+              this->mMemoryType == MemoryTypes::eTransient)) ||
+            this->mEvicted);
 }
 
 void
@@ -90,7 +207,8 @@ Tensor::recordCopyFrom(const vk::CommandBuffer& commandBuffer,
 {
 
     vk::DeviceSize bufferSize(this->memorySize());
-    vk::BufferCopy copyRegion(0, 0, bufferSize);
+    vk::BufferCopy copyRegion(
+      copyFromTensor->memoryOffset(), this->memoryOffset(), bufferSize);
 
     KP_LOG_DEBUG("Kompute Tensor recordCopyFrom data size {}.", bufferSize);
 
@@ -115,7 +233,8 @@ Tensor::recordCopyFrom(const vk::CommandBuffer& commandBuffer,
 
     vk::Extent3D size = { copyFromImage->getX(), copyFromImage->getY(), 1 };
 
-    vk::BufferImageCopy copyRegion(0, 0, 0, layer, offset, size);
+    vk::BufferImageCopy copyRegion(
+      this->memoryOffset(), 0, 0, layer, offset, size);
 
     KP_LOG_DEBUG("Kompute Tensor recordCopyFrom data size {}.", bufferSize);
 
@@ -139,7 +258,8 @@ void
 Tensor::recordCopyFromStagingToDevice(const vk::CommandBuffer& commandBuffer)
 {
     vk::DeviceSize bufferSize(this->memorySize());
-    vk::BufferCopy copyRegion(0, 0, bufferSize);
+    vk::BufferCopy copyRegion(
+      this->memoryOffset(), this->memoryOffset(), bufferSize);
 
     KP_LOG_DEBUG("Kompute Tensor copying data size {}.", bufferSize);
 
@@ -154,7 +274,8 @@ void
 Tensor::recordCopyFromDeviceToStaging(const vk::CommandBuffer& commandBuffer)
 {
     vk::DeviceSize bufferSize(this->memorySize());
-    vk::BufferCopy copyRegion(0, 0, bufferSize);
+    vk::BufferCopy copyRegion(
+      this->memoryOffset(), this->memoryOffset(), bufferSize);
 
     KP_LOG_DEBUG("Kompute Tensor copying data size {}.", bufferSize);
 
@@ -236,6 +357,7 @@ Tensor::recordBufferMemoryBarrier(const vk::CommandBuffer& commandBuffer,
 
     vk::BufferMemoryBarrier bufferMemoryBarrier;
     bufferMemoryBarrier.buffer = buffer;
+    bufferMemoryBarrier.offset = this->memoryOffset();
     bufferMemoryBarrier.size = bufferSize;
     bufferMemoryBarrier.srcAccessMask = srcAccessMask;
     bufferMemoryBarrier.dstAccessMask = dstAccessMask;
@@ -256,9 +378,33 @@ Tensor::constructDescriptorBufferInfo()
     KP_LOG_DEBUG("Kompute Tensor construct descriptor buffer info size {}",
                  this->memorySize());
     vk::DeviceSize bufferSize = this->memorySize();
-    return vk::DescriptorBufferInfo(*this->mPrimaryBuffer,
-                                    0, // offset
-                                    bufferSize);
+    vk::DeviceSize bufferOffset = this->memoryOffset();
+    vk::PhysicalDeviceLimits limits =
+      this->mPhysicalDevice->getProperties().limits;
+
+    // Descriptors can't be split, so larger tensors have to be bound in views
+    if (bufferSize > limits.maxStorageBufferRange) {
+        throw std::runtime_error(
+          fmt::format("Kompute Tensor of {} bytes exceeds the "
+                      "maxStorageBufferRange of {} bytes, bind views created "
+                      "with slice instead",
+                      bufferSize,
+                      limits.maxStorageBufferRange));
+    }
+
+    if (bufferOffset) {
+        vk::DeviceSize alignment = limits.minStorageBufferOffsetAlignment;
+        if (bufferOffset % alignment) {
+            throw std::runtime_error(
+              fmt::format("Kompute Tensor view offset of {} bytes is not a "
+                          "multiple of minStorageBufferOffsetAlignment {}",
+                          bufferOffset,
+                          alignment));
+        }
+    }
+
+    return vk::DescriptorBufferInfo(
+      *this->mPrimaryBuffer, bufferOffset, bufferSize);
 }
 
 vk::WriteDescriptorSet
@@ -290,12 +436,16 @@ Tensor::getPrimaryBufferUsageFlags()
         case MemoryTypes::eDevice:
         case MemoryTypes::eHost:
         case MemoryTypes::eDeviceAndHost:
+            // Any tensor can hold the workgroup counts of an indirect dispatch
             return vk::BufferUsageFlagBits::eStorageBuffer |
+                   vk::BufferUsageFlagBits::eIndirectBuffer |
                    vk::BufferUsageFlagBits::eTransferSrc |
                    vk::BufferUsageFlagBits::eTransferDst;
             break;
         case MemoryTypes::eStorage:
+        case MemoryTypes::eTransient:
             return vk::BufferUsageFlagBits::eStorageBuffer |
+                   vk::BufferUsageFlagBits::eIndirectBuffer |
                    // You can still copy buffers to/from storage memory
                    // so set the transfer usage flags here.
                    vk::BufferUsageFlagBits::eTransferSrc |
@@ -325,6 +475,567 @@ Tensor::getPrimaryBuffer()
     return this->mPrimaryBuffer;
 }
 
+std::shared_ptr<Tensor>
+Tensor::slice(uint64_t offset, uint64_t count)
+{
+    return std::shared_ptr<Tensor>{ new Tensor(
+      this->shared_from_this(), offset, count) };
+}
+
+vk::DeviceSize
+Tensor::memoryOffset()
+{
+    return this->mOffset * this->mDataTypeMemorySize;
+}
+
+void
+Tensor::markHostRangeDirty(uint64_t offset, uint64_t size)
+{
+    if (this->mViewedTensor) {
+        this->mViewedTensor->markHostRangeDirty(this->memoryOffset() + offset,
+                                                size);
+        return;
+    }
+    Memory::markHostRangeDirty(offset, size);
+}
+
+void
+Tensor::flushHostWritesOutside(uint64_t offset, uint64_t size)
+{
+    // Host writes of views are tracked by the viewed tensor
+    if (this->mViewedTensor) {
+        this->mViewedTensor->flushHostWritesOutside(this->memoryOffset() +
+                                                      offset,
+                                                    size);
+        return;
+    }
+    Memory::flushHostWritesOutside(offset, size);
+}
+
+void
+Tensor::acquireSubmission(const vk::Queue& queue)
+{
+    if (this->mViewedTensor) {
+        this->mViewedTensor->acquireSubmission(queue);
+        return;
+    }
+    Memory::acquireSubmission(queue);
+}
+
+void
+Tensor::releaseSubmission(const vk::Queue& queue)
+{
+    if (this->mViewedTensor) {
+        this->mViewedTensor->releaseSubmission(queue);
+        return;
+    }
+    Memory::releaseSubmission(queue);
+}
+
+bool
+Tensor::isUsedByOtherQueue(const vk::Queue& queue)
+{
+    if (this->mViewedTensor) {
+        return this->mViewedTensor->isUsedByOtherQueue(queue);
+    }
+    return Memory::isUsedByOtherQueue(queue);
+}
+
+bool
+Tensor::isUsedBySubmission()
+{
+    if (this->mViewedTensor) {
+        return this->mViewedTensor->isUsedBySubmission();
+    }
+    return Memory::isUsedBySubmission();
+}
+
+void
+Tensor::stopTrackingHostWrites()
+{
+    if (this->mViewedTensor) {
+        this->mViewedTensor->stopTrackingHostWrites();
+    }
+    Memory::stopTrackingHostWrites();
+}
+
+bool
+Tensor::isEvictable()
+{
+    return (this->mMemoryType == MemoryTypes::eDevice ||
+            this->mMemoryType == MemoryTypes::eStorage) &&
+           this->mFreePrimaryBuffer && this->mFreePrimaryMemory &&
+           !this->mViewedTensor && this->mViewCount == 0;
+}
+
+bool
+Tensor::isResident()
+{
+    return !this->mEvicted;
+}
+
+void
+Tensor::evictPrimaryMemory()
+{
+    if (!this->isEvictable()) {
+        throw std::runtime_error(
+          "Kompute Tensor can only evict resident eDevice and eStorage "
+          "tensors that own their memory and have no views");
+    }
+
+    KP_LOG_DEBUG("Kompute Tensor evicting {} bytes of primary memory",
+                 this->memorySize());
+
+    this->mDevice->destroy(
+      *this->mPrimaryBuffer,
+      (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    this->mPrimaryBuffer = nullptr;
+    this->mFreePrimaryBuffer = false;
+
+    this->freeMemory(this->mPrimaryMemory, this->mPrimaryAllocation);
+    this->mFreePrimaryMemory = false;
+
+    this->mEvicted = true;
+}
+
+void
+Tensor::restorePrimaryMemory()
+{
+    if (!this->mEvicted) {
+        return;
+    }
+
+    KP_LOG_DEBUG("Kompute Tensor restoring {} bytes of primary memory",
+                 this->memorySize());
+
+    this->mPrimaryBuffer = std::make_shared<vk::Buffer>();
+    this->createBuffer(this->mPrimaryBuffer,
+                       this->getPrimaryBufferUsageFlags());
+    this->mFreePrimaryBuffer = true;
+
+    this->mPrimaryMemoryPropertyFlags =
+      this->allocateBindMemory(this->mPrimaryBuffer,
+                               this->mPrimaryMemory,
+                               this->mPrimaryAllocation,
+                               this->getPrimaryMemoryPropertyFlags());
+    this->mFreePrimaryMemory = true;
+
+    this->mEvicted = false;
+    this->mGeneration++;
+}
+
+uint64_t
+Tensor::capacity()
+{
+    return this->mCapacity;
+}
+
+std::shared_ptr<const Tensor::Resize>
+Tensor::recordResize(const vk::CommandBuffer& commandBuffer,
+                     uint64_t elementTotalCount)
+{
+    if (this->mViewedTensor || this->mViewCount > 0 ||
+        this->mHostMemoryImported ||
+        this->mMemoryType == MemoryTypes::eTransient ||
+        !this->mFreePrimaryBuffer || !this->mFreePrimaryMemory) {
+        throw std::runtime_error(
+          "Kompute Tensor can only resize tensors that own their memory and "
+          "are not eTransient, views or viewed by other tensors");
+    }
+    if (elementTotalCount == 0) {
+        throw std::runtime_error("Kompute Tensor cannot be resized to zero");
+    }
+
+    KP_LOG_DEBUG("Kompute Tensor resizing from {} to {} elements with "
+                 "capacity {}",
+                 this->mSize,
+                 elementTotalCount,
+                 this->mCapacity);
+
+    if (elementTotalCount == this->mSize) {
+        return nullptr;
+    }
+
+    std::shared_ptr<Resize> resize = std::make_shared<Resize>();
+    this->mPendingResizes.push_back(resize);
+
+    uint64_t previousMemorySize = this->memorySize();
+
+    if (elementTotalCount <= this->mCapacity) {
+        this->mSize = elementTotalCount;
+        if (this->usesStagingRing() && !this->mHostData.empty()) {
+            this->mHostData.resize(this->memorySize());
+            this->mRawData = this->mHostData.data();
+        }
+        this->mGeneration++;
+        return resize;
+    }
+
+    // Host writes to the previous memory have to reach the device before the
+    // copy reads them
+    this->flushHostMemory();
+    if (this->mUnmapMemory) {
+        this->unmapRawData();
+    }
+    if (this->mHostData.empty()) {
+        this->mRawData = nullptr;
+    }
+
+    resize->previousPrimaryBuffer = this->mPrimaryBuffer;
+    resize->previousStagingBuffer = this->mStagingBuffer;
+    this->retireBuffer(
+      this->mPrimaryBuffer, this->mPrimaryMemory, this->mPrimaryAllocation);
+    if (this->mStagingBuffer) {
+        this->retireBuffer(this->mStagingBuffer,
+                           this->mStagingMemory,
+                           this->mStagingAllocation);
+    }
+
+    this->mCapacity = std::max(elementTotalCount, 2 * this->mCapacity);
+    this->mSize = elementTotalCount;
+    this->allocateMemoryCreateGPUResources();
+
+    if (!this->mHostData.empty()) {
+        this->mHostData.resize(this->memorySize());
+        this->mRawData = this->mHostData.data();
+    }
+
+    resize->primaryBuffer = this->mPrimaryBuffer;
+    resize->stagingBuffer = this->mStagingBuffer;
+    resize->copySize =
+      std::min<uint64_t>(previousMemorySize, this->memorySize());
+    this->recordResizeCopy(commandBuffer, *resize);
+
+    this->mGeneration++;
+    return resize;
+}
+
+bool
+Tensor::repeatResize(const vk::CommandBuffer& commandBuffer,
+                     const std::shared_ptr<const Resize>& resize)
+{
+    if (std::find(this->mPendingResizes.begin(),
+                  this->mPendingResizes.end(),
+                  resize) == this->mPendingResizes.end()) {
+        return false;
+    }
+
+    KP_LOG_DEBUG("Kompute Tensor repeating resize that hasn't executed yet");
+
+    if (resize->previousPrimaryBuffer) {
+        this->recordResizeCopy(commandBuffer, *resize);
+    }
+    return true;
+}
+
+void
+Tensor::recordResizeCopy(const vk::CommandBuffer& commandBuffer,
+                         const Resize& resize)
+{
+    vk::BufferCopy copyRegion(0, 0, resize.copySize);
+
+    vk::MemoryBarrier previousWritesBarrier(vk::AccessFlagBits::eMemoryWrite,
+                                            vk::AccessFlagBits::eTransferRead);
+    commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands,
+                                  vk::PipelineStageFlagBits::eTransfer,
+                                  vk::DependencyFlags(),
+                                  previousWritesBarrier,
+                                  nullptr,
+                                  nullptr);
+
+    commandBuffer.copyBuffer(
+      *resize.previousPrimaryBuffer, *resize.primaryBuffer, copyRegion);
+    if (resize.previousStagingBuffer) {
+        commandBuffer.copyBuffer(
+          *resize.previousStagingBuffer, *resize.stagingBuffer, copyRegion);
+    }
+
+    vk::MemoryBarrier copyBarrier(vk::AccessFlagBits::eTransferWrite,
+                                  vk::AccessFlagBits::eMemoryRead |
+                                    vk::AccessFlagBits::eMemoryWrite |
+                                    vk::AccessFlagBits::eHostRead);
+    commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+                                  vk::PipelineStageFlagBits::eAllCommands |
+                                    vk::PipelineStageFlagBits::eHost,
+                                  vk::DependencyFlags(),
+                                  copyBarrier,
+                                  nullptr,
+                                  nullptr);
+}
+
+void
+Tensor::finishResize()
+{
+    this->mPendingResizes.clear();
+
+    if (this->mRetiredBuffers.empty()) {
+        return;
+    }
+
+    KP_LOG_DEBUG("Kompute Tensor freeing {} buffers replaced by resize",
+                 this->mRetiredBuffers.size());
+
+    for (RetiredBuffer& retiredBuffer : this->mRetiredBuffers) {
+        this->mDevice->destroy(
+          *retiredBuffer.buffer,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        this->freeMemory(retiredBuffer.memory, retiredBuffer.allocation);
+    }
+    this->mRetiredBuffers.clear();
+
+    if (this->mPrimaryBuffer) {
+        this->invalidateHostMemory();
+    }
+
+    // Commands recorded with the copy refer to the freed buffers
+    this->mGeneration++;
+}
+
+void
+Tensor::retireBuffer(std::shared_ptr<vk::Buffer>& buffer,
+                     std::shared_ptr<vk::DeviceMemory>& memory,
+                     MemoryPool::Allocation& allocation)
+{
+    this->mRetiredBuffers.push_back({ buffer, memory, allocation });
+    buffer = nullptr;
+    memory = nullptr;
+    allocation = MemoryPool::Allocation();
+}
+
+bool
+Tensor::usesStagingRing()
+{
+    return this->mMemoryType == MemoryTypes::eDevice && this->mStagingRing &&
+           !this->mStagingBuffer;
+}
+
+void
+Tensor::uploadThroughStagingRing()
+{
+    if (!this->usesStagingRing()) {
+        throw std::runtime_error(
+          "Kompute Tensor upload called without a staging ring");
+    }
+
+    if (!this->mRawData) {
+        KP_LOG_DEBUG("Kompute Tensor skipping upload of untouched host data");
+        return;
+    }
+
+    // The copy is ordered after the earlier submissions of the queue of the
+    // ring, but not after the ones of other queues that may still read the
+    // tensor
+    if (this->isUsedByOtherQueue(*this->mStagingRing->queue())) {
+        throw std::runtime_error(
+          "Kompute Tensor upload through staging ring while a submission on "
+          "another queue uses the tensor, which has to be awaited first");
+    }
+
+    KP_LOG_DEBUG("Kompute Tensor uploading {} bytes through staging ring",
+                 this->memorySize());
+
+    this->mStagingRing->upload(*this->mPrimaryBuffer,
+                               this->memoryOffset(),
+                               this->mRawData,
+                               this->memorySize());
+}
+
+void
+Tensor::downloadThroughStagingRing()
+{
+    if (!this->usesStagingRing()) {
+        throw std::runtime_error(
+          "Kompute Tensor download called without a staging ring");
+    }
+
+    if (!this->mRawData) {
+        this->mapRawData();
+    }
+
+    KP_LOG_DEBUG("Kompute Tensor downloading {} bytes through staging ring",
+                 this->memorySize());
+
+    this->mStagingRing->download(*this->mPrimaryBuffer,
+                                 this->memoryOffset(),
+                                 this->mRawData,
+                                 this->memorySize());
+}
+
+void
+Tensor::bindTransientMemory(std::shared_ptr<vk::DeviceMemory> memory,
+                            vk::DeviceSize offset,
+                            vk::MemoryPropertyFlags memoryPropertyFlags)
+{
+    if (this->mMemoryType != MemoryTypes::eTransient) {
+        throw std::runtime_error(
+          "Kompute Tensor transient memory bound to non transient tensor");
+    }
+    if (this->mPrimaryMemory) {
+        throw std::runtime_error(
+          "Kompute Tensor transient memory is already bound");
+    }
+
+    KP_LOG_DEBUG("Kompute Tensor binding transient memory at offset {}",
+                 offset);
+
+    this->mDevice->bindBufferMemory(*this->mPrimaryBuffer, *memory, offset);
+
+    this->mPrimaryMemory = memory;
+    this->mPrimaryMemoryPropertyFlags = memoryPropertyFlags;
+    this->mFreePrimaryMemory = false;
+}
+
+void
+Tensor::unbindTransientMemory()
+{
+    if (this->mMemoryType != MemoryTypes::eTransient) {
+        throw std::runtime_error(
+          "Kompute Tensor transient memory unbound from non transient tensor");
+    }
+    if (!this->mPrimaryMemory) {
+        return;
+    }
+
+    KP_LOG_DEBUG("Kompute Tensor unbinding transient memory");
+
+    this->mDevice->destroy(
+      *this->mPrimaryBuffer,
+      (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    this->mPrimaryBuffer = std::make_shared<vk::Buffer>();
+    this->createBuffer(this->mPrimaryBuffer,
+                       this->getPrimaryBufferUsageFlags());
+    this->mFreePrimaryBuffer = true;
+
+    this->mPrimaryMemory = nullptr;
+    this->mGeneration++;
+}
+
+bool
+Tensor::isHostMemoryImported()
+{
+    return this->mHostMemoryImported;
+}
+
+void
+Tensor::importHostMemory(const HostPointer& hostPointer)
+{
+    if (!this->mPhysicalDevice) {
+        throw std::runtime_error("Kompute Tensor phyisical device is null");
+    }
+    if (!this->mDevice) {
+        throw std::runtime_error("Kompute Tensor device is null");
+    }
+    if (!hostPointer.data || hostPointer.size < this->memorySize()) {
+        throw std::runtime_error(
+          fmt::format("Kompute Tensor host pointer of {} bytes is smaller "
+                      "than the tensor size of {} bytes",
+                      hostPointer.size,
+                      this->memorySize()));
+    }
+
+    // Extension functions are not exported by the loader so they have to be
+    // fetched from the device, which returns null if it's not enabled
+    PFN_vkGetMemoryHostPointerPropertiesEXT getMemoryHostPointerProperties =
+      (PFN_vkGetMemoryHostPointerPropertiesEXT)this->mDevice->getProcAddr(
+        "vkGetMemoryHostPointerPropertiesEXT");
+    if (!getMemoryHostPointerProperties) {
+        throw std::runtime_error(
+          "Kompute Tensor host pointer import requires the "
+          "VK_EXT_external_memory_host device extension");
+    }
+
+    VkMemoryHostPointerPropertiesEXT hostPointerProperties = {};
+    hostPointerProperties.sType =
+      VK_STRUCTURE_TYPE_MEMORY_HOST_POINTER_PROPERTIES_EXT;
+    VkResult result = getMemoryHostPointerProperties(
+      static_cast<VkDevice>(*this->mDevice),
+      VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT,
+      hostPointer.data,
+      &hostPointerProperties);
+    if (result != VK_SUCCESS) {
+        throw std::runtime_error(
+          fmt::format("Kompute Tensor host pointer cannot be imported: {}",
+                      vk::to_string(vk::Result(result))));
+    }
+
+    KP_LOG_DEBUG("Kompute Tensor importing {} bytes of host memory",
+                 hostPointer.size);
+
+    vk::ExternalMemoryBufferCreateInfo externalMemoryInfo(
+      vk::ExternalMemoryHandleTypeFlagBits::eHostAllocationEXT);
+    vk::BufferCreateInfo bufferInfo(vk::BufferCreateFlags(),
+                                    this->memorySize(),
+                                    this->getPrimaryBufferUsageFlags(),
+                                    vk::SharingMode::eExclusive);
+    bufferInfo.pNext = &externalMemoryInfo;
+
+    // The pointer overloads return the result instead of throwing it
+    std::shared_ptr<vk::Buffer> buffer = std::make_shared<vk::Buffer>();
+    vk::Result bufferResult =
+      this->mDevice->createBuffer(&bufferInfo, nullptr, buffer.get());
+    if (bufferResult != vk::Result::eSuccess) {
+        throw std::runtime_error(
+          fmt::format("Kompute Tensor failed to create the buffer for the "
+                      "imported host memory: {}",
+                      vk::to_string(bufferResult)));
+    }
+    this->mPrimaryBuffer = buffer;
+    this->mFreePrimaryBuffer = true;
+
+    try {
+        vk::MemoryRequirements memoryRequirements =
+          this->mDevice->getBufferMemoryRequirements(*this->mPrimaryBuffer);
+
+        // Imported memory is never mapped, so it can't be flushed and has to
+        // be coherent for the host writes to be visible to the device
+        uint32_t memoryTypeIndex = this->findMemoryTypeIndex(
+          memoryRequirements.memoryTypeBits &
+            hostPointerProperties.memoryTypeBits,
+          { vk::MemoryPropertyFlagBits::eHostVisible |
+            vk::MemoryPropertyFlagBits::eHostCoherent });
+
+        vk::ImportMemoryHostPointerInfoEXT importInfo(
+          vk::ExternalMemoryHandleTypeFlagBits::eHostAllocationEXT,
+          hostPointer.data);
+        vk::MemoryAllocateInfo memoryAllocateInfo(hostPointer.size,
+                                                  memoryTypeIndex);
+        memoryAllocateInfo.pNext = &importInfo;
+
+        std::shared_ptr<vk::DeviceMemory> memory =
+          std::make_shared<vk::DeviceMemory>();
+        vk::Result memoryResult = this->mDevice->allocateMemory(
+          &memoryAllocateInfo, nullptr, memory.get());
+        if (memoryResult != vk::Result::eSuccess) {
+            throw std::runtime_error(
+              fmt::format("Kompute Tensor failed to import {} bytes of host "
+                          "memory: {}",
+                          hostPointer.size,
+                          vk::to_string(memoryResult)));
+        }
+        this->mPrimaryMemory = memory;
+        this->mFreePrimaryMemory = true;
+        this->mPrimaryAllocation.size = hostPointer.size;
+        this->mPrimaryAllocation.memoryTypeIndex = memoryTypeIndex;
+
+        this->mDevice->bindBufferMemory(
+          *this->mPrimaryBuffer, *this->mPrimaryMemory, 0);
+
+        this->mPrimaryMemoryPropertyFlags =
+          this->mPhysicalDevice->getMemoryProperties()
+            .memoryTypes[memoryTypeIndex]
+            .propertyFlags;
+    } catch (const std::exception&) {
+        this->destroy();
+        throw;
+    }
+
+    // The host pointer is the data of the tensor, so it's never unmapped
+    this->mRawData = hostPointer.data;
+    this->mUnmapMemory = false;
+    this->mTrackHostWrites = false;
+    this->mHostMemoryImported = true;
+}
+
 void
 Tensor::allocateMemoryCreateGPUResources()
 {
@@ -343,23 +1054,32 @@ Tensor::allocateMemoryCreateGPUResources()
     this->createBuffer(this->mPrimaryBuffer,
                        this->getPrimaryBufferUsageFlags());
     this->mFreePrimaryBuffer = true;
-    this->mPrimaryMemory = std::make_shared<vk::DeviceMemory>();
-    this->allocateBindMemory(this->mPrimaryBuffer,
-                             this->mPrimaryMemory,
-                             this->getPrimaryMemoryPropertyFlags());
+
+    // The memory of transient tensors is bound by the sequence that plans it
+    if (this->mMemoryType == MemoryTypes::eTransient) {
+        KP_LOG_DEBUG("Kompute Tensor deferring transient memory binding");
+        return;
+    }
+
+    this->mPrimaryMemoryPropertyFlags =
+      this->allocateBindMemory(this->mPrimaryBuffer,
+                               this->mPrimaryMemory,
+                               this->mPrimaryAllocation,
+                               this->getPrimaryMemoryPropertyFlags());
     this->mFreePrimaryMemory = true;
 
-    if (this->mMemoryType == MemoryTypes::eDevice) {
+    if (this->mMemoryType == MemoryTypes::eDevice && !this->mStagingRing) {
         KP_LOG_DEBUG("Kompute Tensor creating staging buffer and memory");
 
         this->mStagingBuffer = std::make_shared<vk::Buffer>();
         this->createBuffer(this->mStagingBuffer,
                            this->getStagingBufferUsageFlags());
         this->mFreeStagingBuffer = true;
-        this->mStagingMemory = std::make_shared<vk::DeviceMemory>();
-        this->allocateBindMemory(this->mStagingBuffer,
-                                 this->mStagingMemory,
-                                 this->getStagingMemoryPropertyFlags());
+        this->mStagingMemoryPropertyFlags =
+          this->allocateBindMemory(this->mStagingBuffer,
+                                   this->mStagingMemory,
+                                   this->mStagingAllocation,
+                                   this->getStagingMemoryPropertyFlags());
         this->mFreeStagingMemory = true;
     }
 
@@ -371,7 +1091,9 @@ Tensor::createBuffer(std::shared_ptr<vk::Buffer> buffer,
                      vk::BufferUsageFlags bufferUsageFlags)
 {
 
-    vk::DeviceSize bufferSize = this->memorySize();
+    // Buffers hold the whole capacity so the tensor can grow into it
+    vk::DeviceSize bufferSize =
+      this->mCapacity * static_cast<uint64_t>(this->mDataTypeMemorySize);
 
     if (bufferSize < 1) {
         throw std::runtime_error(
@@ -392,49 +1114,61 @@ Tensor::createBuffer(std::shared_ptr<vk::Buffer> buffer,
     this->mDevice->createBuffer(&bufferInfo, nullptr, buffer.get());
 }
 
-void
-Tensor::allocateBindMemory(std::shared_ptr<vk::Buffer> buffer,
-                           std::shared_ptr<vk::DeviceMemory> memory,
-                           vk::MemoryPropertyFlags memoryPropertyFlags)
+vk::MemoryPropertyFlags
+Tensor::allocateBindMemory(
+  std::shared_ptr<vk::Buffer> buffer,
+  std::shared_ptr<vk::DeviceMemory>& memory,
+  MemoryPool::Allocation& allocation,
+  const std::vector<vk::MemoryPropertyFlags>& memoryPropertyFlags)
 {
 
     KP_LOG_DEBUG("Kompute Tensor allocating and binding memory");
 
-    vk::PhysicalDeviceMemoryProperties memoryProperties =
-      this->mPhysicalDevice->getMemoryProperties();
-
     vk::MemoryRequirements memoryRequirements =
       this->mDevice->getBufferMemoryRequirements(*buffer);
 
-    uint32_t memoryTypeIndex = -1;
-    bool memoryTypeIndexFound = false;
-    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
-        if (memoryRequirements.memoryTypeBits & (1 << i)) {
-            if (((memoryProperties.memoryTypes[i]).propertyFlags &
-                 memoryPropertyFlags) == memoryPropertyFlags) {
-                memoryTypeIndex = i;
-                memoryTypeIndexFound = true;
-                break;
-            }
-        }
-    }
-    if (!memoryTypeIndexFound) {
-        throw std::runtime_error(
-          "Memory type index for buffer creation not found");
+    uint32_t memoryTypeIndex = this->findMemoryTypeIndex(
+      memoryRequirements.memoryTypeBits, memoryPropertyFlags);
+    vk::MemoryPropertyFlags memoryTypeFlags =
+      this->mPhysicalDevice->getMemoryProperties()
+        .memoryTypes[memoryTypeIndex]
+        .propertyFlags;
+
+    if (this->mMemoryPool) {
+        KP_LOG_DEBUG("Kompute Tensor allocating pooled memory index: {}, size "
+                     "{}, flags: {}",
+                     memoryTypeIndex,
+                     memoryRequirements.size,
+                     vk::to_string(memoryTypeFlags));
+
+        allocation = this->mMemoryPool->allocate(memoryRequirements,
+                                                 memoryTypeIndex);
+        memory = allocation.memory;
+
+        this->mDevice->bindBufferMemory(*buffer, *memory, allocation.offset);
+        return memoryTypeFlags;
     }
 
     KP_LOG_DEBUG(
       "Kompute Tensor allocating memory index: {}, size {}, flags: {}",
       memoryTypeIndex,
       memoryRequirements.size,
-      vk::to_string(memoryPropertyFlags));
+      vk::to_string(memoryTypeFlags));
+
+    // Unpooled allocations only record their size and type for accounting
+    allocation = MemoryPool::Allocation();
+    allocation.size = memoryRequirements.size;
+    allocation.memoryTypeIndex = memoryTypeIndex;
 
     vk::MemoryAllocateInfo memoryAllocateInfo(memoryRequirements.size,
                                               memoryTypeIndex);
 
+    memory = std::make_shared<vk::DeviceMemory>();
     this->mDevice->allocateMemory(&memoryAllocateInfo, nullptr, memory.get());
 
     this->mDevice->bindBufferMemory(*buffer, *memory, 0);
+
+    return memoryTypeFlags;
 }
 
 void
@@ -476,6 +1210,17 @@ Tensor::destroy()
         }
     }
 
+    this->finishResize();
+
+    // The viewed tensor can be resized and evicted again once it has no views
+    if (this->mViewedTensor) {
+        this->mViewedTensor->mViewCount--;
+    }
+    this->mViewedTensor = nullptr;
+    this->mHostMemoryImported = false;
+    this->mEvicted = false;
+    this->mCapacity = 0;
+
     Memory::destroy();
 
     KP_LOG_DEBUG("Kompute Tensor successful destroy()");
@@ -4,8 +4,15 @@
 #include "kompute/Core.hpp"
 
 #include "fmt/format.h"
+#include "kompute/PipelineRegistry.hpp"
 #include "kompute/Tensor.hpp"
 #include "logger/Logger.hpp"
+#include <mutex>
+
+// Smallest maxComputeWorkGroupCount limit guaranteed by Vulkan
+#define KP_DEFAULT_MAX_WORKGROUP_COUNT 65535
+// Smallest maxPushConstantsSize limit guaranteed by Vulkan
+#define KP_DEFAULT_MAX_PUSH_CONSTANTS_SIZE 128
 
 namespace kp {
 
@@ -33,18 +40,33 @@ class Algorithm
      * when initializing the pipeline, which set the size of the push constants
      * - these can be modified but all new values must have the same data type
      * and length as otherwise it will result in errors.
+     *  @param pipelineCache (optional) The pipeline cache to create the
+     * pipeline with, which is not owned by the algorithm. An empty cache owned
+     * by the algorithm is created if not provided.
+     *  @param pipelineRegistry (optional) The registry to share the shader
+     * module and pipeline with other algorithms through. The algorithm owns
+     * its shader module and pipeline if not provided.
+     *  @param maxPushConstantsSize (optional) The maxPushConstantsSize limit
+     * of the device, which defaults to the smallest limit Vulkan guarantees.
      */
     template<typename S = float, typename P = float>
-    Algorithm(std::shared_ptr<vk::Device> device,
-              const std::vector<std::shared_ptr<Memory>>& memObjects = {},
-              const std::vector<uint32_t>& spirv = {},
-              const Workgroup& workgroup = {},
-              const std::vector<S>& specializationConstants = {},
-              const std::vector<P>& pushConstants = {})
+    Algorithm(
+      std::shared_ptr<vk::Device> device,
+      const std::vector<std::shared_ptr<Memory>>& memObjects = {},
+      const std::vector<uint32_t>& spirv = {},
+      const Workgroup& workgroup = {},
+      const std::vector<S>& specializationConstants = {},
+      const std::vector<P>& pushConstants = {},
+      std::shared_ptr<vk::PipelineCache> pipelineCache = nullptr,
+      std::shared_ptr<PipelineRegistry> pipelineRegistry = nullptr,
+      uint32_t maxPushConstantsSize = KP_DEFAULT_MAX_PUSH_CONSTANTS_SIZE)
     {
         KP_LOG_DEBUG("Kompute Algorithm Constructor with device");
 
         this->mDevice = device;
+        this->mPipelineCache = pipelineCache;
+        this->mPipelineRegistry = pipelineRegistry;
+        this->mMaxPushConstantsSize = maxPushConstantsSize;
 
         if (memObjects.size() && spirv.size()) {
             KP_LOG_INFO(
@@ -131,9 +153,11 @@ class Algorithm
             this->destroy();
         }
 
+        this->findBaseWorkgroupPushConstant();
         this->createParameters();
         this->createShaderModule();
         this->createPipeline();
+        this->findReadOnlyBindings();
     }
 
     /**
@@ -146,13 +170,21 @@ class Algorithm
      * Records the dispatch function with the provided template parameters or
      * alternatively using the size of the tensor by default.
      *
+     * Workgroups with more groups in X than the maximum workgroup count of
+     * the device are split into several dispatches of at most that count.
+     * Before each of them the index of its first group in X is written to
+     * the reserved push constant, which shaders have to add to
+     * gl_WorkGroupID.x to find the group they process.
+     *
      * @param commandBuffer Command buffer to record the algorithm resources to
      */
     void recordDispatch(const vk::CommandBuffer& commandBuffer);
 
     /**
      * Records command that binds the "core" algorithm components which consist
-     * of binding the pipeline and binding the descriptorsets.
+     * of binding the pipeline and binding the descriptorsets. Descriptors of
+     * eTransient memory objects that were not bound when the algorithm was
+     * created are written before they are first bound.
      *
      * @param commandBuffer Command buffer to record the algorithm resources to
      */
@@ -160,7 +192,7 @@ class Algorithm
 
     /**
      * Records command that binds the push constants to the command buffer
-     * provided
+     * provided, and resets the reserved base workgroup push constant to 0
      * - it is required that the pushConstants provided are of the same size as
      * the ones provided during initialization.
      *
@@ -168,6 +200,22 @@ class Algorithm
      */
     void recordBindPush(const vk::CommandBuffer& commandBuffer);
 
+    /**
+     * Records command that binds the push constants provided to the command
+     * buffer, without changing the push constants of the algorithm. This
+     * allows recording dispatches with different push constants from several
+     * threads at the same time.
+     *
+     * @param commandBuffer Command buffer to record the algorithm resources to
+     * @param data The raw data of the push constants
+     * @param size The number of data elements provided in the data
+     * @param memorySize The memory size of each of the data elements in bytes
+     */
+    void recordBindPush(const vk::CommandBuffer& commandBuffer,
+                        const void* data,
+                        uint32_t size,
+                        uint32_t memorySize);
+
     /**
      * function that checks all the gpu resource components to verify if these
      * have been created and returns true if all are valid.
@@ -184,7 +232,7 @@ class Algorithm
      * will be initialized on the size of the first tensor (ie.
      * this->mTensor[0]->size())
      */
-    void setWorkgroup(const Workgroup& workgroup, uint32_t minSize = 1);
+    void setWorkgroup(const Workgroup& workgroup, uint64_t minSize = 1);
     /**
      * Sets the push constants to the new value provided to use in the next
      * bindPush()
@@ -225,11 +273,12 @@ class Algorithm
               totalSize,
               previousTotalSize));
         }
-        if (this->mPushConstantsData) {
-            free(this->mPushConstantsData);
-        }
 
-        this->mPushConstantsData = malloc(totalSize);
+        // The total size doesn't change, so the data is copied in place
+        std::lock_guard<std::mutex> lock(this->mRecordMutex);
+        if (!this->mPushConstantsData) {
+            this->mPushConstantsData = malloc(totalSize);
+        }
         memcpy(this->mPushConstantsData, data, totalSize);
         this->mPushConstantsDataTypeMemorySize = memorySize;
         this->mPushConstantsSize = size;
@@ -243,6 +292,42 @@ class Algorithm
      * as the ones created during initialization.
      */
     const Workgroup& getWorkgroup();
+
+    /**
+     * Sets the maximum number of workgroups of a single dispatch in each
+     * dimension, which the manager sets to the limits of the device.
+     *
+     * @param maxWorkgroupCount The maximum workgroup count of the device
+     */
+    void setMaxWorkgroupCount(const Workgroup& maxWorkgroupCount);
+
+    /**
+     * Gets the maximum number of workgroups of a single dispatch in each
+     * dimension.
+     *
+     * @returns The maximum workgroup count used to split dispatches
+     */
+    const Workgroup& getMaxWorkgroupCount();
+
+    /**
+     * Gets the offset in bytes of the push constant reserved for the index of
+     * the first workgroup in X of a split dispatch. It is a 32 bit unsigned
+     * integer that follows the push constants of the algorithm, aligned to 4
+     * bytes, so shaders declare it as the last member of their push constant
+     * block.
+     *
+     * @returns The offset of the reserved push constant
+     */
+    uint32_t getBaseWorkgroupOffset() const;
+
+    /**
+     * Whether the push constant block of the shader declares the reserved
+     * base workgroup push constant. The push constant range only includes it
+     * in that case, and only these algorithms can split their dispatches.
+     *
+     * @returns Boolean stating whether the shader reads the base workgroup
+     */
+    bool readsBaseWorkgroup() const;
     /**
      * Gets the specialization constants of the current algorithm.
      *
@@ -274,12 +359,38 @@ class Algorithm
      */
     const std::vector<std::shared_ptr<Memory>>& getMemObjects();
 
+    /**
+     * Returns true if the shader only reads the memory object at the index
+     * provided, which is the case when its binding is declared readonly in
+     * the shader.
+     *
+     * @param index The index of the memory object, which is its binding
+     * @returns Boolean stating if the memory object is only read
+     */
+    bool isReadOnly(uint32_t index) const;
+
+    /**
+     * Sets the name of the algorithm, which labels its dispatches in the
+     * profiles of kp::Profiler.
+     *
+     * @param name The name of the algorithm
+     */
+    void setName(const std::string& name);
+
+    /**
+     * Gets the name of the algorithm.
+     *
+     * @returns The name of the algorithm, which is empty unless set
+     */
+    const std::string& getName() const;
+
     void destroy();
 
   private:
     // -------------- NEVER OWNED RESOURCES
     std::shared_ptr<vk::Device> mDevice;
     std::vector<std::shared_ptr<Memory>> mMemObjects;
+    std::shared_ptr<PipelineRegistry> mPipelineRegistry;
 
     // -------------- OPTIONALLY OWNED RESOURCES
     std::shared_ptr<vk::DescriptorSetLayout> mDescriptorSetLayout;
@@ -296,6 +407,7 @@ class Algorithm
     bool mFreePipelineCache = false;
     std::shared_ptr<vk::Pipeline> mPipeline;
     bool mFreePipeline = false;
+    std::shared_ptr<PipelineRegistry::Pipeline> mRegistryPipeline;
 
     // -------------- ALWAYS OWNED RESOURCES
     std::vector<uint32_t> mSpirv;
@@ -306,13 +418,38 @@ class Algorithm
     uint32_t mPushConstantsDataTypeMemorySize = 0;
     uint32_t mPushConstantsSize = 0;
     Workgroup mWorkgroup;
+    Workgroup mMaxWorkgroupCount = { KP_DEFAULT_MAX_WORKGROUP_COUNT,
+                                     KP_DEFAULT_MAX_WORKGROUP_COUNT,
+                                     KP_DEFAULT_MAX_WORKGROUP_COUNT };
+    std::vector<vk::DescriptorPoolSize> mDescriptorPoolSizes;
+    // Pools of descriptor sets replaced while submissions used them
+    std::vector<std::shared_ptr<vk::DescriptorPool>> mRetiredDescriptorPools;
+    uint32_t mMaxPushConstantsSize = KP_DEFAULT_MAX_PUSH_CONSTANTS_SIZE;
+    bool mReadsBaseWorkgroup = false;
+    bool mDescriptorSetsPending = false;
+    std::vector<uint64_t> mDescriptorGenerations;
+    std::vector<bool> mReadOnlyBindings;
+    std::string mName;
+    // Guards the state read and updated while recording, as different
+    // threads may record dispatches of the algorithm at the same time
+    std::mutex mRecordMutex;
 
     // Create util functions
     void createShaderModule();
     void createPipeline();
+    PipelineRegistry::Pipeline compilePipeline();
 
     // Parameters
     void createParameters();
+    void createDescriptorSet();
+    void retireDescriptorSet();
+    void destroyRetiredDescriptorPools();
+    void updateDescriptorSets();
+
+    // Finds the bindings decorated as NonWritable in the SPIR-V
+    void findReadOnlyBindings();
+    void findBaseWorkgroupPushConstant();
+    uint32_t getPushConstantRangeSize() const;
 };
 
 } // End namespace kp
@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "kompute/Core.hpp"
+#include "logger/Logger.hpp"
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define KP_DEFAULT_COMPLETION_POLL_INTERVAL 1000000
+
+namespace kp {
+
+class Sequence;
+
+/**
+ * Background thread that waits on the submissions of sequences in flight,
+ * and completes them as their fences signal: it runs the postEval of the
+ * operations of the sequence, then the completion callback of the submission,
+ * and finally makes the future returned for the submission ready.
+ *
+ * The thread waits on the fences of all the submissions it watches at once,
+ * so it completes them in the order they finish rather than the order they
+ * were submitted. Submissions watched while it waits are picked up after at
+ * most one poll interval. The thread is only started once the first
+ * submission is watched.
+ *
+ * Callbacks run on the completion thread, so they must not block on other
+ * submissions watched by it, nor destroy it.
+ */
+class CompletionThread
+{
+  public:
+    /**
+     * Callback run on the completion thread once a submission has completed.
+     */
+    using Callback = std::function<void()>;
+
+    /**
+     * Constructor of the completion thread, which doesn't start the thread.
+     *
+     * @param device The device the fences of the submissions belong to
+     * @param pollInterval The maximum number of nanoseconds before the thread
+     * picks up the submissions watched while it waits on the fences
+     */
+    CompletionThread(
+      std::shared_ptr<vk::Device> device,
+      uint64_t pollInterval = KP_DEFAULT_COMPLETION_POLL_INTERVAL);
+
+    /**
+     * Destructor which completes the pending submissions and joins the
+     * thread.
+     */
+    ~CompletionThread();
+
+    /**
+     * Watches a submission of a sequence until it completes. The sequence
+     * must not be submitted, awaited or modified from other threads until the
+     * submission has been completed.
+     *
+     * @param sequence The sequence the submission was made by
+     * @param ticket The ticket of the submission
+     * @param callback Optional callback to run once the submission completed
+     * @return Future that becomes ready once the callback has run, or holds
+     * the exception thrown while completing the submission
+     */
+    std::future<void> watch(std::shared_ptr<Sequence> sequence,
+                            uint64_t ticket,
+                            Callback callback = nullptr);
+
+    /**
+     * Returns the number of submissions watched that have not completed yet.
+     *
+     * @return The number of pending submissions
+     */
+    size_t pendingCount();
+
+    /**
+     * Returns true if the completion thread has been initialised.
+     *
+     * @return Boolean stating if is initialized
+     */
+    bool isInit() const;
+
+    /**
+     * Waits until the pending submissions have been completed, and then stops
+     * and joins the thread.
+     */
+    void destroy();
+
+  private:
+    struct Entry
+    {
+        std::shared_ptr<Sequence> sequence;
+        uint64_t ticket;
+        vk::Fence fence;
+        Callback callback;
+        std::promise<void> promise;
+    };
+
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<vk::Device> mDevice = nullptr;
+
+    // -------------- ALWAYS OWNED RESOURCES
+    std::thread mThread;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::vector<std::shared_ptr<Entry>> mEntries;
+    uint64_t mPollInterval;
+    bool mStop = false;
+
+    void run();
+    static void complete(Entry& entry);
+};
+
+} // End namespace kp
@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "kompute/Core.hpp"
+#include "kompute/operations/OpBase.hpp"
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace kp {
+
+/**
+ * Tracks the accesses of a recording to tensor buffers, and plans the merged
+ * pipeline barrier each operation requires against the operations recorded
+ * before it from the memory accesses the operation declares.
+ *
+ * For every buffer it keeps the last write and the stages that have read it
+ * since. Reads after a write that isn't visible to their stages, writes after
+ * writes, and writes after reads require a barrier, whereas reads of data
+ * already visible to their stage don't. Operations that don't declare any
+ * access are ordered against all the commands before and after them with a
+ * full memory barrier.
+ */
+class HazardTracker
+{
+  public:
+    /**
+     * Counters of the accesses planned by the tracker.
+     */
+    struct Stats
+    {
+        uint64_t trackedAccesses = 0;  ///< Tensor accesses declared by ops
+        uint64_t requiredBarriers = 0; ///< Accesses that required a barrier
+        uint64_t elidedBarriers = 0;   ///< Accesses without a hazard
+        uint64_t pipelineBarriers = 0; ///< Merged pipeline barriers recorded
+        uint64_t fullBarriers = 0;     ///< Barriers around undeclared ops
+    };
+
+    /**
+     * Barrier planned before an operation, which is only recorded when its
+     * source stage mask isn't empty.
+     */
+    struct Barrier
+    {
+        vk::PipelineStageFlags srcStageMask;
+        vk::PipelineStageFlags dstStageMask;
+        vk::MemoryBarrier memoryBarrier;
+    };
+
+    /**
+     * Constructor for the hazard tracker.
+     *
+     * @param assumeWritten Whether buffers accessed for the first time in the
+     * recording may have been written by any command before it. Otherwise
+     * the caller guarantees the previous writes are visible to the recording.
+     */
+    explicit HazardTracker(bool assumeWritten = true);
+
+    /**
+     * Plans the barrier the memory accesses of the operation require, and
+     * updates the state of the buffers it uses. An operation that doesn't
+     * declare any access gets a full memory barrier before it when commands
+     * may have been recorded before it, and the operation after it gets one
+     * as well.
+     *
+     * @param op The operation about to be recorded
+     * @return The barrier to record before the operation
+     */
+    Barrier plan(const std::shared_ptr<OpBase>& op);
+
+    /**
+     * Records the barrier planned for an operation, if it requires any.
+     *
+     * @param commandBuffer The command buffer to record the barrier into
+     * @param barrier The barrier planned for the operation
+     */
+    static void record(const vk::CommandBuffer& commandBuffer,
+                       const Barrier& barrier);
+
+    /**
+     * Forgets the state of the buffers when a new recording begins. The
+     * counters keep accumulating.
+     */
+    void clear();
+
+    /**
+     * Retrieves the counters of the accesses planned so far.
+     *
+     * @return The hazard tracking statistics
+     */
+    Stats stats() const;
+
+  private:
+    struct AccessState
+    {
+        vk::AccessFlags writeAccess;
+        vk::PipelineStageFlags writeStages;
+        vk::PipelineStageFlags visibleStages;
+        vk::PipelineStageFlags readStages;
+    };
+
+    std::unordered_map<VkBuffer, AccessState> mAccessStates;
+    Stats mStats;
+    bool mAssumeWritten;
+    // Whether the previous operation didn't declare its accesses
+    bool mFullBarrierPending = false;
+    // Whether a full barrier made all the previous writes visible
+    bool mAllVisible = false;
+};
+
+} // End namespace kp
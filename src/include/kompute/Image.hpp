@@ -34,6 +34,8 @@ class Image : public Memory
      *  @param dataType Data type for the image which is of type DataTypes
      *  @param memoryType Type for the image which is of type MemoryTypes
      *  @param tiling Tiling mode to use for the image.
+     *  @param memoryPool (Optional) Pool to sub-allocate the memory from
+     *  @param stagingPolicy (Optional) Access pattern of the staging memory
      */
     Image(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
           std::shared_ptr<vk::Device> device,
@@ -44,8 +46,17 @@ class Image : public Memory
           uint32_t numChannels,
           const DataTypes& dataType,
           vk::ImageTiling tiling,
-          const MemoryTypes& memoryType = MemoryTypes::eDevice)
-      : Memory(physicalDevice, device, dataType, memoryType, x, y)
+          const MemoryTypes& memoryType = MemoryTypes::eDevice,
+          std::shared_ptr<MemoryPool> memoryPool = nullptr,
+          const StagingPolicy& stagingPolicy = StagingPolicy::eUpload)
+      : Memory(physicalDevice,
+               device,
+               dataType,
+               memoryType,
+               x,
+               y,
+               memoryPool,
+               stagingPolicy)
     {
         if (dataType == DataTypes::eCustom) {
             throw std::runtime_error(
@@ -65,6 +76,8 @@ class Image : public Memory
      *  @param dataType Data type for the image which is of type ImageDataTypes
      *  @param memoryType Type for the image which is of type MemoryTypes
      *  @param tiling Tiling mode to use for the image.
+     *  @param memoryPool (Optional) Pool to sub-allocate the memory from
+     *  @param stagingPolicy (Optional) Access pattern of the staging memory
      */
     Image(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
           std::shared_ptr<vk::Device> device,
@@ -73,7 +86,9 @@ class Image : public Memory
           uint32_t numChannels,
           const DataTypes& dataType,
           vk::ImageTiling tiling,
-          const MemoryTypes& memoryType = MemoryTypes::eDevice)
+          const MemoryTypes& memoryType = MemoryTypes::eDevice,
+          std::shared_ptr<MemoryPool> memoryPool = nullptr,
+          const StagingPolicy& stagingPolicy = StagingPolicy::eUpload)
       : Image(physicalDevice,
               device,
               nullptr,
@@ -83,7 +98,9 @@ class Image : public Memory
               numChannels,
               dataType,
               tiling,
-              memoryType)
+              memoryType,
+              memoryPool,
+              stagingPolicy)
     {
     }
 
@@ -101,6 +118,8 @@ class Image : public Memory
      *  @param numChannels The number of channels in the image
      *  @param dataType Data type for the image which is of type DataTypes
      *  @param memoryType Type for the image which is of type MemoryTypes
+     *  @param memoryPool (Optional) Pool to sub-allocate the memory from
+     *  @param stagingPolicy (Optional) Access pattern of the staging memory
      */
     Image(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
           std::shared_ptr<vk::Device> device,
@@ -110,8 +129,17 @@ class Image : public Memory
           uint32_t y,
           uint32_t numChannels,
           const DataTypes& dataType,
-          const MemoryTypes& memoryType = MemoryTypes::eDevice)
-      : Memory(physicalDevice, device, dataType, memoryType, x, y)
+          const MemoryTypes& memoryType = MemoryTypes::eDevice,
+          std::shared_ptr<MemoryPool> memoryPool = nullptr,
+          const StagingPolicy& stagingPolicy = StagingPolicy::eUpload)
+      : Memory(physicalDevice,
+               device,
+               dataType,
+               memoryType,
+               x,
+               y,
+               memoryPool,
+               stagingPolicy)
     {
         vk::ImageTiling tiling;
 
@@ -144,6 +172,8 @@ class Image : public Memory
      *  @param y Height of the image in pixels
      *  @param dataType Data type for the image which is of type ImageDataTypes
      *  @param memoryType Type for the image which is of type MemoryTypes
+     *  @param memoryPool (Optional) Pool to sub-allocate the memory from
+     *  @param stagingPolicy (Optional) Access pattern of the staging memory
      */
     Image(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
           std::shared_ptr<vk::Device> device,
@@ -151,7 +181,9 @@ class Image : public Memory
           uint32_t y,
           uint32_t numChannels,
           const DataTypes& dataType,
-          const MemoryTypes& memoryType = MemoryTypes::eDevice)
+          const MemoryTypes& memoryType = MemoryTypes::eDevice,
+          std::shared_ptr<MemoryPool> memoryPool = nullptr,
+          const StagingPolicy& stagingPolicy = StagingPolicy::eUpload)
       : Image(physicalDevice,
               device,
               nullptr,
@@ -160,7 +192,9 @@ class Image : public Memory
               y,
               numChannels,
               dataType,
-              memoryType)
+              memoryType,
+              memoryPool,
+              stagingPolicy)
     {
     }
 
@@ -321,9 +355,12 @@ class Image : public Memory
     void createImage(std::shared_ptr<vk::Image> image,
                      vk::ImageUsageFlags imageUsageFlags,
                      vk::ImageTiling imageTiling);
-    void allocateBindMemory(std::shared_ptr<vk::Image> image,
-                            std::shared_ptr<vk::DeviceMemory> memory,
-                            vk::MemoryPropertyFlags memoryPropertyFlags);
+    vk::MemoryPropertyFlags allocateBindMemory(
+      std::shared_ptr<vk::Image> image,
+      std::shared_ptr<vk::DeviceMemory>& memory,
+      MemoryPool::Allocation& allocation,
+      const std::vector<vk::MemoryPropertyFlags>& memoryPropertyFlags,
+      bool linear);
     void recordCopyImage(const vk::CommandBuffer& commandBuffer,
                          std::shared_ptr<vk::Image> srcImage,
                          std::shared_ptr<vk::Image> dstImage,
@@ -395,7 +432,9 @@ class ImageT : public Image
            uint32_t y,
            uint32_t numChannels,
            vk::ImageTiling tiling,
-           const MemoryTypes& imageType = MemoryTypes::eDevice)
+           const MemoryTypes& imageType = MemoryTypes::eDevice,
+           std::shared_ptr<MemoryPool> memoryPool = nullptr,
+           const StagingPolicy& stagingPolicy = StagingPolicy::eUpload)
       : Image(physicalDevice,
               device,
               (void*)data.data(),
@@ -405,7 +444,9 @@ class ImageT : public Image
               numChannels,
               Memory::dataType<T>(),
               tiling,
-              imageType)
+              imageType,
+              memoryPool,
+              stagingPolicy)
     {
         // Images cannot be created with custom types
         static_assert(Memory::dataType<T>() != DataTypes::eCustom,
@@ -425,7 +466,9 @@ class ImageT : public Image
            uint32_t x,
            uint32_t y,
            uint32_t numChannels,
-           const MemoryTypes& imageType = MemoryTypes::eDevice)
+           const MemoryTypes& imageType = MemoryTypes::eDevice,
+           std::shared_ptr<MemoryPool> memoryPool = nullptr,
+           const StagingPolicy& stagingPolicy = StagingPolicy::eUpload)
       : Image(physicalDevice,
               device,
               (void*)data.data(),
@@ -434,7 +477,9 @@ class ImageT : public Image
               y,
               numChannels,
               Memory::dataType<T>(),
-              imageType)
+              imageType,
+              memoryPool,
+              stagingPolicy)
     {
         // Images cannot be created with custom types
         static_assert(Memory::dataType<T>() != DataTypes::eCustom,
@@ -454,7 +499,9 @@ class ImageT : public Image
            uint32_t y,
            uint32_t numChannels,
            vk::ImageTiling tiling,
-           const MemoryTypes& imageType = MemoryTypes::eDevice)
+           const MemoryTypes& imageType = MemoryTypes::eDevice,
+           std::shared_ptr<MemoryPool> memoryPool = nullptr,
+           const StagingPolicy& stagingPolicy = StagingPolicy::eUpload)
       : Image(physicalDevice,
               device,
               x,
@@ -462,7 +509,9 @@ class ImageT : public Image
               numChannels,
               Memory::dataType<T>(),
               tiling,
-              imageType)
+              imageType,
+              memoryPool,
+              stagingPolicy)
     {
         // Images cannot be created with custom types
         static_assert(Memory::dataType<T>() != DataTypes::eCustom,
@@ -480,14 +529,18 @@ class ImageT : public Image
            uint32_t x,
            uint32_t y,
            uint32_t numChannels,
-           const MemoryTypes& imageType = MemoryTypes::eDevice)
+           const MemoryTypes& imageType = MemoryTypes::eDevice,
+           std::shared_ptr<MemoryPool> memoryPool = nullptr,
+           const StagingPolicy& stagingPolicy = StagingPolicy::eUpload)
       : Image(physicalDevice,
               device,
               x,
               y,
               numChannels,
               Memory::dataType<T>(),
-              imageType)
+              imageType,
+              memoryPool,
+              stagingPolicy)
     {
         // Images cannot be created with custom types
         static_assert(Memory::dataType<T>() != DataTypes::eCustom,
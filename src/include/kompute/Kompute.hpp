@@ -1,20 +1,35 @@
 #pragma once
 
 #include "Algorithm.hpp"
+#include "CompletionThread.hpp"
 #include "Core.hpp"
+#include "HazardTracker.hpp"
 #include "Image.hpp"
 #include "Manager.hpp"
+#include "MemoryPool.hpp"
+#include "ParameterBlock.hpp"
+#include "PipelineRegistry.hpp"
+#include "Profiler.hpp"
+#include "Residency.hpp"
 #include "Sequence.hpp"
+#include "SequenceFragment.hpp"
+#include "StagingRing.hpp"
 #include "Tensor.hpp"
 
 #include "operations/OpAlgoDispatch.hpp"
+#include "operations/OpAlgoDispatchIndirect.hpp"
 #include "operations/OpBase.hpp"
 #include "operations/OpCopy.hpp"
+#include "operations/OpExecuteFragment.hpp"
 #include "operations/OpMemoryBarrier.hpp"
 #include "operations/OpMult.hpp"
+#include "operations/OpResize.hpp"
 #include "operations/OpSyncDevice.hpp"
 #include "operations/OpSyncLocal.hpp"
+#include "operations/OpSyncParameters.hpp"
+#include "operations/OpWorkgroupCount.hpp"
 
 // Will be build by CMake and placed inside the build directory
 #include "ShaderLogisticRegression.hpp"
 #include "ShaderOpMult.hpp"
+#include "ShaderWorkgroupCount.hpp"
@@ -4,8 +4,12 @@
 #include "kompute/Core.hpp"
 
 #include "kompute/Image.hpp"
+#include "kompute/Profiler.hpp"
 #include "kompute/Sequence.hpp"
+#include "kompute/SequenceFragment.hpp"
 #include "logger/Logger.hpp"
+#include <map>
+#include <mutex>
 
 #define KP_DEFAULT_SESSION "DEFAULT"
 
@@ -17,6 +21,39 @@ namespace kp {
 class Manager
 {
   public:
+    /**
+     * Device memory of a heap, as reported by VK_EXT_memory_budget when
+     * available or estimated from the memory objects of the manager otherwise.
+     */
+    struct MemoryHeapStats
+    {
+        vk::DeviceSize size = 0;           ///< Size of the heap
+        vk::DeviceSize budget = 0;         ///< Bytes the process can allocate
+        vk::DeviceSize usage = 0;          ///< Bytes the process allocated
+        vk::DeviceSize allocatedBytes = 0; ///< Bytes of the memory objects
+        bool deviceLocal = false;          ///< Whether the heap is on device
+    };
+
+    /**
+     * Device memory of the memory objects of the manager of a memory type.
+     */
+    struct MemoryTypeStats
+    {
+        uint64_t count = 0;                ///< Memory objects of the type
+        vk::DeviceSize allocatedBytes = 0; ///< Bytes of device memory bound
+        vk::DeviceSize usedBytes = 0;      ///< Bytes of data of the objects
+    };
+
+    /**
+     * Device memory statistics of the manager, per heap and per memory type.
+     */
+    struct MemoryStats
+    {
+        bool budgetAvailable = false; ///< Heaps use VK_EXT_memory_budget
+        std::vector<MemoryHeapStats> heaps;
+        std::map<Memory::MemoryTypes, MemoryTypeStats> memoryTypes;
+    };
+
     /**
         Base constructor and default used which creates the base resources
        including choosing the device 0 by default.
@@ -63,10 +100,55 @@ class Manager
      * @param queueIndex The queue to use from the available queues
      * @param nrOfTimestamps The maximum number of timestamps to allocate.
      * If zero (default), disables latching of timestamps.
+     * @param numBuffers The number of command buffers the sequence submits in
+     * turn, which is the maximum number of its submissions in flight.
      * @returns Shared pointer with initialised sequence
      */
     std::shared_ptr<Sequence> sequence(uint32_t queueIndex = 0,
-                                       uint32_t totalTimestamps = 0);
+                                       uint32_t totalTimestamps = 0,
+                                       uint32_t numBuffers = 1);
+
+    /**
+     * Create a managed sequence fragment that will be destroyed by this
+     * manager if it hasn't been destroyed by its reference count going to
+     * zero. The operations recorded into the fragment can be executed by the
+     * sequences of queues of the same family with kp::OpExecuteFragment.
+     *
+     * @param queueIndex The queue whose family the fragment is recorded for
+     * @returns Shared pointer with initialised sequence fragment
+     */
+    std::shared_ptr<SequenceFragment> fragment(uint32_t queueIndex = 0);
+
+    /**
+     * Create a profiler for the operations of the sequences of this manager,
+     * which converts their timestamps with the timestamp period of the
+     * device. Sequences are profiled when created with a timestamp per
+     * operation plus one.
+     *
+     * @param maxEvents The number of most recent events kept by the profiler
+     * @returns Shared pointer with initialised profiler
+     */
+    std::shared_ptr<Profiler> profiler(
+      size_t maxEvents = KP_DEFAULT_PROFILER_MAX_EVENTS);
+
+    /**
+     * Submits the recorded operations of several sequences, grouping the
+     * sequences that use the same queue into a single queue submission with
+     * one fence, which avoids the overhead of submitting each sequence
+     * separately. The submissions are awaited with await, or individually
+     * with the evalAwait functions of the sequences.
+     *
+     * @param sequences The sequences to submit, in submission order
+     */
+    void submit(const std::vector<std::shared_ptr<Sequence>>& sequences);
+
+    /**
+     * Waits for the queue submissions made with submit to finish processing
+     * and then runs the postEval of all operations of their sequences.
+     *
+     * @param waitFor Number of milliseconds to wait before timing out.
+     */
+    void await(uint64_t waitFor = UINT64_MAX);
 
     /**
      * Create a managed tensor that will be destroyed by this manager
@@ -84,11 +166,20 @@ class Manager
         KP_LOG_DEBUG("Kompute Manager tensor creation triggered");
 
         std::shared_ptr<TensorT<T>> tensor{ new kp::TensorT<T>(
-          this->mPhysicalDevice, this->mDevice, data, tensorType) };
+          this->mPhysicalDevice,
+          this->mDevice,
+          data,
+          tensorType,
+          this->mMemoryPool,
+          this->mStagingPolicy,
+          this->mStagingRing) };
 
         if (this->mManageResources) {
             this->mManagedMemObjects.push_back(tensor);
         }
+        if (this->mResidency) {
+            this->mResidency->track(tensor);
+        }
 
         return tensor;
     }
@@ -109,11 +200,20 @@ class Manager
         KP_LOG_DEBUG("Kompute Manager tensor creation triggered");
 
         std::shared_ptr<TensorT<T>> tensor{ new kp::TensorT<T>(
-          this->mPhysicalDevice, this->mDevice, size, tensorType) };
+          this->mPhysicalDevice,
+          this->mDevice,
+          size,
+          tensorType,
+          this->mMemoryPool,
+          this->mStagingPolicy,
+          this->mStagingRing) };
 
         if (this->mManageResources) {
             this->mManagedMemObjects.push_back(tensor);
         }
+        if (this->mResidency) {
+            this->mResidency->track(tensor);
+        }
 
         return tensor;
     }
@@ -126,7 +226,7 @@ class Manager
 
     std::shared_ptr<Tensor> tensor(
       void* data,
-      uint32_t elementTotalCount,
+      uint64_t elementTotalCount,
       uint32_t elementMemorySize,
       const Memory::DataTypes& dataType,
       Memory::MemoryTypes tensorType = Memory::MemoryTypes::eDevice)
@@ -137,17 +237,23 @@ class Manager
                                                        elementTotalCount,
                                                        elementMemorySize,
                                                        dataType,
-                                                       tensorType) };
+                                                       tensorType,
+                                                       this->mMemoryPool,
+                                                       this->mStagingPolicy,
+                                                       this->mStagingRing) };
 
         if (this->mManageResources) {
             this->mManagedMemObjects.push_back(tensor);
         }
+        if (this->mResidency) {
+            this->mResidency->track(tensor);
+        }
 
         return tensor;
     }
 
     std::shared_ptr<Tensor> tensor(
-      uint32_t elementTotalCount,
+      uint64_t elementTotalCount,
       uint32_t elementMemorySize,
       const Memory::DataTypes& dataType,
       Memory::MemoryTypes tensorType = Memory::MemoryTypes::eDevice)
@@ -157,15 +263,42 @@ class Manager
                                                        elementTotalCount,
                                                        elementMemorySize,
                                                        dataType,
-                                                       tensorType) };
+                                                       tensorType,
+                                                       this->mMemoryPool,
+                                                       this->mStagingPolicy,
+                                                       this->mStagingRing) };
 
         if (this->mManageResources) {
             this->mManagedMemObjects.push_back(tensor);
         }
+        if (this->mResidency) {
+            this->mResidency->track(tensor);
+        }
 
         return tensor;
     }
 
+    /**
+     * Create a managed eHost tensor over host memory owned by the caller
+     * without copying it, by importing the memory through the
+     * VK_EXT_external_memory_host device extension. The memory has to outlive
+     * the tensor, and both the pointer and the size have to be multiples of
+     * the minImportedHostPointerAlignment limit of the device. If the
+     * extension is not enabled, the memory is not aligned or the driver fails
+     * to import it, a warning with the reason is logged and the data is
+     * copied into a regular eHost tensor instead, which can be checked with
+     * Tensor::isHostMemoryImported.
+     *
+     * @param data The host memory to create the tensor over
+     * @param bytes The size in bytes of the host memory
+     * @param dataType The data type of the elements of the tensor
+     * @returns Shared pointer with initialised tensor
+     */
+    std::shared_ptr<Tensor> tensorFromHostPointer(
+      void* data,
+      size_t bytes,
+      const Memory::DataTypes& dataType);
+
     /**
      * Create a managed image that will be destroyed by this manager
      * if it hasn't been destroyed by its reference count going to zero.
@@ -193,7 +326,9 @@ class Manager
           height,
           numChannels,
           tiling,
-          imageType) };
+          imageType,
+          this->mMemoryPool,
+          this->mStagingPolicy) };
 
         if (this->mManageResources) {
             this->mManagedMemObjects.push_back(image);
@@ -219,7 +354,9 @@ class Manager
           width,
           height,
           numChannels,
-          imageType) };
+          imageType,
+          this->mMemoryPool,
+          this->mStagingPolicy) };
 
         if (this->mManageResources) {
             this->mManagedMemObjects.push_back(image);
@@ -245,7 +382,9 @@ class Manager
           height,
           numChannels,
           tiling,
-          imageType) };
+          imageType,
+          this->mMemoryPool,
+          this->mStagingPolicy) };
 
         if (this->mManageResources) {
             this->mManagedMemObjects.push_back(image);
@@ -269,7 +408,9 @@ class Manager
           width,
           height,
           numChannels,
-          imageType) };
+          imageType,
+          this->mMemoryPool,
+          this->mStagingPolicy) };
 
         if (this->mManageResources) {
             this->mManagedMemObjects.push_back(image);
@@ -338,7 +479,9 @@ class Manager
                                                     numChannels,
                                                     dataType,
                                                     tiling,
-                                                    imageType) };
+                                                    imageType,
+                                                    this->mMemoryPool,
+                                                    this->mStagingPolicy) };
 
         if (this->mManageResources) {
             this->mManagedMemObjects.push_back(image);
@@ -364,7 +507,9 @@ class Manager
                                                     height,
                                                     numChannels,
                                                     dataType,
-                                                    imageType) };
+                                                    imageType,
+                                                    this->mMemoryPool,
+                                                    this->mStagingPolicy) };
 
         if (this->mManageResources) {
             this->mManagedMemObjects.push_back(image);
@@ -388,7 +533,9 @@ class Manager
                                                     numChannels,
                                                     dataType,
                                                     tiling,
-                                                    imageType) };
+                                                    imageType,
+                                                    this->mMemoryPool,
+                                                    this->mStagingPolicy) };
 
         if (this->mManageResources) {
             this->mManagedMemObjects.push_back(image);
@@ -410,7 +557,9 @@ class Manager
                                                     height,
                                                     numChannels,
                                                     dataType,
-                                                    imageType) };
+                                                    imageType,
+                                                    this->mMemoryPool,
+                                                    this->mStagingPolicy) };
 
         if (this->mManageResources) {
             this->mManagedMemObjects.push_back(image);
@@ -478,7 +627,14 @@ class Manager
           spirv,
           workgroup,
           specializationConstants,
-          pushConstants) };
+          pushConstants,
+          this->mPipelineCache,
+          this->mPipelineRegistry,
+          this->getDeviceProperties().limits.maxPushConstantsSize) };
+
+        // Dispatches larger than the limits of the device are split
+        algorithm->setMaxWorkgroupCount(
+          this->getDeviceProperties().limits.maxComputeWorkGroupCount);
 
         if (this->mManageResources) {
             this->mManagedAlgorithms.push_back(algorithm);
@@ -487,6 +643,157 @@ class Manager
         return algorithm;
     }
 
+    /**
+     * Enables sub-allocation of tensor and image memory from a manager-owned
+     * kp::MemoryPool. Memory objects created after this call are bound to
+     * aligned ranges of large device memory blocks instead of performing one
+     * device allocation each, and return their ranges to the pool when
+     * destroyed.
+     *
+     * @param blockSize The size in bytes of each device memory block
+     * @returns Shared pointer to the memory pool of the manager
+     **/
+    std::shared_ptr<MemoryPool> enableMemoryPool(
+      vk::DeviceSize blockSize = KP_DEFAULT_MEMORY_POOL_BLOCK_SIZE);
+
+    /**
+     * The memory pool used for new memory objects.
+     *
+     * @return Shared pointer to the memory pool, or nullptr if not enabled
+     **/
+    std::shared_ptr<MemoryPool> getMemoryPool() const;
+
+    /**
+     * Sets the staging policy of the tensors and images created after this
+     * call. Memory objects that are mostly read back with OpSyncLocal should
+     * use kp::Memory::StagingPolicy::eReadback so their staging memory is host
+     * cached.
+     *
+     * @param stagingPolicy The staging policy for new memory objects
+     **/
+    void setStagingPolicy(Memory::StagingPolicy stagingPolicy);
+
+    /**
+     * The staging policy used for new memory objects.
+     *
+     * @return The staging policy of the manager
+     **/
+    Memory::StagingPolicy getStagingPolicy() const;
+
+    /**
+     * Enables a manager-owned kp::StagingRing that eDevice tensors created
+     * after this call transfer their data through, instead of allocating a
+     * staging buffer as large as themselves. OpSyncDevice and OpSyncLocal
+     * stream the data of these tensors through the ring in chunks, and their
+     * host data is only allocated once it is accessed.
+     *
+     * @param size The size in bytes of the ring
+     * @param numChunks The number of chunks the ring is split into
+     * @returns Shared pointer to the staging ring of the manager
+     **/
+    std::shared_ptr<StagingRing> enableStagingRing(
+      vk::DeviceSize size = KP_DEFAULT_STAGING_RING_SIZE,
+      uint32_t numChunks = KP_DEFAULT_STAGING_RING_CHUNKS);
+
+    /**
+     * The staging ring used for new tensors.
+     *
+     * @return Shared pointer to the staging ring, or nullptr if not enabled
+     **/
+    std::shared_ptr<StagingRing> getStagingRing() const;
+
+    /**
+     * Enables a manager-owned kp::Residency policy that keeps the eDevice and
+     * eStorage tensors created after this call within a device memory budget.
+     * Sequences created after this call spill the least recently used tensors
+     * to host memory when they are submitted beyond the budget, and restore
+     * the spilled tensors they use before submitting.
+     *
+     * @param budget The size in bytes of device memory for the tensors
+     * @returns Shared pointer to the residency policy of the manager
+     **/
+    std::shared_ptr<Residency> enableResidency(vk::DeviceSize budget);
+
+    /**
+     * The residency policy used for new tensors and sequences.
+     *
+     * @return Shared pointer to the residency policy, or nullptr if not
+     * enabled
+     **/
+    std::shared_ptr<Residency> getResidency() const;
+
+    /**
+     * Enables a manager-owned kp::CompletionThread that completes the
+     * submissions made with kp::Sequence::evalAsyncFuture by the sequences
+     * created after this call, so the threads that submit them don't have to
+     * wait for them.
+     *
+     * @param pollInterval The maximum number of nanoseconds before the thread
+     * waits on the submissions made while it waits on earlier ones
+     * @returns Shared pointer to the completion thread of the manager
+     **/
+    std::shared_ptr<CompletionThread> enableCompletionThread(
+      uint64_t pollInterval = KP_DEFAULT_COMPLETION_POLL_INTERVAL);
+
+    /**
+     * The completion thread used by new sequences.
+     *
+     * @return Shared pointer to the completion thread, or nullptr if not
+     * enabled
+     **/
+    std::shared_ptr<CompletionThread> getCompletionThread() const;
+
+    /**
+     * Merges the pipeline cache data saved to a file by savePipelineCache
+     * into the pipeline cache shared by the algorithms of the manager, so the
+     * pipelines they create skip the compilation of their shaders. Data
+     * saved by a different device or driver, identified by the vendor,
+     * device and pipeline cache UUID of its header, is ignored.
+     *
+     * @param path The path of the file to load the pipeline cache from
+     * @return True if the data was loaded, or false if the file doesn't
+     * exist or its data doesn't match the device
+     **/
+    bool loadPipelineCache(const std::string& path);
+
+    /**
+     * Saves the data of the pipeline cache shared by the algorithms of the
+     * manager to a file, which is written to a temporary file first and then
+     * renamed, so processes loading it concurrently never read a partial
+     * file.
+     *
+     * @param path The path of the file to save the pipeline cache to
+     **/
+    void savePipelineCache(const std::string& path);
+
+    /**
+     * The pipeline cache shared by the algorithms created by the manager.
+     *
+     * @return Shared pointer to the pipeline cache of the manager
+     **/
+    std::shared_ptr<vk::PipelineCache> getPipelineCache() const;
+
+    /**
+     * The registry through which the algorithms created by the manager share
+     * their shader modules and pipelines, so algorithms with the same SPIR-V,
+     * specialization constants, descriptor types and push constant range
+     * only compile their pipeline once.
+     *
+     * @return Shared pointer to the pipeline registry of the manager
+     **/
+    std::shared_ptr<PipelineRegistry> getPipelineRegistry() const;
+
+    /**
+     * Reports the device memory used per heap and per memory type. Heaps
+     * report the budget and usage of the process from VK_EXT_memory_budget
+     * when the device supports it, and otherwise use the size of the heap as
+     * budget and the memory allocated by the memory objects of the manager as
+     * usage.
+     *
+     * @return The memory statistics of the manager
+     **/
+    MemoryStats memoryStats();
+
     /**
      * Destroy the GPU resources and all managed resources by manager.
      **/
@@ -529,12 +836,33 @@ class Manager
     bool mFreeDevice = false;
 
     // -------------- ALWAYS OWNED RESOURCES
+    std::shared_ptr<vk::PipelineCache> mPipelineCache = nullptr;
+    std::shared_ptr<PipelineRegistry> mPipelineRegistry = nullptr;
+    std::shared_ptr<MemoryPool> mMemoryPool = nullptr;
+    Memory::StagingPolicy mStagingPolicy = Memory::StagingPolicy::eUpload;
+    std::shared_ptr<StagingRing> mStagingRing = nullptr;
+    std::shared_ptr<Residency> mResidency = nullptr;
+    std::shared_ptr<CompletionThread> mCompletionThread = nullptr;
     std::vector<std::weak_ptr<Memory>> mManagedMemObjects;
     std::vector<std::weak_ptr<Sequence>> mManagedSequences;
+    std::vector<std::weak_ptr<SequenceFragment>> mManagedFragments;
     std::vector<std::weak_ptr<Algorithm>> mManagedAlgorithms;
 
+    struct SubmitBatch
+    {
+        std::shared_ptr<vk::Fence> fence;
+        std::vector<std::pair<std::weak_ptr<Sequence>, uint64_t>> tickets;
+    };
+
+    std::vector<SubmitBatch> mSubmitBatches;
+
+    std::vector<std::string> mEnabledExtensions;
     std::vector<uint32_t> mComputeQueueFamilyIndices;
     std::vector<std::shared_ptr<vk::Queue>> mComputeQueues;
+    // Submissions to a queue have to be externally synchronised, including
+    // the ones of the staging ring and residency policy and the ones made
+    // from the completion thread
+    std::vector<std::shared_ptr<std::mutex>> mComputeQueueMutexes;
 
     bool mManageResources = false;
 
@@ -548,6 +876,9 @@ class Manager
     void createDevice(const std::vector<uint32_t>& familyQueueIndices = {},
                       uint32_t hysicalDeviceIndex = 0,
                       const std::vector<std::string>& desiredExtensions = {});
+    void createPipelineCache();
+
+    bool isExtensionEnabled(const std::string& extensionName) const;
 };
 
 } // End namespace kp
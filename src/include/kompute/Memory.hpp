@@ -2,9 +2,12 @@
 #pragma once
 
 #include "kompute/Core.hpp"
+#include "kompute/MemoryPool.hpp"
 #include "logger/Logger.hpp"
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace kp {
 
@@ -22,7 +25,9 @@ class Memory
      * Type for memory created: Device allows memory to be transferred from
      * staging memory. Staging are host memory visible. Storage are device
      * visible but are not set up to transfer or receive data (only for shader
-     * storage).
+     * storage). Transient are storage whose device memory is only bound once
+     * a kp::Sequence has planned their lifetime, so transient memory objects
+     * that are not alive at the same time can share the same device memory.
      */
     enum class MemoryTypes
     {
@@ -31,6 +36,21 @@ class Memory
         eStorage = 2, ///< Type is Device memory (only)
         eDeviceAndHost =
           3, ///< Type is host-visible and host-coherent device memory
+        eTransient = 4, ///< Type is Device memory (only) aliased by sequence
+    };
+
+    /**
+     * Access pattern the host visible staging memory is optimised for. Upload
+     * staging uses write-combined memory, which is fast for the host to write
+     * but slow to read back. Readback staging prefers host cached memory, which
+     * is fast for the host to read after OpSyncLocal. If the preferred memory
+     * is not available on the device, the staging memory falls back to any
+     * host visible and host coherent memory.
+     */
+    enum class StagingPolicy
+    {
+        eUpload = 0,   ///< Write-combined memory for host to device transfers
+        eReadback = 1, ///< Host cached memory for device to host transfers
     };
 
     enum class DataTypes
@@ -55,13 +75,30 @@ class Memory
 
     static std::string toString(MemoryTypes dt);
     static std::string toString(DataTypes dt);
+    static std::string toString(StagingPolicy sp);
 
     Memory(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
            std::shared_ptr<vk::Device> device,
            const DataTypes& dataType,
            const MemoryTypes& memoryType,
            uint32_t x,
-           uint32_t y);
+           uint32_t y,
+           std::shared_ptr<MemoryPool> memoryPool = nullptr,
+           const StagingPolicy& stagingPolicy = StagingPolicy::eUpload);
+
+    /**
+     * Constructor of a one dimensional memory object, such as a tensor, whose
+     * number of elements may exceed the range of the image dimensions.
+     *
+     * @param size The total number of elements of the memory object
+     */
+    Memory(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+           std::shared_ptr<vk::Device> device,
+           const DataTypes& dataType,
+           const MemoryTypes& memoryType,
+           uint64_t size,
+           std::shared_ptr<MemoryPool> memoryPool = nullptr,
+           const StagingPolicy& stagingPolicy = StagingPolicy::eUpload);
 
     /**
      * Destructor which is in charge of freeing vulkan resources unless they
@@ -96,6 +133,51 @@ class Memory
      */
     DataTypes dataType();
 
+    /**
+     * Retrieve the staging policy used to select the staging memory
+     *
+     * @return Staging policy of the memory object
+     */
+    StagingPolicy stagingPolicy();
+
+    /**
+     * Retrieve the property flags of the memory type backing the host visible
+     * memory, which is the staging memory for eDevice memory objects and the
+     * primary memory for eHost and eDeviceAndHost memory objects.
+     *
+     * @return Property flags of the host visible memory, empty for eStorage
+     */
+    vk::MemoryPropertyFlags hostMemoryPropertyFlags();
+
+    /**
+     * Flushes the host writes to the host visible memory so they become
+     * visible to the device. Only the ranges written with setData since the
+     * last flush are flushed, unless the raw data pointer has been handed out
+     * with rawData or data, in which case the whole range is flushed. This is
+     * a no-op for host coherent memory.
+     */
+    void flushHostMemory();
+
+    /**
+     * Invalidates the range of the host visible memory holding the data of
+     * the memory object so the device writes become visible to the host. This
+     * is a no-op for host coherent memory.
+     */
+    void invalidateHostMemory();
+
+    /**
+     * Invalidates a range of the data of the memory object so the device
+     * writes to it become visible to the host. Host writes pending a flush
+     * outside of the range are flushed first, as invalidating the
+     * non-coherent atoms they share with the range would discard them,
+     * whereas the ones inside the range are superseded by the device writes.
+     * This is a no-op for host coherent memory.
+     *
+     * @param offset The offset in bytes into the data of the memory object
+     * @param size The size in bytes of the range written by the device
+     */
+    void invalidateHostMemory(uint64_t offset, uint64_t size);
+
     /**
      * Check whether memory object is initialized based on the created gpu
      * resources.
@@ -104,6 +186,68 @@ class Memory
      */
     virtual bool isInit() = 0;
 
+    /**
+     * Check whether the primary memory of the memory object has been bound,
+     * which is only false for eTransient memory objects whose memory has not
+     * been planned by a sequence yet.
+     *
+     * @returns Boolean stating whether the primary memory is bound
+     */
+    bool isMemoryBound();
+
+    /**
+     * Counter incremented whenever the buffer or image of the memory object is
+     * recreated, which invalidates the descriptors and the commands recorded
+     * with the previous one.
+     *
+     * @returns The generation of the GPU resources of the memory object
+     */
+    uint64_t generation();
+
+    /**
+     * Registers a submission in flight on a queue that uses the memory
+     * object, until it is released with releaseSubmission once it has
+     * completed or been cancelled. Sequences register their submissions so
+     * transfers that bypass them can detect the ones they are not ordered
+     * with.
+     *
+     * @param queue The queue the submission was submitted to
+     */
+    virtual void acquireSubmission(const vk::Queue& queue);
+
+    /**
+     * Releases a submission registered with acquireSubmission.
+     *
+     * @param queue The queue the submission was submitted to
+     */
+    virtual void releaseSubmission(const vk::Queue& queue);
+
+    /**
+     * Check whether a submission in flight on a queue other than the one
+     * provided uses the memory object.
+     *
+     * @param queue The queue whose submissions are ignored
+     * @returns Boolean stating whether another queue uses the memory object
+     */
+    virtual bool isUsedByOtherQueue(const vk::Queue& queue);
+
+    /**
+     * Check whether any submission in flight uses the memory object.
+     *
+     * @returns Boolean stating whether a submission uses the memory object
+     */
+    virtual bool isUsedBySubmission();
+
+    /**
+     * Device memory allocations owned by the memory object, which excludes
+     * the memory of views and of eTransient memory objects. Unpooled
+     * allocations have a null memory but still report their size and memory
+     * type index.
+     *
+     * @returns The allocations of the primary and staging memory
+     */
+    std::vector<MemoryPool::Allocation> ownedAllocations();
+
     /**
      * Records a copy from the internal staging memory to the device memory
      * using an optional barrier to wait for the operation. This function would
@@ -186,7 +330,7 @@ class Memory
      *
      * @return Unsigned integer representing the total number of elements
      */
-    uint32_t size();
+    uint64_t size();
 
     /**
      * Returns the total size of a single element of the respective data type
@@ -212,7 +356,15 @@ class Memory
      * @return Unsigned integer representing the total memory size of the data
      * contained by the image object.
      */
-    uint32_t memorySize();
+    uint64_t memorySize();
+
+    /**
+     * Offset in bytes of the data of the memory object in its buffers and
+     * memory, which is only non-zero for views over other memory objects.
+     *
+     * @return The offset in bytes of the data
+     */
+    virtual vk::DeviceSize memoryOffset() { return 0; }
 
     vk::DescriptorType getDescriptorType() { return mDescriptorType; }
 
@@ -225,6 +377,24 @@ class Memory
      */
     void* rawData();
 
+    /**
+     * Retrieve the pointer to the raw memory for reading only. Unlike
+     * rawData, the ranges written with setData are still tracked, so only
+     * they are flushed to the device.
+     *
+     * @return Pointer to raw memory containing raw bytes data of Tensor/Image.
+     */
+    const void* constRawData();
+
+    /**
+     * Check whether the writes to the host memory are tracked, so that only
+     * the ranges written with setData are flushed to the device. Tracking
+     * stops once a writable pointer to the data has been retrieved.
+     *
+     * @return Boolean stating whether host writes are tracked
+     */
+    bool isTrackingHostWrites();
+
     /**
      * Sets / resets the data of the tensor/image which is directly done on the
      * GPU host visible memory available by the tensor/image.
@@ -244,6 +414,37 @@ class Memory
         this->setData(data.data(), data.size() * sizeof(T));
     }
 
+    /**
+     * Sets a range of the data of the tensor/image, which is directly done on
+     * the GPU host visible memory. Only the range written is flushed to the
+     * device by the next flushHostMemory.
+     *
+     * @param data The data to copy into the memory object
+     * @param offset The offset in bytes into the data of the memory object
+     * @param size The size in bytes of the data to copy
+     */
+    void setData(const void* data, uint64_t offset, uint64_t size);
+
+    /**
+     * Sets a range of the elements of the tensor/image, which is directly done
+     * on the GPU host visible memory. Only the range written is flushed to the
+     * device by the next flushHostMemory.
+     *
+     * @param data The elements to copy into the memory object
+     * @param offset The index of the first element to set
+     */
+    template<typename T>
+    void setData(const std::vector<T>& data, uint64_t offset)
+    {
+        KP_LOG_DEBUG("Kompute Memory setting data with data size {} at "
+                     "offset {}",
+                     data.size() * sizeof(T),
+                     offset * sizeof(T));
+
+        this->setData(
+          data.data(), offset * sizeof(T), data.size() * sizeof(T));
+    }
+
     /**
      * Template to return the pointer data converted by specific type, which
      * would be any of the supported types including float, double, int32,
@@ -258,6 +459,9 @@ class Memory
             this->mapRawData();
         }
 
+        // Writes through the pointer can't be tracked
+        this->stopTrackingHostWrites();
+
         return (T*)this->mRawData;
     }
 
@@ -303,30 +507,62 @@ class Memory
     // -------------- ALWAYS OWNED RESOURCES
     MemoryTypes mMemoryType;
     DataTypes mDataType;
-    uint32_t mSize;
+    uint64_t mSize;
     uint32_t mDataTypeMemorySize;
     void* mRawData = nullptr;
+    std::vector<uint8_t> mHostData;
     vk::DescriptorType mDescriptorType;
     bool mUnmapMemory = false;
+    StagingPolicy mStagingPolicy;
     uint32_t mX;
     uint32_t mY;
 
+    // Byte ranges of the host data written since the last flush
+    struct HostRange
+    {
+        uint64_t begin;
+        uint64_t end;
+    };
+    std::vector<HostRange> mDirtyHostRanges;
+    bool mTrackHostWrites = true;
+    uint64_t mGeneration = 0;
+    // Queues of the submissions in flight that use the memory object, once
+    // per submission
+    std::vector<vk::Queue> mSubmissionQueues;
+    std::mutex mSubmissionQueuesMutex;
+
     // -------------- NEVER OWNED RESOURCES
     std::shared_ptr<vk::PhysicalDevice> mPhysicalDevice;
     std::shared_ptr<vk::Device> mDevice;
+    std::shared_ptr<MemoryPool> mMemoryPool;
 
     // -------------- OPTIONALLY OWNED RESOURCES
     std::shared_ptr<vk::DeviceMemory> mPrimaryMemory;
     bool mFreePrimaryMemory = false;
+    MemoryPool::Allocation mPrimaryAllocation;
+    vk::MemoryPropertyFlags mPrimaryMemoryPropertyFlags;
     std::shared_ptr<vk::DeviceMemory> mStagingMemory;
     bool mFreeStagingMemory = false;
+    MemoryPool::Allocation mStagingAllocation;
+    vk::MemoryPropertyFlags mStagingMemoryPropertyFlags;
 
     // Private util functions
     void mapRawData();
     void unmapRawData();
     void updateRawData(void* data);
-    vk::MemoryPropertyFlags getPrimaryMemoryPropertyFlags();
-    vk::MemoryPropertyFlags getStagingMemoryPropertyFlags();
+    std::vector<vk::MemoryPropertyFlags> getPrimaryMemoryPropertyFlags();
+    std::vector<vk::MemoryPropertyFlags> getStagingMemoryPropertyFlags();
+    uint32_t findMemoryTypeIndex(
+      uint32_t memoryTypeBits,
+      const std::vector<vk::MemoryPropertyFlags>& memoryPropertyFlags);
+    bool hostMemoryRange(vk::MappedMemoryRange& mappedRange,
+                         vk::DeviceSize offset,
+                         vk::DeviceSize size);
+    virtual void markHostRangeDirty(uint64_t offset, uint64_t size);
+    virtual void stopTrackingHostWrites();
+    virtual void flushHostWritesOutside(uint64_t offset, uint64_t size);
+    void freeMemory(std::shared_ptr<vk::DeviceMemory>& memory,
+                    MemoryPool::Allocation& allocation);
 
     virtual void recordCopyFrom(const vk::CommandBuffer& commandBuffer,
                                 std::shared_ptr<Tensor> copyFromMemory) = 0;
@@ -0,0 +1,176 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "kompute/Core.hpp"
+#include "logger/Logger.hpp"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#define KP_DEFAULT_MEMORY_POOL_BLOCK_SIZE (64 * 1024 * 1024)
+
+namespace kp {
+
+/**
+ * Block allocator that sub-allocates tensor and image memory from large
+ * vk::DeviceMemory blocks.
+ *
+ * Requests are rounded up to power-of-two size classes and served from a free
+ * list of previously released ranges of the same class, or carved from the
+ * current block of the requested memory type. Requests larger than a size
+ * class can hold receive a dedicated allocation. Host visible blocks are
+ * mapped once when they are created, and stay mapped until the pool is
+ * destroyed.
+ */
+class MemoryPool
+{
+  public:
+    /**
+     * Device memory block owned by the pool. Defined in the translation unit.
+     */
+    struct Block;
+
+    /**
+     * Range of device memory handed out by the pool.
+     */
+    struct Allocation
+    {
+        std::shared_ptr<vk::DeviceMemory> memory = nullptr;
+        vk::DeviceSize offset = 0;
+        vk::DeviceSize size = 0;
+        uint32_t memoryTypeIndex = 0;
+        // Host pointer to the start of the range, null if not host visible
+        void* mappedData = nullptr;
+        // Size class index, or -1 if the range is a dedicated allocation
+        int32_t sizeClass = -1;
+        bool linear = true;
+        Block* block = nullptr;
+    };
+
+    /**
+     * Counters describing the current state of the pool.
+     */
+    struct Stats
+    {
+        uint64_t blockCount = 0;
+        uint64_t blockBytes = 0;
+        uint64_t dedicatedCount = 0;
+        uint64_t dedicatedBytes = 0;
+        uint64_t allocationCount = 0;
+        uint64_t allocatedBytes = 0;
+        uint64_t totalAllocations = 0;
+        uint64_t totalFrees = 0;
+        uint64_t reusedAllocations = 0;
+        uint64_t deviceAllocateCalls = 0;
+    };
+
+    /**
+     * Constructor for the pool, which does not allocate any device memory
+     * until the first allocation is requested.
+     *
+     * @param physicalDevice The physical device to fetch memory properties from
+     * @param device The device to allocate the memory blocks from
+     * @param blockSize The size in bytes of each device memory block
+     */
+    MemoryPool(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+               std::shared_ptr<vk::Device> device,
+               vk::DeviceSize blockSize = KP_DEFAULT_MEMORY_POOL_BLOCK_SIZE);
+
+    /**
+     * Destructor which frees all the memory blocks owned by the pool.
+     */
+    ~MemoryPool();
+
+    /**
+     * Allocates a range that satisfies the memory requirements provided.
+     *
+     * @param memoryRequirements Size and alignment of the range
+     * @param memoryTypeIndex Memory type index to allocate the range from
+     * @param linear Whether the range will be bound to a buffer or a linear
+     * image, as opposed to an optimal tiled image. Linear and non-linear
+     * resources never share a block so bufferImageGranularity is respected.
+     * @return The allocation describing the range
+     */
+    Allocation allocate(const vk::MemoryRequirements& memoryRequirements,
+                        uint32_t memoryTypeIndex,
+                        bool linear = true);
+
+    /**
+     * Returns the range to the pool so it can be handed out again. The
+     * underlying device memory is not freed.
+     *
+     * @param allocation The allocation previously returned by allocate()
+     */
+    void free(const Allocation& allocation);
+
+    /**
+     * Frees the device memory of all blocks that have no live allocations.
+     */
+    void trim();
+
+    /**
+     * Retrieves the statistics of the pool.
+     *
+     * @return Snapshot of the pool counters
+     */
+    Stats stats();
+
+    /**
+     * Size in bytes of each of the device memory blocks.
+     *
+     * @return The block size of the pool
+     */
+    vk::DeviceSize blockSize() const;
+
+    /**
+     * Check whether the pool is initialized based on the device referenced.
+     *
+     * @return Boolean stating whether the pool is initialized
+     */
+    bool isInit() const;
+
+    /**
+     * Frees all the device memory held by the pool, including the ranges that
+     * are still allocated.
+     */
+    void destroy();
+
+  private:
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<vk::PhysicalDevice> mPhysicalDevice;
+    std::shared_ptr<vk::Device> mDevice;
+
+    // -------------- ALWAYS OWNED RESOURCES
+    struct Chunk
+    {
+        Block* block;
+        vk::DeviceSize offset;
+    };
+    struct Bucket
+    {
+        std::vector<std::unique_ptr<Block>> blocks;
+        std::vector<std::vector<Chunk>> freeChunks;
+    };
+
+    vk::DeviceSize mBlockSize;
+    vk::PhysicalDeviceMemoryProperties mMemoryProperties;
+    vk::DeviceSize mNonCoherentAtomSize = 1;
+    std::map<std::pair<uint32_t, bool>, Bucket> mBuckets;
+    Stats mStats;
+    std::mutex mMutex;
+
+    static constexpr vk::DeviceSize MIN_CLASS_SIZE = 256;
+
+    int32_t sizeClass(vk::DeviceSize size) const;
+    vk::DeviceSize classSize(int32_t sizeClass) const;
+    bool isHostVisible(uint32_t memoryTypeIndex) const;
+    std::shared_ptr<vk::DeviceMemory> allocateDeviceMemory(
+      vk::DeviceSize size,
+      uint32_t memoryTypeIndex,
+      void** mappedData);
+    void freeDeviceMemory(std::shared_ptr<vk::DeviceMemory> memory,
+                          void* mappedData);
+};
+
+} // End namespace kp
@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "kompute/Core.hpp"
+#include "kompute/Tensor.hpp"
+#include "logger/Logger.hpp"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace kp {
+
+/**
+ * Parameters of the shaders of a sequence that can change between evals
+ * without recording the sequence again, unlike push constants which are
+ * recorded into its command buffers.
+ *
+ * The parameters live in a tensor bound to the algorithms as any other
+ * buffer. The block holds a host visible ring with a slot per command buffer
+ * of the sequence that created it. kp::OpSyncParameters writes the current
+ * parameters into the slot of the command buffer being submitted, which is
+ * never in flight, and the command buffer copies its slot into the tensor
+ * when it executes. Setting new parameters is therefore a memcpy, and the
+ * submissions in flight keep the values they were submitted with.
+ */
+class ParameterBlock
+{
+  public:
+    /**
+     * Constructor which allocates the host visible ring of the block, with a
+     * slot of the size of the tensor for each command buffer provided. The
+     * parameters start with the host data of the tensor.
+     *
+     * @param physicalDevice The physical device to fetch memory properties from
+     * @param device The device to allocate the ring from
+     * @param tensor The tensor the parameters are copied into
+     * @param commandBuffers The command buffers the block is recorded into,
+     * each copying from its own slot
+     */
+    ParameterBlock(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                   std::shared_ptr<vk::Device> device,
+                   std::shared_ptr<Tensor> tensor,
+                   const std::vector<vk::CommandBuffer>& commandBuffers);
+
+    /**
+     * Destructor which frees the vulkan resources of the block.
+     */
+    ~ParameterBlock();
+
+    /**
+     * Sets the parameters used by the following submissions of the sequence,
+     * starting at the offset provided.
+     *
+     * @param data The host data to copy the parameters from
+     * @param size The size in bytes of the data
+     * @param offset The offset in bytes into the parameters
+     */
+    void setData(const void* data, uint64_t size, uint64_t offset = 0);
+
+    /**
+     * Sets the parameters used by the following submissions of the sequence.
+     *
+     * @param data The vector of parameters, which can't be larger than the
+     * tensor
+     */
+    template<typename T>
+    void setData(const std::vector<T>& data)
+    {
+        this->setData(data.data(), data.size() * sizeof(T));
+    }
+
+    /**
+     * Records the copy of the slot of the command buffer into the tensor.
+     *
+     * @param commandBuffer The command buffer to record the copy into, which
+     * has to be one of the command buffers of the block
+     */
+    void recordCopy(const vk::CommandBuffer& commandBuffer);
+
+    /**
+     * Writes the current parameters into the slot of the command buffer about
+     * to be submitted.
+     *
+     * @param commandBuffer The command buffer about to be submitted
+     */
+    void writeSlot(const vk::CommandBuffer& commandBuffer);
+
+    /**
+     * Gets the tensor the parameters are copied into.
+     *
+     * @return The tensor of the block
+     */
+    std::shared_ptr<Tensor> getTensor() const;
+
+    /**
+     * Size in bytes of the parameters, which is the size of the tensor when
+     * the block was created.
+     *
+     * @return The size of the parameters
+     */
+    uint64_t size() const;
+
+    /**
+     * Check whether the block is initialized based on the device referenced.
+     *
+     * @return Boolean stating whether the block is initialized
+     */
+    bool isInit() const;
+
+    /**
+     * Destroys the vulkan resources of the block.
+     */
+    void destroy();
+
+  private:
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<vk::PhysicalDevice> mPhysicalDevice;
+    std::shared_ptr<vk::Device> mDevice;
+    std::shared_ptr<Tensor> mTensor;
+
+    // -------------- ALWAYS OWNED RESOURCES
+    std::shared_ptr<vk::Buffer> mBuffer;
+    std::shared_ptr<vk::DeviceMemory> mMemory;
+    std::vector<vk::CommandBuffer> mCommandBuffers;
+    std::vector<uint8_t> mData;
+    uint8_t* mMappedData = nullptr;
+    uint64_t mSize;
+    std::mutex mMutex;
+
+    void createBuffer();
+    uint32_t getSlot(const vk::CommandBuffer& commandBuffer) const;
+};
+
+} // End namespace kp
@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "kompute/Core.hpp"
+#include "logger/Logger.hpp"
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace kp {
+
+/**
+ * Content addressed cache of the shader modules and pipelines of the
+ * algorithms of a manager.
+ *
+ * Shader modules are keyed by the hash of their SPIR-V, and pipelines by
+ * their shader module, specialization constants, descriptor types and push
+ * constant range, so algorithms that only differ by the memory objects they
+ * bind share the same pipeline. The registry hands out shared pointers, and
+ * destroys a shader module or pipeline as soon as the last algorithm using
+ * it releases it.
+ */
+class PipelineRegistry : public std::enable_shared_from_this<PipelineRegistry>
+{
+  public:
+    /**
+     * Description of a pipeline, besides its shader module.
+     */
+    struct PipelineKey
+    {
+        std::vector<vk::DescriptorType> descriptorTypes;
+        std::vector<uint8_t> specializationConstants;
+        uint32_t specializationConstantSize = 0;
+        uint32_t pushConstantsSize = 0;
+
+        bool operator==(const PipelineKey& other) const;
+    };
+
+    /**
+     * Pipeline shared by the algorithms with the same key, which keeps the
+     * shader module it was created with.
+     */
+    struct Pipeline
+    {
+        std::shared_ptr<vk::ShaderModule> shaderModule = nullptr;
+        std::shared_ptr<vk::PipelineLayout> pipelineLayout = nullptr;
+        std::shared_ptr<vk::Pipeline> pipeline = nullptr;
+    };
+
+    /**
+     * Counters describing the current state of the registry.
+     */
+    struct Stats
+    {
+        uint64_t shaderModuleCount = 0;
+        uint64_t pipelineCount = 0;
+        uint64_t shaderModulesCreated = 0;
+        uint64_t pipelinesCreated = 0;
+        uint64_t shaderModuleHits = 0;
+        uint64_t pipelineHits = 0;
+    };
+
+    /**
+     * Constructor for the registry, which creates the shader modules and
+     * pipelines as they are requested.
+     *
+     * @param device The device to create the shader modules and pipelines
+     * with
+     */
+    PipelineRegistry(std::shared_ptr<vk::Device> device);
+
+    /**
+     * Destructor which destroys the shader modules and pipelines that are
+     * still in use.
+     */
+    ~PipelineRegistry();
+
+    /**
+     * Returns the shader module created from the SPIR-V provided, creating
+     * it if no live shader module has the same SPIR-V.
+     *
+     * @param spirv The SPIR-V of the shader module
+     * @return Shared pointer to the shader module
+     */
+    std::shared_ptr<vk::ShaderModule> shaderModule(
+      const std::vector<uint32_t>& spirv);
+
+    /**
+     * Returns the pipeline of a shader module with the key provided, calling
+     * create to create its pipeline layout and pipeline if no live pipeline
+     * has the same shader module and key.
+     *
+     * @param shaderModule The shader module returned by the registry
+     * @param key The description of the pipeline
+     * @param create Function that creates the pipeline layout and pipeline
+     * @return Shared pointer to the pipeline
+     */
+    std::shared_ptr<Pipeline> pipeline(
+      std::shared_ptr<vk::ShaderModule> shaderModule,
+      const PipelineKey& key,
+      const std::function<Pipeline()>& create);
+
+    /**
+     * Retrieves the statistics of the registry.
+     *
+     * @return Snapshot of the registry counters
+     */
+    Stats stats();
+
+    /**
+     * Check whether the registry is initialized based on the device
+     * referenced.
+     *
+     * @return Boolean stating whether the registry is initialized
+     */
+    bool isInit() const;
+
+    /**
+     * Destroys the shader modules and pipelines that are still in use, which
+     * must not be used by any algorithm afterwards.
+     */
+    void destroy();
+
+  private:
+    struct SpirvHash
+    {
+        size_t operator()(const std::vector<uint32_t>& spirv) const;
+    };
+
+    struct Key
+    {
+        vk::ShaderModule shaderModule;
+        PipelineKey pipeline;
+
+        bool operator==(const Key& other) const;
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const;
+    };
+
+    void releaseShaderModule(const std::vector<uint32_t>& spirv,
+                             vk::ShaderModule shaderModule);
+    void releasePipeline(const Key& key, const Pipeline& pipeline);
+
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<vk::Device> mDevice;
+
+    // -------------- ALWAYS OWNED RESOURCES
+    std::unordered_map<std::vector<uint32_t>,
+                       std::weak_ptr<vk::ShaderModule>,
+                       SpirvHash>
+      mShaderModules;
+    std::unordered_map<Key, std::weak_ptr<Pipeline>, KeyHash> mPipelines;
+    Stats mStats;
+    std::mutex mMutex;
+};
+
+} // End namespace kp
@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "kompute/Core.hpp"
+#include "kompute/Sequence.hpp"
+#include "logger/Logger.hpp"
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define KP_DEFAULT_PROFILER_MAX_EVENTS 100000
+
+namespace kp {
+
+/**
+ * Profiler of the GPU time of the operations of sequences, built on the
+ * timestamps the sequences latch after each operation. Sequences have to be
+ * created with at least one timestamp per operation plus one.
+ *
+ * After each eval, collect reads the timestamps of the sequence without
+ * waiting for them, converts them to nanoseconds, and records an event per
+ * operation labelled with its name, such as the name of the algorithm of a
+ * dispatch. The profiler keeps the most recent events, from which it reports
+ * the duration statistics per label and exports a trace.
+ */
+class Profiler
+{
+  public:
+    /**
+     * Duration statistics of the events with the same label.
+     */
+    struct OperationStats
+    {
+        std::string label;   ///< Name of the operations
+        uint64_t count = 0;  ///< Number of events with the label
+        double minNs = 0;    ///< Shortest duration in nanoseconds
+        double meanNs = 0;   ///< Mean duration in nanoseconds
+        double p99Ns = 0;    ///< 99th percentile duration in nanoseconds
+        double totalNs = 0;  ///< Sum of the durations in nanoseconds
+    };
+
+    /**
+     * GPU execution of an operation recorded by the profiler.
+     */
+    struct Event
+    {
+        std::string label;   ///< Name of the operation
+        uint32_t track;      ///< Identifier of the sequence of the operation
+        uint32_t index;      ///< Index of the operation in its sequence
+        double startNs;      ///< Device time the operation started at
+        double durationNs;   ///< Duration of the operation in nanoseconds
+    };
+
+    /**
+     * Constructor for the profiler.
+     *
+     * @param timestampPeriod The number of nanoseconds per timestamp tick of
+     * the device, from its limits
+     * @param maxEvents The number of most recent events kept by the profiler
+     */
+    Profiler(float timestampPeriod,
+             size_t maxEvents = KP_DEFAULT_PROFILER_MAX_EVENTS);
+
+    /**
+     * Records the events of the last submission of a sequence, unless its
+     * timestamps are not available yet or have already been collected. This
+     * doesn't wait for the submission, so it can be called again later.
+     *
+     * @param sequence The sequence to collect the timestamps of
+     * @return True if new events were recorded
+     */
+    bool collect(std::shared_ptr<Sequence> sequence);
+
+    /**
+     * Returns the duration statistics of the events kept, per label, sorted
+     * by total duration from the longest.
+     *
+     * @return The statistics per label
+     */
+    std::vector<OperationStats> stats();
+
+    /**
+     * Returns the events kept by the profiler, from the oldest.
+     *
+     * @return The events of the profiler
+     */
+    std::vector<Event> events();
+
+    /**
+     * Exports the events kept in the Chrome trace event format, which can be
+     * opened with Perfetto or chrome://tracing. Each sequence is shown as a
+     * separate thread.
+     *
+     * @return The trace as a JSON string
+     */
+    std::string traceJson();
+
+    /**
+     * Discards the events kept by the profiler.
+     */
+    void clear();
+
+  private:
+    struct Track
+    {
+        uint32_t id;
+        uint64_t collectedTicket;
+    };
+
+    float mTimestampPeriod;
+    size_t mMaxEvents;
+    std::deque<Event> mEvents;
+    std::map<std::weak_ptr<Sequence>,
+             Track,
+             std::owner_less<std::weak_ptr<Sequence>>>
+      mTracks;
+    uint32_t mNextTrack = 0;
+    std::mutex mMutex;
+};
+
+} // End namespace kp
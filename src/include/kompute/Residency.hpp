@@ -0,0 +1,167 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "kompute/Core.hpp"
+#include "kompute/Tensor.hpp"
+#include "logger/Logger.hpp"
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace kp {
+
+/**
+ * Residency policy that keeps the device memory used by the eDevice and
+ * eStorage tensors it tracks within a budget, by spilling the least recently
+ * used tensors to host memory and restoring them the next time a sequence
+ * uses them.
+ *
+ * Sequences acquire the tensors of their operations before each submission,
+ * which restores the spilled ones and pins them until the submission has
+ * finished, and then spill unpinned tensors in least recently used order
+ * until the resident tensors fit in the budget. Restored tensors have a new
+ * buffer, so algorithms refresh their descriptors and sequences re-record
+ * their commands before using them. Tensors that have views are never
+ * spilled, as the views would keep referring to the evicted buffer.
+ */
+class Residency
+{
+  public:
+    /**
+     * Counters describing the current state of the residency policy.
+     */
+    struct Stats
+    {
+        uint64_t trackedCount = 0;
+        uint64_t residentCount = 0;
+        vk::DeviceSize residentBytes = 0;
+        vk::DeviceSize spilledBytes = 0;
+        uint64_t totalEvictions = 0;
+        uint64_t totalRestores = 0;
+    };
+
+    /**
+     * Constructor which creates the command buffer used to copy tensors to
+     * and from host memory.
+     *
+     * @param physicalDevice The physical device to fetch memory properties from
+     * @param device The device to allocate the host memory from
+     * @param queue The queue to submit the copies to
+     * @param queueFamilyIndex The family index of the queue
+     * @param budget The size in bytes the resident tensors are kept within
+     * @param queueMutex Optional mutex held while submitting to the queue,
+     * shared by everything that submits to it
+     */
+    Residency(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+              std::shared_ptr<vk::Device> device,
+              std::shared_ptr<vk::Queue> queue,
+              uint32_t queueFamilyIndex,
+              vk::DeviceSize budget,
+              std::shared_ptr<std::mutex> queueMutex = nullptr);
+
+    /**
+     * Destructor which frees the host memory of the spilled tensors.
+     */
+    ~Residency();
+
+    /**
+     * Tracks a tensor so it can be spilled when the budget is exceeded. Only
+     * eDevice and eStorage tensors are tracked, other tensors are ignored.
+     *
+     * @param tensor The tensor to track
+     */
+    void track(std::shared_ptr<Tensor> tensor);
+
+    /**
+     * Restores the tracked tensors of the memory objects provided that have
+     * been spilled, and marks them as used.
+     *
+     * @param memObjects The memory objects about to be used
+     */
+    void restore(const std::vector<std::shared_ptr<Memory>>& memObjects);
+
+    /**
+     * Restores and pins the tracked tensors of the memory objects provided,
+     * and spills the least recently used unpinned tensors until the resident
+     * tensors fit in the budget.
+     *
+     * @param memObjects The memory objects of a submission
+     */
+    void acquire(const std::vector<std::shared_ptr<Memory>>& memObjects);
+
+    /**
+     * Unpins the tensors pinned by acquire once the submission using them
+     * has finished.
+     *
+     * @param memObjects The memory objects of the finished submission
+     */
+    void release(const std::vector<std::shared_ptr<Memory>>& memObjects);
+
+    /**
+     * Size in bytes the resident tensors are kept within.
+     *
+     * @return The budget of the residency policy
+     */
+    vk::DeviceSize budget() const;
+
+    /**
+     * Retrieves the current counters of the residency policy.
+     *
+     * @return The residency statistics
+     */
+    Stats stats();
+
+    /**
+     * Check whether the residency policy is initialized based on the device
+     * referenced.
+     *
+     * @return Boolean stating whether the residency policy is initialized
+     */
+    bool isInit() const;
+
+    /**
+     * Destroys the vulkan resources of the residency policy, including the
+     * host memory of the spilled tensors, which loses their contents.
+     */
+    void destroy();
+
+  private:
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<vk::PhysicalDevice> mPhysicalDevice;
+    std::shared_ptr<vk::Device> mDevice;
+    std::shared_ptr<vk::Queue> mQueue;
+    std::shared_ptr<std::mutex> mQueueMutex;
+
+    // -------------- ALWAYS OWNED RESOURCES
+    struct Entry
+    {
+        std::weak_ptr<Tensor> tensor;
+        uint64_t lastUse = 0;
+        uint32_t pins = 0;
+        std::shared_ptr<vk::Buffer> spillBuffer;
+        std::shared_ptr<vk::DeviceMemory> spillMemory;
+    };
+
+    std::shared_ptr<vk::CommandPool> mCommandPool;
+    vk::CommandBuffer mCommandBuffer;
+    vk::Fence mFence;
+    std::unordered_map<Tensor*, Entry> mEntries;
+    vk::DeviceSize mBudget;
+    uint64_t mTick = 0;
+    uint64_t mTotalEvictions = 0;
+    uint64_t mTotalRestores = 0;
+    std::mutex mMutex;
+
+    Entry* findEntry(const std::shared_ptr<Memory>& memory);
+    void restoreEntry(Entry& entry, const std::shared_ptr<Tensor>& tensor);
+    void evictEntry(Entry& entry, const std::shared_ptr<Tensor>& tensor);
+    void enforceBudget();
+    void createSpillBuffer(Entry& entry, vk::DeviceSize size);
+    void freeSpillBuffer(Entry& entry);
+    void copyBuffer(const vk::Buffer& srcBuffer,
+                    const vk::Buffer& dstBuffer,
+                    vk::DeviceSize size);
+};
+
+} // End namespace kp
@@ -1,10 +1,18 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
 
+#include "kompute/CompletionThread.hpp"
 #include "kompute/Core.hpp"
+#include "kompute/HazardTracker.hpp"
+#include "kompute/Residency.hpp"
 
 #include "kompute/operations/OpAlgoDispatch.hpp"
+#include "kompute/operations/OpExecuteFragment.hpp"
 #include "kompute/operations/OpBase.hpp"
+#include "kompute/operations/OpSyncParameters.hpp"
+
+#define KP_DEFAULT_SPIN_DURATION 200000
+#define KP_DEFAULT_OVER_DISPATCH_FACTOR 4.0
 
 namespace kp {
 
@@ -14,6 +22,47 @@ namespace kp {
 class Sequence : public std::enable_shared_from_this<Sequence>
 {
   public:
+    /**
+     * Statistics of the device memory the sequence has bound to the eTransient
+     * tensors recorded into it.
+     */
+    struct TransientMemoryStats
+    {
+        uint64_t tensorCount = 0;    ///< Transient tensors bound by sequence
+        uint64_t requestedBytes = 0; ///< Bytes required without aliasing
+        uint64_t allocatedBytes = 0; ///< Bytes allocated for the tensors
+        uint64_t savedBytes = 0;     ///< Bytes saved by aliasing the tensors
+    };
+
+    /**
+     * Statistics of the barriers the sequence has recorded for the tensor
+     * accesses declared by its operations.
+     */
+    using BarrierStats = HazardTracker::Stats;
+
+    /**
+     * Compute shader invocations of a dispatch counted by the pipeline
+     * statistics queries of the sequence, next to the size of the memory
+     * objects bound to its algorithm.
+     */
+    struct DispatchStatistics
+    {
+        uint64_t operationIndex = 0; ///< Index of the dispatch operation
+        uint64_t invocations = 0;    ///< Compute shader invocations counted
+        uint64_t boundElements = 0;  ///< Elements of the largest memory bound
+    };
+
+    /**
+     * Strategies used by evalAwait and evalAwaitTicket to wait for the
+     * submissions of the sequence.
+     */
+    enum class WaitStrategy
+    {
+        eBlock,  ///< Sleeps in the driver until the submission finishes
+        eSpin,   ///< Polls the status of the submission until it finishes
+        eHybrid, ///< Polls for an adaptive duration, and then sleeps
+    };
+
     /**
      * Main constructor for sequence which requires core vulkan components to
      * generate all dependent resources.
@@ -23,12 +72,26 @@ class Sequence : public std::enable_shared_from_this<Sequence>
      * @param computeQueue Vulkan compute queue
      * @param queueIndex Vulkan compute queue index in device
      * @param totalTimestamps Maximum number of timestamps to allocate
+     * @param numBuffers Number of command buffers and fences the recorded
+     * operations are submitted with in turn, which allows resubmitting the
+     * sequence while earlier submissions are still executing. Timestamps are
+     * only supported with a single buffer.
+     * @param residency Optional residency policy that restores the spilled
+     * tensors of the sequence before it is submitted
+     * @param completionThread Optional completion thread that completes the
+     * submissions made with evalAsyncFuture
+     * @param queueMutex Optional mutex held while submitting to the queue,
+     * shared by everything that submits to it
      */
     Sequence(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
              std::shared_ptr<vk::Device> device,
              std::shared_ptr<vk::Queue> computeQueue,
              uint32_t queueIndex,
-             uint32_t totalTimestamps = 0);
+             uint32_t totalTimestamps = 0,
+             uint32_t numBuffers = 1,
+             std::shared_ptr<Residency> residency = nullptr,
+             std::shared_ptr<CompletionThread> completionThread = nullptr,
+             std::shared_ptr<std::mutex> queueMutex = nullptr);
     /**
      * Destructor for sequence which is responsible for cleaning all subsequent
      * owned operations.
@@ -41,12 +104,68 @@ class Sequence : public std::enable_shared_from_this<Sequence>
      * function also requires the Sequence to be recording, otherwise it will
      * not be able to add the operation.
      *
+     * Once an operation uses an eTransient tensor without bound memory, this
+     * and the following operations are only recorded into the command buffer
+     * when the recording ends. At that point the sequence computes the range
+     * of operations each transient tensor is used in, binds transient tensors
+     * whose ranges don't overlap to the same device memory, and records a
+     * barrier before the first operation of a tensor that reuses the memory of
+     * another one. The memory is owned by the sequence, so the transient
+     * tensors can't be used once the sequence is destroyed, and their contents
+     * are only defined within the range of operations they are used in.
+     *
      * @param op Object derived from kp::BaseOp that will be recoreded by the
      * sequence which will be used when the operation is evaluated.
      * @return shared_ptr<Sequence> of the Sequence class itself
      */
     std::shared_ptr<Sequence> record(std::shared_ptr<OpBase> op);
 
+    /**
+     * Records the execution of a fragment, whose operations were recorded
+     * once into a secondary command buffer, as a kp::OpExecuteFragment
+     * operation. The fragment has to be recorded for the queue family of the
+     * sequence.
+     *
+     * @param fragment The fragment to execute
+     * @return shared_ptr<Sequence> of the Sequence class itself
+     */
+    std::shared_ptr<Sequence> record(
+      std::shared_ptr<SequenceFragment> fragment);
+
+    /**
+     * Records the copy of the parameters of a parameter block into its
+     * tensor as a kp::OpSyncParameters operation, which uses the parameters
+     * set on the block before each eval.
+     *
+     * @param parameterBlock The parameter block created by this sequence
+     * @return shared_ptr<Sequence> of the Sequence class itself
+     */
+    std::shared_ptr<Sequence> record(
+      std::shared_ptr<ParameterBlock> parameterBlock);
+
+    /**
+     * Records the operations provided from several host threads at once.
+     * The operations are split in contiguous ranges of similar size, and each
+     * thread records a range into its own kp::SequenceFragment, which has its
+     * own command pool and secondary command buffer. The fragments are then
+     * recorded into the sequence in the order of the ranges, so the result
+     * is the same regardless of how the threads are scheduled.
+     *
+     * The record function of the operations has to be safe to call from
+     * several threads for different operations. This is the case for the
+     * operations provided by Kompute except kp::OpResize, which can't be
+     * recorded in parallel. Dispatches without push constants use the push
+     * constants of their algorithm, which may have been set by a dispatch
+     * recorded in another range.
+     *
+     * @param ops The operations to record, in order
+     * @param numThreads The number of threads to record the operations with
+     * @return shared_ptr<Sequence> of the Sequence class itself
+     */
+    std::shared_ptr<Sequence> recordParallel(
+      const std::vector<std::shared_ptr<OpBase>>& ops,
+      uint32_t numThreads);
+
     /**
      * Record function for operation to be added to the GPU queue in batch. This
      * template requires classes to be derived from the OpBase class. This
@@ -197,15 +316,200 @@ class Sequence : public std::enable_shared_from_this<Sequence>
         return this->evalAsync(op);
     }
 
+    /**
+     * Eval Async Future submits the recorded operations like evalAsync, and
+     * hands the submission to the completion thread of the sequence instead
+     * of requiring evalAwait. The completion thread runs the postEval of the
+     * operations once the submission finishes, and then the callback. The
+     * sequence must not be submitted, awaited or modified from other threads
+     * until the returned future is ready.
+     *
+     * @param callback Optional callback run on the completion thread once the
+     * submission has completed
+     * @return Future that becomes ready once the submission has completed and
+     * the callback has run, or holds the exception thrown by either
+     */
+    std::future<void> evalAsyncFuture(
+      CompletionThread::Callback callback = nullptr);
+
     /**
      * Eval Await waits for the fence to finish processing and then once it
-     * finishes, it runs the postEval of all operations.
+     * finishes, it runs the postEval of all operations. If the sequence has
+     * several submissions in flight it waits for all of them in the order
+     * they were submitted.
      *
      * @param waitFor Number of milliseconds to wait before timing out.
      * @return shared_ptr<Sequence> of the Sequence class itself
      */
     std::shared_ptr<Sequence> evalAwait(uint64_t waitFor = UINT64_MAX);
 
+    /**
+     * Eval Await Ticket waits for the fence of a single submission returned
+     * by getLastTicket() to finish processing, and then runs the postEval of
+     * all operations for that submission.
+     *
+     * @param ticket The ticket of the submission to wait for
+     * @param waitFor Number of milliseconds to wait before timing out.
+     * @return shared_ptr<Sequence> of the Sequence class itself
+     */
+    std::shared_ptr<Sequence> evalAwaitTicket(uint64_t ticket,
+                                              uint64_t waitFor = UINT64_MAX);
+
+    /**
+     * Returns the ticket of the last submission made with evalAsync, which
+     * identifies the submission in evalAwaitTicket. Tickets start at 1 and
+     * increase with every submission.
+     *
+     * @return The ticket of the last submission, or 0 if none was made
+     */
+    uint64_t getLastTicket() const;
+
+    /**
+     * Returns the fence signalled by a submission in flight, which is the
+     * fence shared by the batch for submissions made by kp::Manager::submit.
+     *
+     * @param ticket The ticket of the submission
+     * @return The fence of the submission
+     */
+    vk::Fence getSubmissionFence(uint64_t ticket) const;
+
+    /**
+     * Returns the number of command buffers the sequence submits in turn,
+     * which is the maximum number of submissions in flight.
+     *
+     * @return The number of command buffers of the sequence
+     */
+    uint32_t getBufferCount() const;
+
+    /**
+     * Creates a parameter block whose parameters are copied into the tensor
+     * provided, with a slot for each command buffer of the sequence. Once
+     * recorded into the sequence, the parameters set on the block are used
+     * by the following evals without recording the sequence again. The
+     * block is destroyed with the sequence.
+     *
+     * @param tensor The tensor the parameters are copied into, which the
+     * algorithms bind to read them
+     * @return Shared pointer to the parameter block
+     */
+    std::shared_ptr<ParameterBlock> parameterBlock(
+      std::shared_ptr<Tensor> tensor);
+
+    /**
+     * Sets how the sequence waits for its submissions. Blocking waits let the
+     * thread sleep in the driver, which can add tens of microseconds of
+     * wake-up latency once the submission has finished. Spinning polls the
+     * status of the submission instead, which keeps a core busy during the
+     * whole wait. The hybrid strategy polls with an increasing backoff for
+     * up to the spin duration before sleeping, and shortens the polling while
+     * the submissions outlast it.
+     *
+     * @param strategy The wait strategy of the sequence
+     * @param spinDuration The maximum number of nanoseconds the hybrid
+     * strategy polls before sleeping
+     */
+    void setWaitStrategy(WaitStrategy strategy,
+                         uint64_t spinDuration = KP_DEFAULT_SPIN_DURATION);
+
+    /**
+     * Returns how the sequence waits for its submissions.
+     *
+     * @return The wait strategy of the sequence
+     */
+    WaitStrategy getWaitStrategy() const;
+
+    /**
+     * Prepares the next submission of the sequence in the same way as
+     * evalAsync, but returns its command buffer instead of submitting it.
+     * This allows kp::Manager::submit to batch the submissions of several
+     * sequences into one queue submission that signals a shared fence. The
+     * submission is awaited with evalAwait or evalAwaitTicket as usual.
+     *
+     * @param fence The fence signalled by the queue submission that will
+     * contain the submit info
+     * @return The submit info of the command buffer, including its timeline
+     * semaphore waits and signal, which stays valid until the submission has
+     * been awaited
+     */
+    vk::SubmitInfo prepareSubmit(std::shared_ptr<vk::Fence> fence);
+
+    /**
+     * Cancels the last submission prepared with prepareSubmit, which is
+     * required if its command buffer could not be submitted.
+     */
+    void cancelSubmit();
+
+    /**
+     * The queue the sequence submits its command buffers to.
+     *
+     * @return Shared pointer to the compute queue of the sequence
+     */
+    std::shared_ptr<vk::Queue> getComputeQueue() const;
+
+    /**
+     * Creates the timeline semaphore of the sequence, which requires the
+     * VK_KHR_timeline_semaphore extension and the timelineSemaphore feature
+     * to be enabled on the device. Sequences created by a kp::Manager whose
+     * device has the extension enabled have a timeline semaphore already.
+     *
+     * Every submission of a sequence with a timeline semaphore signals it
+     * at a new value, which other sequences can wait for on the GPU, and
+     * evalAwait waits for that value instead of the fence.
+     */
+    void enableTimeline();
+
+    /**
+     * Returns true if the sequence has a timeline semaphore.
+     *
+     * @return Boolean stating if timeline semaphores are enabled
+     */
+    bool isTimelineEnabled() const;
+
+    /**
+     * Declares that the next submission of this sequence waits on the GPU
+     * until the timeline semaphore of another sequence reaches a value,
+     * without involving the host. Both sequences require a timeline
+     * semaphore, and the submission waited for may be made later, from any
+     * queue.
+     *
+     * @param sequence The sequence to wait for
+     * @param value The timeline value to wait for, which defaults to the
+     * value signalled by the last submission of the sequence
+     * @param stages The pipeline stages that wait for the value
+     * @return shared_ptr<Sequence> of the Sequence class itself
+     */
+    std::shared_ptr<Sequence> waitFor(
+      std::shared_ptr<Sequence> sequence,
+      uint64_t value = 0,
+      vk::PipelineStageFlags stages = vk::PipelineStageFlagBits::eAllCommands);
+
+    /**
+     * Declares the value the timeline semaphore of the sequence is signalled
+     * at by its next submission, which has to be greater than the values
+     * signalled before. Submissions without a declared value signal the
+     * value after the last one.
+     *
+     * @param value The timeline value to signal
+     * @return shared_ptr<Sequence> of the Sequence class itself
+     */
+    std::shared_ptr<Sequence> signal(uint64_t value);
+
+    /**
+     * Returns the timeline value signalled by the last submission of the
+     * sequence.
+     *
+     * @return The last timeline value submitted, or 0 if none was
+     */
+    uint64_t getTimelineValue() const;
+
+    /**
+     * Returns the current value of the timeline semaphore of the sequence,
+     * which is the value signalled by the last submission that finished.
+     *
+     * @return The completed timeline value
+     */
+    uint64_t getCompletedTimelineValue() const;
+
     /**
      * Clear function clears all operations currently recorded and starts
      * recording again.
@@ -218,6 +522,87 @@ class Sequence : public std::enable_shared_from_this<Sequence>
      */
     std::vector<std::uint64_t> getTimestamps();
 
+    /**
+     * Retrieves the timestamps latched by the last submission without waiting
+     * for them, using the availability of the queries. The timestamps are
+     * not retrieved while the submission is running.
+     *
+     * @param timestamps Vector the timestamps are written to, at the
+     * beginning and after each operation
+     * @return True if all the timestamps were available
+     */
+    bool tryGetTimestamps(std::vector<std::uint64_t>& timestamps);
+
+    /**
+     * Creates the pipeline statistics query pool of the sequence, which
+     * counts the compute shader invocations of each kp::OpAlgoDispatch
+     * recorded after this call. This requires the pipelineStatisticsQuery
+     * feature, which kp::Manager enables when the device supports it, and is
+     * only supported with a single command buffer.
+     *
+     * @param totalQueries Maximum number of operations queried, as the
+     * operations are queried by their index in the sequence
+     */
+    void enablePipelineStatistics(uint32_t totalQueries);
+
+    /**
+     * Returns true if the sequence has a pipeline statistics query pool.
+     *
+     * @return Boolean stating if pipeline statistics are enabled
+     */
+    bool isPipelineStatisticsEnabled() const;
+
+    /**
+     * Return the compute shader invocations counted for each operation during
+     * the last eval() call, which are zero for the operations that are not
+     * queried dispatches.
+     *
+     * @return The invocations per operation
+     */
+    std::vector<std::uint64_t> getPipelineStatistics();
+
+    /**
+     * Returns the dispatches of the last eval() call whose compute shader
+     * invocations exceed the number of elements of the largest memory object
+     * bound to their algorithm by more than the factor provided. This is
+     * usually the case when the workgroup of the algorithm defaults to the
+     * size of the tensor for a shader with a local size larger than 1.
+     *
+     * @param factor Ratio of invocations to bound elements above which a
+     * dispatch is reported
+     * @return The statistics of the over-dispatched operations
+     */
+    std::vector<DispatchStatistics> getOverDispatchedOperations(
+      double factor = KP_DEFAULT_OVER_DISPATCH_FACTOR);
+
+    /**
+     * Returns the names of the operations recorded into the sequence, in the
+     * order they are recorded.
+     *
+     * @return The names of the operations
+     */
+    std::vector<std::string> getOperationNames() const;
+
+    /**
+     * Return the statistics of the device memory bound to the eTransient
+     * tensors recorded into the sequence, including the bytes saved by
+     * aliasing tensors that are not used at the same time. The statistics
+     * cover the current recording, and are reset when the memory is released
+     * by clear or rerecord.
+     *
+     * @return The transient memory statistics of the sequence
+     */
+    TransientMemoryStats getTransientMemoryStats() const;
+
+    /**
+     * Return the statistics of the barriers recorded for the tensor accesses
+     * declared by the operations, including the barriers elided because the
+     * previous accesses to the tensor didn't conflict.
+     *
+     * @return The barrier statistics of the sequence
+     */
+    BarrierStats getBarrierStats() const;
+
     /**
      * Begins recording commands for commands to be submitted into the command
      * buffer.
@@ -254,12 +639,20 @@ class Sequence : public std::enable_shared_from_this<Sequence>
 
     /**
      * Returns true if the sequence is currently running - mostly used for async
-     * workloads.
+     * workloads. This is the case while any submission is in flight.
      *
      * @return Boolean stating if currently running.
      */
     bool isRunning() const;
 
+    /**
+     * Returns true if the submission with the ticket provided is in flight.
+     *
+     * @param ticket The ticket of the submission
+     * @return Boolean stating if the submission is currently running.
+     */
+    bool isRunning(uint64_t ticket) const;
+
     /**
      * Destroys and frees the GPU resources which include the buffer and memory
      * and sets the sequence as init=False.
@@ -272,6 +665,9 @@ class Sequence : public std::enable_shared_from_this<Sequence>
     std::shared_ptr<vk::Device> mDevice = nullptr;
     std::shared_ptr<vk::Queue> mComputeQueue = nullptr;
     uint32_t mQueueIndex = -1;
+    std::shared_ptr<Residency> mResidency = nullptr;
+    std::shared_ptr<CompletionThread> mCompletionThread = nullptr;
+    std::shared_ptr<std::mutex> mQueueMutex = nullptr;
 
     // -------------- OPTIONALLY OWNED RESOURCES
     std::shared_ptr<vk::CommandPool> mCommandPool = nullptr;
@@ -280,18 +676,104 @@ class Sequence : public std::enable_shared_from_this<Sequence>
     bool mFreeCommandBuffer = false;
 
     // -------------- ALWAYS OWNED RESOURCES
-    vk::Fence mFence;
+    struct TimelineWait
+    {
+        std::shared_ptr<Sequence> sequence;
+        uint64_t value;
+        vk::PipelineStageFlags stages;
+    };
+
+    struct Submission
+    {
+        std::shared_ptr<vk::CommandBuffer> commandBuffer;
+        vk::Fence fence;
+        std::shared_ptr<vk::Fence> sharedFence;
+        uint64_t ticket = 0;
+        bool pending = false;
+        std::vector<std::shared_ptr<Memory>> acquiredMemObjects;
+        std::vector<TimelineWait> timelineWaits;
+        std::vector<vk::Semaphore> waitSemaphores;
+        std::vector<uint64_t> waitValues;
+        std::vector<vk::PipelineStageFlags> waitStages;
+        uint64_t timelineValue = 0;
+        uint64_t previousTimelineValue = 0;
+        vk::TimelineSemaphoreSubmitInfoKHR timelineSubmitInfo;
+        vk::SubmitInfo submitInfo;
+    };
+
+    std::vector<Submission> mSubmissions;
     std::vector<std::shared_ptr<OpBase>> mOperations{};
     std::shared_ptr<vk::QueryPool> timestampQueryPool = nullptr;
+    uint32_t mTimestampCount = 0;
+    std::shared_ptr<vk::QueryPool> mStatisticsQueryPool = nullptr;
+    uint32_t mStatisticsCount = 0;
+    size_t mFirstStatisticsOperation = 0;
+    std::vector<std::shared_ptr<vk::DeviceMemory>> mTransientMemories;
+    std::vector<std::weak_ptr<Tensor>> mTransientTensors;
+    TransientMemoryStats mTransientMemoryStats;
+    std::vector<uint64_t> mRecordedGenerations;
+    std::vector<bool> mAliasBarriers;
+
+    HazardTracker mHazardTracker;
+    std::vector<HazardTracker::Barrier> mHazardBarriers;
+    vk::Semaphore mTimelineSemaphore;
+    PFN_vkWaitSemaphoresKHR mWaitSemaphores = nullptr;
+    PFN_vkGetSemaphoreCounterValueKHR mGetSemaphoreCounterValue = nullptr;
+    std::vector<TimelineWait> mTimelineWaits;
+    std::vector<std::weak_ptr<ParameterBlock>> mParameterBlocks;
 
     // State
     bool mRecording = false;
-    bool mIsRunning = false;
+    bool mDeferRecording = false;
+    size_t mFirstRecordedOperation = 0;
+    size_t mFirstDeferredOperation = 0;
+    uint64_t mLastTicket = 0;
+    uint64_t mTimelineValue = 0;
+    uint64_t mSignalValue = 0;
+    WaitStrategy mWaitStrategy = WaitStrategy::eBlock;
+    uint64_t mSpinDuration = KP_DEFAULT_SPIN_DURATION;
+    uint64_t mSpinBudget = KP_DEFAULT_SPIN_DURATION;
 
     // Create functions
     void createCommandPool();
-    void createCommandBuffer();
+    void createCommandBuffer(uint32_t numBuffers);
     void createTimestampQueryPool(uint32_t totalTimestamps);
+
+    // Returns the memory objects used by all the operations
+    std::vector<std::shared_ptr<Memory>> getMemObjects();
+    std::vector<uint64_t> getMemGenerations();
+
+    // Prepares the next submission up to the point of submitting it
+    Submission& prepareSubmission(std::shared_ptr<vk::Fence> sharedFence);
+    // Waits for a submission and runs the postEval of the operations
+    bool awaitSubmission(Submission& submission, uint64_t waitFor);
+    // Unpins the memory objects of a submission that is no longer in flight
+    void releaseMemObjects(Submission& submission);
+    // Polls the status of a submission for up to the duration provided
+    vk::Result spinSubmission(const Submission& submission,
+                              uint64_t duration,
+                              bool backoff) const;
+    bool isSubmissionComplete(const Submission& submission) const;
+    // Records the operations recorded into the first command buffer into the
+    // other command buffers of the sequence
+    void replayOperations();
+    void recordAliasBarrier(const vk::CommandBuffer& commandBuffer);
+    // Records an operation with the barriers planned before it
+    void recordOperation(const vk::CommandBuffer& commandBuffer, size_t index);
+    // Whether the pipeline statistics of an operation are queried
+    bool isStatisticsQueried(size_t index) const;
+
+    // Transient memory functions
+    void recordDeferredOperations();
+    std::vector<bool> planTransientMemory();
+    // Unbinds the transient tensors planned by the sequence and frees their
+    // memory, so they are planned again when recorded
+    void releaseTransientMemory();
+    static bool usesUnboundTransientMemory(const std::shared_ptr<OpBase>& op);
+    bool usesForeignTransientMemory(const std::shared_ptr<OpBase>& op);
+    // Rejects syncs through the staging ring whose transfer, made before or
+    // after the submission, would not match their place in the sequence
+    void checkStagingRingSyncs(const std::shared_ptr<OpBase>& op);
 };
 
 } // End namespace kp
@@ -0,0 +1,217 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "kompute/Core.hpp"
+#include "kompute/HazardTracker.hpp"
+#include "kompute/Residency.hpp"
+
+#include "kompute/operations/OpBase.hpp"
+
+namespace kp {
+
+/**
+ * Block of operations recorded once into a secondary command buffer, which
+ * any number of sequences can then execute with kp::OpExecuteFragment instead
+ * of recording the operations themselves.
+ *
+ * The fragment records the barriers between its own operations, and declares
+ * the accesses of all its operations to the sequences that execute it, so
+ * they record the barriers it requires before and after it. Sequences that
+ * execute a fragment have to submit to a queue of the same family it was
+ * created for.
+ */
+class SequenceFragment : public std::enable_shared_from_this<SequenceFragment>
+{
+  public:
+    /**
+     * Constructor which creates the command pool and the secondary command
+     * buffer of the fragment.
+     *
+     * @param device Vulkan logical device
+     * @param queueIndex Family index of the queues of the sequences that
+     * execute the fragment
+     * @param residency Optional residency policy that restores the spilled
+     * tensors of the operations when they are recorded
+     */
+    SequenceFragment(std::shared_ptr<vk::Device> device,
+                     uint32_t queueIndex,
+                     std::shared_ptr<Residency> residency = nullptr);
+
+    /**
+     * Destructor for the fragment which frees its command buffer.
+     */
+    ~SequenceFragment();
+
+    /**
+     * Records an operation at the end of the fragment. Operations that use
+     * eTransient tensors without bound memory can't be recorded into a
+     * fragment, as their memory is planned by the sequence. Sequences that
+     * recorded the fragment before have to be re-recorded to execute the
+     * operation.
+     *
+     * @param op Object derived from kp::BaseOp that will be recorded by the
+     * fragment
+     * @return shared_ptr<SequenceFragment> of the fragment itself
+     */
+    std::shared_ptr<SequenceFragment> record(std::shared_ptr<OpBase> op);
+
+    /**
+     * Records an operation at the end of the fragment.
+     *
+     * @param memObjects Vector of mem objects to use for the operation
+     * @param TArgs Template parameters that are used to initialise operation
+     * which allows for extensible configurations on initialisation.
+     * @return shared_ptr<SequenceFragment> of the fragment itself
+     */
+    template<typename T, typename... TArgs>
+    std::shared_ptr<SequenceFragment> record(
+      std::vector<std::shared_ptr<Memory>> memObjects,
+      TArgs&&... params)
+    {
+        std::shared_ptr<T> op{ new T(memObjects,
+                                     std::forward<TArgs>(params)...) };
+        return this->record(op);
+    }
+
+    /**
+     * Records an operation at the end of the fragment.
+     *
+     * @param algorithm Algorithm to use for the record often used for OpAlgo
+     * operations
+     * @param TArgs Template parameters that are used to initialise operation
+     * which allows for extensible configurations on initialisation.
+     * @return shared_ptr<SequenceFragment> of the fragment itself
+     */
+    template<typename T, typename... TArgs>
+    std::shared_ptr<SequenceFragment> record(
+      std::shared_ptr<Algorithm> algorithm,
+      TArgs&&... params)
+    {
+        std::shared_ptr<T> op{ new T(algorithm,
+                                     std::forward<TArgs>(params)...) };
+        return this->record(op);
+    }
+
+    /**
+     * Returns the secondary command buffer of the fragment ready to be
+     * executed. The recording is ended if ongoing, and the operations are
+     * re-recorded if their memory objects have been recreated since. Once
+     * returned, the command buffer is never recorded again: re-recording the
+     * fragment records a new command buffer, so the sequences still running
+     * the previous one are not affected, and it is freed once they release
+     * it.
+     *
+     * @return Shared pointer to the secondary command buffer
+     */
+    std::shared_ptr<vk::CommandBuffer> getCommandBuffer();
+
+    /**
+     * Returns the union of the memory objects used by the operations.
+     *
+     * @return The memory objects used by the fragment
+     */
+    std::vector<std::shared_ptr<Memory>> getMemObjects();
+
+    /**
+     * Returns the accesses of the operations to the tensors they use, merged
+     * per tensor, which is how a sequence sees the fragment.
+     *
+     * @return The tensor accesses of the fragment
+     */
+    std::vector<OpBase::MemoryAccess> getMemoryAccesses();
+
+    /**
+     * Runs the preEval of the operations of the fragment.
+     *
+     * @param commandBuffer The command buffer of the sequence submitted
+     */
+    void preEval(const vk::CommandBuffer& commandBuffer);
+
+    /**
+     * Runs the postEval of the operations of the fragment.
+     *
+     * @param commandBuffer The command buffer of the sequence submitted
+     */
+    void postEval(const vk::CommandBuffer& commandBuffer);
+
+    /**
+     * Return the statistics of the barriers recorded between the operations
+     * of the fragment.
+     *
+     * @return The barrier statistics of the fragment
+     */
+    HazardTracker::Stats getBarrierStats() const;
+
+    /**
+     * Begins recording the secondary command buffer, which re-records the
+     * operations already in the fragment.
+     */
+    void begin();
+
+    /**
+     * Ends the recording of the secondary command buffer.
+     */
+    void end();
+
+    /**
+     * Clears the operations of the fragment.
+     */
+    void clear();
+
+    /**
+     * Re-records the operations of the fragment, which is required if the
+     * underlying kp::Memorys or kp::Algorithms are modified.
+     */
+    void rerecord();
+
+    /**
+     * Returns true if the fragment is currently recording.
+     *
+     * @return Boolean stating if recording ongoing.
+     */
+    bool isRecording() const;
+
+    /**
+     * Returns the family index of the queues the fragment is recorded for.
+     *
+     * @return The queue family index of the fragment
+     */
+    uint32_t getQueueIndex() const;
+
+    /**
+     * Returns true if the fragment has been initialised, and it's based on the
+     * GPU resources being referenced.
+     *
+     * @return Boolean stating if is initialized
+     */
+    bool isInit() const;
+
+    /**
+     * Destroys and frees the GPU resources of the fragment.
+     */
+    void destroy();
+
+  private:
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<vk::Device> mDevice = nullptr;
+    uint32_t mQueueIndex = -1;
+    std::shared_ptr<Residency> mResidency = nullptr;
+
+    // -------------- ALWAYS OWNED RESOURCES
+    std::shared_ptr<vk::CommandPool> mCommandPool = nullptr;
+    std::shared_ptr<vk::CommandBuffer> mCommandBuffer = nullptr;
+    std::vector<std::shared_ptr<OpBase>> mOperations{};
+    std::vector<uint64_t> mRecordedGenerations;
+    HazardTracker mHazardTracker{ false };
+
+    // State
+    bool mRecording = false;
+    bool mRecorded = false;
+    bool mCommandBufferShared = false;
+
+    std::shared_ptr<vk::CommandBuffer> allocateCommandBuffer();
+    void recordOperation(const std::shared_ptr<OpBase>& op);
+    std::vector<uint64_t> getMemGenerations();
+};
+
+} // End namespace kp
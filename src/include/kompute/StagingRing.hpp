@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "kompute/Core.hpp"
+#include "logger/Logger.hpp"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#define KP_DEFAULT_STAGING_RING_SIZE (16 * 1024 * 1024)
+#define KP_DEFAULT_STAGING_RING_CHUNKS 4
+
+namespace kp {
+
+/**
+ * Host visible ring buffer shared by the tensors of a manager to transfer
+ * data between host memory and device buffers, instead of each tensor holding
+ * a staging buffer as large as itself.
+ *
+ * The ring is split in equally sized chunks, each with its own command buffer
+ * and fence. Transfers larger than a chunk are streamed through the chunks in
+ * order, so the host copy of one chunk overlaps the device copy of the
+ * previous ones. Transfers are synchronous: they return once all the chunks
+ * have been copied. Each copy waits for the commands submitted to the queue of
+ * the ring before it, so transfers into buffers used by submissions on other
+ * queues must wait for these submissions to complete.
+ */
+class StagingRing
+{
+  public:
+    /**
+     * Constructor which allocates the host visible memory of the ring and the
+     * command buffers used to copy each chunk.
+     *
+     * @param physicalDevice The physical device to fetch memory properties from
+     * @param device The device to allocate the ring from
+     * @param queue The queue to submit the transfers to
+     * @param queueFamilyIndex The family index of the queue
+     * @param size The size in bytes of the ring
+     * @param numChunks The number of chunks the ring is split into
+     * @param queueMutex Optional mutex held while submitting to the queue,
+     * shared by everything that submits to it
+     */
+    StagingRing(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                std::shared_ptr<vk::Device> device,
+                std::shared_ptr<vk::Queue> queue,
+                uint32_t queueFamilyIndex,
+                vk::DeviceSize size = KP_DEFAULT_STAGING_RING_SIZE,
+                uint32_t numChunks = KP_DEFAULT_STAGING_RING_CHUNKS,
+                std::shared_ptr<std::mutex> queueMutex = nullptr);
+
+    /**
+     * Destructor which frees the vulkan resources of the ring.
+     */
+    ~StagingRing();
+
+    /**
+     * Copies host data into a device buffer through the ring, waiting until
+     * the copy has completed.
+     *
+     * @param dstBuffer The buffer to copy the data into
+     * @param dstOffset The offset in bytes into the destination buffer
+     * @param data The host data to copy from
+     * @param size The size in bytes of the data
+     */
+    void upload(const vk::Buffer& dstBuffer,
+                vk::DeviceSize dstOffset,
+                const void* data,
+                vk::DeviceSize size);
+
+    /**
+     * Copies the contents of a device buffer into host memory through the
+     * ring, waiting until the copy has completed.
+     *
+     * @param srcBuffer The buffer to copy the data from
+     * @param srcOffset The offset in bytes into the source buffer
+     * @param data The host memory to copy the data into
+     * @param size The size in bytes of the data
+     */
+    void download(const vk::Buffer& srcBuffer,
+                  vk::DeviceSize srcOffset,
+                  void* data,
+                  vk::DeviceSize size);
+
+    /**
+     * Size in bytes of the ring.
+     *
+     * @return The size of the ring
+     */
+    vk::DeviceSize size() const;
+
+    /**
+     * Size in bytes of each of the chunks the transfers are split into.
+     *
+     * @return The chunk size of the ring
+     */
+    vk::DeviceSize chunkSize() const;
+
+    /**
+     * Queue the transfers are submitted to, after the commands submitted to
+     * it earlier.
+     *
+     * @return The queue of the ring
+     */
+    std::shared_ptr<vk::Queue> queue() const;
+
+    /**
+     * Check whether the ring is initialized based on the device referenced.
+     *
+     * @return Boolean stating whether the ring is initialized
+     */
+    bool isInit() const;
+
+    /**
+     * Destroys the vulkan resources of the ring, waiting for the transfers in
+     * flight to finish.
+     */
+    void destroy();
+
+  private:
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<vk::PhysicalDevice> mPhysicalDevice;
+    std::shared_ptr<vk::Device> mDevice;
+    std::shared_ptr<vk::Queue> mQueue;
+    std::shared_ptr<std::mutex> mQueueMutex;
+
+    // -------------- ALWAYS OWNED RESOURCES
+    struct PendingRead
+    {
+        uint8_t* data = nullptr;
+        vk::DeviceSize size = 0;
+    };
+
+    std::shared_ptr<vk::Buffer> mBuffer;
+    std::shared_ptr<vk::DeviceMemory> mMemory;
+    std::shared_ptr<vk::CommandPool> mCommandPool;
+    std::vector<vk::CommandBuffer> mCommandBuffers;
+    std::vector<vk::Fence> mFences;
+    std::vector<bool> mSubmitted;
+    std::vector<PendingRead> mPendingReads;
+    uint8_t* mMappedData = nullptr;
+    vk::DeviceSize mSize;
+    vk::DeviceSize mChunkSize;
+    std::mutex mMutex;
+
+    void createBuffer(uint32_t queueFamilyIndex);
+    void submitChunk(uint32_t chunk,
+                     const vk::Buffer& srcBuffer,
+                     const vk::Buffer& dstBuffer,
+                     const vk::BufferCopy& copyRegion,
+                     bool hostRead);
+    void finishChunk(uint32_t chunk);
+};
+
+} // End namespace kp
@@ -3,7 +3,9 @@
 
 #include "kompute/Core.hpp"
 #include "kompute/Memory.hpp"
+#include "kompute/StagingRing.hpp"
 #include "logger/Logger.hpp"
+#include <atomic>
 #include <memory>
 #include <string>
 
@@ -19,9 +21,23 @@ class Image;
  * would be used to store their respective data. The tensors can be used for GPU
  * data storage or transfer.
  */
-class Tensor : public Memory
+class Tensor
+  : public Memory
+  , public std::enable_shared_from_this<Tensor>
 {
   public:
+    /**
+     * Host memory allocated by the user that a tensor imports as its primary
+     * memory through VK_EXT_external_memory_host instead of copying it. Both
+     * the pointer and the size have to be multiples of the
+     * minImportedHostPointerAlignment limit of the device.
+     */
+    struct HostPointer
+    {
+        void* data = nullptr;
+        vk::DeviceSize size = 0;
+    };
+
     /**
      *  Constructor with data provided which would be used to create the
      * respective vulkan buffer and memory.
@@ -31,14 +47,21 @@ class Tensor : public Memory
      *  @param data Non-zero-sized vector of data that will be used by the
      * tensor
      *  @param tensorTypes Type for the tensor which is of type MemoryTypes
+     *  @param memoryPool (Optional) Pool to sub-allocate the memory from
+     *  @param stagingPolicy (Optional) Access pattern of the staging memory
+     *  @param stagingRing (Optional) Ring to transfer the data through instead
+     *   of allocating a staging buffer
      */
     Tensor(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
            std::shared_ptr<vk::Device> device,
            void* data,
-           uint32_t elementTotalCount,
+           uint64_t elementTotalCount,
            uint32_t elementMemorySize,
            const DataTypes& dataType,
-           const MemoryTypes& tensorType = MemoryTypes::eDevice);
+           const MemoryTypes& tensorType = MemoryTypes::eDevice,
+           std::shared_ptr<MemoryPool> memoryPool = nullptr,
+           const StagingPolicy& stagingPolicy = StagingPolicy::eUpload,
+           std::shared_ptr<StagingRing> stagingRing = nullptr);
 
     /**
      *  Constructor with size provided which would be used to create the
@@ -49,13 +72,54 @@ class Tensor : public Memory
      *  @param elmentTotalCount the number of elements of the array
      *  @param elementMemorySize the size of the element
      *  @param tensorTypes Type for the tensor which is of type TensorTypes
+     *  @param memoryPool (Optional) Pool to sub-allocate the memory from
+     *  @param stagingPolicy (Optional) Access pattern of the staging memory
+     *  @param stagingRing (Optional) Ring to transfer the data through instead
+     *   of allocating a staging buffer
      */
     Tensor(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
            std::shared_ptr<vk::Device> device,
-           uint32_t elementTotalCount,
+           uint64_t elementTotalCount,
            uint32_t elementMemorySize,
            const DataTypes& dataType,
-           const MemoryTypes& memoryType = MemoryTypes::eDevice);
+           const MemoryTypes& memoryType = MemoryTypes::eDevice,
+           std::shared_ptr<MemoryPool> memoryPool = nullptr,
+           const StagingPolicy& stagingPolicy = StagingPolicy::eUpload,
+           std::shared_ptr<StagingRing> stagingRing = nullptr);
+
+    /**
+     *  Constructor of a view over a range of the elements of another tensor,
+     * which shares the buffers and memory of the tensor instead of creating
+     * its own. Descriptors, copies, syncs and barriers of the view only cover
+     * its range, and its host data aliases the host data of the tensor. The
+     * view keeps a reference to the tensor, but becomes invalid if the tensor
+     * is destroyed.
+     *
+     *  @param tensor The tensor to create the view of
+     *  @param offset The index of the first element of the view
+     *  @param count The number of elements of the view
+     */
+    Tensor(std::shared_ptr<Tensor> tensor, uint64_t offset, uint64_t count);
+
+    /**
+     *  Constructor of an eHost tensor whose primary memory is imported from
+     * host memory owned by the user, so the data is neither copied nor mapped.
+     * The device has to be created with the VK_EXT_external_memory_host
+     * extension, and the host memory has to outlive the tensor.
+     *
+     *  @param physicalDevice The physical device to use to fetch properties
+     *  @param device The device to use to create the buffer and import memory
+     *  @param hostPointer The aligned host memory to import
+     *  @param elementTotalCount the number of elements of the array
+     *  @param elementMemorySize the size of the element
+     *  @param dataType The data type of the elements
+     */
+    Tensor(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+           std::shared_ptr<vk::Device> device,
+           const HostPointer& hostPointer,
+           uint64_t elementTotalCount,
+           uint32_t elementMemorySize,
+           const DataTypes& dataType);
 
     /**
      * Destructor which is in charge of freeing vulkan resources unless they
@@ -165,13 +229,211 @@ class Tensor : public Memory
 
     std::shared_ptr<vk::Buffer> getPrimaryBuffer();
 
+    /**
+     * Creates a view over a range of the elements of the tensor, which can be
+     * used in algorithms and operations in place of a tensor. To be bound as a
+     * descriptor the offset of the view in bytes has to be a multiple of the
+     * minStorageBufferOffsetAlignment limit of the device.
+     *
+     * @param offset The index of the first element of the view
+     * @param count The number of elements of the view
+     * @return Shared pointer with the view of the tensor
+     */
+    std::shared_ptr<Tensor> slice(uint64_t offset, uint64_t count);
+
+    /**
+     * Offset in bytes of the tensor data in its buffers, which is only non-zero
+     * for views created with slice.
+     *
+     * @return The offset in bytes of the tensor data
+     */
+    vk::DeviceSize memoryOffset() override;
+
+    /**
+     * Check whether the tensor transfers its data through a staging ring
+     * instead of its own staging buffer.
+     *
+     * @return Boolean stating whether the tensor uses a staging ring
+     */
+    bool usesStagingRing();
+
+    /**
+     * Copies the host data of the tensor into the device buffer through the
+     * staging ring, waiting for the transfer to complete. Nothing is copied if
+     * the host data has not been accessed since the tensor was created.
+     */
+    void uploadThroughStagingRing();
+
+    /**
+     * Copies the device buffer of the tensor into its host data through the
+     * staging ring, allocating the host data if required and waiting for the
+     * transfer to complete.
+     */
+    void downloadThroughStagingRing();
+
+    /**
+     * Binds the device buffer of an eTransient tensor to a range of device
+     * memory owned by a sequence, which may be shared with other transient
+     * tensors that are not alive at the same time. The tensor does not free
+     * the memory on destroy.
+     *
+     * @param memory The device memory to bind the buffer to
+     * @param offset The offset in bytes into the device memory
+     * @param memoryPropertyFlags The property flags of the device memory
+     */
+    void bindTransientMemory(std::shared_ptr<vk::DeviceMemory> memory,
+                             vk::DeviceSize offset,
+                             vk::MemoryPropertyFlags memoryPropertyFlags);
+
+    /**
+     * Releases the device memory bound to an eTransient tensor by the
+     * sequence that planned it. As a buffer can't be bound to other memory,
+     * the buffer is recreated without memory, which increases the generation
+     * of the tensor so it is planned again by the next sequence recording it.
+     */
+    void unbindTransientMemory();
+
+    /**
+     * Check whether the primary memory of the tensor is imported from host
+     * memory owned by the user, which means its data was not copied.
+     *
+     * @return Boolean stating whether the tensor imports host memory
+     */
+    bool isHostMemoryImported();
+
+    /**
+     * Check whether the primary memory of the tensor can be evicted, which is
+     * only the case for resident eDevice and eStorage tensors that own their
+     * buffer and memory and have no views.
+     *
+     * @return Boolean stating whether the tensor can be evicted
+     */
+    bool isEvictable();
+
+    /**
+     * Check whether the primary buffer and memory of the tensor exist, which
+     * is only false while the tensor is evicted.
+     *
+     * @return Boolean stating whether the tensor is resident
+     */
+    bool isResident();
+
+    /**
+     * Frees the primary buffer and memory of the tensor so other tensors can
+     * use the device memory. The contents are lost, so they have to be copied
+     * elsewhere beforehand, which kp::Residency does when it spills a tensor.
+     */
+    void evictPrimaryMemory();
+
+    /**
+     * Recreates the primary buffer and memory of an evicted tensor, which
+     * increases its generation as the buffer is a new one. The contents have
+     * to be copied back afterwards.
+     */
+    void restorePrimaryMemory();
+
+    /**
+     * Resize recorded by recordResize, with the buffers its copy reads from
+     * and writes to, which are null when the buffers were kept.
+     */
+    struct Resize
+    {
+        std::shared_ptr<vk::Buffer> previousPrimaryBuffer;
+        std::shared_ptr<vk::Buffer> previousStagingBuffer;
+        std::shared_ptr<vk::Buffer> primaryBuffer;
+        std::shared_ptr<vk::Buffer> stagingBuffer;
+        uint64_t copySize = 0;
+    };
+
+    /**
+     * Number of elements the buffers of the tensor can hold without being
+     * reallocated, which is at least the size of the tensor.
+     *
+     * @return The capacity of the tensor in elements
+     */
+    uint64_t capacity();
+
+    /**
+     * Changes the number of elements of the tensor with std::vector-like
+     * capacity semantics. Sizes within the capacity keep the buffers and only
+     * change the range used by descriptors and copies, whereas larger sizes
+     * grow the capacity geometrically into new buffers and record a copy of
+     * the existing contents into the command buffer. The host data of grown
+     * tensors only holds the copied contents once the command buffer has
+     * executed, and finishResize has to be called afterwards to free the
+     * previous buffers. Either way the generation of the tensor increases, so
+     * algorithms refresh their descriptors and sequences re-record their
+     * commands. Views, eTransient tensors and tensors that have views or
+     * import host memory can't be resized.
+     *
+     * @param commandBuffer Vulkan Command Buffer to record the copy into
+     * @param elementTotalCount The new number of elements of the tensor
+     * @return The resize, which other command buffers recorded before it
+     * executes repeat with repeatResize, or null if the size didn't change
+     */
+    std::shared_ptr<const Resize> recordResize(
+      const vk::CommandBuffer& commandBuffer,
+      uint64_t elementTotalCount);
+
+    /**
+     * Records the copy of a resize again into another command buffer, such as
+     * the other command buffers of a multi-buffered sequence, as long as
+     * finishResize hasn't been called since, without resizing the tensor
+     * again.
+     *
+     * @param commandBuffer Vulkan Command Buffer to record the copy into
+     * @param resize The resize returned by recordResize
+     * @return Whether the resize was still pending and has been repeated
+     */
+    bool repeatResize(const vk::CommandBuffer& commandBuffer,
+                      const std::shared_ptr<const Resize>& resize);
+
+    /**
+     * Frees the buffers and memory replaced by recordResize once the recorded
+     * copy has executed, and invalidates the host memory the copy wrote to.
+     */
+    void finishResize();
+
+    // Views share the buffer of the viewed tensor, so their submissions are
+    // registered with it
+    void acquireSubmission(const vk::Queue& queue) override;
+    void releaseSubmission(const vk::Queue& queue) override;
+    bool isUsedByOtherQueue(const vk::Queue& queue) override;
+    bool isUsedBySubmission() override;
+
     Type type() override { return Type::eTensor; }
 
   protected:
     // -------------- ALWAYS OWNED RESOURCES
     vk::DescriptorBufferInfo mDescriptorBufferInfo;
 
+    void markHostRangeDirty(uint64_t offset, uint64_t size) override;
+    void stopTrackingHostWrites() override;
+    void flushHostWritesOutside(uint64_t offset, uint64_t size) override;
+
   private:
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<StagingRing> mStagingRing;
+    std::shared_ptr<Tensor> mViewedTensor;
+
+    // -------------- ALWAYS OWNED RESOURCES
+    struct RetiredBuffer
+    {
+        std::shared_ptr<vk::Buffer> buffer;
+        std::shared_ptr<vk::DeviceMemory> memory;
+        MemoryPool::Allocation allocation;
+    };
+
+    uint64_t mOffset = 0;
+    uint64_t mCapacity = 0;
+    std::vector<RetiredBuffer> mRetiredBuffers;
+    // Resizes recorded since finishResize was last called
+    std::vector<std::shared_ptr<const Resize>> mPendingResizes;
+    bool mHostMemoryImported = false;
+    // Number of live views of the tensor, which share its buffers
+    std::atomic<uint32_t> mViewCount{ 0 };
+    bool mEvicted = false;
+
     // -------------- OPTIONALLY OWNED RESOURCES
     std::shared_ptr<vk::Buffer> mPrimaryBuffer;
     bool mFreePrimaryBuffer = false;
@@ -179,11 +441,19 @@ class Tensor : public Memory
     bool mFreeStagingBuffer = false;
 
     void allocateMemoryCreateGPUResources(); // Creates the vulkan buffer
+    void importHostMemory(const HostPointer& hostPointer);
     void createBuffer(std::shared_ptr<vk::Buffer> buffer,
                       vk::BufferUsageFlags bufferUsageFlags);
-    void allocateBindMemory(std::shared_ptr<vk::Buffer> buffer,
-                            std::shared_ptr<vk::DeviceMemory> memory,
-                            vk::MemoryPropertyFlags memoryPropertyFlags);
+    void recordResizeCopy(const vk::CommandBuffer& commandBuffer,
+                          const Resize& resize);
+    void retireBuffer(std::shared_ptr<vk::Buffer>& buffer,
+                      std::shared_ptr<vk::DeviceMemory>& memory,
+                      MemoryPool::Allocation& allocation);
+    vk::MemoryPropertyFlags allocateBindMemory(
+      std::shared_ptr<vk::Buffer> buffer,
+      std::shared_ptr<vk::DeviceMemory>& memory,
+      MemoryPool::Allocation& allocation,
+      const std::vector<vk::MemoryPropertyFlags>& memoryPropertyFlags);
     void recordCopyBuffer(const vk::CommandBuffer& commandBuffer,
                           std::shared_ptr<vk::Buffer> bufferFrom,
                           std::shared_ptr<vk::Buffer> bufferTo,
@@ -222,13 +492,19 @@ class TensorT : public Tensor
     TensorT(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
             std::shared_ptr<vk::Device> device,
             const size_t size,
-            const MemoryTypes& tensorType = MemoryTypes::eDevice)
+            const MemoryTypes& tensorType = MemoryTypes::eDevice,
+            std::shared_ptr<MemoryPool> memoryPool = nullptr,
+            const StagingPolicy& stagingPolicy = StagingPolicy::eUpload,
+            std::shared_ptr<StagingRing> stagingRing = nullptr)
       : Tensor(physicalDevice,
                device,
                size,
                sizeof(T),
                Memory::dataType<T>(),
-               tensorType)
+               tensorType,
+               memoryPool,
+               stagingPolicy,
+               stagingRing)
     {
         KP_LOG_DEBUG("Kompute TensorT constructor with data size {}", size);
     }
@@ -237,21 +513,42 @@ class TensorT : public Tensor
       std::shared_ptr<vk::PhysicalDevice> physicalDevice,
       std::shared_ptr<vk::Device> device,
       const std::vector<T>& data,
-      const Memory::MemoryTypes& tensorType = Memory::MemoryTypes::eDevice)
+      const Memory::MemoryTypes& tensorType = Memory::MemoryTypes::eDevice,
+      std::shared_ptr<MemoryPool> memoryPool = nullptr,
+      const StagingPolicy& stagingPolicy = StagingPolicy::eUpload,
+      std::shared_ptr<StagingRing> stagingRing = nullptr)
       : Tensor(physicalDevice,
                device,
                (void*)data.data(),
-               static_cast<uint32_t>(data.size()),
+               data.size(),
                sizeof(T),
                Memory::dataType<T>(),
-               tensorType)
+               tensorType,
+               memoryPool,
+               stagingPolicy,
+               stagingRing)
     {
         KP_LOG_DEBUG("Kompute TensorT filling constructor with data size {}",
                      data.size());
     }
 
+    TensorT(std::shared_ptr<Tensor> tensor, uint64_t offset, uint64_t count)
+      : Tensor(tensor, offset, count)
+    {
+        KP_LOG_DEBUG("Kompute TensorT view constructor with offset {} and "
+                     "size {}",
+                     offset,
+                     count);
+    }
+
     ~TensorT() { KP_LOG_DEBUG("Kompute TensorT destructor"); }
 
+    std::shared_ptr<TensorT<T>> slice(uint64_t offset, uint64_t count)
+    {
+        return std::shared_ptr<TensorT<T>>{ new TensorT<T>(
+          this->shared_from_this(), offset, count) };
+    }
+
     DataTypes dataType() { return Memory::dataType<T>(); }
     std::vector<T> vector() { return Memory::vector<T>(); }
     T* data() { return Memory::data<T>(); }
@@ -51,11 +51,10 @@ class OpAlgoDispatch : public OpBase
 
     /**
      * This records the commands that are to be sent to the GPU. This includes
-     * the barriers that ensure the memory has been copied before going in and
-     * out of the shader, as well as the dispatch operation that sends the
-     * shader processing to the gpu. This function also records the GPU memory
-     * copy of the output data for the staging buffer so it can be read by the
-     * host.
+     * the layout transitions of the images used by the shader, as well as the
+     * dispatch operation that sends the shader processing to the gpu. The
+     * barriers for the tensors are recorded by the Sequence from the accesses
+     * returned by getMemoryAccesses.
      *
      * @param commandBuffer The command buffer to record the command into.
      */
@@ -75,7 +74,39 @@ class OpAlgoDispatch : public OpBase
      */
     virtual void postEval(const vk::CommandBuffer& commandBuffer) override;
 
-  private:
+    /**
+     * Returns the memory objects used by the operation.
+     *
+     * @returns The memory objects used by the operation
+     */
+    std::vector<std::shared_ptr<Memory>> getMemObjects() override;
+
+    /**
+     * Returns the shader read and write accesses to the tensors of the
+     * algorithm, as the Sequence records the barriers for them.
+     *
+     * @returns The tensor accesses of the operation
+     */
+    std::vector<MemoryAccess> getMemoryAccesses() override;
+
+    /**
+     * Returns the name of the operation, followed by the name of its
+     * algorithm if it has one.
+     *
+     * @returns The name of the operation
+     */
+    std::string name() const override;
+
+  protected:
+    /**
+     * Records the layout transitions of the images used by the shader, and
+     * binds the pipeline, descriptor set and push constants of the algorithm,
+     * which are the commands that precede the dispatch.
+     *
+     * @param commandBuffer The command buffer to record the command into.
+     */
+    void recordBind(const vk::CommandBuffer& commandBuffer);
+
     // -------------- ALWAYS OWNED RESOURCES
     std::shared_ptr<Algorithm> mAlgorithm;
     void* mPushConstantsData = nullptr;
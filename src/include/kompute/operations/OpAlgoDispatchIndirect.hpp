@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "kompute/Algorithm.hpp"
+#include "kompute/Core.hpp"
+#include "kompute/Tensor.hpp"
+#include "kompute/operations/OpAlgoDispatch.hpp"
+
+namespace kp {
+
+/**
+ * Operation that dispatches an algorithm with the workgroup counts read by
+ * the GPU from a tensor when the dispatch executes, instead of the workgroup
+ * of the algorithm. The tensor holds the X, Y and Z counts as three
+ * consecutive 32 bit unsigned integers, which can be written by earlier
+ * operations of the sequence, such as kp::OpWorkgroupCount.
+ */
+class OpAlgoDispatchIndirect : public OpAlgoDispatch
+{
+  public:
+    /**
+     * Constructor that stores the algorithm to dispatch, the tensor with the
+     * workgroup counts and the relevant push constants to override when
+     * recording.
+     *
+     * @param algorithm The algorithm object to use for dispatch
+     * @param indirectTensor The tensor with the workgroup counts
+     * @param offset The offset in bytes of the workgroup counts in the
+     * tensor, which has to be a multiple of 4
+     * @param pushConstants The push constants to use for override
+     */
+    template<typename T = float>
+    OpAlgoDispatchIndirect(const std::shared_ptr<kp::Algorithm>& algorithm,
+                           const std::shared_ptr<Tensor>& indirectTensor,
+                           uint64_t offset = 0,
+                           const std::vector<T>& pushConstants = {})
+      : OpAlgoDispatch(algorithm, pushConstants)
+    {
+        KP_LOG_DEBUG("Kompute OpAlgoDispatchIndirect constructor");
+
+        if (!indirectTensor) {
+            throw std::runtime_error(
+              "Kompute OpAlgoDispatchIndirect indirect tensor is null");
+        }
+        if (offset % 4 != 0 ||
+            offset + 3 * sizeof(uint32_t) > indirectTensor->memorySize()) {
+            throw std::runtime_error(fmt::format(
+              "Kompute OpAlgoDispatchIndirect offset {} is not aligned to 4 "
+              "bytes or doesn't leave 3 workgroup counts in the {} bytes of "
+              "the indirect tensor",
+              offset,
+              indirectTensor->memorySize()));
+        }
+
+        this->mIndirectTensor = indirectTensor;
+        this->mOffset = offset;
+    }
+
+    /**
+     * Default destructor, which does not destroy the algorithm or the
+     * underlying tensors.
+     */
+    ~OpAlgoDispatchIndirect() override;
+
+    /**
+     * Records the bind commands of the algorithm followed by the indirect
+     * dispatch, which reads the workgroup counts from the primary buffer of
+     * the indirect tensor.
+     *
+     * @param commandBuffer The command buffer to record the command into.
+     */
+    void record(const vk::CommandBuffer& commandBuffer) override;
+
+    /**
+     * Returns the memory objects of the algorithm followed by the indirect
+     * tensor.
+     *
+     * @returns The memory objects used by the operation
+     */
+    std::vector<std::shared_ptr<Memory>> getMemObjects() override;
+
+    /**
+     * Returns the shader accesses to the tensors of the algorithm, and the
+     * indirect command read of the workgroup counts, so the Sequence records
+     * a barrier after the operation that wrote them.
+     *
+     * @returns The tensor accesses of the operation
+     */
+    std::vector<MemoryAccess> getMemoryAccesses() override;
+
+    /**
+     * Returns the name of the operation, followed by the name of its
+     * algorithm if it has one.
+     *
+     * @returns The name of the operation
+     */
+    std::string name() const override;
+
+  private:
+    // -------------- ALWAYS OWNED RESOURCES
+    std::shared_ptr<Tensor> mIndirectTensor;
+    uint64_t mOffset = 0;
+};
+
+} // End namespace kp
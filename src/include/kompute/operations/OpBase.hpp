@@ -19,6 +19,18 @@ namespace kp {
 class OpBase
 {
   public:
+    /**
+     * Access of an operation to a memory object, which the Sequence uses to
+     * record the barriers required between the operations.
+     */
+    struct MemoryAccess
+    {
+        std::shared_ptr<Memory> memory;
+        vk::AccessFlags accessMask;
+        vk::PipelineStageFlags stageMask;
+        bool write;
+    };
+
     /**
      * Default destructor for OpBase class. This OpBase destructor class should
      * always be called to destroy and free owned resources unless it is
@@ -58,6 +70,41 @@ class OpBase
      * @param commandBuffer The command buffer to record the command into.
      */
     virtual void postEval(const vk::CommandBuffer& commandBuffer) = 0;
+
+    /**
+     * Returns the memory objects that the operation reads or writes, which is
+     * used by the Sequence to compute the lifetime of eTransient memory
+     * objects. Operations that don't override it are assumed not to use any
+     * transient memory objects.
+     *
+     * @returns The memory objects used by the operation
+     */
+    virtual std::vector<std::shared_ptr<Memory>> getMemObjects()
+    {
+        return {};
+    }
+
+    /**
+     * Returns the accesses of the operation to the tensors it uses. The
+     * Sequence records the barriers these accesses require against the
+     * previous operations before recording the operation, merged into a
+     * single pipeline barrier, so operations that declare their accesses must
+     * not record barriers for these tensors themselves. Operations that don't
+     * override it, or don't declare any access, may access any memory, so a
+     * full memory barrier orders them against the commands before and after
+     * them.
+     *
+     * @returns The tensor accesses of the operation
+     */
+    virtual std::vector<MemoryAccess> getMemoryAccesses() { return {}; }
+
+    /**
+     * Returns the name of the operation, which labels it in the profiles of
+     * kp::Profiler. Operations that don't override it are named OpBase.
+     *
+     * @returns The name of the operation
+     */
+    virtual std::string name() const { return "OpBase"; }
 };
 
 } // End namespace kp
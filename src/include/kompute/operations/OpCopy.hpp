@@ -55,6 +55,29 @@ class OpCopy : public OpBase
      */
     virtual void postEval(const vk::CommandBuffer& commandBuffer) override;
 
+    /**
+     * Returns the memory objects used by the operation.
+     *
+     * @returns The memory objects used by the operation
+     */
+    std::vector<std::shared_ptr<Memory>> getMemObjects() override;
+
+    /**
+     * Returns the transfer read of the source tensor and the transfer writes
+     * of the destination tensors, as the Sequence records the barriers for
+     * them.
+     *
+     * @returns The tensor accesses of the operation
+     */
+    std::vector<MemoryAccess> getMemoryAccesses() override;
+
+    /**
+     * Returns the name of the operation.
+     *
+     * @returns The name of the operation
+     */
+    std::string name() const override;
+
   private:
     // -------------- ALWAYS OWNED RESOURCES
     std::vector<std::shared_ptr<Memory>> mMemObjects;
@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "kompute/Core.hpp"
+#include "kompute/SequenceFragment.hpp"
+
+#include "kompute/operations/OpBase.hpp"
+
+namespace kp {
+
+/**
+ * Operation that executes the secondary command buffer of a
+ * kp::SequenceFragment, which inserts the operations recorded into the
+ * fragment without recording them again. The sequence the operation is
+ * recorded into has to submit to a queue of the family the fragment was
+ * created for.
+ */
+class OpExecuteFragment : public OpBase
+{
+  public:
+    /**
+     * Constructor that stores the fragment to execute.
+     *
+     * @param fragment The fragment to execute
+     */
+    OpExecuteFragment(std::shared_ptr<SequenceFragment> fragment);
+
+    /**
+     * Default destructor, which doesn't destroy the fragment as it can be
+     * executed by other sequences.
+     */
+    ~OpExecuteFragment() override;
+
+    /**
+     * Records the execution of the secondary command buffer of the fragment,
+     * ending its recording first if it is ongoing.
+     *
+     * @param commandBuffer The command buffer to record the command into.
+     */
+    void record(const vk::CommandBuffer& commandBuffer) override;
+
+    /**
+     * Runs the preEval of the operations of the fragment.
+     *
+     * @param commandBuffer The command buffer to record the command into.
+     */
+    virtual void preEval(const vk::CommandBuffer& commandBuffer) override;
+
+    /**
+     * Runs the postEval of the operations of the fragment.
+     *
+     * @param commandBuffer The command buffer to record the command into.
+     */
+    virtual void postEval(const vk::CommandBuffer& commandBuffer) override;
+
+    /**
+     * Returns the memory objects used by the operations of the fragment.
+     *
+     * @returns The memory objects used by the operation
+     */
+    std::vector<std::shared_ptr<Memory>> getMemObjects() override;
+
+    /**
+     * Returns the accesses of the operations of the fragment, merged per
+     * tensor, so the sequence records the barriers the fragment requires.
+     *
+     * @returns The tensor accesses of the operation
+     */
+    std::vector<MemoryAccess> getMemoryAccesses() override;
+
+    /**
+     * Returns the name of the operation.
+     *
+     * @returns The name of the operation
+     */
+    std::string name() const override;
+
+  private:
+    std::shared_ptr<SequenceFragment> mFragment;
+    // Secondary command buffer recorded into the sequence, which is kept
+    // until the operation is recorded again in case the fragment replaces it
+    std::shared_ptr<vk::CommandBuffer> mFragmentBuffer;
+};
+
+} // End namespace kp
@@ -69,6 +69,20 @@ class OpMemoryBarrier : public OpBase
      */
     virtual void postEval(const vk::CommandBuffer& commandBuffer) override;
 
+    /**
+     * Returns the memory objects used by the operation.
+     *
+     * @returns The memory objects used by the operation
+     */
+    std::vector<std::shared_ptr<Memory>> getMemObjects() override;
+
+    /**
+     * Returns the name of the operation.
+     *
+     * @returns The name of the operation
+     */
+    std::string name() const override;
+
   private:
     const vk::AccessFlagBits mSrcAccessMask;
     const vk::AccessFlagBits mDstAccessMask;
@@ -53,6 +53,13 @@ class OpMult : public OpAlgoDispatch
      * components but does not destroy the underlying tensors
      */
     ~OpMult() override { KP_LOG_DEBUG("Kompute OpMult destructor started"); }
+
+    /**
+     * Returns the name of the operation.
+     *
+     * @returns The name of the operation
+     */
+    std::string name() const override { return "OpMult"; }
 };
 
 } // End namespace kp
@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "kompute/Core.hpp"
+
+#include "kompute/Tensor.hpp"
+
+#include "kompute/operations/OpBase.hpp"
+
+namespace kp {
+
+/**
+ * Operation that resizes tensors to a new number of elements, reusing their
+ * buffers while the size fits in their capacity and otherwise growing the
+ * capacity geometrically into new buffers with a copy of the existing
+ * contents. Algorithms bound to the tensors refresh their descriptors without
+ * rebuilding their pipelines. The tensors are resized when the operation is
+ * recorded, so the operations recorded after it in the sequence use the new
+ * size. Recording the operation again before it has executed, such as into
+ * the other command buffers of a multi-buffered sequence, repeats the same
+ * copy.
+ */
+class OpResize : public OpBase
+{
+  public:
+    /**
+     * Default constructor with parameters that provides the tensors to resize
+     * and their new number of elements. All the memory objects provided have
+     * to be tensors.
+     *
+     * @param memObjects Tensors that will be resized by the operation.
+     * @param elementTotalCount The new number of elements of the tensors.
+     */
+    OpResize(const std::vector<std::shared_ptr<Memory>>& memObjects,
+             uint64_t elementTotalCount);
+
+    /**
+     * Default destructor. This class does not manage memory so it won't be
+     * expecting the parent to perform a release.
+     */
+    ~OpResize() override;
+
+    /**
+     * Resizes the tensors, recording the copy of their contents for the ones
+     * that outgrow their capacity.
+     *
+     * @param commandBuffer The command buffer to record the command into.
+     */
+    void record(const vk::CommandBuffer& commandBuffer) override;
+
+    /**
+     * Does not perform any preEval commands.
+     *
+     * @param commandBuffer The command buffer to record the command into.
+     */
+    virtual void preEval(const vk::CommandBuffer& commandBuffer) override;
+
+    /**
+     * Frees the buffers the tensors were copied from once the copy has
+     * completed.
+     *
+     * @param commandBuffer The command buffer to record the command into.
+     */
+    virtual void postEval(const vk::CommandBuffer& commandBuffer) override;
+
+    /**
+     * Returns the memory objects used by the operation.
+     *
+     * @returns The memory objects used by the operation
+     */
+    std::vector<std::shared_ptr<Memory>> getMemObjects() override;
+
+    /**
+     * Returns the name of the operation.
+     *
+     * @returns The name of the operation
+     */
+    std::string name() const override;
+
+  private:
+    // -------------- ALWAYS OWNED RESOURCES
+    std::vector<std::shared_ptr<Memory>> mMemObjects;
+    uint64_t mElementTotalCount;
+    std::vector<std::shared_ptr<const Tensor::Resize>> mResizes;
+};
+
+} // End namespace kp
@@ -36,14 +36,18 @@ class OpSyncDevice : public OpBase
 
     /**
      * For device memory objects, it records the copy command for the memory
-     * object to copy the data from its staging to device memory.
+     * object to copy the data from its staging to device memory. Tensors that
+     * use the staging ring of the manager only record a barrier, as their data
+     * is uploaded during preEval.
      *
      * @param commandBuffer The command buffer to record the command into.
      */
     void record(const vk::CommandBuffer& commandBuffer) override;
 
     /**
-     * Does not perform any preEval commands.
+     * Flushes host writes to non-coherent staging memory, and uploads the data
+     * of tensors that use the staging ring of the manager before the recorded
+     * commands are submitted.
      *
      * @param commandBuffer The command buffer to record the command into.
      */
@@ -56,9 +60,35 @@ class OpSyncDevice : public OpBase
      */
     virtual void postEval(const vk::CommandBuffer& commandBuffer) override;
 
+    /**
+     * Returns the memory objects used by the operation.
+     *
+     * @returns The memory objects used by the operation
+     */
+    std::vector<std::shared_ptr<Memory>> getMemObjects() override;
+
+    /**
+     * Returns the transfer writes to the eDevice tensors copied from their
+     * staging memory, as the Sequence records the barriers for them.
+     *
+     * @returns The tensor accesses of the operation
+     */
+    std::vector<MemoryAccess> getMemoryAccesses() override;
+
+    /**
+     * Returns the name of the operation.
+     *
+     * @returns The name of the operation
+     */
+    std::string name() const override;
+
   private:
     // -------------- ALWAYS OWNED RESOURCES
     std::vector<std::shared_ptr<Memory>> mMemObjects;
+
+    // Whether the memory object is a tensor that transfers its data through
+    // the staging ring of the manager instead of its own staging buffer
+    static bool usesStagingRing(const std::shared_ptr<Memory>& memory);
 };
 
 } // End namespace kp
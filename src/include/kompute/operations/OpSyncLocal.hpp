@@ -38,7 +38,9 @@ class OpSyncLocal : public OpBase
 
     /**
      * For device memory objects, it records the copy command for the tensor to
-     * copy the data from its device to staging memory.
+     * copy the data from its device to staging memory. Tensors that use the
+     * staging ring of the manager don't record any command, as their data is
+     * downloaded during postEval.
      *
      * @param commandBuffer The command buffer to record the command into.
      */
@@ -53,15 +55,42 @@ class OpSyncLocal : public OpBase
 
     /**
      * For host memory objects it performs the map command from the host memory
-     * into local memory.
+     * into local memory. Tensors that use the staging ring of the manager are
+     * downloaded through the ring once the submission has completed.
      *
      * @param commandBuffer The command buffer to record the command into.
      */
     virtual void postEval(const vk::CommandBuffer& commandBuffer) override;
 
+    /**
+     * Returns the memory objects used by the operation.
+     *
+     * @returns The memory objects used by the operation
+     */
+    std::vector<std::shared_ptr<Memory>> getMemObjects() override;
+
+    /**
+     * Returns the transfer reads of the device tensors and the host reads of
+     * the host tensors.
+     *
+     * @returns The tensor accesses of the operation
+     */
+    std::vector<MemoryAccess> getMemoryAccesses() override;
+
+    /**
+     * Returns the name of the operation.
+     *
+     * @returns The name of the operation
+     */
+    std::string name() const override;
+
   private:
     // -------------- ALWAYS OWNED RESOURCES
     std::vector<std::shared_ptr<Memory>> mMemObjects;
+
+    // Whether the memory object is a tensor that transfers its data through
+    // the staging ring of the manager instead of its own staging buffer
+    static bool usesStagingRing(const std::shared_ptr<Memory>& memory);
 };
 
 } // End namespace kp
@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "kompute/Core.hpp"
+#include "kompute/ParameterBlock.hpp"
+#include "kompute/operations/OpBase.hpp"
+
+namespace kp {
+
+/**
+ * Operation that copies the parameters of a kp::ParameterBlock into its
+ * tensor. The parameters set on the block are written into the slot of the
+ * command buffer during preEval, so a recorded sequence uses the parameters
+ * set before each of its evals without being recorded again.
+ */
+class OpSyncParameters : public OpBase
+{
+  public:
+    /**
+     * Constructor that stores the parameter block to copy.
+     *
+     * @param parameterBlock The parameter block, which has to be created by
+     * the sequence the operation is recorded into
+     */
+    OpSyncParameters(std::shared_ptr<ParameterBlock> parameterBlock);
+
+    /**
+     * Default destructor. This class does not manage memory so it won't be
+     * expecting the parent to perform a release.
+     */
+    ~OpSyncParameters() override;
+
+    /**
+     * Records the copy of the slot of the command buffer into the tensor of
+     * the block.
+     *
+     * @param commandBuffer The command buffer to record the command into.
+     */
+    void record(const vk::CommandBuffer& commandBuffer) override;
+
+    /**
+     * Writes the current parameters of the block into the slot of the command
+     * buffer about to be submitted.
+     *
+     * @param commandBuffer The command buffer to record the command into.
+     */
+    void preEval(const vk::CommandBuffer& commandBuffer) override;
+
+    /**
+     * Does not perform any postEval commands.
+     *
+     * @param commandBuffer The command buffer to record the command into.
+     */
+    void postEval(const vk::CommandBuffer& commandBuffer) override;
+
+    /**
+     * Returns the tensor of the parameter block.
+     *
+     * @returns The memory objects used by the operation
+     */
+    std::vector<std::shared_ptr<Memory>> getMemObjects() override;
+
+    /**
+     * Returns the transfer write to the tensor of the parameter block, as the
+     * Sequence records the barriers for it.
+     *
+     * @returns The tensor accesses of the operation
+     */
+    std::vector<MemoryAccess> getMemoryAccesses() override;
+
+    /**
+     * Returns the name of the operation.
+     *
+     * @returns The name of the operation
+     */
+    std::string name() const override;
+
+  private:
+    // -------------- ALWAYS OWNED RESOURCES
+    std::shared_ptr<ParameterBlock> mParameterBlock;
+};
+
+} // End namespace kp
@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "kompute/Core.hpp"
+
+#include "ShaderWorkgroupCount.hpp"
+
+#include "kompute/Algorithm.hpp"
+#include "kompute/Tensor.hpp"
+
+#include "kompute/operations/OpAlgoDispatch.hpp"
+
+namespace kp {
+
+/**
+ * Operation that turns an element count computed on the GPU into the
+ * workgroup counts of an indirect dispatch, with a built-in shader. It reads
+ * the count from the first element of a 32 bit unsigned integer tensor, and
+ * writes the number of workgroups of groupSize invocations needed to cover
+ * it, followed by 1 and 1, to the first three elements of another, which can
+ * then be used by kp::OpAlgoDispatchIndirect.
+ */
+class OpWorkgroupCount : public OpAlgoDispatch
+{
+  public:
+    /**
+     * Constructor that rebuilds the algorithm provided with the built-in
+     * shader and the tensors provided.
+     *
+     * @param memObjects The tensor with the element count, followed by the
+     * tensor to write the workgroup counts to
+     * @param algorithm An algorithm that will be overridden with the
+     * OpWorkgroupCount shader data and the tensors provided
+     * @param groupSize The number of invocations per workgroup of the
+     * indirect dispatch, usually the local size X of its shader
+     */
+    OpWorkgroupCount(std::vector<std::shared_ptr<Memory>> memObjects,
+                     std::shared_ptr<Algorithm> algorithm,
+                     uint32_t groupSize = 1)
+      : OpAlgoDispatch(algorithm, std::vector<uint32_t>{ groupSize })
+    {
+        KP_LOG_DEBUG("Kompute OpWorkgroupCount constructor with params");
+
+        if (memObjects.size() != 2) {
+            throw std::runtime_error(
+              "Kompute OpWorkgroupCount expected 2 mem objects but got " +
+              std::to_string(memObjects.size()));
+        }
+        if (groupSize == 0) {
+            throw std::runtime_error(
+              "Kompute OpWorkgroupCount group size must not be 0");
+        }
+
+        const std::vector<uint32_t> spirv =
+          std::vector<uint32_t>(SHADERWORKGROUPCOUNT_COMP_SPV.begin(),
+                                SHADERWORKGROUPCOUNT_COMP_SPV.end());
+
+        algorithm->rebuild<float, uint32_t>(
+          memObjects, spirv, Workgroup({ 1, 1, 1 }), {}, { groupSize });
+    }
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithm
+     * components but does not destroy the underlying tensors
+     */
+    ~OpWorkgroupCount() override
+    {
+        KP_LOG_DEBUG("Kompute OpWorkgroupCount destructor started");
+    }
+
+    /**
+     * Returns the name of the operation.
+     *
+     * @returns The name of the operation
+     */
+    std::string name() const override { return "OpWorkgroupCount"; }
+};
+
+} // End namespace kp
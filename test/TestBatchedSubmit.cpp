@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+TEST(TestBatchedSubmit, SubmitSequencesTogether)
+{
+    kp::Manager mgr;
+
+    std::vector<std::shared_ptr<kp::TensorT<float>>> inputs;
+    std::vector<std::shared_ptr<kp::TensorT<float>>> outputs;
+    std::vector<std::shared_ptr<kp::Sequence>> sequences;
+
+    for (uint32_t i = 0; i < 4; i++) {
+        inputs.push_back(mgr.tensor(std::vector<float>(16, i + 1.0f)));
+        outputs.push_back(mgr.tensor(std::vector<float>(16, 0)));
+        sequences.push_back(
+          mgr.sequence()
+            ->record<kp::OpSyncDevice>({ inputs[i] })
+            ->record<kp::OpCopy>({ inputs[i], outputs[i] })
+            ->record<kp::OpSyncLocal>({ outputs[i] }));
+    }
+
+    mgr.submit(sequences);
+
+    for (const std::shared_ptr<kp::Sequence>& sq : sequences) {
+        EXPECT_TRUE(sq->isRunning());
+    }
+
+    mgr.await();
+
+    for (uint32_t i = 0; i < 4; i++) {
+        EXPECT_FALSE(sequences[i]->isRunning());
+        EXPECT_EQ(outputs[i]->vector(), std::vector<float>(16, i + 1.0f));
+    }
+}
+
+TEST(TestBatchedSubmit, SequenceAwaitsBatchedSubmission)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+    std::shared_ptr<kp::TensorT<float>> tensorC = mgr.tensor({ 0, 0, 0 });
+
+    std::shared_ptr<kp::Sequence> sqA =
+      mgr.sequence()
+        ->record<kp::OpSyncDevice>({ tensorA })
+        ->record<kp::OpCopy>({ tensorA, tensorB })
+        ->record<kp::OpSyncLocal>({ tensorB });
+    std::shared_ptr<kp::Sequence> sqB =
+      mgr.sequence()
+        ->record<kp::OpSyncDevice>({ tensorA })
+        ->record<kp::OpCopy>({ tensorA, tensorC })
+        ->record<kp::OpSyncLocal>({ tensorC });
+
+    mgr.submit({ sqA, sqB });
+
+    sqA->evalAwait();
+    EXPECT_FALSE(sqA->isRunning());
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 1, 2, 3 }));
+
+    mgr.await();
+    EXPECT_FALSE(sqB->isRunning());
+    EXPECT_EQ(tensorC->vector(), std::vector<float>({ 1, 2, 3 }));
+
+    // Sequences can be submitted again after being awaited
+    EXPECT_NO_THROW(mgr.submit({ sqA, sqB }));
+    mgr.await();
+}
+
+TEST(TestBatchedSubmit, RunningSequenceCancelsBatch)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+
+    std::shared_ptr<kp::Sequence> sqA =
+      mgr.sequence()->record<kp::OpSyncDevice>({ tensorA });
+    std::shared_ptr<kp::Sequence> sqB =
+      mgr.sequence()->record<kp::OpSyncLocal>({ tensorA });
+
+    sqB->evalAsync();
+
+    // The second sequence is still running, so the first isn't submitted
+    EXPECT_THROW(mgr.submit({ sqA, sqB }), std::runtime_error);
+    EXPECT_FALSE(sqA->isRunning());
+    EXPECT_EQ(sqA->getLastTicket(), 0u);
+
+    sqB->evalAwait();
+    EXPECT_NO_THROW(mgr.submit({ sqA, sqB }));
+    mgr.await();
+}
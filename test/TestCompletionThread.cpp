@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+TEST(TestCompletionThread, FutureRunsPostEval)
+{
+    kp::Manager mgr;
+    mgr.enableCompletionThread();
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence()
+        ->record<kp::OpSyncDevice>({ tensorA, tensorB })
+        ->record<kp::OpCopy>({ tensorA, tensorB })
+        ->record<kp::OpSyncLocal>({ tensorB });
+
+    std::future<void> future = sq->evalAsyncFuture();
+    future.get();
+
+    EXPECT_FALSE(sq->isRunning());
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 1, 2, 3 }));
+}
+
+TEST(TestCompletionThread, CallbacksRunForAllSequences)
+{
+    kp::Manager mgr;
+    mgr.enableCompletionThread();
+
+    std::atomic<uint32_t> completed{ 0 };
+    std::vector<std::shared_ptr<kp::TensorT<float>>> tensors;
+    std::vector<std::future<void>> futures;
+
+    for (uint32_t i = 0; i < 8; i++) {
+        std::shared_ptr<kp::TensorT<float>> tensorA =
+          mgr.tensor({ float(i), float(i), float(i) });
+        std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+        tensors.push_back(tensorB);
+
+        futures.push_back(
+          mgr.sequence()
+            ->record<kp::OpSyncDevice>({ tensorA, tensorB })
+            ->record<kp::OpCopy>({ tensorA, tensorB })
+            ->record<kp::OpSyncLocal>({ tensorB })
+            ->evalAsyncFuture([&completed]() { completed++; }));
+    }
+
+    for (std::future<void>& future : futures) {
+        future.get();
+    }
+
+    EXPECT_EQ(completed.load(), 8);
+    EXPECT_EQ(mgr.getCompletionThread()->pendingCount(), 0);
+    for (uint32_t i = 0; i < tensors.size(); i++) {
+        EXPECT_EQ(tensors[i]->vector(), std::vector<float>(3, float(i)));
+    }
+}
+
+TEST(TestCompletionThread, CallbackExceptionIsReturnedByFuture)
+{
+    kp::Manager mgr;
+    mgr.enableCompletionThread();
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 1, 2, 3 });
+
+    std::future<void> future =
+      mgr.sequence()
+        ->record<kp::OpSyncDevice>({ tensor })
+        ->evalAsyncFuture([]() { throw std::runtime_error("callback"); });
+
+    EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+TEST(TestCompletionThread, RequiresCompletionThread)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 1, 2, 3 });
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence()->record<kp::OpSyncDevice>({ tensor });
+
+    EXPECT_THROW(sq->evalAsyncFuture(), std::runtime_error);
+}
@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+TEST(TestDispatchIndirect, WorkgroupCountRoundsUp)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<uint32_t>> count =
+      mgr.tensorT<uint32_t>({ 10 });
+    std::shared_ptr<kp::TensorT<uint32_t>> groups =
+      mgr.tensorT<uint32_t>({ 0, 0, 0 });
+
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ count, groups })
+      ->record<kp::OpWorkgroupCount>(
+        { count, groups }, mgr.algorithm(), uint32_t(4))
+      ->record<kp::OpSyncLocal>({ groups })
+      ->eval();
+
+    EXPECT_EQ(groups->vector(), std::vector<uint32_t>({ 3, 1, 1 }));
+}
+
+TEST(TestDispatchIndirect, DispatchesElementsCountedOnDevice)
+{
+    kp::Manager mgr;
+
+    std::string filterShader(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) readonly buffer a { float values[]; };
+      layout(set = 0, binding = 1) buffer b { float selected[]; };
+      layout(set = 0, binding = 2) buffer c { uint count[]; };
+      void main() {
+          uint index = gl_GlobalInvocationID.x;
+          if (values[index] > 2) {
+              selected[atomicAdd(count[0], 1)] = values[index];
+          }
+      })");
+
+    std::string doubleShader(R"(
+      #version 450
+      layout (local_size_x = 4) in;
+      layout(set = 0, binding = 0) buffer a { float selected[]; };
+      layout(set = 0, binding = 1) readonly buffer b { uint count[]; };
+      void main() {
+          uint index = gl_GlobalInvocationID.x;
+          if (index < count[0]) {
+              selected[index] = selected[index] * 2;
+          }
+      })");
+
+    std::shared_ptr<kp::TensorT<float>> values =
+      mgr.tensor({ 1, 5, 2, 3, 7, 4, 0, 6, 9, 1 });
+    std::shared_ptr<kp::TensorT<float>> selected =
+      mgr.tensor(std::vector<float>(10, 0));
+    std::shared_ptr<kp::TensorT<uint32_t>> count = mgr.tensorT<uint32_t>({ 0 });
+    std::shared_ptr<kp::TensorT<uint32_t>> groups =
+      mgr.tensorT<uint32_t>({ 0, 0, 0 });
+
+    std::shared_ptr<kp::Algorithm> filter = mgr.algorithm(
+      { values, selected, count }, compileSource(filterShader));
+    std::shared_ptr<kp::Algorithm> doubled =
+      mgr.algorithm({ selected, count }, compileSource(doubleShader));
+
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ values, selected, count, groups })
+      ->record<kp::OpAlgoDispatch>(filter)
+      ->record<kp::OpWorkgroupCount>(
+        { count, groups }, mgr.algorithm(), uint32_t(4))
+      ->record<kp::OpAlgoDispatchIndirect>(doubled, groups)
+      ->record<kp::OpSyncLocal>({ selected, count, groups })
+      ->eval();
+
+    EXPECT_EQ(count->vector(), std::vector<uint32_t>({ 6 }));
+    EXPECT_EQ(groups->vector(), std::vector<uint32_t>({ 2, 1, 1 }));
+
+    // The order of the selected values depends on the atomics
+    std::vector<float> result = selected->vector();
+    std::sort(result.begin(), result.begin() + 6);
+    EXPECT_EQ(result,
+              std::vector<float>({ 6, 8, 10, 12, 14, 18, 0, 0, 0, 0 }));
+}
+
+TEST(TestDispatchIndirect, InvalidOffsetThrows)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<uint32_t>> groups =
+      mgr.tensorT<uint32_t>({ 1, 1, 1, 1 });
+    std::shared_ptr<kp::Algorithm> algorithm = mgr.algorithm();
+
+    EXPECT_NO_THROW(kp::OpAlgoDispatchIndirect(algorithm, groups, 4));
+    EXPECT_THROW(kp::OpAlgoDispatchIndirect(algorithm, groups, 2),
+                 std::runtime_error);
+    EXPECT_THROW(kp::OpAlgoDispatchIndirect(algorithm, groups, 8),
+                 std::runtime_error);
+}
+
+TEST(TestDispatchIndirect, SlicedIndirectTensorReadsItsOwnElements)
+{
+    kp::Manager mgr;
+
+    std::string shader(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) buffer a { uint dispatched[]; };
+      void main() {
+          dispatched[gl_WorkGroupID.x] = 1;
+      })");
+
+    std::shared_ptr<kp::TensorT<uint32_t>> dispatched =
+      mgr.tensorT<uint32_t>({ 0, 0, 0, 0, 0, 0 });
+    std::shared_ptr<kp::TensorT<uint32_t>> counts =
+      mgr.tensorT<uint32_t>({ 6, 1, 1, 2, 1, 1 });
+    std::shared_ptr<kp::TensorT<uint32_t>> groups = counts->slice(3, 3);
+
+    std::shared_ptr<kp::Algorithm> algorithm =
+      mgr.algorithm({ dispatched }, compileSource(shader));
+
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ dispatched, counts })
+      ->record<kp::OpAlgoDispatchIndirect>(algorithm, groups)
+      ->record<kp::OpSyncLocal>({ dispatched })
+      ->eval();
+
+    EXPECT_EQ(dispatched->vector(),
+              std::vector<uint32_t>({ 1, 1, 0, 0, 0, 0 }));
+}
@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+// Operation that fills the buffer of a tensor with ones without declaring
+// its accesses
+class OpFillUndeclared : public kp::OpBase
+{
+  public:
+    OpFillUndeclared(std::shared_ptr<kp::Tensor> tensor)
+      : mTensor(tensor)
+    {
+    }
+
+    void record(const vk::CommandBuffer& commandBuffer) override
+    {
+        // Bit pattern of the float 1.0
+        commandBuffer.fillBuffer(
+          *this->mTensor->getPrimaryBuffer(), 0, VK_WHOLE_SIZE, 0x3f800000);
+    }
+
+    void preEval(const vk::CommandBuffer& /*commandBuffer*/) override {}
+
+    void postEval(const vk::CommandBuffer& /*commandBuffer*/) override {}
+
+  private:
+    std::shared_ptr<kp::Tensor> mTensor;
+};
+
+static const std::string readOnlyShader(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) readonly buffer a { float pa[]; };
+      layout(set = 0, binding = 1) buffer b { float pb[]; };
+      void main() {
+          uint index = gl_GlobalInvocationID.x;
+          pb[index] = pa[index] * 2;
+      })");
+
+TEST(TestHazardTracking, ElidesBarriersBetweenReads)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+    std::shared_ptr<kp::TensorT<float>> tensorC = mgr.tensor({ 0, 0, 0 });
+
+    std::vector<uint32_t> spirv = compileSource(readOnlyShader);
+    std::shared_ptr<kp::Algorithm> algorithmB =
+      mgr.algorithm({ tensorA, tensorB }, spirv);
+    std::shared_ptr<kp::Algorithm> algorithmC =
+      mgr.algorithm({ tensorA, tensorC }, spirv);
+
+    EXPECT_TRUE(algorithmB->isReadOnly(0));
+    EXPECT_FALSE(algorithmB->isReadOnly(1));
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence()
+        ->record<kp::OpSyncDevice>({ tensorA })
+        ->record<kp::OpAlgoDispatch>(algorithmB)
+        ->record<kp::OpAlgoDispatch>(algorithmC);
+
+    // The second dispatch only needs a barrier for C, as the copy into A is
+    // already visible to the compute shaders
+    kp::Sequence::BarrierStats stats = sq->getBarrierStats();
+    EXPECT_EQ(stats.trackedAccesses, 5u);
+    EXPECT_EQ(stats.requiredBarriers, 4u);
+    EXPECT_EQ(stats.elidedBarriers, 1u);
+    EXPECT_EQ(stats.pipelineBarriers, 3u);
+
+    sq->record<kp::OpSyncLocal>({ tensorB, tensorC })->eval();
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 2, 4, 6 }));
+    EXPECT_EQ(tensorC->vector(), std::vector<float>({ 2, 4, 6 }));
+}
+
+TEST(TestHazardTracking, WritesWaitForPreviousAccesses)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+    std::shared_ptr<kp::TensorT<float>> tensorC = mgr.tensor({ 5, 5, 5 });
+
+    std::shared_ptr<kp::Algorithm> algorithm =
+      mgr.algorithm({ tensorA, tensorB }, compileSource(readOnlyShader));
+
+    // Overwriting A after the dispatch reads it, and reading B after the
+    // dispatch writes it, both require a barrier
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ tensorA, tensorC })
+      ->record<kp::OpAlgoDispatch>(algorithm)
+      ->record<kp::OpCopy>({ tensorC, tensorA })
+      ->record<kp::OpAlgoDispatch>(algorithm)
+      ->record<kp::OpSyncLocal>({ tensorA, tensorB })
+      ->eval();
+
+    EXPECT_EQ(tensorA->vector(), std::vector<float>({ 5, 5, 5 }));
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 10, 10, 10 }));
+}
+
+TEST(TestHazardTracking, UndeclaredWriterFollowedByDispatch)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 0, 0, 0 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+
+    std::shared_ptr<kp::Algorithm> algorithm =
+      mgr.algorithm({ tensorA, tensorB }, compileSource(readOnlyShader));
+
+    // The fill doesn't declare any access, so it's ordered against the
+    // commands before it and the dispatch against the fill
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence()
+        ->record<OpFillUndeclared>(tensorA)
+        ->record<kp::OpAlgoDispatch>(algorithm)
+        ->record<kp::OpSyncLocal>({ tensorB });
+
+    EXPECT_EQ(sq->getBarrierStats().fullBarriers, 2u);
+
+    sq->eval();
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 2, 2, 2 }));
+}
@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+TEST(TestMemoryPool, TensorsShareDeviceMemoryBlocks)
+{
+    kp::Manager mgr;
+    std::shared_ptr<kp::MemoryPool> pool = mgr.enableMemoryPool();
+
+    EXPECT_TRUE(pool->isInit());
+    EXPECT_EQ(pool, mgr.getMemoryPool());
+
+    std::vector<std::shared_ptr<kp::TensorT<float>>> tensors;
+    for (uint32_t i = 0; i < 64; i++) {
+        tensors.push_back(mgr.tensor(std::vector<float>(16, i)));
+    }
+
+    kp::MemoryPool::Stats stats = pool->stats();
+
+    // Each tensor has a device and a staging buffer
+    EXPECT_EQ(stats.allocationCount, 128u);
+    EXPECT_EQ(stats.totalAllocations, 128u);
+    EXPECT_EQ(stats.dedicatedCount, 0u);
+    EXPECT_LT(stats.deviceAllocateCalls, 8u);
+}
+
+TEST(TestMemoryPool, PooledTensorsRoundTripData)
+{
+    kp::Manager mgr;
+    mgr.enableMemoryPool();
+
+    std::vector<float> testVecA{ 1, 2, 3 };
+    std::vector<float> testVecB{ 0, 0, 0 };
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor(testVecA);
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor(testVecB);
+    std::shared_ptr<kp::TensorT<float>> tensorC =
+      mgr.tensor(testVecB, kp::Memory::MemoryTypes::eHost);
+
+    mgr.sequence()
+      ->eval<kp::OpSyncDevice>({ tensorA, tensorB })
+      ->eval<kp::OpCopy>({ tensorA, tensorB, tensorC })
+      ->eval<kp::OpSyncLocal>({ tensorB, tensorC });
+
+    EXPECT_EQ(testVecA, tensorB->vector());
+    EXPECT_EQ(testVecA, tensorC->vector());
+}
+
+TEST(TestMemoryPool, DestroyedTensorsReturnRangesToPool)
+{
+    kp::Manager mgr;
+    std::shared_ptr<kp::MemoryPool> pool = mgr.enableMemoryPool();
+
+    {
+        std::shared_ptr<kp::TensorT<float>> tensorA =
+          mgr.tensor(std::vector<float>(256, 1));
+        std::shared_ptr<kp::TensorT<float>> tensorB =
+          mgr.tensor(std::vector<float>(256, 2));
+        EXPECT_EQ(pool->stats().allocationCount, 4u);
+    }
+
+    EXPECT_EQ(pool->stats().allocationCount, 0u);
+    EXPECT_EQ(pool->stats().totalFrees, 4u);
+
+    uint64_t deviceAllocateCalls = pool->stats().deviceAllocateCalls;
+
+    std::shared_ptr<kp::TensorT<float>> tensorC =
+      mgr.tensor(std::vector<float>(256, 3));
+
+    EXPECT_EQ(pool->stats().reusedAllocations, 2u);
+    EXPECT_EQ(pool->stats().deviceAllocateCalls, deviceAllocateCalls);
+
+    mgr.sequence()
+      ->eval<kp::OpSyncDevice>({ tensorC })
+      ->eval<kp::OpSyncLocal>({ tensorC });
+
+    EXPECT_EQ(tensorC->vector(), std::vector<float>(256, 3));
+
+    tensorC->destroy();
+    pool->trim();
+
+    EXPECT_EQ(pool->stats().blockCount, 0u);
+    EXPECT_EQ(pool->stats().blockBytes, 0u);
+}
+
+TEST(TestMemoryPool, LargeTensorsUseDedicatedAllocations)
+{
+    kp::Manager mgr;
+    std::shared_ptr<kp::MemoryPool> pool = mgr.enableMemoryPool(64 * 1024);
+
+    std::shared_ptr<kp::TensorT<float>> tensor =
+      mgr.tensor(std::vector<float>(64 * 1024, 1));
+
+    EXPECT_EQ(pool->stats().dedicatedCount, 2u);
+    EXPECT_EQ(pool->stats().blockCount, 0u);
+
+    mgr.sequence()
+      ->eval<kp::OpSyncDevice>({ tensor })
+      ->eval<kp::OpSyncLocal>({ tensor });
+
+    EXPECT_EQ(tensor->vector(), std::vector<float>(64 * 1024, 1));
+
+    tensor->destroy();
+
+    EXPECT_EQ(pool->stats().dedicatedCount, 0u);
+    EXPECT_EQ(pool->stats().dedicatedBytes, 0u);
+}
+
+TEST(TestMemoryPool, PooledImagesRoundTripData)
+{
+    kp::Manager mgr;
+    std::shared_ptr<kp::MemoryPool> pool = mgr.enableMemoryPool();
+
+    std::vector<float> testVecA{ 1, 2, 3 };
+    std::vector<float> testVecB{ 0, 0, 0 };
+
+    std::shared_ptr<kp::ImageT<float>> imageA = mgr.image(testVecA, 3, 1, 1);
+    std::shared_ptr<kp::ImageT<float>> imageB = mgr.image(testVecB, 3, 1, 1);
+
+    EXPECT_EQ(pool->stats().allocationCount, 4u);
+
+    mgr.sequence()
+      ->eval<kp::OpSyncDevice>({ imageA, imageB })
+      ->eval<kp::OpCopy>({ imageA, imageB })
+      ->eval<kp::OpSyncLocal>({ imageA, imageB });
+
+    EXPECT_EQ(testVecA, imageB->vector());
+}
+
+TEST(TestMemoryPool, EnableMemoryPoolTwiceReturnsSamePool)
+{
+    kp::Manager mgr;
+    std::shared_ptr<kp::MemoryPool> pool = mgr.enableMemoryPool();
+
+    EXPECT_EQ(pool, mgr.enableMemoryPool());
+}
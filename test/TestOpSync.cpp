@@ -121,3 +121,51 @@ TEST(TestOpSync, NegativeUnrelatedImageSync)
     // Making sure the GPU holds the same vector
     EXPECT_NE(ImageIn->vector(), ImageOut->vector());
 }
+
+TEST(TestOpSync, SyncWithReadbackStagingPolicy)
+{
+    kp::Manager mgr;
+
+    EXPECT_EQ(mgr.getStagingPolicy(), kp::Memory::StagingPolicy::eUpload);
+
+    std::vector<float> testVec{ 9, 8, 7 };
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 0, 0, 0 });
+
+    mgr.setStagingPolicy(kp::Memory::StagingPolicy::eReadback);
+
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+    std::shared_ptr<kp::ImageT<float>> imageC = mgr.image({ 0, 0, 0 }, 3, 1, 1);
+
+    EXPECT_EQ(tensorA->stagingPolicy(), kp::Memory::StagingPolicy::eUpload);
+    EXPECT_EQ(tensorB->stagingPolicy(), kp::Memory::StagingPolicy::eReadback);
+    EXPECT_EQ(imageC->stagingPolicy(), kp::Memory::StagingPolicy::eReadback);
+
+    // Readback staging falls back to uncached memory when it is unavailable
+    // but is always host visible
+    EXPECT_TRUE(tensorB->hostMemoryPropertyFlags() &
+                vk::MemoryPropertyFlagBits::eHostVisible);
+    EXPECT_TRUE(imageC->hostMemoryPropertyFlags() &
+                vk::MemoryPropertyFlagBits::eHostVisible);
+
+    tensorA->setData(testVec);
+
+    mgr.sequence()
+      ->eval<kp::OpSyncDevice>({ tensorA })
+      ->eval<kp::OpCopy>({ tensorA, tensorB })
+      ->eval<kp::OpCopy>({ tensorA, imageC })
+      ->eval<kp::OpSyncLocal>({ tensorB, imageC });
+
+    EXPECT_EQ(tensorB->vector(), testVec);
+    EXPECT_EQ(imageC->vector(), testVec);
+
+    // Writes to readback staging memory are still synced to the device
+    tensorB->setData(std::vector<float>{ 1, 2, 3 });
+
+    mgr.sequence()
+      ->eval<kp::OpSyncDevice>({ tensorB })
+      ->eval<kp::OpCopy>({ tensorB, tensorA })
+      ->eval<kp::OpSyncLocal>({ tensorA });
+
+    EXPECT_EQ(tensorA->vector(), std::vector<float>({ 1, 2, 3 }));
+}
@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+static const std::string accumulateShader(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) buffer a { float pa[]; };
+      layout(push_constant) uniform PushConstants { float value; } pc;
+      void main() {
+          uint index = gl_GlobalInvocationID.x;
+          pa[index] = pa[index] * 2 + pc.value;
+      })");
+
+TEST(TestParallelRecording, MatchesSequentialRecording)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 0, 0, 0 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+
+    std::vector<uint32_t> spirv = compileSource(accumulateShader);
+    std::shared_ptr<kp::Algorithm> algorithmA =
+      mgr.algorithm({ tensorA }, spirv, {}, {}, { 0.0f });
+    std::shared_ptr<kp::Algorithm> algorithmB =
+      mgr.algorithm({ tensorB }, spirv, {}, {}, { 0.0f });
+
+    // The result depends on the order of the dispatches
+    std::vector<std::shared_ptr<kp::OpBase>> opsA;
+    std::vector<std::shared_ptr<kp::OpBase>> opsB;
+    for (uint32_t i = 0; i < 20; i++) {
+        float value = i % 2;
+        opsA.push_back(std::make_shared<kp::OpAlgoDispatch>(
+          algorithmA, std::vector<float>{ value }));
+        opsB.push_back(std::make_shared<kp::OpAlgoDispatch>(
+          algorithmB, std::vector<float>{ value }));
+    }
+
+    std::shared_ptr<kp::Sequence> sqA =
+      mgr.sequence()->record<kp::OpSyncDevice>({ tensorA });
+    for (const std::shared_ptr<kp::OpBase>& op : opsA) {
+        sqA->record(op);
+    }
+    sqA->record<kp::OpSyncLocal>({ tensorA })->eval();
+
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ tensorB })
+      ->recordParallel(opsB, 3)
+      ->record<kp::OpSyncLocal>({ tensorB })
+      ->eval();
+
+    EXPECT_EQ(tensorA->vector(), std::vector<float>(3, 349525));
+    EXPECT_EQ(tensorB->vector(), tensorA->vector());
+}
+
+TEST(TestParallelRecording, MoreThreadsThanOperations)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ tensorA })
+      ->recordParallel({ std::make_shared<kp::OpCopy>(
+                           std::vector<std::shared_ptr<kp::Memory>>{
+                             tensorA, tensorB }) },
+                       8)
+      ->record<kp::OpSyncLocal>({ tensorB })
+      ->eval();
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 1, 2, 3 }));
+}
+
+TEST(TestParallelRecording, ResizeThrows)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+
+    std::vector<std::shared_ptr<kp::OpBase>> ops{
+        std::make_shared<kp::OpResize>(
+          std::vector<std::shared_ptr<kp::Memory>>{ tensorA }, 6)
+    };
+
+    EXPECT_THROW(mgr.sequence()->recordParallel(ops, 2), std::runtime_error);
+    EXPECT_EQ(tensorA->size(), 3u);
+}
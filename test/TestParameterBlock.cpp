@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+TEST(TestParameterBlock, EvalsUseParametersSetSinceRecording)
+{
+    kp::Manager mgr;
+
+    std::string shader(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) readonly buffer a { float pa[]; };
+      layout(set = 0, binding = 1) buffer b { float pb[]; };
+      layout(set = 0, binding = 2) readonly buffer c { float scale; };
+      void main() {
+          uint index = gl_GlobalInvocationID.x;
+          pb[index] = pa[index] * scale;
+      })");
+
+    std::shared_ptr<kp::TensorT<float>> tensorIn = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorOut = mgr.tensor({ 0, 0, 0 });
+    std::shared_ptr<kp::TensorT<float>> parameters = mgr.tensor({ 2 });
+
+    std::shared_ptr<kp::Algorithm> algorithm = mgr.algorithm(
+      { tensorIn, tensorOut, parameters }, compileSource(shader));
+
+    std::shared_ptr<kp::Sequence> sq = mgr.sequence();
+    std::shared_ptr<kp::ParameterBlock> block = sq->parameterBlock(parameters);
+    EXPECT_EQ(block->size(), sizeof(float));
+
+    sq->record<kp::OpSyncDevice>({ tensorIn })
+      ->record(block)
+      ->record<kp::OpAlgoDispatch>(algorithm)
+      ->record<kp::OpSyncLocal>({ tensorOut });
+
+    // Starts with the data of the tensor
+    sq->eval();
+    EXPECT_EQ(tensorOut->vector(), std::vector<float>({ 2, 4, 6 }));
+
+    block->setData(std::vector<float>{ 3 });
+    sq->eval();
+    EXPECT_EQ(tensorOut->vector(), std::vector<float>({ 3, 6, 9 }));
+
+    block->setData(std::vector<float>{ -1 });
+    sq->eval();
+    EXPECT_EQ(tensorOut->vector(), std::vector<float>({ -1, -2, -3 }));
+}
+
+TEST(TestParameterBlock, SubmissionsInFlightKeepTheirParameters)
+{
+    kp::Manager mgr;
+
+    std::string shader(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) buffer a { uint total; };
+      layout(set = 0, binding = 1) readonly buffer b { uint increment; };
+      void main() {
+          atomicAdd(total, increment);
+      })");
+
+    std::shared_ptr<kp::TensorT<uint32_t>> total = mgr.tensorT<uint32_t>({ 0 });
+    std::shared_ptr<kp::TensorT<uint32_t>> increment =
+      mgr.tensorT<uint32_t>({ 0 });
+
+    std::shared_ptr<kp::Algorithm> algorithm =
+      mgr.algorithm({ total, increment }, compileSource(shader));
+
+    mgr.sequence()->eval<kp::OpSyncDevice>({ total });
+
+    std::shared_ptr<kp::Sequence> sq = mgr.sequence(0, 0, 3);
+    std::shared_ptr<kp::ParameterBlock> block = sq->parameterBlock(increment);
+    sq->record(block)->record<kp::OpAlgoDispatch>(algorithm);
+
+    for (uint32_t value : { 1, 10, 100 }) {
+        block->setData(std::vector<uint32_t>{ value });
+        sq->evalAsync();
+    }
+    sq->evalAwait();
+
+    mgr.sequence()->eval<kp::OpSyncLocal>({ total });
+    EXPECT_EQ(total->vector(), std::vector<uint32_t>({ 111 }));
+}
+
+TEST(TestParameterBlock, OtherSequenceThrows)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> parameters = mgr.tensor({ 1 });
+    std::shared_ptr<kp::ParameterBlock> block =
+      mgr.sequence()->parameterBlock(parameters);
+
+    EXPECT_THROW(mgr.sequence()->record(block), std::runtime_error);
+    EXPECT_THROW(block->setData(std::vector<float>{ 1, 2 }),
+                 std::runtime_error);
+}
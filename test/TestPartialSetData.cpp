@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+TEST(TestPartialSetData, SetElementRangeOfHostTensor)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA =
+      mgr.tensor({ 0, 0, 0, 0 }, kp::Memory::MemoryTypes::eHost);
+    std::shared_ptr<kp::TensorT<float>> tensorB =
+      mgr.tensor({ 0, 0, 0, 0 }, kp::Memory::MemoryTypes::eHost);
+
+    tensorA->setData(std::vector<float>{ 5, 6 }, 1);
+
+    EXPECT_EQ(tensorA->vector(), std::vector<float>({ 0, 5, 6, 0 }));
+
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ tensorA })
+      ->record<kp::OpCopy>({ tensorA, tensorB })
+      ->record<kp::OpSyncLocal>({ tensorB })
+      ->eval();
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 0, 5, 6, 0 }));
+}
+
+TEST(TestPartialSetData, RepeatedUpdatesOfDeviceTensor)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA =
+      mgr.tensor(std::vector<float>(1024, 1));
+    std::shared_ptr<kp::TensorT<float>> tensorB =
+      mgr.tensor(std::vector<float>(1024, 0));
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence()
+        ->record<kp::OpSyncDevice>({ tensorA })
+        ->record<kp::OpCopy>({ tensorA, tensorB })
+        ->record<kp::OpSyncLocal>({ tensorB });
+
+    std::vector<float> expected(1024, 1);
+    for (uint32_t i = 0; i < 4; i++) {
+        tensorA->setData(std::vector<float>{ 2.0f + i }, i * 100);
+        tensorA->setData(std::vector<float>{ 3.0f + i }, 1023 - i);
+        expected[i * 100] = 2.0f + i;
+        expected[1023 - i] = 3.0f + i;
+
+        sq->eval();
+
+        EXPECT_EQ(tensorB->vector(), expected);
+    }
+}
+
+TEST(TestPartialSetData, BytesRangeOutOfBoundsThrows)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 0, 0, 0 });
+
+    std::vector<float> data{ 1, 2 };
+    EXPECT_THROW(tensor->setData(data.data(), 2 * sizeof(float), 8),
+                 std::runtime_error);
+    EXPECT_THROW(tensor->setData(data, 2), std::runtime_error);
+    EXPECT_NO_THROW(tensor->setData(data, 1));
+}
+
+TEST(TestPartialSetData, WritesThroughViewAreSynced)
+{
+    kp::Manager mgr;
+    mgr.setStagingPolicy(kp::Memory::StagingPolicy::eReadback);
+
+    std::shared_ptr<kp::TensorT<float>> tensorA =
+      mgr.tensor({ 0, 0, 0, 0, 0, 0 });
+    std::shared_ptr<kp::TensorT<float>> tensorB =
+      mgr.tensor({ 0, 0, 0, 0, 0, 0 });
+
+    tensorA->slice(2, 3)->setData(std::vector<float>{ 7, 8 }, 1);
+
+    mgr.sequence()
+      ->eval<kp::OpSyncDevice>({ tensorA })
+      ->eval<kp::OpCopy>({ tensorA, tensorB })
+      ->eval<kp::OpSyncLocal>({ tensorB->slice(3, 2) });
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 0, 0, 0, 7, 8, 0 }));
+}
+
+TEST(TestPartialSetData, ReadingViewKeepsPendingWritesOutsideIt)
+{
+    kp::Manager mgr;
+    mgr.setStagingPolicy(kp::Memory::StagingPolicy::eReadback);
+
+    std::shared_ptr<kp::TensorT<float>> tensorA =
+      mgr.tensor({ 1, 2, 3, 4, 5, 6 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+
+    mgr.sequence()->eval<kp::OpSyncDevice>({ tensorA, tensorB });
+
+    // Written but not synced yet when the view of the same tensor is read
+    tensorA->setData(std::vector<float>{ 9 }, 0);
+
+    mgr.sequence()
+      ->eval<kp::OpCopy>({ tensorB, tensorA->slice(3, 3) })
+      ->eval<kp::OpSyncLocal>({ tensorA->slice(3, 3) })
+      ->eval<kp::OpSyncDevice>({ tensorA->slice(0, 3) })
+      ->eval<kp::OpSyncLocal>({ tensorA });
+
+    EXPECT_EQ(tensorA->vector(), std::vector<float>({ 9, 2, 3, 0, 0, 0 }));
+}
+
+TEST(TestPartialSetData, CopyKeepsTrackingWritesOfSource)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3, 4 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0, 0 });
+
+    mgr.sequence()
+      ->eval<kp::OpSyncDevice>({ tensorA, tensorB })
+      ->eval<kp::OpCopy>({ tensorA, tensorB });
+
+    // The copy only reads the host data of the source
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 1, 2, 3, 4 }));
+    EXPECT_TRUE(tensorA->isTrackingHostWrites());
+
+    tensorA->setData(std::vector<float>{ 9 }, 2);
+
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ tensorA })
+      ->record<kp::OpCopy>({ tensorA, tensorB })
+      ->record<kp::OpSyncLocal>({ tensorB })
+      ->eval();
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 1, 2, 9, 4 }));
+    EXPECT_TRUE(tensorA->isTrackingHostWrites());
+}
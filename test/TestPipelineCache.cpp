@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+static const std::string shader(R"(
+  #version 450
+  layout (local_size_x = 1) in;
+  layout(set = 0, binding = 0) buffer a { float pa[]; };
+  void main() {
+      uint index = gl_GlobalInvocationID.x;
+      pa[index] = pa[index] * 2.0;
+  })");
+
+static std::vector<float>
+runAlgorithm(kp::Manager& mgr, const std::vector<uint32_t>& spirv)
+{
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::Algorithm> algorithm = mgr.algorithm({ tensor }, spirv);
+
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ tensor })
+      ->record<kp::OpAlgoDispatch>(algorithm)
+      ->record<kp::OpSyncLocal>({ tensor })
+      ->eval();
+
+    return tensor->vector();
+}
+
+TEST(TestPipelineCache, SavedCacheLoadsIntoAnotherManager)
+{
+    std::string path = "kompute_test_pipeline_cache.bin";
+    std::vector<uint32_t> spirv = compileSource(shader);
+
+    {
+        kp::Manager mgr;
+        EXPECT_NE(mgr.getPipelineCache(), nullptr);
+        EXPECT_EQ(runAlgorithm(mgr, spirv), std::vector<float>({ 2, 4, 6 }));
+        mgr.savePipelineCache(path);
+    }
+
+    {
+        kp::Manager mgr;
+        EXPECT_TRUE(mgr.loadPipelineCache(path));
+        EXPECT_EQ(runAlgorithm(mgr, spirv), std::vector<float>({ 2, 4, 6 }));
+
+        // Loading again merges the same data into the shared cache
+        EXPECT_TRUE(mgr.loadPipelineCache(path));
+        EXPECT_EQ(runAlgorithm(mgr, spirv), std::vector<float>({ 2, 4, 6 }));
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST(TestPipelineCache, MissingFileIsIgnored)
+{
+    kp::Manager mgr;
+    EXPECT_FALSE(mgr.loadPipelineCache("kompute_test_missing_cache.bin"));
+}
+
+TEST(TestPipelineCache, CacheOfAnotherDeviceIsIgnored)
+{
+    std::string path = "kompute_test_pipeline_cache_other.bin";
+
+    kp::Manager mgr;
+    mgr.savePipelineCache(path);
+
+    std::vector<char> data;
+    {
+        std::ifstream file(path, std::ios::binary);
+        data.assign(std::istreambuf_iterator<char>(file),
+                    std::istreambuf_iterator<char>());
+    }
+    ASSERT_GE(data.size(), 32u);
+
+    // Flips the first byte of the pipeline cache UUID of the header
+    data[16] = static_cast<char>(~data[16]);
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(data.data(), data.size());
+    }
+    EXPECT_FALSE(mgr.loadPipelineCache(path));
+
+    // Truncated headers are ignored as well
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(data.data(), 8);
+    }
+    EXPECT_FALSE(mgr.loadPipelineCache(path));
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+static const std::string shader(R"(
+  #version 450
+  layout (local_size_x = 1) in;
+  layout (constant_id = 0) const float scale = 2.0;
+  layout(set = 0, binding = 0) buffer a { float pa[]; };
+  void main() {
+      uint index = gl_GlobalInvocationID.x;
+      pa[index] = pa[index] * scale;
+  })");
+
+TEST(TestPipelineRegistry, IdenticalAlgorithmsSharePipeline)
+{
+    kp::Manager mgr;
+    std::shared_ptr<kp::PipelineRegistry> registry = mgr.getPipelineRegistry();
+    std::vector<uint32_t> spirv = compileSource(shader);
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 4, 5, 6 });
+
+    std::shared_ptr<kp::Algorithm> algorithmA =
+      mgr.algorithm({ tensorA }, spirv);
+    std::shared_ptr<kp::Algorithm> algorithmB =
+      mgr.algorithm({ tensorB }, spirv);
+
+    kp::PipelineRegistry::Stats stats = registry->stats();
+    EXPECT_EQ(stats.shaderModuleCount, 1u);
+    EXPECT_EQ(stats.pipelineCount, 1u);
+    EXPECT_EQ(stats.shaderModulesCreated, 1u);
+    EXPECT_EQ(stats.pipelinesCreated, 1u);
+    EXPECT_EQ(stats.shaderModuleHits, 1u);
+    EXPECT_EQ(stats.pipelineHits, 1u);
+
+    // Each algorithm still binds its own tensors
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ tensorA, tensorB })
+      ->record<kp::OpAlgoDispatch>(algorithmA)
+      ->record<kp::OpAlgoDispatch>(algorithmB)
+      ->record<kp::OpSyncLocal>({ tensorA, tensorB })
+      ->eval();
+
+    EXPECT_EQ(tensorA->vector(), std::vector<float>({ 2, 4, 6 }));
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 8, 10, 12 }));
+}
+
+TEST(TestPipelineRegistry, SpecializationConstantsSeparatePipelines)
+{
+    kp::Manager mgr;
+    std::shared_ptr<kp::PipelineRegistry> registry = mgr.getPipelineRegistry();
+    std::vector<uint32_t> spirv = compileSource(shader);
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 1, 2, 3 });
+
+    std::shared_ptr<kp::Algorithm> algorithmA =
+      mgr.algorithm({ tensorA }, spirv, {}, { 3.0f });
+    std::shared_ptr<kp::Algorithm> algorithmB =
+      mgr.algorithm({ tensorB }, spirv, {}, { 4.0f });
+
+    kp::PipelineRegistry::Stats stats = registry->stats();
+    EXPECT_EQ(stats.shaderModuleCount, 1u);
+    EXPECT_EQ(stats.pipelineCount, 2u);
+
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ tensorA, tensorB })
+      ->record<kp::OpAlgoDispatch>(algorithmA)
+      ->record<kp::OpAlgoDispatch>(algorithmB)
+      ->record<kp::OpSyncLocal>({ tensorA, tensorB })
+      ->eval();
+
+    EXPECT_EQ(tensorA->vector(), std::vector<float>({ 3, 6, 9 }));
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 4, 8, 12 }));
+}
+
+TEST(TestPipelineRegistry, PipelinesReleasedWithLastAlgorithm)
+{
+    kp::Manager mgr;
+    std::shared_ptr<kp::PipelineRegistry> registry = mgr.getPipelineRegistry();
+    std::vector<uint32_t> spirv = compileSource(shader);
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 1, 2, 3 });
+
+    std::shared_ptr<kp::Algorithm> algorithmA =
+      mgr.algorithm({ tensor }, spirv);
+    std::shared_ptr<kp::Algorithm> algorithmB =
+      mgr.algorithm({ tensor }, spirv);
+
+    algorithmA = nullptr;
+    EXPECT_EQ(registry->stats().pipelineCount, 1u);
+
+    // Rebuilding with another shader releases the previous pipeline
+    algorithmB->rebuild({ tensor }, compileSource(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) buffer a { float pa[]; };
+      void main() {
+          pa[gl_GlobalInvocationID.x] += 1.0;
+      })"));
+    EXPECT_EQ(registry->stats().shaderModuleCount, 1u);
+    EXPECT_EQ(registry->stats().pipelineCount, 1u);
+    EXPECT_EQ(registry->stats().pipelinesCreated, 2u);
+
+    algorithmB = nullptr;
+    EXPECT_EQ(registry->stats().shaderModuleCount, 0u);
+    EXPECT_EQ(registry->stats().pipelineCount, 0u);
+
+    // Released pipelines are created again when requested
+    std::shared_ptr<kp::Algorithm> algorithmC =
+      mgr.algorithm({ tensor }, spirv);
+    EXPECT_EQ(registry->stats().pipelinesCreated, 3u);
+
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ tensor })
+      ->record<kp::OpAlgoDispatch>(algorithmC)
+      ->record<kp::OpSyncLocal>({ tensor })
+      ->eval();
+
+    EXPECT_EQ(tensor->vector(), std::vector<float>({ 2, 4, 6 }));
+}
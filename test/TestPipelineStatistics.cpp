@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+static std::string
+incrementShader(uint32_t localSize)
+{
+    return R"(
+      #version 450
+      layout (local_size_x = )" +
+           std::to_string(localSize) + R"() in;
+      layout(set = 0, binding = 0) buffer a { float pa[]; };
+      void main() {
+          uint index = gl_GlobalInvocationID.x;
+          if (index < pa.length()) {
+              pa[index] = pa[index] + 1;
+          }
+      })";
+}
+
+TEST(TestPipelineStatistics, FlagsOverDispatchedAlgorithms)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 1, 2, 3, 4 });
+
+    // Both default to a workgroup of one group per element of the tensor
+    std::shared_ptr<kp::Algorithm> algorithmNarrow =
+      mgr.algorithm({ tensor }, compileSource(incrementShader(1)));
+    std::shared_ptr<kp::Algorithm> algorithmWide =
+      mgr.algorithm({ tensor }, compileSource(incrementShader(64)));
+
+    std::shared_ptr<kp::Sequence> sq = mgr.sequence();
+    try {
+        sq->enablePipelineStatistics(4);
+    } catch (const std::runtime_error&) {
+        GTEST_SKIP() << "Device does not support pipeline statistics";
+    }
+    EXPECT_TRUE(sq->isPipelineStatisticsEnabled());
+
+    sq->record<kp::OpSyncDevice>({ tensor })
+      ->record<kp::OpAlgoDispatch>(algorithmNarrow)
+      ->record<kp::OpAlgoDispatch>(algorithmWide)
+      ->record<kp::OpSyncLocal>({ tensor })
+      ->eval();
+
+    EXPECT_EQ(sq->getPipelineStatistics(),
+              std::vector<uint64_t>({ 0, 4, 256, 0 }));
+
+    std::vector<kp::Sequence::DispatchStatistics> overDispatched =
+      sq->getOverDispatchedOperations();
+    ASSERT_EQ(overDispatched.size(), 1);
+    EXPECT_EQ(overDispatched[0].operationIndex, 2);
+    EXPECT_EQ(overDispatched[0].invocations, 256);
+    EXPECT_EQ(overDispatched[0].boundElements, 4);
+
+    EXPECT_EQ(tensor->vector(), std::vector<float>({ 3, 4, 5, 6 }));
+}
+
+TEST(TestPipelineStatistics, NotEnabledThrows)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::Sequence> sq = mgr.sequence();
+
+    EXPECT_FALSE(sq->isPipelineStatisticsEnabled());
+    EXPECT_THROW(sq->getPipelineStatistics(), std::runtime_error);
+}
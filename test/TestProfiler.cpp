@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+static const std::string incrementShader(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) buffer a { float pa[]; };
+      void main() {
+          uint index = gl_GlobalInvocationID.x;
+          pa[index] = pa[index] + 1;
+      })");
+
+TEST(TestProfiler, LabelsAndAggregatesOperations)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 0, 0, 0 });
+
+    std::shared_ptr<kp::Algorithm> algorithm =
+      mgr.algorithm({ tensor }, compileSource(incrementShader));
+    algorithm->setName("increment");
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence(0, 4)
+        ->record<kp::OpSyncDevice>({ tensor })
+        ->record<kp::OpAlgoDispatch>(algorithm)
+        ->record<kp::OpSyncLocal>({ tensor });
+
+    std::shared_ptr<kp::Profiler> profiler = mgr.profiler();
+
+    // Nothing was submitted yet
+    EXPECT_FALSE(profiler->collect(sq));
+
+    sq->eval();
+    EXPECT_TRUE(profiler->collect(sq));
+    // The timestamps of an eval are only collected once
+    EXPECT_FALSE(profiler->collect(sq));
+
+    sq->eval();
+    EXPECT_TRUE(profiler->collect(sq));
+
+    std::vector<kp::Profiler::Event> events = profiler->events();
+    ASSERT_EQ(events.size(), 6);
+    EXPECT_EQ(events[0].label, "OpSyncDevice");
+    EXPECT_EQ(events[1].label, "OpAlgoDispatch(increment)");
+    EXPECT_EQ(events[2].label, "OpSyncLocal");
+    EXPECT_EQ(events[4].index, 1);
+
+    std::vector<kp::Profiler::OperationStats> stats = profiler->stats();
+    ASSERT_EQ(stats.size(), 3);
+    for (const kp::Profiler::OperationStats& opStats : stats) {
+        EXPECT_EQ(opStats.count, 2);
+        EXPECT_LE(opStats.minNs, opStats.meanNs);
+        EXPECT_LE(opStats.meanNs, opStats.p99Ns);
+    }
+
+    std::string trace = profiler->traceJson();
+    EXPECT_NE(trace.find("\"traceEvents\""), std::string::npos);
+    EXPECT_NE(trace.find("\"name\":\"OpAlgoDispatch(increment)\""),
+              std::string::npos);
+
+    profiler->clear();
+    EXPECT_TRUE(profiler->events().empty());
+
+    EXPECT_EQ(tensor->vector(), std::vector<float>({ 2, 2, 2 }));
+}
+
+TEST(TestProfiler, RequiresTimestamps)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 0, 0, 0 });
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence()->eval<kp::OpSyncDevice>({ tensor });
+
+    EXPECT_THROW(mgr.profiler()->collect(sq), std::runtime_error);
+}
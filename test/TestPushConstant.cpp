@@ -390,3 +390,43 @@ TEST(TestPushConstants, TestConstantsDouble)
         }
     }
 }
+
+TEST(TestPushConstants, TestConstantsExceedingDeviceLimitThrow)
+{
+    std::string shader(R"(
+      #version 450
+      layout(push_constant) uniform PushConstants {
+        float x;
+      } pcs;
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) buffer a { float pa[]; };
+      void main() {
+          pa[0] += pcs.x;
+      })");
+
+    std::vector<uint32_t> spirv = compileSource(shader);
+
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 0 });
+
+    uint32_t limit = mgr.getDeviceProperties().limits.maxPushConstantsSize;
+
+    EXPECT_THROW(mgr.algorithm({ tensor },
+                               spirv,
+                               kp::Workgroup({ 1 }),
+                               {},
+                               std::vector<float>(limit / sizeof(float) + 1)),
+                 std::runtime_error);
+
+    // The base workgroup isn't reserved for shaders that don't read it, so
+    // the push constants can use the whole limit
+    std::shared_ptr<kp::Algorithm> algo =
+      mgr.algorithm({ tensor },
+                    spirv,
+                    kp::Workgroup({ 1 }),
+                    {},
+                    std::vector<float>(limit / sizeof(float)));
+    EXPECT_FALSE(algo->readsBaseWorkgroup());
+    EXPECT_EQ(algo->getBaseWorkgroupOffset(), limit);
+}
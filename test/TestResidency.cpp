@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+TEST(TestResidency, MemoryStatsPerMemoryType)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA =
+      mgr.tensor(std::vector<float>(256, 0));
+    std::shared_ptr<kp::TensorT<float>> tensorB =
+      mgr.tensor(std::vector<float>(64, 0), kp::Memory::MemoryTypes::eHost);
+
+    kp::Manager::MemoryStats stats = mgr.memoryStats();
+
+    EXPECT_FALSE(stats.heaps.empty());
+
+    const kp::Manager::MemoryTypeStats& deviceStats =
+      stats.memoryTypes[kp::Memory::MemoryTypes::eDevice];
+    EXPECT_EQ(deviceStats.count, 1u);
+    EXPECT_EQ(deviceStats.usedBytes, 256 * sizeof(float));
+    // Primary and staging memory of the device tensor
+    EXPECT_GE(deviceStats.allocatedBytes, 2 * 256 * sizeof(float));
+
+    const kp::Manager::MemoryTypeStats& hostStats =
+      stats.memoryTypes[kp::Memory::MemoryTypes::eHost];
+    EXPECT_EQ(hostStats.count, 1u);
+    EXPECT_GE(hostStats.allocatedBytes, 64 * sizeof(float));
+
+    vk::DeviceSize heapBytes = 0;
+    for (const kp::Manager::MemoryHeapStats& heap : stats.heaps) {
+        heapBytes += heap.allocatedBytes;
+        EXPECT_LE(heap.usage, heap.size);
+    }
+    EXPECT_EQ(heapBytes, deviceStats.allocatedBytes + hostStats.allocatedBytes);
+}
+
+TEST(TestResidency, SpillsLeastRecentlyUsedTensors)
+{
+    kp::Manager mgr;
+    std::shared_ptr<kp::Residency> residency =
+      mgr.enableResidency(2 * 1024 * sizeof(float));
+
+    std::shared_ptr<kp::TensorT<float>> tensorA =
+      mgr.tensor(std::vector<float>(1024, 1));
+    std::shared_ptr<kp::TensorT<float>> tensorB =
+      mgr.tensor(std::vector<float>(1024, 2));
+    std::shared_ptr<kp::TensorT<float>> tensorC =
+      mgr.tensor(std::vector<float>(1024, 0));
+
+    mgr.sequence()->eval<kp::OpSyncDevice>({ tensorA, tensorB, tensorC });
+
+    // Copying into C keeps B and C resident and spills A
+    mgr.sequence()
+      ->record<kp::OpCopy>({ tensorB, tensorC })
+      ->record<kp::OpSyncLocal>({ tensorC })
+      ->eval();
+
+    EXPECT_FALSE(tensorA->isResident());
+    EXPECT_TRUE(tensorB->isResident());
+    EXPECT_EQ(tensorC->vector(), std::vector<float>(1024, 2));
+
+    kp::Residency::Stats stats = residency->stats();
+    EXPECT_EQ(stats.trackedCount, 3u);
+    EXPECT_EQ(stats.residentCount, 2u);
+    EXPECT_EQ(stats.spilledBytes, 1024 * sizeof(float));
+    EXPECT_EQ(stats.totalEvictions, 1u);
+
+    // Using A again restores its contents and spills B
+    mgr.sequence()
+      ->record<kp::OpCopy>({ tensorA, tensorC })
+      ->record<kp::OpSyncLocal>({ tensorC })
+      ->eval();
+
+    EXPECT_TRUE(tensorA->isResident());
+    EXPECT_FALSE(tensorB->isResident());
+    EXPECT_EQ(tensorC->vector(), std::vector<float>(1024, 1));
+    EXPECT_EQ(residency->stats().totalRestores, 1u);
+}
+
+TEST(TestResidency, AlgorithmUsesRestoredTensor)
+{
+    kp::Manager mgr;
+    mgr.enableResidency(1024 * sizeof(float));
+
+    std::shared_ptr<kp::TensorT<float>> tensorA =
+      mgr.tensor(std::vector<float>(1024, 1));
+    std::shared_ptr<kp::TensorT<float>> tensorB =
+      mgr.tensor(std::vector<float>(1024, 0));
+
+    std::string shader(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) buffer a { float pa[]; };
+      void main() {
+          uint index = gl_GlobalInvocationID.x;
+          pa[index] = pa[index] + 1;
+      })");
+
+    std::shared_ptr<kp::Algorithm> algorithm =
+      mgr.algorithm({ tensorA }, compileSource(shader));
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence()
+        ->record<kp::OpSyncDevice>({ tensorA })
+        ->record<kp::OpAlgoDispatch>(algorithm);
+    sq->eval();
+
+    // Spills A, so the recorded sequence refers to a stale buffer
+    mgr.sequence()->eval<kp::OpSyncDevice>({ tensorB });
+    EXPECT_FALSE(tensorA->isResident());
+
+    uint64_t generation = tensorA->generation();
+    sq->eval();
+    EXPECT_GT(tensorA->generation(), generation);
+
+    mgr.sequence()->eval<kp::OpSyncLocal>({ tensorA });
+    EXPECT_EQ(tensorA->vector(), std::vector<float>(1024, 2));
+}
@@ -243,3 +243,38 @@ TEST(TestSequence, CorrectSequenceRunningError)
 
     EXPECT_EQ(tensorOut->vector(), std::vector<float>({ 2, 4, 6 }));
 }
+
+TEST(TestSequence, WaitStrategies)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence(0, 0, 2)
+        ->record<kp::OpSyncDevice>({ tensorA })
+        ->record<kp::OpCopy>({ tensorA, tensorB })
+        ->record<kp::OpSyncLocal>({ tensorB });
+
+    EXPECT_EQ(sq->getWaitStrategy(), kp::Sequence::WaitStrategy::eBlock);
+
+    for (kp::Sequence::WaitStrategy strategy :
+         { kp::Sequence::WaitStrategy::eSpin,
+           kp::Sequence::WaitStrategy::eHybrid,
+           kp::Sequence::WaitStrategy::eBlock }) {
+        sq->setWaitStrategy(strategy, 1000);
+        EXPECT_EQ(sq->getWaitStrategy(), strategy);
+
+        tensorB->setData(std::vector<float>{ 0, 0, 0 });
+
+        sq->evalAsync();
+        uint64_t first = sq->getLastTicket();
+        sq->evalAsync();
+        sq->evalAwaitTicket(first);
+        sq->evalAwait();
+
+        EXPECT_FALSE(sq->isRunning());
+        EXPECT_EQ(tensorB->vector(), std::vector<float>({ 1, 2, 3 }));
+    }
+}
@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+static const std::string doubleShader(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) readonly buffer a { float pa[]; };
+      layout(set = 0, binding = 1) buffer b { float pb[]; };
+      void main() {
+          uint index = gl_GlobalInvocationID.x;
+          pb[index] = pa[index] * 2;
+      })");
+
+static const std::string incrementShader(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) readonly buffer a { float pa[]; };
+      layout(set = 0, binding = 1) buffer b { float pb[]; };
+      void main() {
+          uint index = gl_GlobalInvocationID.x;
+          pb[index] = pa[index] + 1;
+      })");
+
+TEST(TestSequenceFragment, ExecutedByDifferentSequences)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+    std::shared_ptr<kp::TensorT<float>> tensorC = mgr.tensor({ 0, 0, 0 });
+
+    std::shared_ptr<kp::SequenceFragment> fragment =
+      mgr.fragment()->record<kp::OpAlgoDispatch>(
+        mgr.algorithm({ tensorA, tensorB }, compileSource(doubleShader)));
+
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ tensorA })
+      ->record(fragment)
+      ->record<kp::OpSyncLocal>({ tensorB })
+      ->eval();
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 2, 4, 6 }));
+
+    tensorA->setData(std::vector<float>{ 4, 5, 6 });
+
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ tensorA })
+      ->record(fragment)
+      ->record<kp::OpCopy>({ tensorB, tensorC })
+      ->record<kp::OpSyncLocal>({ tensorC })
+      ->eval();
+
+    EXPECT_EQ(tensorC->vector(), std::vector<float>({ 8, 10, 12 }));
+}
+
+TEST(TestSequenceFragment, BarriersBetweenFragments)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+    std::shared_ptr<kp::TensorT<float>> tensorC = mgr.tensor({ 0, 0, 0 });
+
+    std::shared_ptr<kp::SequenceFragment> fragmentB =
+      mgr.fragment()->record<kp::OpAlgoDispatch>(
+        mgr.algorithm({ tensorA, tensorB }, compileSource(doubleShader)));
+
+    // The second dispatch reads B within the fragment that writes it
+    std::shared_ptr<kp::SequenceFragment> fragmentC =
+      mgr.fragment()
+        ->record<kp::OpAlgoDispatch>(
+          mgr.algorithm({ tensorB, tensorC }, compileSource(incrementShader)))
+        ->record<kp::OpAlgoDispatch>(
+          mgr.algorithm({ tensorC, tensorB }, compileSource(doubleShader)));
+
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ tensorA })
+      ->record(fragmentB)
+      ->record(fragmentC)
+      ->record<kp::OpSyncLocal>({ tensorB, tensorC })
+      ->eval();
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 6, 10, 14 }));
+    EXPECT_EQ(tensorC->vector(), std::vector<float>({ 3, 5, 7 }));
+    EXPECT_EQ(fragmentC->getBarrierStats().pipelineBarriers, 1u);
+}
+
+TEST(TestSequenceFragment, ExecutedByMultiBufferedSequence)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+
+    mgr.sequence()->eval<kp::OpSyncDevice>({ tensorA });
+
+    std::shared_ptr<kp::SequenceFragment> fragment =
+      mgr.fragment()->record<kp::OpAlgoDispatch>(
+        mgr.algorithm({ tensorA, tensorB }, compileSource(doubleShader)));
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence(0, 0, 2)->record(fragment);
+
+    sq->evalAsync();
+    sq->evalAsync();
+    sq->evalAwait();
+
+    mgr.sequence()->eval<kp::OpSyncLocal>({ tensorB });
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 2, 4, 6 }));
+}
+
+TEST(TestSequenceFragment, RecordedAgainWhileExecuting)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+    std::shared_ptr<kp::TensorT<float>> tensorC = mgr.tensor({ 0, 0, 0 });
+
+    mgr.sequence()->eval<kp::OpSyncDevice>({ tensorA });
+
+    std::shared_ptr<kp::SequenceFragment> fragment =
+      mgr.fragment()->record<kp::OpAlgoDispatch>(
+        mgr.algorithm({ tensorA, tensorB }, compileSource(doubleShader)));
+
+    std::shared_ptr<kp::Sequence> sqA = mgr.sequence()->record(fragment);
+    std::shared_ptr<vk::CommandBuffer> first = fragment->getCommandBuffer();
+
+    sqA->evalAsync();
+
+    // The running sequence keeps executing the first recording
+    fragment->record<kp::OpAlgoDispatch>(
+      mgr.algorithm({ tensorB, tensorC }, compileSource(incrementShader)));
+    EXPECT_NE(fragment->getCommandBuffer(), first);
+
+    sqA->evalAwait();
+
+    mgr.sequence()
+      ->record(fragment)
+      ->record<kp::OpSyncLocal>({ tensorB, tensorC })
+      ->eval();
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 2, 4, 6 }));
+    EXPECT_EQ(tensorC->vector(), std::vector<float>({ 3, 5, 7 }));
+}
+
+TEST(TestSequenceFragment, UnboundTransientMemoryThrows)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB =
+      mgr.tensorT<float>(3, kp::Memory::MemoryTypes::eTransient);
+
+    EXPECT_THROW(mgr.fragment()->record<kp::OpCopy>({ tensorA, tensorB }),
+                 std::runtime_error);
+}
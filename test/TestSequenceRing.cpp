@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+// Operation whose preEval throws while it is set to fail
+class OpFailingPreEval : public kp::OpBase
+{
+  public:
+    bool fail = true;
+
+    void record(const vk::CommandBuffer& /*commandBuffer*/) override {}
+
+    void preEval(const vk::CommandBuffer& /*commandBuffer*/) override
+    {
+        if (this->fail) {
+            throw std::runtime_error("OpFailingPreEval preEval failed");
+        }
+    }
+
+    void postEval(const vk::CommandBuffer& /*commandBuffer*/) override {}
+};
+
+TEST(TestSequenceRing, OverlappingSubmissions)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA =
+      mgr.tensor(std::vector<float>(1024, 3));
+    std::shared_ptr<kp::TensorT<float>> tensorB =
+      mgr.tensor(std::vector<float>(1024, 0));
+
+    // Submissions in flight aren't ordered, so each one writes the same result
+    std::string shader(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) buffer a { float pa[]; };
+      layout(set = 0, binding = 1) buffer b { float pb[]; };
+      void main() {
+          uint index = gl_GlobalInvocationID.x;
+          pb[index] = pa[index] * 2;
+      })");
+
+    std::shared_ptr<kp::Algorithm> algorithm =
+      mgr.algorithm({ tensorA, tensorB }, compileSource(shader));
+
+    mgr.sequence()->eval<kp::OpSyncDevice>({ tensorA, tensorB });
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence(0, 0, 3)->record<kp::OpAlgoDispatch>(algorithm);
+
+    EXPECT_EQ(sq->getBufferCount(), 3u);
+    EXPECT_EQ(sq->getLastTicket(), 0u);
+
+    sq->evalAsync();
+    uint64_t first = sq->getLastTicket();
+    sq->evalAsync();
+    sq->evalAsync();
+    uint64_t last = sq->getLastTicket();
+
+    EXPECT_EQ(first, 1u);
+    EXPECT_EQ(last, 3u);
+    EXPECT_TRUE(sq->isRunning());
+
+    // All the command buffers are in flight
+    EXPECT_THROW(sq->evalAsync(), std::runtime_error);
+
+    sq->evalAwaitTicket(first);
+    sq->evalAsync();
+    EXPECT_EQ(sq->getLastTicket(), 4u);
+
+    sq->evalAwait();
+    EXPECT_FALSE(sq->isRunning());
+
+    mgr.sequence()->eval<kp::OpSyncLocal>({ tensorB });
+    EXPECT_EQ(tensorB->vector(), std::vector<float>(1024, 6));
+}
+
+TEST(TestSequenceRing, AwaitTicketNotInFlight)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence(0, 0, 2)
+        ->record<kp::OpSyncDevice>({ tensorA })
+        ->record<kp::OpCopy>({ tensorA, tensorB })
+        ->record<kp::OpSyncLocal>({ tensorB });
+
+    sq->evalAsync();
+    uint64_t ticket = sq->getLastTicket();
+
+    EXPECT_NO_THROW(sq->evalAwaitTicket(ticket));
+    EXPECT_NO_THROW(sq->evalAwaitTicket(ticket));
+    EXPECT_NO_THROW(sq->evalAwaitTicket(0));
+    EXPECT_NO_THROW(sq->evalAwaitTicket(ticket + 1));
+    EXPECT_FALSE(sq->isRunning());
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 1, 2, 3 }));
+}
+
+TEST(TestSequenceRing, TimestampsRequireSingleBuffer)
+{
+    kp::Manager mgr;
+
+    EXPECT_THROW(mgr.sequence(0, 10, 2), std::runtime_error);
+    EXPECT_THROW(mgr.sequence(0, 0, 0), std::runtime_error);
+}
+
+TEST(TestSequenceRing, FailedPreEvalDoesNotTakeTicket)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+
+    std::shared_ptr<OpFailingPreEval> failing =
+      std::make_shared<OpFailingPreEval>();
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence(0, 0, 2)
+        ->record(failing)
+        ->record<kp::OpSyncDevice>({ tensorA })
+        ->record<kp::OpCopy>({ tensorA, tensorB })
+        ->record<kp::OpSyncLocal>({ tensorB });
+
+    EXPECT_THROW(sq->evalAsync(), std::runtime_error);
+    EXPECT_EQ(sq->getLastTicket(), 0u);
+    EXPECT_FALSE(sq->isRunning());
+
+    failing->fail = false;
+    sq->evalAsync();
+    EXPECT_EQ(sq->getLastTicket(), 1u);
+    sq->evalAsync();
+    EXPECT_EQ(sq->getLastTicket(), 2u);
+    sq->evalAwait();
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 1, 2, 3 }));
+}
@@ -0,0 +1,244 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+TEST(TestStagingRing, TensorsLargerThanRingRoundTripData)
+{
+    kp::Manager mgr;
+    std::shared_ptr<kp::StagingRing> ring =
+      mgr.enableStagingRing(64 * 1024, 4);
+
+    EXPECT_TRUE(ring->isInit());
+    EXPECT_EQ(ring, mgr.getStagingRing());
+    EXPECT_EQ(ring->chunkSize(), 16u * 1024u);
+
+    std::vector<float> testVecA(100 * 1024);
+    for (size_t i = 0; i < testVecA.size(); i++) {
+        testVecA[i] = static_cast<float>(i);
+    }
+    std::vector<float> testVecB(testVecA.size(), 0);
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor(testVecA);
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor(testVecB);
+
+    EXPECT_TRUE(tensorA->usesStagingRing());
+    EXPECT_TRUE(tensorB->usesStagingRing());
+
+    mgr.sequence()
+      ->eval<kp::OpSyncDevice>({ tensorA, tensorB })
+      ->eval<kp::OpCopy>({ tensorA, tensorB })
+      ->eval<kp::OpSyncLocal>({ tensorB });
+
+    EXPECT_EQ(testVecA, tensorB->vector());
+}
+
+TEST(TestStagingRing, AlgorithmOnRingTensors)
+{
+    kp::Manager mgr;
+    mgr.enableStagingRing();
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 0, 1, 2 });
+
+    std::string shader(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) buffer a { float pa[]; };
+      void main() {
+          uint index = gl_GlobalInvocationID.x;
+          pa[index] = pa[index] + 1;
+      })");
+
+    std::vector<uint32_t> spirv = compileSource(shader);
+
+    std::shared_ptr<kp::Algorithm> algorithm =
+      mgr.algorithm({ tensorA }, spirv);
+
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ tensorA })
+      ->record<kp::OpAlgoDispatch>(algorithm)
+      ->record<kp::OpAlgoDispatch>(algorithm)
+      ->record<kp::OpSyncLocal>({ tensorA })
+      ->eval();
+
+    EXPECT_EQ(tensorA->vector(), std::vector<float>({ 2, 3, 4 }));
+}
+
+TEST(TestStagingRing, HostAndStorageTensorsDoNotUseRing)
+{
+    kp::Manager mgr;
+    mgr.enableStagingRing();
+
+    std::shared_ptr<kp::TensorT<float>> tensorA =
+      mgr.tensor({ 1, 2, 3 }, kp::Memory::MemoryTypes::eHost);
+    std::shared_ptr<kp::TensorT<float>> tensorB =
+      mgr.tensorT<float>(3, kp::Memory::MemoryTypes::eStorage);
+    std::shared_ptr<kp::TensorT<float>> tensorC =
+      mgr.tensor({ 0, 0, 0 }, kp::Memory::MemoryTypes::eHost);
+
+    EXPECT_FALSE(tensorA->usesStagingRing());
+    EXPECT_FALSE(tensorB->usesStagingRing());
+
+    mgr.sequence()
+      ->eval<kp::OpSyncDevice>({ tensorA })
+      ->eval<kp::OpCopy>({ tensorA, tensorB })
+      ->eval<kp::OpCopy>({ tensorB, tensorC })
+      ->eval<kp::OpSyncLocal>({ tensorC });
+
+    EXPECT_EQ(tensorC->vector(), std::vector<float>({ 1, 2, 3 }));
+}
+
+TEST(TestStagingRing, TensorsCreatedBySizeAllocateHostDataLazily)
+{
+    kp::Manager mgr;
+    mgr.enableStagingRing();
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 4, 5, 6 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensorT<float>(3);
+
+    EXPECT_TRUE(tensorB->usesStagingRing());
+
+    mgr.sequence()
+      ->eval<kp::OpSyncDevice>({ tensorA, tensorB })
+      ->eval<kp::OpCopy>({ tensorA, tensorB })
+      ->eval<kp::OpSyncLocal>({ tensorB });
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 4, 5, 6 }));
+}
+
+TEST(TestStagingRing, EnableStagingRingTwiceReturnsSameRing)
+{
+    kp::Manager mgr;
+    std::shared_ptr<kp::StagingRing> ring = mgr.enableStagingRing();
+
+    EXPECT_EQ(ring->size(), 16u * 1024u * 1024u);
+    EXPECT_EQ(ring, mgr.enableStagingRing(1024));
+}
+
+TEST(TestStagingRing, UploadWaitsForSubmissionsInFlight)
+{
+    kp::Manager mgr;
+    mgr.enableStagingRing();
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+
+    std::string shader(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) readonly buffer a { float pa[]; };
+      layout(set = 0, binding = 1) buffer b { float pb[]; };
+      void main() {
+          uint index = gl_GlobalInvocationID.x;
+          pb[index] = pa[index] * 2;
+      })");
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence(0, 0, 2)
+        ->record<kp::OpSyncDevice>({ tensorA })
+        ->record<kp::OpAlgoDispatch>(
+          mgr.algorithm({ tensorA, tensorB }, compileSource(shader)));
+
+    // The second upload is only copied once the first dispatch has read A
+    sq->evalAsync();
+    tensorA->setData(std::vector<float>{ 4, 5, 6 });
+    sq->evalAsync();
+    sq->evalAwait();
+
+    mgr.sequence()->eval<kp::OpSyncLocal>({ tensorB });
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 8, 10, 12 }));
+}
+
+TEST(TestStagingRing, UploadUsedByOtherQueueThrows)
+{
+    kp::Manager mgr;
+    std::shared_ptr<kp::StagingRing> ring = mgr.enableStagingRing();
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::Tensor> view = tensorA->slice(1, 2);
+
+    // Submissions on the queue of the ring are ordered before the copy
+    view->acquireSubmission(*ring->queue());
+    EXPECT_NO_THROW(mgr.sequence()->eval<kp::OpSyncDevice>({ tensorA }));
+    view->releaseSubmission(*ring->queue());
+
+    vk::Queue otherQueue;
+    view->acquireSubmission(otherQueue);
+    EXPECT_TRUE(tensorA->isUsedByOtherQueue(*ring->queue()));
+    EXPECT_THROW(mgr.sequence()->eval<kp::OpSyncDevice>({ tensorA }),
+                 std::runtime_error);
+
+    view->releaseSubmission(otherQueue);
+    EXPECT_FALSE(tensorA->isUsedByOtherQueue(*ring->queue()));
+    EXPECT_NO_THROW(mgr.sequence()->eval<kp::OpSyncDevice>({ tensorA }));
+}
+
+TEST(TestStagingRing, SyncsInsideSequenceThrow)
+{
+    kp::Manager mgr;
+    mgr.enableStagingRing();
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+
+    // The upload would happen before the copy that reads the tensor
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence()->record<kp::OpCopy>({ tensorA, tensorB });
+    EXPECT_THROW(sq->record<kp::OpSyncDevice>({ tensorA->slice(0, 2) }),
+                 std::runtime_error);
+
+    // The download would happen after the copy that writes the tensor
+    sq->clear();
+    sq->record<kp::OpSyncLocal>({ tensorB });
+    EXPECT_THROW(sq->record<kp::OpCopy>({ tensorA, tensorB }),
+                 std::runtime_error);
+
+    // Reading a downloaded tensor afterwards keeps its data
+    sq->clear();
+    sq->record<kp::OpSyncDevice>({ tensorA })
+      ->record<kp::OpCopy>({ tensorA, tensorB })
+      ->record<kp::OpSyncLocal>({ tensorB });
+    EXPECT_NO_THROW(sq->record<kp::OpCopy>({ tensorB, tensorA }));
+    sq->eval();
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 1, 2, 3 }));
+}
+
+TEST(TestStagingRing, TransfersFromCompletionThread)
+{
+    kp::Manager mgr;
+    mgr.enableStagingRing();
+    mgr.enableCompletionThread();
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+    std::shared_ptr<kp::TensorT<float>> tensorC = mgr.tensor({ 4, 5, 6 });
+    std::shared_ptr<kp::TensorT<float>> tensorD = mgr.tensor({ 0, 0, 0 });
+
+    std::shared_ptr<kp::Sequence> sqAsync =
+      mgr.sequence()
+        ->record<kp::OpSyncDevice>({ tensorA })
+        ->record<kp::OpCopy>({ tensorA, tensorB })
+        ->record<kp::OpSyncLocal>({ tensorB });
+    std::shared_ptr<kp::Sequence> sqSync =
+      mgr.sequence()
+        ->record<kp::OpSyncDevice>({ tensorC })
+        ->record<kp::OpCopy>({ tensorC, tensorD })
+        ->record<kp::OpSyncLocal>({ tensorD });
+
+    // The completion thread downloads B while this thread submits to the
+    // same queue
+    for (uint32_t i = 0; i < 100; i++) {
+        std::future<void> done = sqAsync->evalAsyncFuture();
+        sqSync->eval();
+        done.get();
+    }
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 1, 2, 3 }));
+    EXPECT_EQ(tensorD->vector(), std::vector<float>({ 4, 5, 6 }));
+}
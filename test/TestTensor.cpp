@@ -5,6 +5,8 @@
 #include "kompute/Kompute.hpp"
 #include "kompute/logger/Logger.hpp"
 
+#include "shaders/Utils.hpp"
+
 // Introducing custom struct that can be used for tensors
 struct TensorTestStruct
 {
@@ -111,3 +113,57 @@ TEST(TestTensor, DataTypes)
         EXPECT_EQ(tensor->dataType(), kp::Memory::DataTypes::eDouble);
     }
 }
+
+TEST(TestTensor, SizesBeyond32Bits)
+{
+    kp::Manager mgr;
+
+    // Transient tensors only create their buffer until a sequence binds their
+    // memory, so the sizes can exceed 32 bits without allocating any memory
+    uint64_t count = uint64_t(UINT32_MAX) + 2;
+    std::shared_ptr<kp::TensorT<uint16_t>> tensor;
+    try {
+        tensor =
+          mgr.tensorT<uint16_t>(count, kp::Memory::MemoryTypes::eTransient);
+    } catch (const std::exception& e) {
+        GTEST_SKIP() << "Device can't create a buffer of " << count * 2
+                     << " bytes: " << e.what();
+    }
+
+    EXPECT_EQ(tensor->size(), count);
+    EXPECT_EQ(tensor->memorySize(), count * sizeof(uint16_t));
+
+    // The x dimension of the one dimensional memory object saturates
+    EXPECT_EQ(tensor->getX(), UINT32_MAX);
+    EXPECT_EQ(tensor->getY(), 1u);
+}
+
+TEST(TestTensor, BindingBeyondMaxStorageBufferRangeThrows)
+{
+    kp::Manager mgr;
+
+    uint32_t range = mgr.getDeviceProperties().limits.maxStorageBufferRange;
+    if (range > 256 * 1024 * 1024) {
+        GTEST_SKIP() << "maxStorageBufferRange of " << range
+                     << " bytes is too large to exceed in a test";
+    }
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensorT<float>(
+      range / sizeof(float) + 1, kp::Memory::MemoryTypes::eStorage);
+
+    std::vector<uint32_t> spirv = compileSource(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) buffer a { float pa[]; };
+      void main() {
+          pa[gl_GlobalInvocationID.x] = 1;
+      })");
+
+    EXPECT_THROW(mgr.algorithm({ tensor }, spirv, kp::Workgroup({ 1 })),
+                 std::runtime_error);
+
+    // Views within the range can be bound instead
+    std::shared_ptr<kp::Tensor> view =
+      tensor->slice(0, range / sizeof(float));
+    EXPECT_NO_THROW(mgr.algorithm({ view }, spirv, kp::Workgroup({ 1 })));
+}
@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+// Larger than the minImportedHostPointerAlignment of common devices
+static const size_t hostPointerAlignment = 64 * 1024;
+
+static float*
+alignedHostData(std::vector<uint8_t>& memory, size_t bytes)
+{
+    memory.resize(bytes + hostPointerAlignment);
+    uintptr_t address = reinterpret_cast<uintptr_t>(memory.data());
+    address =
+      (address + hostPointerAlignment - 1) & ~(hostPointerAlignment - 1);
+    return reinterpret_cast<float*>(address);
+}
+
+TEST(TestTensorFromHostPointer, CopiesDataWithoutExtension)
+{
+    kp::Manager mgr;
+
+    std::vector<uint8_t> memory;
+    float* data = alignedHostData(memory, hostPointerAlignment);
+    std::fill(data, data + hostPointerAlignment / sizeof(float), 1.0f);
+
+    std::shared_ptr<kp::Tensor> tensor = mgr.tensorFromHostPointer(
+      data, hostPointerAlignment, kp::Memory::DataTypes::eFloat);
+
+    EXPECT_FALSE(tensor->isHostMemoryImported());
+    EXPECT_EQ(tensor->memoryType(), kp::Memory::MemoryTypes::eHost);
+    EXPECT_EQ(tensor->size(), hostPointerAlignment / sizeof(float));
+    EXPECT_NE(tensor->data<float>(), data);
+
+    data[0] = 2.0f;
+    EXPECT_EQ(tensor->data<float>()[0], 1.0f);
+}
+
+TEST(TestTensorFromHostPointer, ImportsAlignedHostMemory)
+{
+    kp::Manager mgr(0, {}, { VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME });
+
+    size_t bytes = 2 * hostPointerAlignment;
+    uint32_t count = static_cast<uint32_t>(bytes / sizeof(float));
+
+    std::vector<uint8_t> memory;
+    float* data = alignedHostData(memory, bytes);
+    std::fill(data, data + count, 1.0f);
+
+    std::shared_ptr<kp::Tensor> tensor =
+      mgr.tensorFromHostPointer(data, bytes, kp::Memory::DataTypes::eFloat);
+
+    EXPECT_TRUE(tensor->isInit());
+    EXPECT_EQ(tensor->size(), count);
+
+    std::string shader(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) buffer a { float pa[]; };
+      void main() {
+          uint index = gl_GlobalInvocationID.x;
+          pa[index] = pa[index] + 1;
+      })");
+
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ tensor })
+      ->record<kp::OpAlgoDispatch>(
+        mgr.algorithm({ tensor }, compileSource(shader)))
+      ->record<kp::OpSyncLocal>({ tensor })
+      ->eval();
+
+    EXPECT_EQ(tensor->vector<float>(), std::vector<float>(count, 2.0f));
+
+    // Devices without the extension fall back to a copy of the data
+    if (tensor->isHostMemoryImported()) {
+        EXPECT_EQ(tensor->data<float>(), data);
+        EXPECT_EQ(std::vector<float>(data, data + count),
+                  std::vector<float>(count, 2.0f));
+    }
+}
+
+TEST(TestTensorFromHostPointer, CopiesMisalignedHostMemory)
+{
+    kp::Manager mgr(0, {}, { VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME });
+
+    std::vector<uint8_t> memory;
+    float* data = alignedHostData(memory, 2 * hostPointerAlignment) + 1;
+    std::fill(data, data + 3, 3.0f);
+
+    std::shared_ptr<kp::Tensor> tensor = mgr.tensorFromHostPointer(
+      data, 3 * sizeof(float), kp::Memory::DataTypes::eFloat);
+
+    EXPECT_FALSE(tensor->isHostMemoryImported());
+    EXPECT_EQ(tensor->vector<float>(), std::vector<float>({ 3, 3, 3 }));
+}
+
+TEST(TestTensorFromHostPointer, PartialElementsThrow)
+{
+    kp::Manager mgr;
+
+    std::vector<float> data(4, 0);
+
+    EXPECT_THROW(
+      mgr.tensorFromHostPointer(data.data(), 5, kp::Memory::DataTypes::eFloat),
+      std::runtime_error);
+}
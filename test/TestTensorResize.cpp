@@ -0,0 +1,184 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+TEST(TestTensorResize, ShrinkKeepsBuffer)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor =
+      mgr.tensor({ 0, 1, 2, 3, 4, 5, 6, 7 });
+    std::shared_ptr<vk::Buffer> buffer = tensor->getPrimaryBuffer();
+
+    mgr.sequence()->eval<kp::OpResize>({ tensor }, 4);
+
+    EXPECT_EQ(tensor->size(), 4u);
+    EXPECT_EQ(tensor->capacity(), 8u);
+    EXPECT_EQ(tensor->getPrimaryBuffer(), buffer);
+    EXPECT_EQ(tensor->vector(), std::vector<float>({ 0, 1, 2, 3 }));
+
+    // Growing back within the capacity keeps the buffer as well
+    mgr.sequence()->eval<kp::OpResize>({ tensor }, 6);
+
+    EXPECT_EQ(tensor->size(), 6u);
+    EXPECT_EQ(tensor->getPrimaryBuffer(), buffer);
+}
+
+TEST(TestTensorResize, GrowPreservesDeviceContents)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 1, 2, 3, 4 });
+
+    mgr.sequence()->eval<kp::OpSyncDevice>({ tensor });
+
+    // Clears the host data so only the device contents hold the values
+    tensor->setData(std::vector<float>{ 0, 0, 0, 0 });
+
+    mgr.sequence()
+      ->record<kp::OpResize>({ tensor }, 6)
+      ->record<kp::OpSyncLocal>({ tensor })
+      ->eval();
+
+    EXPECT_EQ(tensor->size(), 6u);
+    EXPECT_EQ(tensor->capacity(), 8u);
+
+    std::vector<float> data = tensor->vector();
+    EXPECT_EQ(std::vector<float>(data.begin(), data.begin() + 4),
+              std::vector<float>({ 1, 2, 3, 4 }));
+}
+
+TEST(TestTensorResize, AlgorithmUsesResizedTensor)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor =
+      mgr.tensor(std::vector<float>(4, 1));
+
+    std::string shader(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) buffer a { float pa[]; };
+      void main() {
+          uint index = gl_GlobalInvocationID.x;
+          pa[index] = pa[index] + 1;
+      })");
+
+    std::shared_ptr<kp::Algorithm> algorithm =
+      mgr.algorithm({ tensor }, compileSource(shader));
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence()
+        ->record<kp::OpSyncDevice>({ tensor })
+        ->record<kp::OpAlgoDispatch>(algorithm)
+        ->record<kp::OpSyncLocal>({ tensor });
+    sq->eval();
+
+    EXPECT_EQ(tensor->vector(), std::vector<float>(4, 2));
+
+    mgr.sequence()->eval<kp::OpResize>({ tensor }, 16);
+    tensor->setData(std::vector<float>(12, 1), 4);
+    algorithm->setWorkgroup({ 16, 1, 1 });
+
+    // The sequence is re-recorded and the descriptors point to the new buffer
+    sq->eval();
+
+    std::vector<float> expected(16, 2);
+    std::fill(expected.begin(), expected.begin() + 4, 3);
+    EXPECT_EQ(tensor->vector(), expected);
+}
+
+TEST(TestTensorResize, GrowInMultiBufferedSequence)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 1, 2, 3, 4 });
+
+    mgr.sequence()->eval<kp::OpSyncDevice>({ tensor });
+    tensor->setData(std::vector<float>{ 0, 0, 0, 0 });
+
+    // Every command buffer repeats the copy of the same resize, so whichever
+    // executes first preserves the contents
+    std::shared_ptr<kp::Sequence> sq = mgr.sequence(0, 0, 3)
+                                         ->record<kp::OpResize>({ tensor }, 6)
+                                         ->record<kp::OpSyncLocal>({ tensor });
+
+    EXPECT_EQ(tensor->size(), 6u);
+    EXPECT_EQ(tensor->capacity(), 8u);
+
+    for (uint32_t i = 0; i < 3; i++) {
+        sq->eval();
+
+        std::vector<float> data = tensor->vector();
+        EXPECT_EQ(std::vector<float>(data.begin(), data.begin() + 4),
+                  std::vector<float>({ 1, 2, 3, 4 }));
+    }
+    EXPECT_EQ(tensor->capacity(), 8u);
+}
+
+TEST(TestTensorResize, DescriptorsRefreshedWhileInFlight)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor =
+      mgr.tensor(std::vector<float>(4, 1));
+
+    std::string shader(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) buffer a { float pa[]; };
+      void main() {
+          uint index = gl_GlobalInvocationID.x;
+          pa[index] = pa[index] + 1;
+      })");
+
+    std::shared_ptr<kp::Algorithm> algorithm =
+      mgr.algorithm({ tensor }, compileSource(shader));
+
+    mgr.sequence()->eval<kp::OpSyncDevice>({ tensor });
+
+    std::shared_ptr<kp::Sequence> sqInFlight =
+      mgr.sequence()->record<kp::OpAlgoDispatch>(algorithm);
+    sqInFlight->evalAsync();
+
+    // The descriptor set used by the submission in flight is retired, and
+    // the new buffer is written into a fresh one
+    mgr.sequence()
+      ->record<kp::OpResize>({ tensor }, 8)
+      ->record<kp::OpAlgoDispatch>(algorithm)
+      ->record<kp::OpSyncLocal>({ tensor })
+      ->eval();
+
+    sqInFlight->evalAwait();
+
+    std::vector<float> data = tensor->vector();
+    EXPECT_EQ(std::vector<float>(data.begin(), data.begin() + 4),
+              std::vector<float>(4, 3));
+}
+
+TEST(TestTensorResize, InvalidResizeThrows)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 0, 1, 2, 3 });
+
+    EXPECT_THROW(mgr.sequence()->eval<kp::OpResize>({ tensor }, 0),
+                 std::runtime_error);
+    std::shared_ptr<kp::TensorT<float>> view = tensor->slice(0, 2);
+    EXPECT_THROW(mgr.sequence()->eval<kp::OpResize>({ view }, 3),
+                 std::runtime_error);
+    EXPECT_THROW(mgr.sequence()->eval<kp::OpResize>({ tensor }, 8),
+                 std::runtime_error);
+
+    // Tensors can be resized again once their views are destroyed
+    view = nullptr;
+    EXPECT_NO_THROW(mgr.sequence()->eval<kp::OpResize>({ tensor }, 8));
+    EXPECT_EQ(tensor->size(), 8u);
+}
@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+TEST(TestTensorView, SliceSharesHostData)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor =
+      mgr.tensor({ 0, 1, 2, 3, 4, 5, 6, 7 });
+    std::shared_ptr<kp::TensorT<float>> view = tensor->slice(2, 3);
+
+    EXPECT_TRUE(view->isInit());
+    EXPECT_EQ(view->size(), 3u);
+    EXPECT_EQ(view->memoryOffset(), 2 * sizeof(float));
+    EXPECT_EQ(view->getPrimaryBuffer(), tensor->getPrimaryBuffer());
+    EXPECT_EQ(view->vector(), std::vector<float>({ 2, 3, 4 }));
+
+    view->data()[0] = 9;
+    EXPECT_EQ(tensor->vector()[2], 9);
+
+    // Views of views are offset from the viewed tensor
+    std::shared_ptr<kp::TensorT<float>> subView = view->slice(1, 2);
+    EXPECT_EQ(subView->memoryOffset(), 3 * sizeof(float));
+    EXPECT_EQ(subView->vector(), std::vector<float>({ 3, 4 }));
+}
+
+TEST(TestTensorView, SliceOutOfRangeThrows)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 0, 1, 2 });
+
+    EXPECT_THROW(tensor->slice(2, 2), std::runtime_error);
+}
+
+TEST(TestTensorView, SyncOnlyTheSliceRange)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor =
+      mgr.tensor({ 0, 0, 0, 0, 0, 0 });
+
+    mgr.sequence()->eval<kp::OpSyncDevice>({ tensor });
+
+    tensor->setData(std::vector<float>{ 1, 2, 3, 4, 5, 6 });
+    mgr.sequence()->eval<kp::OpSyncDevice>({ tensor->slice(2, 2) });
+
+    tensor->setData(std::vector<float>{ 0, 0, 0, 0, 0, 0 });
+    mgr.sequence()->eval<kp::OpSyncLocal>({ tensor });
+
+    EXPECT_EQ(tensor->vector(), std::vector<float>({ 0, 0, 3, 4, 0, 0 }));
+
+    tensor->setData(std::vector<float>{ 9, 9, 9, 9, 9, 9 });
+    mgr.sequence()->eval<kp::OpSyncLocal>({ tensor->slice(2, 2) });
+
+    EXPECT_EQ(tensor->vector(), std::vector<float>({ 9, 9, 3, 4, 9, 9 }));
+}
+
+TEST(TestTensorView, CopyBetweenSlices)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA =
+      mgr.tensor({ 1, 2, 3, 4, 5, 6 });
+    std::shared_ptr<kp::TensorT<float>> tensorB =
+      mgr.tensor({ 0, 0, 0, 0, 0, 0 });
+
+    mgr.sequence()
+      ->eval<kp::OpSyncDevice>({ tensorA, tensorB })
+      ->eval<kp::OpCopy>({ tensorA->slice(0, 3), tensorB->slice(3, 3) })
+      ->eval<kp::OpSyncLocal>({ tensorB });
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 0, 0, 0, 1, 2, 3 }));
+}
+
+TEST(TestTensorView, AlgorithmOnAlignedSlice)
+{
+    kp::Manager mgr;
+
+    vk::DeviceSize alignment =
+      mgr.getDeviceProperties().limits.minStorageBufferOffsetAlignment;
+    uint32_t count =
+      std::max<uint32_t>(static_cast<uint32_t>(alignment / sizeof(float)), 1);
+
+    std::shared_ptr<kp::TensorT<float>> tensor =
+      mgr.tensor(std::vector<float>(2 * count, 1));
+    std::shared_ptr<kp::TensorT<float>> view = tensor->slice(count, count);
+
+    std::string shader(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) buffer a { float pa[]; };
+      void main() {
+          uint index = gl_GlobalInvocationID.x;
+          pa[index] = pa[index] + 1;
+      })");
+
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ tensor })
+      ->record<kp::OpAlgoDispatch>(
+        mgr.algorithm({ view }, compileSource(shader)))
+      ->record<kp::OpSyncLocal>({ tensor })
+      ->eval();
+
+    std::vector<float> expected(2 * count, 1);
+    std::fill(expected.begin() + count, expected.end(), 2);
+
+    EXPECT_EQ(tensor->vector(), expected);
+}
@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+TEST(TestTimelineSemaphore, SequenceWaitsForSequenceOnDevice)
+{
+    kp::Manager mgr(0, {}, { VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME });
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+    std::shared_ptr<kp::TensorT<float>> tensorC = mgr.tensor({ 0, 0, 0 });
+
+    std::shared_ptr<kp::Sequence> sqA =
+      mgr.sequence()
+        ->record<kp::OpSyncDevice>({ tensorA })
+        ->record<kp::OpCopy>({ tensorA, tensorB });
+    std::shared_ptr<kp::Sequence> sqB =
+      mgr.sequence()
+        ->record<kp::OpCopy>({ tensorB, tensorC })
+        ->record<kp::OpSyncLocal>({ tensorC });
+
+    // Devices without the extension only synchronise through the host
+    if (!sqA->isTimelineEnabled()) {
+        EXPECT_THROW(sqB->waitFor(sqA), std::runtime_error);
+        return;
+    }
+
+    for (uint32_t i = 1; i <= 3; i++) {
+        sqA->evalAsync();
+        EXPECT_EQ(sqA->getTimelineValue(), i);
+
+        sqB->waitFor(sqA)->evalAsync();
+        sqB->evalAwait();
+
+        EXPECT_EQ(tensorC->vector(), std::vector<float>({ 1, 2, 3 }));
+        EXPECT_EQ(sqA->getCompletedTimelineValue(), i);
+
+        sqA->evalAwait();
+    }
+}
+
+TEST(TestTimelineSemaphore, SignalDeclaredValue)
+{
+    kp::Manager mgr(0, {}, { VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME });
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence()->record<kp::OpSyncDevice>({ tensorA });
+
+    if (!sq->isTimelineEnabled()) {
+        EXPECT_THROW(sq->signal(10), std::runtime_error);
+        return;
+    }
+
+    sq->signal(10)->eval();
+    EXPECT_EQ(sq->getTimelineValue(), 10u);
+    EXPECT_EQ(sq->getCompletedTimelineValue(), 10u);
+
+    sq->eval();
+    EXPECT_EQ(sq->getCompletedTimelineValue(), 11u);
+
+    EXPECT_THROW(sq->signal(11), std::runtime_error);
+}
+
+TEST(TestTimelineSemaphore, WaitRequiresTimeline)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::Sequence> sqA = mgr.sequence();
+    std::shared_ptr<kp::Sequence> sqB = mgr.sequence();
+
+    EXPECT_FALSE(sqA->isTimelineEnabled());
+    EXPECT_EQ(sqA->getCompletedTimelineValue(), 0u);
+    EXPECT_THROW(sqB->waitFor(sqA, 1), std::runtime_error);
+}
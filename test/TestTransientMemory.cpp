@@ -0,0 +1,251 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+static const std::string shaderAddOne(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) buffer a { float pa[]; };
+      layout(set = 0, binding = 1) buffer b { float pb[]; };
+      void main() {
+          uint index = gl_GlobalInvocationID.x;
+          pb[index] = pa[index] + 1;
+      })");
+
+TEST(TestTransientMemory, ChainedTransientTensorsShareMemory)
+{
+    kp::Manager mgr;
+
+    uint32_t size = 1024;
+
+    std::shared_ptr<kp::TensorT<float>> tensorIn =
+      mgr.tensor(std::vector<float>(size, 1));
+    std::shared_ptr<kp::TensorT<float>> tensorOut =
+      mgr.tensor(std::vector<float>(size, 0));
+
+    std::vector<std::shared_ptr<kp::TensorT<float>>> transients;
+    for (uint32_t i = 0; i < 4; i++) {
+        transients.push_back(
+          mgr.tensorT<float>(size, kp::Memory::MemoryTypes::eTransient));
+    }
+
+    EXPECT_TRUE(transients[0]->isInit());
+    EXPECT_FALSE(transients[0]->isMemoryBound());
+
+    std::vector<uint32_t> spirv = compileSource(shaderAddOne);
+
+    std::shared_ptr<kp::Sequence> sq = mgr.sequence();
+    sq->record<kp::OpSyncDevice>({ tensorIn })
+      ->record<kp::OpCopy>({ tensorIn, transients[0] });
+    for (uint32_t i = 0; i < 3; i++) {
+        sq->record<kp::OpAlgoDispatch>(
+          mgr.algorithm({ transients[i], transients[i + 1] }, spirv));
+    }
+    sq->record<kp::OpCopy>({ transients[3], tensorOut })
+      ->record<kp::OpSyncLocal>({ tensorOut })
+      ->eval();
+
+    EXPECT_EQ(tensorOut->vector(), std::vector<float>(size, 4));
+
+    for (const std::shared_ptr<kp::TensorT<float>>& transient : transients) {
+        EXPECT_TRUE(transient->isMemoryBound());
+    }
+
+    // Only two of the four tensors are alive at any point of the chain
+    kp::Sequence::TransientMemoryStats stats = sq->getTransientMemoryStats();
+    EXPECT_EQ(stats.tensorCount, 4u);
+    EXPECT_EQ(stats.allocatedBytes * 2, stats.requestedBytes);
+    EXPECT_EQ(stats.savedBytes, stats.requestedBytes - stats.allocatedBytes);
+
+    // Evaluating again reuses the recorded command buffer
+    tensorOut->setData(std::vector<float>(size, 0));
+    sq->eval();
+
+    EXPECT_EQ(tensorOut->vector(), std::vector<float>(size, 4));
+    EXPECT_EQ(sq->getTransientMemoryStats().tensorCount, 4u);
+}
+
+TEST(TestTransientMemory, TransientTensorsAliveTogetherDontShareMemory)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorIn = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorOut = mgr.tensor({ 0, 0, 0 });
+    std::shared_ptr<kp::TensorT<float>> transientA =
+      mgr.tensorT<float>(3, kp::Memory::MemoryTypes::eTransient);
+    std::shared_ptr<kp::TensorT<float>> transientB =
+      mgr.tensorT<float>(3, kp::Memory::MemoryTypes::eTransient);
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence()
+        ->record<kp::OpSyncDevice>({ tensorIn })
+        ->record<kp::OpCopy>({ tensorIn, transientA, transientB })
+        ->record<kp::OpAlgoDispatch>(mgr.algorithm(
+          { transientA, transientB }, compileSource(shaderAddOne)))
+        ->record<kp::OpCopy>({ transientB, tensorOut })
+        ->record<kp::OpSyncLocal>({ tensorOut })
+        ->eval();
+
+    EXPECT_EQ(tensorOut->vector(), std::vector<float>({ 2, 3, 4 }));
+
+    kp::Sequence::TransientMemoryStats stats = sq->getTransientMemoryStats();
+    EXPECT_EQ(stats.tensorCount, 2u);
+    EXPECT_EQ(stats.savedBytes, 0u);
+    EXPECT_GE(stats.allocatedBytes, stats.requestedBytes);
+}
+
+TEST(TestTransientMemory, SequenceWithoutTransientTensorsReportsNoSavings)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence()
+        ->record<kp::OpSyncDevice>({ tensorA })
+        ->record<kp::OpCopy>({ tensorA, tensorB })
+        ->record<kp::OpSyncLocal>({ tensorB })
+        ->eval();
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 1, 2, 3 }));
+    EXPECT_EQ(sq->getTransientMemoryStats().tensorCount, 0u);
+    EXPECT_EQ(sq->getTransientMemoryStats().savedBytes, 0u);
+}
+
+TEST(TestTransientMemory, RecordingAgainInDifferentOrderReplans)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 7, 8, 9 });
+    std::shared_ptr<kp::TensorT<float>> outA = mgr.tensor({ 0, 0, 0 });
+    std::shared_ptr<kp::TensorT<float>> outB = mgr.tensor({ 0, 0, 0 });
+
+    std::vector<std::shared_ptr<kp::TensorT<float>>> transients;
+    for (uint32_t i = 0; i < 3; i++) {
+        transients.push_back(
+          mgr.tensorT<float>(3, kp::Memory::MemoryTypes::eTransient));
+    }
+
+    std::vector<uint32_t> spirv = compileSource(shaderAddOne);
+
+    mgr.sequence()->eval<kp::OpSyncDevice>({ tensorA, tensorB });
+
+    // The first and last transient tensors share memory in this order
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence()
+        ->record<kp::OpCopy>({ tensorA, transients[0] })
+        ->record<kp::OpAlgoDispatch>(
+          mgr.algorithm({ transients[0], transients[1] }, spirv))
+        ->record<kp::OpAlgoDispatch>(
+          mgr.algorithm({ transients[1], transients[2] }, spirv))
+        ->record<kp::OpCopy>({ transients[2], outA })
+        ->record<kp::OpSyncLocal>({ outA })
+        ->eval();
+
+    EXPECT_EQ(outA->vector(), std::vector<float>({ 3, 4, 5 }));
+    EXPECT_GT(sq->getTransientMemoryStats().savedBytes, 0u);
+
+    sq->clear();
+    for (const std::shared_ptr<kp::TensorT<float>>& transient : transients) {
+        EXPECT_FALSE(transient->isMemoryBound());
+    }
+
+    // In this order they are alive at the same time
+    sq->record<kp::OpCopy>({ tensorA, transients[0] })
+      ->record<kp::OpCopy>({ tensorB, transients[2] })
+      ->record<kp::OpAlgoDispatch>(
+        mgr.algorithm({ transients[0], transients[1] }, spirv))
+      ->record<kp::OpCopy>({ transients[1], outA })
+      ->record<kp::OpCopy>({ transients[2], outB })
+      ->record<kp::OpSyncLocal>({ outA, outB })
+      ->eval();
+
+    EXPECT_EQ(outA->vector(), std::vector<float>({ 2, 3, 4 }));
+    EXPECT_EQ(outB->vector(), std::vector<float>({ 7, 8, 9 }));
+}
+
+TEST(TestTransientMemory, RerecordingKeepsStats)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorIn = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorOut = mgr.tensor({ 0, 0, 0 });
+
+    std::vector<std::shared_ptr<kp::TensorT<float>>> transients;
+    for (uint32_t i = 0; i < 3; i++) {
+        transients.push_back(
+          mgr.tensorT<float>(3, kp::Memory::MemoryTypes::eTransient));
+    }
+
+    std::vector<uint32_t> spirv = compileSource(shaderAddOne);
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence()
+        ->record<kp::OpSyncDevice>({ tensorIn })
+        ->record<kp::OpCopy>({ tensorIn, transients[0] })
+        ->record<kp::OpAlgoDispatch>(
+          mgr.algorithm({ transients[0], transients[1] }, spirv))
+        ->record<kp::OpAlgoDispatch>(
+          mgr.algorithm({ transients[1], transients[2] }, spirv))
+        ->record<kp::OpCopy>({ transients[2], tensorOut })
+        ->record<kp::OpSyncLocal>({ tensorOut })
+        ->eval();
+
+    kp::Sequence::TransientMemoryStats stats = sq->getTransientMemoryStats();
+    EXPECT_EQ(stats.tensorCount, 3u);
+
+    // Planning the same operations again reports the same memory
+    for (uint32_t i = 0; i < 2; i++) {
+        sq->rerecord();
+        sq->eval();
+
+        kp::Sequence::TransientMemoryStats replanned =
+          sq->getTransientMemoryStats();
+        EXPECT_EQ(replanned.tensorCount, stats.tensorCount);
+        EXPECT_EQ(replanned.requestedBytes, stats.requestedBytes);
+        EXPECT_EQ(replanned.allocatedBytes, stats.allocatedBytes);
+        EXPECT_EQ(replanned.savedBytes, stats.savedBytes);
+    }
+
+    EXPECT_EQ(tensorOut->vector(), std::vector<float>({ 3, 4, 5 }));
+}
+
+TEST(TestTransientMemory, TransientTensorPlannedByAnotherSequenceThrows)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+    std::shared_ptr<kp::TensorT<float>> transient =
+      mgr.tensorT<float>(3, kp::Memory::MemoryTypes::eTransient);
+
+    std::shared_ptr<kp::Sequence> sqA =
+      mgr.sequence()
+        ->record<kp::OpSyncDevice>({ tensorA })
+        ->record<kp::OpCopy>({ tensorA, transient })
+        ->record<kp::OpCopy>({ transient, tensorB });
+    sqA->eval();
+
+    std::shared_ptr<kp::Sequence> sqB = mgr.sequence();
+    EXPECT_THROW(sqB->record<kp::OpCopy>({ tensorA, transient }),
+                 std::runtime_error);
+
+    // Destroying the sequence releases the memory of the tensor
+    sqA->destroy();
+    EXPECT_FALSE(transient->isMemoryBound());
+
+    sqB->record<kp::OpCopy>({ tensorA, transient })
+      ->record<kp::OpAlgoDispatch>(mgr.algorithm(
+        { transient, tensorB }, compileSource(shaderAddOne)))
+      ->record<kp::OpSyncLocal>({ tensorB })
+      ->eval();
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 2, 3, 4 }));
+}
@@ -5,6 +5,7 @@
 #include "kompute/Kompute.hpp"
 #include "kompute/logger/Logger.hpp"
 
+#include "shaders/Utils.hpp"
 #include "test_workgroup_shader.hpp"
 
 TEST(TestWorkgroup, TestSimpleWorkgroup)
@@ -63,3 +64,112 @@ TEST(TestWorkgroup, TestSimpleWorkgroup)
         }
     }
 }
+
+TEST(TestWorkgroup, SplitsDispatchesOverMaxWorkgroupCount)
+{
+    kp::Manager mgr;
+
+    std::string shader(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) buffer a { float pa[]; };
+      layout(push_constant) uniform PushConstants {
+          float scale;
+          uint baseWorkgroup;
+      };
+      void main() {
+          uint index = gl_WorkGroupID.x + baseWorkgroup;
+          pa[index] = pa[index] + index * scale;
+      })");
+
+    std::shared_ptr<kp::TensorT<float>> tensor =
+      mgr.tensor(std::vector<float>(10, 1));
+
+    // Defaults to one workgroup per element, split in parts of 4, 4 and 2
+    std::shared_ptr<kp::Algorithm> algorithm = mgr.algorithm<float, float>(
+      { tensor }, compileSource(shader), {}, {}, { 2.0 });
+    algorithm->setMaxWorkgroupCount({ 4, 4, 4 });
+    EXPECT_EQ(algorithm->getBaseWorkgroupOffset(), sizeof(float));
+    EXPECT_TRUE(algorithm->readsBaseWorkgroup());
+
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ tensor })
+      ->record<kp::OpAlgoDispatch>(algorithm)
+      ->record<kp::OpAlgoDispatch>(algorithm, std::vector<float>{ 1.0 })
+      ->record<kp::OpSyncLocal>({ tensor })
+      ->eval();
+
+    EXPECT_EQ(tensor->vector(),
+              std::vector<float>({ 1, 4, 7, 10, 13, 16, 19, 22, 25, 28 }));
+}
+
+TEST(TestWorkgroup, OversizedWorkgroupInYThrows)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 0, 0, 0, 0 });
+
+    std::shared_ptr<kp::Algorithm> algorithm = mgr.algorithm(
+      { tensor },
+      compileSource(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) buffer a { float pa[]; };
+      void main() {
+          pa[gl_GlobalInvocationID.x] = 1;
+      })"),
+      { 1, 8, 1 });
+    algorithm->setMaxWorkgroupCount({ 4, 4, 4 });
+    EXPECT_EQ(algorithm->getBaseWorkgroupOffset(), 0);
+
+    EXPECT_THROW(mgr.sequence()->record<kp::OpAlgoDispatch>(algorithm),
+                 std::runtime_error);
+}
+
+TEST(TestWorkgroup, SplitWithoutBaseWorkgroupThrows)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor =
+      mgr.tensor(std::vector<float>(10, 0));
+
+    // The shader can't offset the groups of the parts of a split dispatch
+    std::shared_ptr<kp::Algorithm> algorithm = mgr.algorithm(
+      { tensor },
+      compileSource(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) buffer a { float pa[]; };
+      void main() {
+          pa[gl_GlobalInvocationID.x] = 1;
+      })"));
+    algorithm->setMaxWorkgroupCount({ 4, 4, 4 });
+    EXPECT_FALSE(algorithm->readsBaseWorkgroup());
+
+    EXPECT_THROW(mgr.sequence()->record<kp::OpAlgoDispatch>(algorithm),
+                 std::runtime_error);
+}
+
+TEST(TestWorkgroup, DefaultWorkgroupBeyond32BitsThrows)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 0, 0, 0, 0 });
+
+    std::shared_ptr<kp::Algorithm> algorithm = mgr.algorithm(
+      { tensor },
+      compileSource(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) buffer a { float pa[]; };
+      void main() {
+          pa[gl_GlobalInvocationID.x] = 1;
+      })"));
+
+    // The default workgroup of a tensor with more than 32 bits of elements
+    // can't be dispatched, whereas an explicit workgroup can be set
+    uint64_t size = uint64_t(UINT32_MAX) + 1;
+    EXPECT_THROW(algorithm->setWorkgroup({}, size), std::runtime_error);
+    EXPECT_NO_THROW(algorithm->setWorkgroup({ 4, 1, 1 }, size));
+    EXPECT_EQ(algorithm->getWorkgroup(), kp::Workgroup({ 4, 1, 1 }));
+}